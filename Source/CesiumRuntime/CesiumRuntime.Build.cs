@@ -121,6 +121,8 @@ public class CesiumRuntime : ModuleRules
         );
 
         PrivateDependencyModuleNames.Add("Chaos");
+        PrivateDependencyModuleNames.Add("EyeTracker");
+        PrivateDependencyModuleNames.Add("Json");
 
         if (Target.bBuildEditor == true)
         {
@@ -16,6 +16,7 @@
 #include "CesiumAsync/SharedAssetDepot.h"
 #include "CesiumBoundingVolumeComponent.h"
 #include "CesiumCamera.h"
+#include "CesiumCameraPath.h"
 #include "CesiumCameraManager.h"
 #include "CesiumCommon.h"
 #include "CesiumCustomVersion.h"
@@ -25,33 +26,49 @@
 #include "CesiumGltfComponent.h"
 #include "CesiumGltfPointsSceneProxyUpdater.h"
 #include "CesiumGltfPrimitiveComponent.h"
+#include "CesiumInstanceAggregator.h"
 #include "CesiumIonClient/Connection.h"
 #include "CesiumLifetime.h"
+#include "CesiumMeshDepot.h"
+#include "CesiumPhysicsMeshCooker.h"
+#include "CesiumPolygonClipper.h"
+#include "CesiumPolygonRasterOverlay.h"
 #include "CesiumRasterOverlay.h"
 #include "CesiumRuntime.h"
 #include "CesiumRuntimeSettings.h"
+#include "CesiumScreenSpaceErrorGovernor.h"
+#include "CesiumStats.h"
+#include "CesiumStyle.h"
+#include "CesiumTextureMipStreamer.h"
 #include "CesiumTextureUtility.h"
+#include "CesiumTileBudgetSubsystem.h"
 #include "CesiumTileExcluder.h"
+#include "CesiumTileObjectPool.h"
+#include "CesiumTilesetMemory.h"
 #include "CesiumViewExtension.h"
-#include "Components/SceneCaptureComponent2D.h"
+#include "CesiumViewSubsystem.h"
+#include "CesiumWarmStart.h"
 #include "CreateGltfOptions.h"
 #include "Engine/Engine.h"
-#include "Engine/LocalPlayer.h"
-#include "Engine/SceneCapture2D.h"
 #include "Engine/Texture.h"
 #include "Engine/Texture2D.h"
 #include "Engine/TextureRenderTarget2D.h"
 #include "Engine/World.h"
 #include "EngineUtils.h"
 #include "ExtensionImageAssetUnreal.h"
+#include "GameFramework/Pawn.h"
 #include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
 #include "Kismet/GameplayStatics.h"
 #include "LevelSequenceActor.h"
 #include "LevelSequencePlayer.h"
 #include "Math/UnrealMathUtility.h"
+#include "Misc/App.h"
 #include "PixelFormat.h"
-#include "StereoRendering.h"
+#include "RHI.h"
+#include "RenderCore.h"
 #include "VecMath.h"
+#include <algorithm>
 #include <glm/gtc/matrix_inverse.hpp>
 #include <memory>
 #include <spdlog/spdlog.h>
@@ -93,6 +110,15 @@ ACesium3DTileset::ACesium3DTileset()
       _beforeMovieLoadingDescendantLimit{LoadingDescendantLimit},
       _beforeMovieUseLodTransitions{true},
 
+      _warmStartActive(false),
+      _cameraPathTime(0.0),
+      _lastTileLoadQueueLength(0),
+
+      _unrealMemoryBytes(0),
+      _unrealMemoryFrame(0),
+
+      _overlaysScaledByTileBudget(false),
+
       _tilesetsBeingDestroyed(0) {
   PrimaryActorTick.bCanEverTick = true;
   PrimaryActorTick.TickGroup = ETickingGroup::TG_PostUpdateWork;
@@ -455,6 +481,48 @@ void ACesium3DTileset::SetCreatePhysicsMeshes(bool bCreatePhysicsMeshes) {
   }
 }
 
+void ACesium3DTileset::SetPhysicsMeshPolicy(
+    ECesiumPhysicsMeshPolicy NewPhysicsMeshPolicy) {
+  if (this->PhysicsMeshPolicy != NewPhysicsMeshPolicy) {
+    this->PhysicsMeshPolicy = NewPhysicsMeshPolicy;
+    this->DestroyTileset();
+  }
+}
+
+void ACesium3DTileset::SetPhysicsMeshSimplificationResolution(
+    int32 NewResolution) {
+  if (this->PhysicsMeshSimplificationResolution != NewResolution) {
+    this->PhysicsMeshSimplificationResolution = NewResolution;
+    this->DestroyTileset();
+  }
+}
+
+void ACesium3DTileset::SetCollisionOnlyMode(
+    ECesiumCollisionOnlyMode NewCollisionOnlyMode) {
+  if (this->CollisionOnlyMode != NewCollisionOnlyMode) {
+    this->CollisionOnlyMode = NewCollisionOnlyMode;
+    this->DestroyTileset();
+  }
+}
+
+void ACesium3DTileset::SetLoadMetadataWhenCollisionOnly(bool bLoadMetadata) {
+  if (this->LoadMetadataWhenCollisionOnly != bLoadMetadata) {
+    this->LoadMetadataWhenCollisionOnly = bLoadMetadata;
+    this->DestroyTileset();
+  }
+}
+
+bool ACesium3DTileset::IsCollisionOnly() const {
+  switch (this->CollisionOnlyMode) {
+  case ECesiumCollisionOnlyMode::Always:
+    return true;
+  case ECesiumCollisionOnlyMode::WhenHeadless:
+    return IsRunningDedicatedServer() || !FApp::CanEverRender();
+  default:
+    return false;
+  }
+}
+
 void ACesium3DTileset::SetCreateNavCollision(bool bCreateNavCollision) {
   if (this->CreateNavCollision != bCreateNavCollision) {
     this->CreateNavCollision = bCreateNavCollision;
@@ -476,6 +544,42 @@ void ACesium3DTileset::SetGenerateSmoothNormals(bool bGenerateSmoothNormals) {
   }
 }
 
+void ACesium3DTileset::SetOptimizeMeshes(bool bOptimizeMeshes) {
+  if (this->OptimizeMeshes != bOptimizeMeshes) {
+    this->OptimizeMeshes = bOptimizeMeshes;
+    this->DestroyTileset();
+  }
+}
+
+void ACesium3DTileset::SetUseHalfPrecisionUVs(
+    bool bUseHalfPrecisionUVs) {
+  if (this->UseHalfPrecisionUVs != bUseHalfPrecisionUVs) {
+    this->UseHalfPrecisionUVs = bUseHalfPrecisionUVs;
+    this->DestroyTileset();
+  }
+}
+
+void ACesium3DTileset::SetMergePrimitives(bool bMergePrimitives) {
+  if (this->MergePrimitives != bMergePrimitives) {
+    this->MergePrimitives = bMergePrimitives;
+    this->DestroyTileset();
+  }
+}
+
+void ACesium3DTileset::SetAggregateInstances(bool bAggregateInstances) {
+  if (this->AggregateInstances != bAggregateInstances) {
+    this->AggregateInstances = bAggregateInstances;
+    this->DestroyTileset();
+  }
+}
+
+void ACesium3DTileset::SetShareIdenticalMeshes(bool bShareIdenticalMeshes) {
+  if (this->ShareIdenticalMeshes != bShareIdenticalMeshes) {
+    this->ShareIdenticalMeshes = bShareIdenticalMeshes;
+    this->DestroyTileset();
+  }
+}
+
 void ACesium3DTileset::SetEnableWaterMask(bool bEnableMask) {
   if (this->EnableWaterMask != bEnableMask) {
     this->EnableWaterMask = bEnableMask;
@@ -528,6 +632,206 @@ void ACesium3DTileset::SetPointCloudShading(
   }
 }
 
+void ACesium3DTileset::SetStyle(const FString& InStyle) {
+  this->Style = InStyle;
+  this->compileStyle();
+
+  TArray<UCesiumGltfComponent*> gltfComponents;
+  this->GetComponents<UCesiumGltfComponent>(gltfComponents);
+
+  for (UCesiumGltfComponent* pGltf : gltfComponents) {
+    pGltf->UpdateStyle(this->_pStyle.get());
+  }
+}
+
+void ACesium3DTileset::compileStyle() {
+  std::shared_ptr<const CesiumStyle::Style> pStyle;
+
+  if (!this->Style.TrimStartAndEnd().IsEmpty()) {
+    FString error;
+    std::optional<CesiumStyle::Style> maybeStyle =
+        CesiumStyle::Style::parse(this->Style, error);
+    if (maybeStyle) {
+      if (this->_featuresMetadataDescription) {
+        maybeStyle->compilePrograms(
+            this->_featuresMetadataDescription->ModelMetadata.PropertyTables);
+      }
+      pStyle = std::make_shared<CesiumStyle::Style>(std::move(*maybeStyle));
+    } else {
+      UE_LOG(
+          LogCesium,
+          Error,
+          TEXT("Tileset %s has an invalid style: %s"),
+          *this->GetName(),
+          *error);
+    }
+  }
+
+  {
+    FScopeLock lock(&this->_styleLock);
+    this->_pStyle = std::move(pStyle);
+  }
+
+  this->updateStyleProgramTextures();
+}
+
+namespace {
+/**
+ * Copies a style program into texels, padding it with End instructions to the
+ * width of the program texture.
+ */
+TArray<FLinearColor>*
+createStyleProgramTexels(const std::vector<glm::vec4>* pProgram) {
+  TArray<FLinearColor>* pTexels = new TArray<FLinearColor>();
+  pTexels->SetNumZeroed(CesiumStyle::MaximumProgramLength);
+  if (pProgram) {
+    const int32 length =
+        FMath::Min(int32(pProgram->size()), CesiumStyle::MaximumProgramLength);
+    for (int32 i = 0; i < length; ++i) {
+      const glm::vec4& instruction = (*pProgram)[i];
+      (*pTexels)[i] = FLinearColor(
+          instruction.x,
+          instruction.y,
+          instruction.z,
+          instruction.w);
+    }
+  }
+  return pTexels;
+}
+} // namespace
+
+UTexture2D*
+ACesium3DTileset::GetStyleProgramTexture(const FString& PropertyTableName) {
+  UTexture2D*& pTexture =
+      this->StyleProgramTextures.FindOrAdd(PropertyTableName, nullptr);
+  if (pTexture) {
+    return pTexture;
+  }
+
+  pTexture = UTexture2D::CreateTransient(
+      CesiumStyle::MaximumProgramLength,
+      1,
+      PF_A32B32G32R32F);
+  pTexture->Filter = TextureFilter::TF_Nearest;
+  pTexture->AddressX = TextureAddress::TA_Clamp;
+  pTexture->AddressY = TextureAddress::TA_Clamp;
+  pTexture->SRGB = false;
+
+  const CesiumStyle::Style* pStyle = this->_pStyle.get();
+  TUniquePtr<TArray<FLinearColor>> pTexels(createStyleProgramTexels(
+      pStyle ? pStyle->getProgram(PropertyTableName) : nullptr));
+
+  FTexture2DMipMap& mip = pTexture->GetPlatformData()->Mips[0];
+  void* pData = mip.BulkData.Lock(LOCK_READ_WRITE);
+  FMemory::Memcpy(
+      pData,
+      pTexels->GetData(),
+      pTexels->Num() * sizeof(FLinearColor));
+  mip.BulkData.Unlock();
+  pTexture->UpdateResource();
+
+  return pTexture;
+}
+
+void ACesium3DTileset::updateStyleProgramTextures() {
+  const CesiumStyle::Style* pStyle = this->_pStyle.get();
+
+  for (const TPair<FString, UTexture2D*>& pair : this->StyleProgramTextures) {
+    if (!pair.Value) {
+      continue;
+    }
+
+    // The materials keep referencing the same texture, so changing the style
+    // is one small upload per property table.
+    TArray<FLinearColor>* pTexels = createStyleProgramTexels(
+        pStyle ? pStyle->getProgram(pair.Key) : nullptr);
+    FUpdateTextureRegion2D* pRegion = new FUpdateTextureRegion2D(
+        0,
+        0,
+        0,
+        0,
+        CesiumStyle::MaximumProgramLength,
+        1);
+    pair.Value->UpdateTextureRegions(
+        0,
+        1,
+        pRegion,
+        CesiumStyle::MaximumProgramLength * sizeof(FLinearColor),
+        sizeof(FLinearColor),
+        reinterpret_cast<uint8*>(pTexels->GetData()),
+        [pTexels](uint8* pSrcData, const FUpdateTextureRegion2D* pRegions) {
+          delete pTexels;
+          delete pRegions;
+        });
+  }
+}
+
+std::shared_ptr<const CesiumStyle::Style>
+ACesium3DTileset::getStyleForLoading() const {
+  FScopeLock lock(&this->_styleLock);
+  return this->_pStyle;
+}
+
+void ACesium3DTileset::SetPolygonClipper(
+    const UCesiumPolygonRasterOverlay* pOverlay,
+    std::shared_ptr<const CesiumPolygonClipper> pClipper) {
+  if (pClipper) {
+    this->_polygonClippersByOverlay.Add(pOverlay, std::move(pClipper));
+  } else {
+    this->_polygonClippersByOverlay.Remove(pOverlay);
+  }
+  this->_polygonClippersChanged = true;
+}
+
+void ACesium3DTileset::updatePolygonClippers() {
+  if (!this->_polygonClippersChanged) {
+    return;
+  }
+  this->_polygonClippersChanged = false;
+
+  auto pClippers = std::make_shared<PolygonClippers>();
+  for (const auto& pair : this->_polygonClippersByOverlay) {
+    pClippers->emplace_back(pair.Value);
+  }
+
+  std::shared_ptr<const PolygonClippers> pPrevious;
+  {
+    FScopeLock lock(&this->_polygonClipperLock);
+    pPrevious = std::move(this->_pPolygonClippers);
+    this->_pPolygonClippers = pClippers;
+  }
+
+  // Refreshing an overlay removes and adds its clipper again, which does not
+  // change the clipping.
+  const bool unchanged =
+      pPrevious && pPrevious->size() == pClippers->size() &&
+      std::equal(
+          pPrevious->begin(),
+          pPrevious->end(),
+          pClippers->begin(),
+          [](const std::shared_ptr<const CesiumPolygonClipper>& pA,
+             const std::shared_ptr<const CesiumPolygonClipper>& pB) {
+            return *pA == *pB;
+          });
+
+  // Triangles are only clipped as tiles are loaded, so the tiles that are
+  // already loaded need to be loaded again.
+  if (!unchanged && this->_pTileset && this->_tilesLoadedWithPolygonClippers) {
+    UE_LOG(
+        LogCesium,
+        Verbose,
+        TEXT("Refreshing tileset %s because its polygon clipping changed"),
+        *this->GetName());
+    this->RefreshTileset();
+  }
+}
+
+std::shared_ptr<const ACesium3DTileset::PolygonClippers>
+ACesium3DTileset::getPolygonClippersForLoading() const {
+  FScopeLock lock(&this->_polygonClipperLock);
+  return this->_pPolygonClippers;
+}
+
 void ACesium3DTileset::PlayMovieSequencer() {
   this->_beforeMoviePreloadAncestors = this->PreloadAncestors;
   this->_beforeMoviePreloadSiblings = this->PreloadSiblings;
@@ -551,6 +855,26 @@ void ACesium3DTileset::StopMovieSequencer() {
 
 void ACesium3DTileset::PauseMovieSequencer() { this->StopMovieSequencer(); }
 
+void ACesium3DTileset::SetCameraPath(
+    const TArray<FCesiumCameraPathPoint>& Path) {
+  this->_cameraPath = Path;
+  this->_cameraPath.StableSort(
+      [](const FCesiumCameraPathPoint& a, const FCesiumCameraPathPoint& b) {
+        return a.Time < b.Time;
+      });
+  this->_cameraPathTime =
+      this->_cameraPath.IsEmpty() ? 0.0 : this->_cameraPath[0].Time;
+}
+
+void ACesium3DTileset::ClearCameraPath() {
+  this->_cameraPath.Empty();
+  this->_cameraPathTime = 0.0;
+}
+
+void ACesium3DTileset::SetCameraPathTime(double Time) {
+  this->_cameraPathTime = Time;
+}
+
 #if WITH_EDITOR
 void ACesium3DTileset::OnFocusEditorViewportOnThis() {
   UE_LOG(
@@ -776,6 +1100,20 @@ void ACesium3DTileset::NotifyHit(
   // std::cout << "Hit face index 2: " << detailedHit.FaceIndex << std::endl;
 }
 
+namespace {
+/**
+ * Gets the URL of a tile's content, which matches the tile's trace events to
+ * its network request.
+ */
+std::string getTileUrl(const CesiumGltf::Model& model) {
+  auto urlIt = model.extras.find("Cesium3DTiles_TileUrl");
+  if (urlIt == model.extras.end()) {
+    return std::string();
+  }
+  return urlIt->second.getStringOrDefault("");
+}
+} // namespace
+
 class UnrealResourcePreparer
     : public Cesium3DTilesSelection::IPrepareRendererResources {
 public:
@@ -796,13 +1134,53 @@ public:
               nullptr});
     }
 
+    const bool trace = CesiumTrace::isEnabled();
+    const uint64 startCycle = trace ? FPlatformTime::Cycles64() : 0;
+    std::string url = trace ? getTileUrl(*options.pModel) : std::string();
+    if (trace) {
+      std::optional<uint64> networkEnd =
+          CesiumTrace::takeNetworkRequestEnd(url);
+      if (networkEnd) {
+        CesiumTrace::traceTileStage(
+            CesiumTrace::TileStage::Decode,
+            *networkEnd,
+            startCycle,
+            std::string(),
+            url);
+      }
+    }
+
     options.alwaysIncludeTangents = this->_pActor->GetAlwaysIncludeTangents();
     options.createPhysicsMeshes = this->_pActor->GetCreatePhysicsMeshes();
+    options.collisionOnly = this->_pActor->IsCollisionOnly();
+    options.loadMetadata = this->_pActor->GetLoadMetadataWhenCollisionOnly();
+    options.deferPhysicsMeshes =
+        this->_pActor->GetPhysicsMeshPolicy() ==
+        ECesiumPhysicsMeshPolicy::NearPhysicsRelevantActors;
+    options.physicsMeshSimplificationResolution =
+        this->_pActor->GetPhysicsMeshSimplificationResolution();
 
     options.ignoreKhrMaterialsUnlit =
         this->_pActor->GetIgnoreKhrMaterialsUnlit();
+    options.optimizeMeshes = this->_pActor->GetOptimizeMeshes();
+    options.useHalfPrecisionUVs =
+        this->_pActor->GetUseHalfPrecisionUVs();
+    options.mergePrimitives = this->_pActor->GetMergePrimitives();
+    options.aggregateInstances = this->_pActor->GetAggregateInstances();
+    options.shareMeshes = this->_pActor->GetShareIdenticalMeshes();
+
+    std::shared_ptr<const ACesium3DTileset::PolygonClippers> pClippers =
+        this->_pActor->getPolygonClippersForLoading();
+    if (pClippers) {
+      options.polygonClippers = *pClippers;
+    }
+    this->_pActor->_tilesLoadedWithPolygonClippers = true;
 
-    if (this->_pActor->_featuresMetadataDescription) {
+    if (options.collisionOnly) {
+      // Collision is the only reason to load a collision-only tile, and its
+      // metadata is never encoded for materials.
+      options.createPhysicsMeshes = true;
+    } else if (this->_pActor->_featuresMetadataDescription) {
       options.pFeaturesMetadataDescription =
           &(*this->_pActor->_featuresMetadataDescription);
     } else if (this->_pActor->_metadataDescription_DEPRECATED) {
@@ -810,6 +1188,10 @@ public:
           &(*this->_pActor->_metadataDescription_DEPRECATED);
     }
 
+    if (!options.collisionOnly) {
+      options.pStyle = this->_pActor->getStyleForLoading();
+    }
+
     const CesiumGeospatial::Ellipsoid& ellipsoid = tileLoadResult.ellipsoid;
 
     CesiumAsync::Future<UCesiumGltfComponent::CreateOffGameThreadResult>
@@ -821,8 +1203,17 @@ public:
 
     return MoveTemp(pHalfFuture)
         .thenImmediately(
-            [](UCesiumGltfComponent::CreateOffGameThreadResult&& result)
+            [trace, startCycle, url = std::move(url)](
+                UCesiumGltfComponent::CreateOffGameThreadResult&& result)
                 -> Cesium3DTilesSelection::TileLoadResultAndRenderResources {
+              if (trace) {
+                CesiumTrace::traceTileStage(
+                    CesiumTrace::TileStage::LoadThread,
+                    startCycle,
+                    FPlatformTime::Cycles64(),
+                    std::string(),
+                    url);
+              }
               return Cesium3DTilesSelection::TileLoadResultAndRenderResources{
                   std::move(result.TileLoadResult),
                   result.HalfConstructed.Release()};
@@ -834,12 +1225,15 @@ public:
       void* pLoadThreadResult) override {
     Cesium3DTilesSelection::TileContent& content = tile.getContent();
     if (content.isRenderContent()) {
+      const bool trace = CesiumTrace::isEnabled();
+      const uint64 startCycle = trace ? FPlatformTime::Cycles64() : 0;
+
       TUniquePtr<UCesiumGltfComponent::HalfConstructed> pHalf(
           reinterpret_cast<UCesiumGltfComponent::HalfConstructed*>(
               pLoadThreadResult));
       Cesium3DTilesSelection::TileRenderContent& renderContent =
           *content.getRenderContent();
-      return UCesiumGltfComponent::CreateOnGameThread(
+      UCesiumGltfComponent* pGltf = UCesiumGltfComponent::CreateOnGameThread(
           renderContent.getModel(),
           this->_pActor,
           std::move(pHalf),
@@ -849,7 +1243,25 @@ public:
           this->_pActor->GetWaterMaterial(),
           this->_pActor->GetCustomDepthParameters(),
           tile,
-          this->_pActor->GetCreateNavCollision());
+          this->_pActor->GetCreateNavCollision(),
+          this->_pActor->TileObjectPool);
+      if (pGltf && this->_pActor->_pPhysicsMeshCooker) {
+        this->_pActor->_pPhysicsMeshCooker->addComponent(pGltf);
+      }
+      if (pGltf && this->_pActor->_pInstanceAggregator) {
+        this->_pActor->_pInstanceAggregator->addComponent(pGltf);
+      }
+
+      if (trace) {
+        CesiumTrace::traceTileStage(
+            CesiumTrace::TileStage::MainThread,
+            startCycle,
+            FPlatformTime::Cycles64(),
+            Cesium3DTilesSelection::TileIdUtilities::createTileIdString(
+                tile.getTileID()),
+            getTileUrl(renderContent.getModel()));
+      }
+      return pGltf;
     }
     // UE_LOG(LogCesium, VeryVerbose, TEXT("No content for tile"));
     return nullptr;
@@ -867,7 +1279,14 @@ public:
     } else if (pMainThreadResult) {
       UCesiumGltfComponent* pGltf =
           reinterpret_cast<UCesiumGltfComponent*>(pMainThreadResult);
-      CesiumLifetime::destroyComponentRecursively(pGltf);
+      if (this->_pActor->_pTileTeardownQueue) {
+        CesiumLifetime::scheduleTileTeardown(
+            *this->_pActor->_pTileTeardownQueue,
+            pGltf,
+            this->_pActor->TileObjectPool);
+      } else {
+        CesiumLifetime::destroyComponentRecursively(pGltf);
+      }
     }
   }
 
@@ -1175,6 +1594,37 @@ void ACesium3DTileset::LoadTileset() {
     this->BoundingVolumePoolComponent->initPool(this->OcclusionPoolSize);
   }
 
+  if (!this->TileObjectPool) {
+    this->TileObjectPool = NewObject<UCesiumTileObjectPool>(this);
+    this->TileObjectPool->SetFlags(
+        RF_Transient | RF_DuplicateTransient | RF_TextExportTransient);
+  }
+
+  if (!this->_pTileTeardownQueue) {
+    this->_pTileTeardownQueue = MakeUnique<TileTeardownQueue>();
+  }
+
+  if (!this->_pPhysicsMeshCooker) {
+    this->_pPhysicsMeshCooker = MakeUnique<CesiumPhysicsMeshCooker>();
+  }
+
+  if (!this->_pInstanceAggregator) {
+    this->_pInstanceAggregator = MakeUnique<CesiumInstanceAggregator>();
+  }
+
+  if (this->ShareIdenticalMeshes) {
+    // Create the mesh depot on the game thread, before tiles are loaded by
+    // worker threads.
+    CesiumMeshDepot::getInstance();
+  }
+
+  if (!this->_pScreenSpaceErrorGovernor) {
+    this->_pScreenSpaceErrorGovernor =
+        MakeUnique<CesiumScreenSpaceErrorGovernor>();
+  }
+
+  this->compileStyle();
+
   CesiumGeospatial::Ellipsoid pNativeEllipsoid =
       this->ResolveGeoreference()->GetEllipsoid()->GetNativeEllipsoid();
 
@@ -1326,12 +1776,20 @@ void ACesium3DTileset::LoadTileset() {
     break;
   }
 
+  // Polygon raster overlays set their clippers as they are added, before any
+  // tile of the new tileset starts loading.
+  this->_polygonClippersByOverlay.Empty();
+  this->_polygonClippersChanged = true;
+  this->_tilesLoadedWithPolygonClippers = false;
+
   for (UCesiumRasterOverlay* pOverlay : rasterOverlays) {
     if (pOverlay->IsActive()) {
       pOverlay->AddToTileset();
     }
   }
 
+  this->updatePolygonClippers();
+
   for (UCesiumTileExcluder* pTileExcluder : tileExcluders) {
     if (pTileExcluder->IsActive()) {
       pTileExcluder->AddToTileset();
@@ -1372,6 +1830,8 @@ void ACesium3DTileset::LoadTileset() {
   default:
     _scaleUsingDPI = true;
   }
+
+  this->beginWarmStart();
 }
 
 void ACesium3DTileset::DestroyTileset() {
@@ -1379,6 +1839,30 @@ void ACesium3DTileset::DestroyTileset() {
     this->_cesiumViewExtension = nullptr;
   }
 
+  this->_warmStartActive = false;
+
+  if (this->_pPhysicsMeshCooker) {
+    this->_pPhysicsMeshCooker->clear();
+  }
+
+  if (this->_pInstanceAggregator) {
+    this->_pInstanceAggregator->clear();
+  }
+
+  if (this->_pScreenSpaceErrorGovernor) {
+    this->_pScreenSpaceErrorGovernor->reset();
+  }
+
+  // When called from the destructor, the world may already be gone. The
+  // budget drops destroyed tilesets on its own in that case.
+  UWorld* pWorld =
+      this->HasAnyFlags(RF_BeginDestroyed) ? nullptr : this->GetWorld();
+  UCesiumTileBudgetSubsystem* pBudget =
+      pWorld ? pWorld->GetSubsystem<UCesiumTileBudgetSubsystem>() : nullptr;
+  if (pBudget) {
+    pBudget->removeTileset(this);
+  }
+
   switch (this->TilesetSource) {
   case ETilesetSource::FromEllipsoid:
     UE_LOG(LogCesium, Verbose, TEXT("Destroying tileset from ellipsoid"));
@@ -1453,234 +1937,37 @@ void ACesium3DTileset::DestroyTileset() {
   }
 }
 
-std::vector<FCesiumCamera> ACesium3DTileset::GetCameras() const {
-  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::CollectCameras)
-  std::vector<FCesiumCamera> cameras = this->GetPlayerCameras();
-
-  std::vector<FCesiumCamera> sceneCaptures = this->GetSceneCaptures();
-  cameras.insert(
-      cameras.end(),
-      std::make_move_iterator(sceneCaptures.begin()),
-      std::make_move_iterator(sceneCaptures.end()));
-
-#if WITH_EDITOR
-  std::vector<FCesiumCamera> editorCameras = this->GetEditorCameras();
-  cameras.insert(
-      cameras.end(),
-      std::make_move_iterator(editorCameras.begin()),
-      std::make_move_iterator(editorCameras.end()));
-#endif
-
-  ACesiumCameraManager* pCameraManager = this->ResolvedCameraManager;
-  if (pCameraManager) {
-    const TMap<int32, FCesiumCamera>& extraCameras =
-        pCameraManager->GetCameras();
-    cameras.reserve(cameras.size() + extraCameras.Num());
-    for (auto cameraIt : extraCameras) {
-      cameras.push_back(cameraIt.Value);
-    }
-  }
-
-  return cameras;
-}
-
-std::vector<FCesiumCamera> ACesium3DTileset::GetPlayerCameras() const {
-  UWorld* pWorld = this->GetWorld();
-  if (!pWorld) {
-    return {};
-  }
-
-  double worldToMeters = 100.0;
-  AWorldSettings* pWorldSettings = pWorld->GetWorldSettings();
-  if (pWorldSettings) {
-    worldToMeters = pWorldSettings->WorldToMeters;
+std::vector<FCesiumCamera>
+ACesium3DTileset::GetCameraPathPrefetchCameras() const {
+  std::vector<FCesiumCamera> cameras;
+  if (this->_cameraPath.IsEmpty() || this->MaximumCameraPathPrefetchViews <= 0 ||
+      this->CameraPathLookAheadSeconds <= 0.0f || !this->_pTileset) {
+    return cameras;
   }
 
-  TSharedPtr<IStereoRendering, ESPMode::ThreadSafe> pStereoRendering = nullptr;
-  if (GEngine) {
-    pStereoRendering = GEngine->StereoRenderingDevice;
+  if (!CesiumCameraPath::canPrefetch(
+          this->_pTileset->getTotalDataBytes(),
+          this->_pTileset->getOptions().maximumCachedBytes,
+          this->CameraPathPrefetchMaximumBytes,
+          this->_lastTileLoadQueueLength,
+          this->CameraPathPrefetchMaximumPendingLoads)) {
+    return cameras;
   }
 
-  bool useStereoRendering = false;
-  if (pStereoRendering && pStereoRendering->IsStereoEnabled()) {
-    useStereoRendering = true;
+  double endOfPath = this->_cameraPath.Last().Time;
+  if (this->_cameraPathTime >= endOfPath) {
+    return cameras;
   }
 
-  std::vector<FCesiumCamera> cameras;
-  cameras.reserve(pWorld->GetNumPlayerControllers());
-
-  for (auto playerControllerIt = pWorld->GetPlayerControllerIterator();
-       playerControllerIt;
-       playerControllerIt++) {
-    const TWeakObjectPtr<APlayerController> pPlayerController =
-        *playerControllerIt;
-    if (pPlayerController == nullptr) {
-      continue;
+  double step = double(this->CameraPathLookAheadSeconds) /
+                double(this->MaximumCameraPathPrefetchViews);
+  cameras.reserve(this->MaximumCameraPathPrefetchViews);
+  for (int32 i = 1; i <= this->MaximumCameraPathPrefetchViews; ++i) {
+    double time = this->_cameraPathTime + step * i;
+    cameras.push_back(CesiumCameraPath::interpolate(this->_cameraPath, time));
+    if (time >= endOfPath) {
+      break;
     }
-
-    const APlayerCameraManager* pPlayerCameraManager =
-        pPlayerController->PlayerCameraManager;
-
-    if (!pPlayerCameraManager) {
-      continue;
-    }
-
-    double fov = pPlayerCameraManager->GetFOVAngle();
-
-    FVector location;
-    FRotator rotation;
-    pPlayerController->GetPlayerViewPoint(location, rotation);
-
-    int32 sizeX, sizeY;
-    pPlayerController->GetViewportSize(sizeX, sizeY);
-    if (sizeX < 1 || sizeY < 1) {
-      continue;
-    }
-
-    float dpiScalingFactor = 1.0f;
-    if (this->_scaleUsingDPI) {
-      ULocalPlayer* LocPlayer = Cast<ULocalPlayer>(pPlayerController->Player);
-      if (LocPlayer && LocPlayer->ViewportClient) {
-        dpiScalingFactor = LocPlayer->ViewportClient->GetDPIScale();
-      }
-    }
-
-    if (useStereoRendering) {
-      const auto leftEye = EStereoscopicEye::eSSE_LEFT_EYE;
-      const auto rightEye = EStereoscopicEye::eSSE_RIGHT_EYE;
-
-      uint32 stereoLeftSizeX = static_cast<uint32>(sizeX);
-      uint32 stereoLeftSizeY = static_cast<uint32>(sizeY);
-      uint32 stereoRightSizeX = static_cast<uint32>(sizeX);
-      uint32 stereoRightSizeY = static_cast<uint32>(sizeY);
-      if (useStereoRendering) {
-        int32 _x;
-        int32 _y;
-
-        pStereoRendering
-            ->AdjustViewRect(leftEye, _x, _y, stereoLeftSizeX, stereoLeftSizeY);
-
-        pStereoRendering->AdjustViewRect(
-            rightEye,
-            _x,
-            _y,
-            stereoRightSizeX,
-            stereoRightSizeY);
-      }
-
-      FVector2D stereoLeftSize(stereoLeftSizeX, stereoLeftSizeY);
-      FVector2D stereoRightSize(stereoRightSizeX, stereoRightSizeY);
-
-      if (stereoLeftSize.X >= 1.0 && stereoLeftSize.Y >= 1.0) {
-        FVector leftEyeLocation = location;
-        FRotator leftEyeRotation = rotation;
-        pStereoRendering->CalculateStereoViewOffset(
-            leftEye,
-            leftEyeRotation,
-            worldToMeters,
-            leftEyeLocation);
-
-        FMatrix projection =
-            pStereoRendering->GetStereoProjectionMatrix(leftEye);
-
-        // TODO: consider assymetric frustums using 4 fovs
-        double one_over_tan_half_hfov = projection.M[0][0];
-
-        double hfov =
-            glm::degrees(2.0 * glm::atan(1.0 / one_over_tan_half_hfov));
-
-        cameras.emplace_back(
-            stereoLeftSize,
-            leftEyeLocation,
-            leftEyeRotation,
-            hfov);
-      }
-
-      if (stereoRightSize.X >= 1.0 && stereoRightSize.Y >= 1.0) {
-        FVector rightEyeLocation = location;
-        FRotator rightEyeRotation = rotation;
-        pStereoRendering->CalculateStereoViewOffset(
-            rightEye,
-            rightEyeRotation,
-            worldToMeters,
-            rightEyeLocation);
-
-        FMatrix projection =
-            pStereoRendering->GetStereoProjectionMatrix(rightEye);
-
-        double one_over_tan_half_hfov = projection.M[0][0];
-
-        double hfov =
-            glm::degrees(2.0f * glm::atan(1.0f / one_over_tan_half_hfov));
-
-        cameras.emplace_back(
-            stereoRightSize,
-            rightEyeLocation,
-            rightEyeRotation,
-            hfov);
-      }
-    } else {
-      cameras.emplace_back(
-          FVector2D(sizeX / dpiScalingFactor, sizeY / dpiScalingFactor),
-          location,
-          rotation,
-          fov);
-    }
-  }
-
-  return cameras;
-}
-
-std::vector<FCesiumCamera> ACesium3DTileset::GetSceneCaptures() const {
-  // TODO: really USceneCaptureComponent2D can be attached to any actor, is it
-  // worth searching every actor? Might it be better to provide an interface
-  // where users can volunteer cameras to be used with the tile selection as
-  // needed?
-  TArray<AActor*> sceneCaptures;
-  static TSubclassOf<ASceneCapture2D> SceneCapture2D =
-      ASceneCapture2D::StaticClass();
-  UGameplayStatics::GetAllActorsOfClass(this, SceneCapture2D, sceneCaptures);
-
-  std::vector<FCesiumCamera> cameras;
-  cameras.reserve(sceneCaptures.Num());
-
-  for (AActor* pActor : sceneCaptures) {
-    ASceneCapture2D* pSceneCapture = static_cast<ASceneCapture2D*>(pActor);
-    if (!pSceneCapture) {
-      continue;
-    }
-
-    USceneCaptureComponent2D* pSceneCaptureComponent =
-        pSceneCapture->GetCaptureComponent2D();
-    if (!pSceneCaptureComponent) {
-      continue;
-    }
-
-    if (pSceneCaptureComponent->ProjectionType !=
-        ECameraProjectionMode::Type::Perspective) {
-      continue;
-    }
-
-    UTextureRenderTarget2D* pRenderTarget =
-        pSceneCaptureComponent->TextureTarget;
-    if (!pRenderTarget) {
-      continue;
-    }
-
-    FVector2D renderTargetSize(pRenderTarget->SizeX, pRenderTarget->SizeY);
-    if (renderTargetSize.X < 1.0 || renderTargetSize.Y < 1.0) {
-      continue;
-    }
-
-    FVector captureLocation = pSceneCaptureComponent->GetComponentLocation();
-    FRotator captureRotation = pSceneCaptureComponent->GetComponentRotation();
-    double captureFov = pSceneCaptureComponent->FOVAngle;
-
-    cameras.emplace_back(
-        renderTargetSize,
-        captureLocation,
-        captureRotation,
-        captureFov);
   }
 
   return cameras;
@@ -1691,133 +1978,11 @@ ACesium3DTileset::CreateViewStateFromViewParameters(
     const FCesiumCamera& camera,
     const glm::dmat4& unrealWorldToTileset,
     UCesiumEllipsoid* ellipsoid) {
-  double horizontalFieldOfView =
-      FMath::DegreesToRadians(camera.FieldOfViewDegrees);
-
-  double actualAspectRatio;
-  glm::dvec2 size(camera.ViewportSize.X, camera.ViewportSize.Y);
-
-  if (camera.OverrideAspectRatio != 0.0f) {
-    // Use aspect ratio and recompute effective viewport size after black bars
-    // are added.
-    actualAspectRatio = camera.OverrideAspectRatio;
-    double computedX = actualAspectRatio * camera.ViewportSize.Y;
-    double computedY = camera.ViewportSize.Y / actualAspectRatio;
-
-    double barWidth = camera.ViewportSize.X - computedX;
-    double barHeight = camera.ViewportSize.Y - computedY;
-
-    if (barWidth > 0.0 && barWidth > barHeight) {
-      // Black bars on the sides
-      size.x = computedX;
-    } else if (barHeight > 0.0 && barHeight > barWidth) {
-      // Black bars on the top and bottom
-      size.y = computedY;
-    }
-  } else {
-    actualAspectRatio = camera.ViewportSize.X / camera.ViewportSize.Y;
-  }
-
-  double verticalFieldOfView =
-      atan(tan(horizontalFieldOfView * 0.5) / actualAspectRatio) * 2.0;
-
-  FVector direction = camera.Rotation.RotateVector(FVector(1.0f, 0.0f, 0.0f));
-  FVector up = camera.Rotation.RotateVector(FVector(0.0f, 0.0f, 1.0f));
-
-  glm::dvec3 tilesetCameraLocation = glm::dvec3(
-      unrealWorldToTileset *
-      glm::dvec4(camera.Location.X, camera.Location.Y, camera.Location.Z, 1.0));
-  glm::dvec3 tilesetCameraFront = glm::normalize(glm::dvec3(
-      unrealWorldToTileset *
-      glm::dvec4(direction.X, direction.Y, direction.Z, 0.0)));
-  glm::dvec3 tilesetCameraUp = glm::normalize(
-      glm::dvec3(unrealWorldToTileset * glm::dvec4(up.X, up.Y, up.Z, 0.0)));
-
-  return Cesium3DTilesSelection::ViewState::create(
-      tilesetCameraLocation,
-      tilesetCameraFront,
-      tilesetCameraUp,
-      size,
-      horizontalFieldOfView,
-      verticalFieldOfView,
+  return CesiumCollectedView::fromCamera(camera).createViewState(
+      unrealWorldToTileset,
       ellipsoid->GetNativeEllipsoid());
 }
 
-#if WITH_EDITOR
-std::vector<FCesiumCamera> ACesium3DTileset::GetEditorCameras() const {
-  if (!GEditor) {
-    return {};
-  }
-
-  UWorld* pWorld = this->GetWorld();
-  if (!IsValid(pWorld)) {
-    return {};
-  }
-
-  // Do not include editor cameras when running in a game world (which includes
-  // Play-in-Editor)
-  if (pWorld->IsGameWorld()) {
-    return {};
-  }
-
-  const TArray<FEditorViewportClient*>& viewportClients =
-      GEditor->GetAllViewportClients();
-
-  std::vector<FCesiumCamera> cameras;
-  cameras.reserve(viewportClients.Num());
-
-  for (FEditorViewportClient* pEditorViewportClient : viewportClients) {
-    if (!pEditorViewportClient) {
-      continue;
-    }
-
-    if (!pEditorViewportClient->IsVisible() ||
-        !pEditorViewportClient->IsRealtime() ||
-        !pEditorViewportClient->IsPerspective()) {
-      continue;
-    }
-
-    FRotator rotation;
-    if (pEditorViewportClient->bUsingOrbitCamera) {
-      rotation = (pEditorViewportClient->GetLookAtLocation() -
-                  pEditorViewportClient->GetViewLocation())
-                     .Rotation();
-    } else {
-      rotation = pEditorViewportClient->GetViewRotation();
-    }
-
-    const FVector& location = pEditorViewportClient->GetViewLocation();
-    double fov = pEditorViewportClient->ViewFOV;
-    FIntPoint offset;
-    FIntPoint size;
-    pEditorViewportClient->GetViewportDimensions(offset, size);
-
-    if (size.X < 1 || size.Y < 1) {
-      continue;
-    }
-
-    if (this->_scaleUsingDPI) {
-      float dpiScalingFactor = pEditorViewportClient->GetDPIScale();
-      size.X = static_cast<float>(size.X) / dpiScalingFactor;
-      size.Y = static_cast<float>(size.Y) / dpiScalingFactor;
-    }
-
-    if (pEditorViewportClient->IsAspectRatioConstrained()) {
-      cameras.emplace_back(
-          size,
-          location,
-          rotation,
-          fov,
-          pEditorViewportClient->AspectRatio);
-    } else {
-      cameras.emplace_back(size, location, rotation, fov);
-    }
-  }
-
-  return cameras;
-}
-#endif
-
 bool ACesium3DTileset::ShouldTickIfViewportsOnly() const {
   return this->UpdateInEditor;
 }
@@ -1971,8 +2136,302 @@ void ACesium3DTileset::updateTilesetOptionsFromProperties() {
   options.enableLodTransitionPeriod = this->UseLodTransitions;
   options.lodTransitionLength = this->LodTransitionLength;
   // options.kickDescendantsWhileFadingIn = false;
+
+  if (this->IsCollisionOnly()) {
+    // Collision-only views surround the physics-relevant actors, so culling
+    // that assumes a camera does not apply, and nothing is drawn to fade.
+    options.maximumScreenSpaceError = this->CollisionMaximumScreenSpaceError;
+    options.enableFogCulling = false;
+    options.enableOcclusionCulling = false;
+    options.enableLodTransitionPeriod = false;
+  }
+
+  if (UCesiumTileBudgetSubsystem::IsWorldTileBudgetEnabled()) {
+    this->applyWorldTileBudget(options);
+  } else if (this->_overlaysScaledByTileBudget) {
+    this->leaveWorldTileBudget();
+  }
+
+  if (this->CountUnrealMemoryInCache) {
+    this->applyUnrealMemoryToCache(options);
+  }
+
+  if (this->EnableAdaptiveScreenSpaceError) {
+    this->applyAdaptiveScreenSpaceError(options);
+  }
+
+  if (this->_warmStartActive) {
+    CesiumWarmStart::applyToOptions(
+        options,
+        this->WarmStartMaximumSimultaneousTileLoads,
+        this->WarmStartLoadingDescendantLimit);
+  }
+}
+
+void ACesium3DTileset::applyWorldTileBudget(
+    Cesium3DTilesSelection::TilesetOptions& options) {
+  UWorld* pWorld = this->GetWorld();
+  UCesiumTileBudgetSubsystem* pBudget =
+      pWorld ? pWorld->GetSubsystem<UCesiumTileBudgetSubsystem>() : nullptr;
+  if (!pBudget) {
+    return;
+  }
+
+  const FCesiumTilesetBudgetUsage* pAllocation =
+      pBudget->getTilesetAllocation(this, GFrameCounter);
+  if (!pAllocation) {
+    // This tileset has not reported its usage yet, so keep its own settings
+    // for the first frame.
+    return;
+  }
+
+  options.maximumCachedBytes = pAllocation->AllocatedBytes;
+  options.maximumSimultaneousTileLoads =
+      static_cast<uint32_t>(pAllocation->AllocatedTileLoads);
+
+  // An even split of the budget scales the overlays by 1.0, so the total
+  // across the world stays the same as without the budget.
+  const double overlayScale =
+      double(pAllocation->Share) * double(pBudget->getTilesetCount());
+  TInlineComponentArray<UCesiumRasterOverlay*> rasterOverlays(this);
+  for (UCesiumRasterOverlay* pOverlay : rasterOverlays) {
+    pOverlay->ApplyTileBudgetScale(overlayScale);
+  }
+  this->_overlaysScaledByTileBudget = true;
 }
 
+void ACesium3DTileset::leaveWorldTileBudget() {
+  TInlineComponentArray<UCesiumRasterOverlay*> rasterOverlays(this);
+  for (UCesiumRasterOverlay* pOverlay : rasterOverlays) {
+    pOverlay->ApplyTileBudgetScale(1.0);
+  }
+  this->_overlaysScaledByTileBudget = false;
+
+  UWorld* pWorld = this->GetWorld();
+  UCesiumTileBudgetSubsystem* pBudget =
+      pWorld ? pWorld->GetSubsystem<UCesiumTileBudgetSubsystem>() : nullptr;
+  if (pBudget) {
+    pBudget->removeTileset(this);
+  }
+}
+
+namespace {
+// Walking the loaded tiles is too slow to do every frame, and the memory they
+// use only changes as tiles are loaded, unloaded, shown, and hidden.
+constexpr uint64 UnrealMemoryUpdateFrames = 15;
+
+/**
+ * Adds the loaded tiles of a tileset whose glTF passes the given filter to
+ * a memory report.
+ */
+template <typename Filter>
+void addLoadedTilesToReport(
+    Cesium3DTilesSelection::Tileset& tileset,
+    FCesiumTilesetMemoryReport& report,
+    Filter&& filter) {
+  CesiumTilesetMemoryAccumulator accumulator(report);
+  tileset.forEachLoadedTile([&report, &accumulator, &filter](
+                                Cesium3DTilesSelection::Tile& tile) {
+    if (tile.getState() != Cesium3DTilesSelection::TileLoadState::Done) {
+      return;
+    }
+    const Cesium3DTilesSelection::TileRenderContent* pRenderContent =
+        tile.getContent().getRenderContent();
+    if (!pRenderContent) {
+      return;
+    }
+    UCesiumGltfComponent* pGltf = static_cast<UCesiumGltfComponent*>(
+        pRenderContent->getRenderResources());
+    if (pGltf && filter(*pGltf)) {
+      ++report.TileCount;
+      accumulator.addGltf(*pGltf);
+    }
+  });
+  accumulator.finish();
+}
+} // namespace
+
+void ACesium3DTileset::applyUnrealMemoryToCache(
+    Cesium3DTilesSelection::TilesetOptions& options) {
+  if (GFrameCounter - this->_unrealMemoryFrame >= UnrealMemoryUpdateFrames &&
+      this->_pTileset) {
+    TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::MeasureEvictableUnrealMemory)
+
+    // Only tiles that are not rendered can be unloaded to make room, so the
+    // Unreal memory of rendered tiles is left out. Otherwise, once the
+    // rendered tiles alone exceeded the cache size, every other tile would be
+    // unloaded as soon as it was hidden, and loaded again when it was needed.
+    FCesiumTilesetMemoryReport report;
+    addLoadedTilesToReport(
+        *this->_pTileset,
+        report,
+        [](const UCesiumGltfComponent& gltf) { return !gltf.IsVisible(); });
+    this->_unrealMemoryBytes = report.GetUnrealBytes();
+    this->_unrealMemoryFrame = GFrameCounter;
+  }
+
+  options.maximumCachedBytes = std::max<int64_t>(
+      0,
+      options.maximumCachedBytes - this->_unrealMemoryBytes);
+}
+
+void ACesium3DTileset::applyAdaptiveScreenSpaceError(
+    Cesium3DTilesSelection::TilesetOptions& options) {
+  if (!this->_pScreenSpaceErrorGovernor) {
+    return;
+  }
+
+  FCesiumAdaptiveScreenSpaceErrorState& state =
+      this->_pScreenSpaceErrorGovernor->getState();
+
+  options.maximumScreenSpaceError *= state.ScreenSpaceErrorScale;
+  options.maximumSimultaneousTileLoads = static_cast<uint32_t>(FMath::Max(
+      1,
+      FMath::RoundToInt32(
+          double(options.maximumSimultaneousTileLoads) *
+          state.TileLoadScale)));
+
+  state.EffectiveMaximumScreenSpaceError = options.maximumScreenSpaceError;
+  state.EffectiveMaximumSimultaneousTileLoads =
+      static_cast<int32>(options.maximumSimultaneousTileLoads);
+}
+
+void ACesium3DTileset::updateAdaptiveScreenSpaceError(
+    const Cesium3DTilesSelection::ViewUpdateResult& result,
+    float deltaTime) {
+  if (!this->_pScreenSpaceErrorGovernor) {
+    return;
+  }
+
+  if (!this->EnableAdaptiveScreenSpaceError || this->_captureMovieMode) {
+    this->_pScreenSpaceErrorGovernor->reset();
+    return;
+  }
+
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::UpdateAdaptiveScreenSpaceError)
+
+  // The slowest of the game, render, and GPU threads bounds the frame rate.
+  double frameTime = FPlatformTime::ToMilliseconds(FMath::Max3(
+      GGameThreadTime,
+      GRenderThreadTime,
+      RHIGetGPUFrameCycles()));
+  if (frameTime <= 0.0) {
+    frameTime = double(deltaTime) * 1000.0;
+  }
+
+  CesiumScreenSpaceErrorGovernorTargets targets;
+  targets.frameTimeMilliseconds = this->TargetFrameTime;
+  targets.memoryBytes = this->AdaptiveMemoryCeiling == 0
+                            ? this->_pTileset->getOptions().maximumCachedBytes
+                            : this->AdaptiveMemoryCeiling;
+  targets.tileCount = this->AdaptiveMaximumTilesRendered;
+  targets.maximumScale = this->MaximumScreenSpaceError > 0.0
+                             ? this->AdaptiveMaximumScreenSpaceError /
+                                   this->MaximumScreenSpaceError
+                             : 1.0;
+  targets.hysteresis = this->AdaptiveHysteresis;
+  targets.adjustTileLoads = this->AdaptMaximumSimultaneousTileLoads;
+
+  const double previousScale =
+      this->_pScreenSpaceErrorGovernor->getScreenSpaceErrorScale();
+  this->_pScreenSpaceErrorGovernor->update(
+      targets,
+      frameTime,
+      this->_pTileset->getTotalDataBytes(),
+      int64(result.tilesToRenderThisFrame.size()),
+      double(deltaTime));
+
+  const FCesiumAdaptiveScreenSpaceErrorState& state =
+      this->_pScreenSpaceErrorGovernor->getState();
+  CesiumStats::recordAdaptiveScreenSpaceError(state);
+  if (state.ScreenSpaceErrorScale != previousScale) {
+    UE_LOG(
+        LogCesium,
+        Verbose,
+        TEXT(
+            "%s: adaptive maximum screen-space error %.2f (x%.2f), limited by %s (frame time %.2f, memory %.2f, tiles %.2f)"),
+        *this->GetName(),
+        this->MaximumScreenSpaceError * state.ScreenSpaceErrorScale,
+        state.ScreenSpaceErrorScale,
+        *UEnum::GetDisplayValueAsText(state.LimitingFactor).ToString(),
+        state.FrameTimePressure,
+        state.MemoryPressure,
+        state.TileCountPressure);
+  }
+}
+
+FCesiumAdaptiveScreenSpaceErrorState
+ACesium3DTileset::GetAdaptiveScreenSpaceErrorState() const {
+  return this->_pScreenSpaceErrorGovernor
+             ? this->_pScreenSpaceErrorGovernor->getState()
+             : FCesiumAdaptiveScreenSpaceErrorState();
+}
+
+FCesiumTilesetMemoryReport ACesium3DTileset::GetMemoryReport() const {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::GetMemoryReport)
+
+  FCesiumTilesetMemoryReport report;
+  report.Tileset = const_cast<ACesium3DTileset*>(this);
+  if (!this->_pTileset) {
+    return report;
+  }
+
+  report.ModelBytes = this->_pTileset->getTotalDataBytes();
+  addLoadedTilesToReport(
+      *this->_pTileset,
+      report,
+      [](const UCesiumGltfComponent&) { return true; });
+
+  return report;
+}
+
+namespace {
+void logMemoryReports(UWorld* pWorld) {
+  if (!pWorld) {
+    return;
+  }
+
+  constexpr double BytesPerMiB = 1024.0 * 1024.0;
+  FCesiumTilesetMemoryReport total;
+  int32 tilesetCount = 0;
+  for (TActorIterator<ACesium3DTileset> it(pWorld); it; ++it) {
+    FCesiumTilesetMemoryReport report = it->GetMemoryReport();
+    UE_LOG(
+        LogCesium,
+        Display,
+        TEXT(
+            "%s: %d tiles, %.2f MiB (model %.2f, mesh %.2f, physics %.2f, texture %.2f, metadata %.2f, primitive data %.2f)"),
+        *it->GetName(),
+        report.TileCount,
+        report.TotalBytes / BytesPerMiB,
+        report.ModelBytes / BytesPerMiB,
+        report.MeshBytes / BytesPerMiB,
+        report.PhysicsBytes / BytesPerMiB,
+        report.TextureBytes / BytesPerMiB,
+        report.MetadataBytes / BytesPerMiB,
+        report.PrimitiveDataBytes / BytesPerMiB);
+
+    ++tilesetCount;
+    total.TileCount += report.TileCount;
+    total.TotalBytes += report.TotalBytes;
+  }
+
+  UE_LOG(
+      LogCesium,
+      Display,
+      TEXT("%d tilesets: %d tiles, %.2f MiB"),
+      tilesetCount,
+      total.TileCount,
+      total.TotalBytes / BytesPerMiB);
+}
+
+FAutoConsoleCommandWithWorld CCmdMemReport(
+    TEXT("cesium.memreport"),
+    TEXT(
+        "Logs an estimate of the memory used by the loaded tiles of each tileset, by category."),
+    FConsoleCommandWithWorldDelegate::CreateStatic(&logMemoryReports));
+} // namespace
+
 void ACesium3DTileset::updateLastViewUpdateResultState(
     const Cesium3DTilesSelection::ViewUpdateResult& result) {
   TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::updateLastViewUpdateResultState)
@@ -2007,7 +2466,8 @@ void ACesium3DTileset::updateLastViewUpdateResultState(
     }
   }
 
-  if (!this->LogSelectionStats && !this->LogSharedAssetStats) {
+  if (!this->LogSelectionStats && !this->LogSharedAssetStats &&
+      !this->LogObjectPoolStats) {
     return;
   }
 
@@ -2070,6 +2530,35 @@ void ACesium3DTileset::updateLastViewUpdateResultState(
           imageDepot.getAssetCount(),
           imageDepot.getInactiveAssetCount(),
           imageDepot.getInactiveAssetTotalSizeBytes());
+
+      if (this->ShareIdenticalMeshes) {
+        const CesiumMeshDepot& meshDepot = CesiumMeshDepot::getInstance();
+        UE_LOG(
+            LogCesium,
+            Display,
+            TEXT(
+                "Meshes shared asset depot (all tilesets): %d distinct meshes, %d references, %lld conversions avoided"),
+            meshDepot.getMeshCount(),
+            meshDepot.getReferenceCount(),
+            meshDepot.getHitCount());
+      }
+    }
+
+    if (this->LogObjectPoolStats && this->TileObjectPool) {
+      const CesiumTileObjectPoolStats& stats =
+          this->TileObjectPool->getStats();
+      UE_LOG(
+          LogCesium,
+          Display,
+          TEXT(
+              "Tile object pool: %d components and %d materials pooled (capacity %d), component reuse rate %.1f%%, %lld materials reused, %lld objects discarded, %lld UObject allocations avoided"),
+          this->TileObjectPool->getPooledComponentCount(),
+          this->TileObjectPool->getPooledMaterialCount(),
+          this->TileObjectPool->getComponentCapacity(),
+          stats.getComponentReuseRate() * 100.0,
+          stats.materialsReused,
+          stats.objectsDiscarded,
+          stats.getObjectsNotAllocated());
     }
   }
 }
@@ -2107,6 +2596,18 @@ void ACesium3DTileset::showTilesToRender(
         if (!pGltf->IsVisible()) {
           TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::SetVisibilityTrue)
           pGltf->SetVisibility(true, true);
+
+          if (CesiumTrace::isEnabled()) {
+            const uint64 cycle = FPlatformTime::Cycles64();
+            CesiumTrace::traceTileStage(
+                CesiumTrace::TileStage::Visible,
+                cycle,
+                cycle,
+                Cesium3DTilesSelection::TileIdUtilities::createTileIdString(
+                    pTile->getTileID()),
+                getTileUrl(
+                    pTile->getContent().getRenderContent()->getModel()));
+          }
         }
 
         {
@@ -2129,6 +2630,183 @@ static void updateTileFades(const auto& tiles, bool fadingIn) {
       });
 }
 
+bool ACesium3DTileset::CaptureTileSelectionSnapshot() {
+  if (!this->_pTileset || this->_lastCameras.empty()) {
+    UE_LOG(
+        LogCesium,
+        Warning,
+        TEXT(
+            "Cannot capture a tile selection snapshot for %s because it has not been updated yet."),
+        *this->GetName());
+    return false;
+  }
+
+  FCesiumTileSelectionSnapshot snapshot;
+  snapshot.Cameras.Reserve(this->_lastCameras.size());
+  for (const FCesiumCamera& camera : this->_lastCameras) {
+    snapshot.Cameras.Add(camera);
+  }
+
+  this->_pTileset->forEachLoadedTile([&snapshot](
+                                         Cesium3DTilesSelection::Tile& tile) {
+    if (tile.getState() != Cesium3DTilesSelection::TileLoadState::Done) {
+      return;
+    }
+    const Cesium3DTilesSelection::TileRenderContent* pRenderContent =
+        tile.getContent().getRenderContent();
+    if (!pRenderContent) {
+      return;
+    }
+    UCesiumGltfComponent* pGltf = static_cast<UCesiumGltfComponent*>(
+        pRenderContent->getRenderResources());
+    if (pGltf && pGltf->IsVisible()) {
+      snapshot.TileIDs.Add(UTF8_TO_TCHAR(
+          Cesium3DTilesSelection::TileIdUtilities::createTileIdString(
+              tile.getTileID())
+              .c_str()));
+    }
+  });
+
+  UE_LOG(
+      LogCesium,
+      Log,
+      TEXT("Captured tile selection snapshot for %s with %d tiles"),
+      *this->GetName(),
+      snapshot.TileIDs.Num());
+
+  this->Modify();
+  this->TileSelectionSnapshot = MoveTemp(snapshot);
+  return true;
+}
+
+void ACesium3DTileset::ClearTileSelectionSnapshot() {
+  this->Modify();
+  this->TileSelectionSnapshot = FCesiumTileSelectionSnapshot();
+  this->_warmStartActive = false;
+}
+
+void ACesium3DTileset::beginWarmStart() {
+  this->_warmStartActive =
+      this->EnableWarmStart && !this->TileSelectionSnapshot.IsEmpty();
+  if (!this->_warmStartActive) {
+    return;
+  }
+
+  this->_warmStartTime = std::chrono::high_resolution_clock::now();
+  UE_LOG(
+      LogCesium,
+      Log,
+      TEXT("Warm-starting %s from a snapshot of %d tiles"),
+      *this->GetName(),
+      this->TileSelectionSnapshot.TileIDs.Num());
+}
+
+void ACesium3DTileset::updateWarmStart(
+    const std::vector<Cesium3DTilesSelection::Tile*>& tilesToRender) {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::UpdateWarmStart)
+
+  TSet<FString> renderedTileIDs;
+  renderedTileIDs.Reserve(tilesToRender.size());
+  forEachRenderableTile(
+      tilesToRender,
+      [&renderedTileIDs](Cesium3DTilesSelection::Tile* pTile, auto*) {
+        renderedTileIDs.Add(UTF8_TO_TCHAR(
+            Cesium3DTilesSelection::TileIdUtilities::createTileIdString(
+                pTile->getTileID())
+                .c_str()));
+      });
+
+  int32 renderedCount = 0;
+  for (const FString& tileID : this->TileSelectionSnapshot.TileIDs) {
+    if (renderedTileIDs.Contains(tileID)) {
+      ++renderedCount;
+    }
+  }
+
+  const int32 snapshotCount = this->TileSelectionSnapshot.TileIDs.Num();
+  const float elapsedSeconds =
+      std::chrono::duration<float>(
+          std::chrono::high_resolution_clock::now() - this->_warmStartTime)
+          .count();
+
+  const bool complete = renderedCount >= snapshotCount;
+  if (!complete && elapsedSeconds < this->WarmStartTimeout) {
+    return;
+  }
+
+  this->_warmStartActive = false;
+  UE_LOG(
+      LogCesium,
+      Log,
+      TEXT("Warm start of %s %s after %.2f seconds, %d of %d snapshot tiles rendered"),
+      *this->GetName(),
+      complete ? TEXT("completed") : TEXT("timed out"),
+      elapsedSeconds,
+      renderedCount,
+      snapshotCount);
+}
+
+void ACesium3DTileset::updatePhysicsMeshCooking() {
+  if ((!this->CreatePhysicsMeshes && !this->IsCollisionOnly()) ||
+      !this->_pPhysicsMeshCooker ||
+      this->PhysicsMeshPolicy !=
+          ECesiumPhysicsMeshPolicy::NearPhysicsRelevantActors ||
+      this->_pPhysicsMeshCooker->getPendingCount() == 0) {
+    return;
+  }
+
+  this->_pPhysicsMeshCooker->update(
+      getAsyncSystem(),
+      this->getPhysicsRelevantLocations(),
+      this->PhysicsMeshRadius,
+      this->MaximumSimultaneousPhysicsMeshCooks);
+}
+
+TArray<FVector> ACesium3DTileset::getPhysicsRelevantLocations() const {
+  TArray<FVector> locations;
+
+  UWorld* pWorld = this->GetWorld();
+  if (!pWorld) {
+    return locations;
+  }
+
+  for (auto it = pWorld->GetPlayerControllerIterator(); it; ++it) {
+    const APlayerController* pPlayerController = it->Get();
+    const APawn* pPawn =
+        pPlayerController ? pPlayerController->GetPawn() : nullptr;
+    if (pPawn) {
+      locations.Add(pPawn->GetActorLocation());
+    }
+  }
+
+  for (const TSoftObjectPtr<AActor>& pActorReference :
+       this->PhysicsRelevantActors) {
+    const AActor* pActor = pActorReference.Get();
+    if (IsValid(pActor)) {
+      locations.Add(pActor->GetActorLocation());
+    }
+  }
+
+  return locations;
+}
+
+void ACesium3DTileset::appendCollisionViewStates(
+    const glm::dmat4& unrealWorldToCesiumTileset,
+    UCesiumEllipsoid* pEllipsoid,
+    std::vector<Cesium3DTilesSelection::ViewState>& frustums) const {
+  std::vector<FCesiumCamera> cameras;
+  for (const FVector& location : this->getPhysicsRelevantLocations()) {
+    UCesiumViewSubsystem::appendCubeFaceCameras(location, cameras);
+  }
+
+  for (const FCesiumCamera& camera : cameras) {
+    frustums.push_back(CreateViewStateFromViewParameters(
+        camera,
+        unrealWorldToCesiumTileset,
+        pEllipsoid));
+  }
+}
+
 // Called every frame
 void ACesium3DTileset::Tick(float DeltaTime) {
   TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::TilesetTick)
@@ -2148,6 +2826,8 @@ void ACesium3DTileset::Tick(float DeltaTime) {
     return;
   }
 
+  this->updatePolygonClippers();
+
   if (!this->_pTileset) {
     LoadTileset();
 
@@ -2177,8 +2857,6 @@ void ACesium3DTileset::Tick(float DeltaTime) {
 
   updateTilesetOptionsFromProperties();
 
-  std::vector<FCesiumCamera> cameras = this->GetCameras();
-
   glm::dmat4 ueTilesetToUeWorld =
       VecMath::createMatrix4D(this->GetActorTransform().ToMatrixWithScale());
 
@@ -2196,16 +2874,89 @@ void ACesium3DTileset::Tick(float DeltaTime) {
 
   UCesiumEllipsoid* ellipsoid = this->ResolveGeoreference()->GetEllipsoid();
 
+  std::vector<FCesiumCamera> cameras;
   std::vector<Cesium3DTilesSelection::ViewState> frustums;
-  for (const FCesiumCamera& camera : cameras) {
-    frustums.push_back(CreateViewStateFromViewParameters(
-        camera,
+
+  const bool collisionOnly = this->IsCollisionOnly();
+  if (collisionOnly) {
+    this->appendCollisionViewStates(
         unrealWorldToCesiumTileset,
-        ellipsoid));
+        ellipsoid,
+        frustums);
+  }
+
+  // The views are collected once per frame for all tilesets in the world, so
+  // only this tileset's transform needs to be applied here.
+  UCesiumViewSubsystem* pViewSubsystem =
+      collisionOnly ? nullptr
+                    : this->GetWorld()->GetSubsystem<UCesiumViewSubsystem>();
+  if (pViewSubsystem) {
+    const std::vector<CesiumCollectedView>& views =
+        pViewSubsystem->GetViews(this->_scaleUsingDPI, GFrameCounter);
+    cameras.reserve(views.size());
+    frustums.reserve(views.size());
+    for (const CesiumCollectedView& view : views) {
+      cameras.push_back(view.camera);
+      frustums.push_back(view.createViewState(
+          unrealWorldToCesiumTileset,
+          ellipsoid->GetNativeEllipsoid()));
+    }
+  }
+
+  ACesiumCameraManager* pCameraManager =
+      collisionOnly ? nullptr : this->ResolvedCameraManager;
+  if (pCameraManager) {
+    for (const auto& cameraIt : pCameraManager->GetCameras()) {
+      cameras.push_back(cameraIt.Value);
+      frustums.push_back(CreateViewStateFromViewParameters(
+          cameraIt.Value,
+          unrealWorldToCesiumTileset,
+          ellipsoid));
+    }
   }
 
+  if (!this->_cameraPath.IsEmpty()) {
+    if (this->AdvanceCameraPathAutomatically) {
+      this->_cameraPathTime += DeltaTime;
+    }
+  }
+
+  // The offline update blocks until every one of its views is fully loaded,
+  // so when capturing a movie, the upcoming poses are preloaded by a separate
+  // update that does not wait for them.
+  std::vector<Cesium3DTilesSelection::ViewState> preloadFrustums;
+  if (!this->_cameraPath.IsEmpty()) {
+    TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::CameraPathPrefetch)
+    std::vector<Cesium3DTilesSelection::ViewState>& prefetchFrustums =
+        this->_captureMovieMode ? preloadFrustums : frustums;
+    for (const FCesiumCamera& camera : this->GetCameraPathPrefetchCameras()) {
+      prefetchFrustums.push_back(CreateViewStateFromViewParameters(
+          camera,
+          unrealWorldToCesiumTileset,
+          ellipsoid));
+    }
+  }
+
+  if (this->_warmStartActive) {
+    for (const FCesiumCamera& camera : this->TileSelectionSnapshot.Cameras) {
+      frustums.push_back(CreateViewStateFromViewParameters(
+          camera,
+          unrealWorldToCesiumTileset,
+          ellipsoid));
+    }
+  }
+
+  this->_lastCameras = std::move(cameras);
+
   const Cesium3DTilesSelection::ViewUpdateResult* pResult;
   if (this->_captureMovieMode) {
+    if (!preloadFrustums.empty()) {
+      // Only starts loading the tiles of the upcoming poses. Its selection is
+      // replaced by that of the offline update below, so nothing is shown.
+      TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::CameraPathPreload)
+      this->_pTileset->updateView(preloadFrustums, 0.0f);
+    }
+
     TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::updateViewOffline)
     pResult = &this->_pTileset->updateViewOffline(frustums);
   } else {
@@ -2213,6 +2964,43 @@ void ACesium3DTileset::Tick(float DeltaTime) {
     pResult = &this->_pTileset->updateView(frustums, DeltaTime);
   }
   updateLastViewUpdateResultState(*pResult);
+  updateAdaptiveScreenSpaceError(*pResult, DeltaTime);
+  this->_lastTileLoadQueueLength = int32(
+      pResult->workerThreadTileLoadQueueLength +
+      pResult->mainThreadTileLoadQueueLength);
+
+  INC_DWORD_STAT_BY(
+      STAT_CesiumTilesLoading,
+      pResult->workerThreadTileLoadQueueLength +
+          pResult->mainThreadTileLoadQueueLength);
+  INC_DWORD_STAT_BY(
+      STAT_CesiumTilesLoaded,
+      this->_pTileset->getNumberOfTilesLoaded());
+  INC_DWORD_STAT_BY(
+      STAT_CesiumTilesRendered,
+      pResult->tilesToRenderThisFrame.size());
+  INC_DWORD_STAT_BY(STAT_CesiumTilesCulled, pResult->tilesCulled);
+  INC_DWORD_STAT_BY(STAT_CesiumTilesOccluded, pResult->tilesOccluded);
+  INC_DWORD_STAT_BY(
+      STAT_CesiumWorkerThreadLoadQueue,
+      pResult->workerThreadTileLoadQueueLength);
+  INC_DWORD_STAT_BY(
+      STAT_CesiumMainThreadLoadQueue,
+      pResult->mainThreadTileLoadQueueLength);
+
+  if (UCesiumTileBudgetSubsystem::IsWorldTileBudgetEnabled()) {
+    UCesiumTileBudgetSubsystem* pBudget =
+        this->GetWorld()->GetSubsystem<UCesiumTileBudgetSubsystem>();
+    if (pBudget) {
+      pBudget->reportTilesetUsage(
+          this,
+          this->_pTileset->getTotalDataBytes(),
+          static_cast<int32>(
+              pResult->workerThreadTileLoadQueueLength +
+              pResult->mainThreadTileLoadQueueLength),
+          GFrameCounter);
+    }
+  }
 
   removeCollisionForTiles(pResult->tilesFadingOut);
 
@@ -2234,12 +3022,31 @@ void ACesium3DTileset::Tick(float DeltaTime) {
 
   showTilesToRender(pResult->tilesToRenderThisFrame);
 
+  if (this->AggregateInstances && this->_pInstanceAggregator) {
+    this->_pInstanceAggregator->update();
+  }
+
+  const UCesiumRuntimeSettings* pSettings =
+      GetDefault<UCesiumRuntimeSettings>();
+  if (pSettings->EnableTextureMipStreaming) {
+    CesiumTextureMipStreamer::update(
+        pResult->tilesToRenderThisFrame,
+        this->_lastCameras,
+        pSettings->MaximumTextureMipUpdatesPerFrame);
+  }
+
   if (this->UseLodTransitions) {
     TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::UpdateTileFades)
     updateTileFades(pResult->tilesToRenderThisFrame, true);
     updateTileFades(pResult->tilesFadingOut, false);
   }
 
+  if (this->_warmStartActive) {
+    this->updateWarmStart(pResult->tilesToRenderThisFrame);
+  }
+
+  this->updatePhysicsMeshCooking();
+
   this->UpdateLoadStatus();
 }
 
@@ -2310,12 +3117,30 @@ void ACesium3DTileset::PostEditChangeProperty(
       PropName == GET_MEMBER_NAME_CHECKED(ACesium3DTileset, IonAccessToken) ||
       PropName ==
           GET_MEMBER_NAME_CHECKED(ACesium3DTileset, CreatePhysicsMeshes) ||
+      PropName ==
+          GET_MEMBER_NAME_CHECKED(ACesium3DTileset, PhysicsMeshPolicy) ||
+      PropName == GET_MEMBER_NAME_CHECKED(
+                      ACesium3DTileset,
+                      PhysicsMeshSimplificationResolution) ||
+      PropName ==
+          GET_MEMBER_NAME_CHECKED(ACesium3DTileset, CollisionOnlyMode) ||
+      PropName == GET_MEMBER_NAME_CHECKED(
+                      ACesium3DTileset,
+                      LoadMetadataWhenCollisionOnly) ||
       PropName ==
           GET_MEMBER_NAME_CHECKED(ACesium3DTileset, CreateNavCollision) ||
       PropName ==
           GET_MEMBER_NAME_CHECKED(ACesium3DTileset, AlwaysIncludeTangents) ||
       PropName ==
           GET_MEMBER_NAME_CHECKED(ACesium3DTileset, GenerateSmoothNormals) ||
+      PropName == GET_MEMBER_NAME_CHECKED(ACesium3DTileset, OptimizeMeshes) ||
+      PropName ==
+          GET_MEMBER_NAME_CHECKED(ACesium3DTileset, UseHalfPrecisionUVs) ||
+      PropName == GET_MEMBER_NAME_CHECKED(ACesium3DTileset, MergePrimitives) ||
+      PropName ==
+          GET_MEMBER_NAME_CHECKED(ACesium3DTileset, AggregateInstances) ||
+      PropName ==
+          GET_MEMBER_NAME_CHECKED(ACesium3DTileset, ShareIdenticalMeshes) ||
       PropName == GET_MEMBER_NAME_CHECKED(ACesium3DTileset, EnableWaterMask) ||
       PropName ==
           GET_MEMBER_NAME_CHECKED(ACesium3DTileset, IgnoreKhrMaterialsUnlit) ||
@@ -2344,6 +3169,8 @@ void ACesium3DTileset::PostEditChangeProperty(
   } else if (
       PropName == GET_MEMBER_NAME_CHECKED(ACesium3DTileset, CreditSystem)) {
     this->InvalidateResolvedCreditSystem();
+  } else if (PropName == GET_MEMBER_NAME_CHECKED(ACesium3DTileset, Style)) {
+    this->SetStyle(this->Style);
   } else if (
       PropName ==
       GET_MEMBER_NAME_CHECKED(ACesium3DTileset, MaximumScreenSpaceError)) {
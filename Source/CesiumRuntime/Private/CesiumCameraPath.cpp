@@ -0,0 +1,49 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumCameraPath.h"
+#include "Algo/BinarySearch.h"
+
+namespace CesiumCameraPath {
+
+FCesiumCamera
+interpolate(const TArray<FCesiumCameraPathPoint>& path, double time) {
+  int32 next = Algo::LowerBoundBy(path, time, &FCesiumCameraPathPoint::Time);
+  if (next <= 0) {
+    return path[0].Camera;
+  }
+  if (next >= path.Num()) {
+    return path.Last().Camera;
+  }
+
+  const FCesiumCameraPathPoint& a = path[next - 1];
+  const FCesiumCameraPathPoint& b = path[next];
+  double span = b.Time - a.Time;
+  double alpha = span > 0.0 ? (time - a.Time) / span : 1.0;
+
+  FCesiumCamera result = alpha < 0.5 ? a.Camera : b.Camera;
+  result.Location = FMath::Lerp(a.Camera.Location, b.Camera.Location, alpha);
+  result.Rotation = FQuat::Slerp(
+                        a.Camera.Rotation.Quaternion(),
+                        b.Camera.Rotation.Quaternion(),
+                        alpha)
+                        .Rotator();
+  result.FieldOfViewDegrees = FMath::Lerp(
+      a.Camera.FieldOfViewDegrees,
+      b.Camera.FieldOfViewDegrees,
+      alpha);
+  return result;
+}
+
+bool canPrefetch(
+    int64 totalBytes,
+    int64 maximumCachedBytes,
+    int64 prefetchBytes,
+    int32 pendingLoads,
+    int32 maximumPendingLoads) {
+  if (pendingLoads > maximumPendingLoads) {
+    return false;
+  }
+  return totalBytes < maximumCachedBytes + FMath::Max<int64>(0, prefetchBytes);
+}
+
+} // namespace CesiumCameraPath
@@ -0,0 +1,44 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CesiumCameraPathPoint.h"
+#include "CoreMinimal.h"
+
+namespace CesiumCameraPath {
+
+/**
+ * Computes the camera pose at the given time along a path that is sorted by
+ * time, interpolating between the two nearest points. Times before the start
+ * or after the end of the path give the first or last pose.
+ *
+ * @param path The points of the path. This must not be empty.
+ * @param time The time, in seconds.
+ */
+FCesiumCamera
+interpolate(const TArray<FCesiumCameraPathPoint>& path, double time);
+
+/**
+ * Determines if a tileset has room to load tiles for upcoming camera poses.
+ *
+ * Prefetching may hold up to `prefetchBytes` of tiles beyond the cache size,
+ * so it keeps working when the cache is full, which is its usual state. It
+ * pauses while more than `maximumPendingLoads` tiles are waiting to load, so
+ * that the tiles of the current views are not delayed behind upcoming ones.
+ *
+ * @param totalBytes The size of the tile data that the tileset holds.
+ * @param maximumCachedBytes The tileset's cache size.
+ * @param prefetchBytes The size of tile data that prefetching may add beyond
+ * the cache size.
+ * @param pendingLoads The number of tiles waiting to load.
+ * @param maximumPendingLoads The number of waiting tiles above which
+ * prefetching pauses.
+ */
+bool canPrefetch(
+    int64 totalBytes,
+    int64 maximumCachedBytes,
+    int64 prefetchBytes,
+    int32 pendingLoads,
+    int32 maximumPendingLoads);
+
+} // namespace CesiumCameraPath
@@ -12,7 +12,9 @@
 #include "CesiumPropertyTable.h"
 #include "CesiumPropertyTexture.h"
 #include "CesiumRuntime.h"
+#include "CesiumTextureResource.h"
 #include "Containers/Map.h"
+#include "ExtensionImageAssetUnreal.h"
 #include "Materials/MaterialInstanceDynamic.h"
 #include "PixelFormat.h"
 #include "TextureResource.h"
@@ -20,6 +22,8 @@
 
 #include <CesiumGltf/FeatureIdTextureView.h>
 #include <CesiumUtility/Tracing.h>
+#include <algorithm>
+#include <cstring>
 #include <optional>
 #include <unordered_map>
 
@@ -70,6 +74,43 @@ FString getNameForFeatureIDSet(
 
 namespace {
 
+/**
+ * @brief Loads a feature ID or property texture from its glTF image.
+ *
+ * The texture wraps the image's metadata resource, so an image that is
+ * referenced by several feature ID sets and property textures, even of
+ * different tiles, is only uploaded once. The image keeps its pixel data,
+ * which the feature ID and property texture views still read on the CPU.
+ *
+ * @returns The loaded texture, or nullptr if it could not be created.
+ */
+TSharedPtr<LoadedTextureResult> loadMetadataTextureAnyThreadPart(
+    const CesiumGltf::ImageAsset& image,
+    TextureAddress addressX,
+    TextureAddress addressY) {
+  // The views only expose the image as const. Creating the resource only adds
+  // an extension to it; the pixel data is left as it is.
+  const ExtensionImageAssetUnrealMetadata& extension =
+      ExtensionImageAssetUnrealMetadata::getOrCreate(
+          CesiumAsync::AsyncSystem(nullptr),
+          const_cast<CesiumGltf::ImageAsset&>(image));
+
+  TUniquePtr<LoadedTextureResult> pTexture = loadTextureAnyThreadPart(
+      extension,
+      addressX,
+      addressY,
+      // TODO: account for texture filter
+      TextureFilter::TF_Nearest,
+      false,
+      TEXTUREGROUP_8BitData,
+      false);
+  if (!pTexture) {
+    return nullptr;
+  }
+
+  return MakeShared<LoadedTextureResult>(std::move(*pTexture));
+}
+
 /**
  * @brief Encodes a feature ID attribute for access in a Unreal Engine Material.
  * The feature IDs are simply sent to the GPU as texture coordinates, so this
@@ -142,20 +183,16 @@ std::optional<EncodedFeatureIdSet> encodeFeatureIdTexture(
       addressY = convertGltfWrapTToUnreal(pSampler->wrapT);
     }
 
-    // Copy the image, so that we can keep a copy of it in the glTF.
-    CesiumUtility::IntrusivePointer<CesiumGltf::ImageAsset> pImageCopy =
-        new CesiumGltf::ImageAsset(*pFeatureIdImage);
     encodedFeatureIdTexture.pTexture =
-        MakeShared<LoadedTextureResult>(std::move(*loadTextureAnyThreadPart(
-            *pImageCopy,
-            addressX,
-            addressY,
-            TextureFilter::TF_Nearest,
-            false,
-            TEXTUREGROUP_8BitData,
-            false,
-            // TODO: currently this is always the case, but doesn't have to be
-            EPixelFormat::PF_R8G8B8A8_UINT)));
+        loadMetadataTextureAnyThreadPart(*pFeatureIdImage, addressX, addressY);
+    if (!encodedFeatureIdTexture.pTexture) {
+      UE_LOG(
+          LogCesium,
+          Warning,
+          TEXT("Unable to create a texture for feature ID texture, skipped."));
+      return std::nullopt;
+    }
+
     featureIdTextureMap.Emplace(
         pFeatureIdImage,
         encodedFeatureIdTexture.pTexture);
@@ -307,6 +344,50 @@ FString getMaterialNameForPropertyTableProperty(
       MaterialPropertyTablePrefix + propertyTableName + "_" + propertyName);
 }
 
+FString getMaterialNameForPackedPropertyTable(
+    const FString& propertyTableName,
+    int32 packIndex) {
+  // Example: "PTABLE_houses_PACKED0"
+  return createHlslSafeName(
+      MaterialPropertyTablePrefix + propertyTableName +
+      MaterialPackedPropertiesSuffix + FString::FromInt(packIndex));
+}
+
+TArray<EPixelFormat> getPackedPropertyTableFormats(
+    const FCesiumPropertyTableDescription& propertyTableDescription) {
+  TArray<EPixelFormat> formats;
+  for (const FCesiumPropertyTablePropertyDescription& property :
+       propertyTableDescription.Properties) {
+    const FCesiumMetadataEncodingDetails& encodingDetails =
+        property.EncodingDetails;
+    if (encodingDetails.Conversion == ECesiumEncodedMetadataConversion::None ||
+        !encodingDetails.HasValidType()) {
+      continue;
+    }
+
+    EPixelFormat format =
+        getPixelFormat(encodingDetails.Type, encodingDetails.ComponentType)
+            .format;
+    if (format != EPixelFormat::PF_Unknown) {
+      formats.AddUnique(format);
+    }
+  }
+  return formats;
+}
+
+FString getMaterialNameForPropertyTableStyle(const FString& propertyTableName) {
+  // Example: "STYLE_houses"
+  return createHlslSafeName(
+      MaterialPropertyTableStylePrefix + propertyTableName);
+}
+
+FString
+getMaterialNameForPropertyTableStyleProgram(const FString& propertyTableName) {
+  // Example: "STYLEPROGRAM_houses"
+  return createHlslSafeName(
+      MaterialPropertyTableStyleProgramPrefix + propertyTableName);
+}
+
 FString getMaterialNameForPropertyTextureProperty(
     const FString& propertyTextureName,
     const FString& propertyName) {
@@ -417,6 +498,92 @@ bool isValidPropertyTexturePropertyDescription(
   return true;
 }
 
+/**
+ * A property table property whose values have been encoded, but not yet
+ * copied into its packed texture.
+ */
+struct PendingPackedProperty {
+  int32 propertyIndex;
+  int32 packIndex;
+  EncodedPixelFormat format;
+  std::vector<std::byte> pixelData;
+};
+
+/**
+ * Copies the encoded values of each property into consecutive rows of the
+ * texture of its pack. All of the properties get the same number of rows, and
+ * the packs share a width that keeps the largest of them roughly square.
+ */
+void packPropertyTableProperties(
+    EncodedPropertyTable& encodedPropertyTable,
+    const TArray<EPixelFormat>& packFormats,
+    const std::vector<PendingPackedProperty>& pendingProperties,
+    int64 featureCount) {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::PackPropertyTable)
+
+  std::vector<int64> packSizes(packFormats.Num(), 0);
+  for (const PendingPackedProperty& pending : pendingProperties) {
+    ++packSizes[pending.packIndex];
+  }
+
+  const int64 largestPackSize =
+      *std::max_element(packSizes.begin(), packSizes.end());
+  const int64 width = glm::clamp(
+      int64(glm::ceil(glm::sqrt(double(featureCount * largestPackSize)))),
+      int64(1),
+      featureCount);
+  const int64 rowsPerProperty = (featureCount + width - 1) / width;
+
+  std::vector<CesiumUtility::IntrusivePointer<CesiumGltf::ImageAsset>> images(
+      packFormats.Num());
+  std::vector<int64> nextRows(packFormats.Num(), 0);
+
+  for (const PendingPackedProperty& pending : pendingProperties) {
+    CesiumUtility::IntrusivePointer<CesiumGltf::ImageAsset>& pImage =
+        images[pending.packIndex];
+    const int64 pixelSize =
+        pending.format.bytesPerChannel * pending.format.channels;
+    if (pImage == nullptr) {
+      pImage = new CesiumGltf::ImageAsset();
+      pImage->width = int32_t(width);
+      pImage->height = int32_t(rowsPerProperty * packSizes[pending.packIndex]);
+      pImage->bytesPerChannel = pending.format.bytesPerChannel;
+      pImage->channels = pending.format.channels;
+      pImage->pixelData.resize(pImage->width * pImage->height * pixelSize);
+    }
+
+    const int64 rowOffset = nextRows[pending.packIndex];
+    nextRows[pending.packIndex] += rowsPerProperty;
+    std::memcpy(
+        pImage->pixelData.data() + rowOffset * width * pixelSize,
+        pending.pixelData.data(),
+        pending.pixelData.size());
+
+    EncodedPropertyTableProperty& encodedProperty =
+        encodedPropertyTable.properties[pending.propertyIndex];
+    encodedProperty.packIndex = pending.packIndex;
+    encodedProperty.packedRowOffset = int32(rowOffset);
+  }
+
+  encodedPropertyTable.packedProperties.SetNum(packFormats.Num());
+  for (int32 i = 0; i < packFormats.Num(); ++i) {
+    EncodedPackedPropertyTableProperties& packedProperties =
+        encodedPropertyTable.packedProperties[i];
+    packedProperties.format = packFormats[i];
+    if (images[i] != nullptr) {
+      packedProperties.pTexture = loadTextureAnyThreadPart(
+          *images[i],
+          TextureAddress::TA_Clamp,
+          TextureAddress::TA_Clamp,
+          TextureFilter::TF_Nearest,
+          false,
+          TEXTUREGROUP_8BitData,
+          false,
+          packFormats[i]);
+    }
+  }
+}
+
 } // namespace
 
 EncodedPropertyTable encodePropertyTableAnyThreadPart(
@@ -435,6 +602,13 @@ EncodedPropertyTable encodePropertyTableAnyThreadPart(
       UCesiumPropertyTableBlueprintLibrary::GetProperties(propertyTable);
 
   encodedPropertyTable.properties.Reserve(properties.Num());
+
+  const TArray<EPixelFormat> packFormats =
+      propertyTableDescription.PackProperties
+          ? getPackedPropertyTableFormats(propertyTableDescription)
+          : TArray<EPixelFormat>();
+  std::vector<PendingPackedProperty> pendingPackedProperties;
+
   for (const auto& pair : properties) {
     const FCesiumPropertyTableProperty& property = pair.Value;
 
@@ -503,46 +677,66 @@ EncodedPropertyTable encodePropertyTableAnyThreadPart(
     if (UCesiumPropertyTablePropertyBlueprintLibrary::
             GetPropertyTablePropertyStatus(property) ==
         ECesiumPropertyTablePropertyStatus::Valid) {
-
-      int64 floorSqrtFeatureCount = glm::sqrt(propertyTableCount);
-      int64 textureDimension =
-          (floorSqrtFeatureCount * floorSqrtFeatureCount == propertyTableCount)
-              ? floorSqrtFeatureCount
-              : (floorSqrtFeatureCount + 1);
-
-      CesiumUtility::IntrusivePointer<CesiumGltf::ImageAsset> pImage =
-          new CesiumGltf::ImageAsset();
-      pImage->width = pImage->height = textureDimension;
-      pImage->bytesPerChannel = encodedFormat.bytesPerChannel;
-      pImage->channels = encodedFormat.channels;
-      pImage->pixelData.resize(
-          textureDimension * textureDimension * encodedFormat.bytesPerChannel *
-          encodedFormat.channels);
-
-      if (encodingDetails.Conversion ==
-          ECesiumEncodedMetadataConversion::ParseColorFromString) {
-        CesiumEncodedMetadataParseColorFromString::encode(
-            *pDescription,
-            property,
-            std::span(pImage->pixelData),
-            encodedFormat.bytesPerChannel * encodedFormat.channels);
-      } else /* info.Conversion == ECesiumEncodedMetadataConversion::Coerce */ {
-        CesiumEncodedMetadataCoerce::encode(
-            *pDescription,
-            property,
-            std::span(pImage->pixelData),
-            encodedFormat.bytesPerChannel * encodedFormat.channels);
+      const int64 pixelSize =
+          encodedFormat.bytesPerChannel * encodedFormat.channels;
+      auto encodeValues = [&](std::span<std::byte> pixelData) {
+        if (encodingDetails.Conversion ==
+            ECesiumEncodedMetadataConversion::ParseColorFromString) {
+          CesiumEncodedMetadataParseColorFromString::encode(
+              *pDescription,
+              property,
+              pixelData,
+              pixelSize);
+        } else /* Conversion == ECesiumEncodedMetadataConversion::Coerce */ {
+          CesiumEncodedMetadataCoerce::encode(
+              *pDescription,
+              property,
+              pixelData,
+              pixelSize);
+        }
+      };
+
+      if (propertyTableDescription.PackProperties) {
+        // The values are copied into their pack after all of the properties
+        // are encoded, once the size of each pack is known.
+        const int32 packIndex = packFormats.IndexOfByKey(encodedFormat.format);
+        if (packIndex != INDEX_NONE) {
+          PendingPackedProperty& pending =
+              pendingPackedProperties.emplace_back();
+          pending.propertyIndex = encodedPropertyTable.properties.Num() - 1;
+          pending.packIndex = packIndex;
+          pending.format = encodedFormat;
+          pending.pixelData.resize(propertyTableCount * pixelSize);
+          encodeValues(std::span(pending.pixelData));
+        }
+      } else {
+        int64 floorSqrtFeatureCount = glm::sqrt(propertyTableCount);
+        int64 textureDimension =
+            (floorSqrtFeatureCount * floorSqrtFeatureCount ==
+             propertyTableCount)
+                ? floorSqrtFeatureCount
+                : (floorSqrtFeatureCount + 1);
+
+        CesiumUtility::IntrusivePointer<CesiumGltf::ImageAsset> pImage =
+            new CesiumGltf::ImageAsset();
+        pImage->width = pImage->height = textureDimension;
+        pImage->bytesPerChannel = encodedFormat.bytesPerChannel;
+        pImage->channels = encodedFormat.channels;
+        pImage->pixelData.resize(
+            textureDimension * textureDimension * pixelSize);
+
+        encodeValues(std::span(pImage->pixelData));
+
+        encodedProperty.pTexture = loadTextureAnyThreadPart(
+            *pImage,
+            TextureAddress::TA_Clamp,
+            TextureAddress::TA_Clamp,
+            TextureFilter::TF_Nearest,
+            false,
+            TEXTUREGROUP_8BitData,
+            false,
+            encodedFormat.format);
       }
-
-      encodedProperty.pTexture = loadTextureAnyThreadPart(
-          *pImage,
-          TextureAddress::TA_Clamp,
-          TextureAddress::TA_Clamp,
-          TextureFilter::TF_Nearest,
-          false,
-          TEXTUREGROUP_8BitData,
-          false,
-          encodedFormat.format);
     }
 
     if (pDescription->PropertyDetails.bHasOffset) {
@@ -586,6 +780,14 @@ EncodedPropertyTable encodePropertyTableAnyThreadPart(
     }
   }
 
+  if (!pendingPackedProperties.empty()) {
+    packPropertyTableProperties(
+        encodedPropertyTable,
+        packFormats,
+        pendingPackedProperties,
+        propertyTableCount);
+  }
+
   return encodedPropertyTable;
 }
 
@@ -657,22 +859,8 @@ EncodedPropertyTexture encodePropertyTextureAnyThreadPart(
           addressY = convertGltfWrapTToUnreal(pSampler->wrapT);
         }
 
-        // Copy the image, so that we can keep a copy of it in the glTF.
-        CesiumUtility::IntrusivePointer<CesiumGltf::ImageAsset> pImageCopy =
-            new CesiumGltf::ImageAsset(*pImage);
         encodedProperty.pTexture =
-            MakeShared<LoadedTextureResult>(std::move(*loadTextureAnyThreadPart(
-                *pImageCopy,
-                addressX,
-                addressY,
-                // TODO: account for texture filter
-                TextureFilter::TF_Nearest,
-                false,
-                TEXTUREGROUP_8BitData,
-                false,
-                // This assumes that the texture's image only contains one byte
-                // per channel.
-                EPixelFormat::PF_R8G8B8A8_UINT)));
+            loadMetadataTextureAnyThreadPart(*pImage, addressX, addressY);
         propertyTexturePropertyMap.Emplace(pImage, encodedProperty.pTexture);
       }
     };
@@ -815,6 +1003,14 @@ bool encodePropertyTableGameThreadPart(
     }
   }
 
+  for (EncodedPackedPropertyTableProperties& packedProperties :
+       encodedPropertyTable.packedProperties) {
+    if (packedProperties.pTexture) {
+      success &= loadTextureGameThreadPart(packedProperties.pTexture.Get()) !=
+                 nullptr;
+    }
+  }
+
   return success;
 }
 
@@ -864,6 +1060,13 @@ void destroyEncodedModelMetadata(EncodedModelMetadata& encodedMetadata) {
         encodedProperty.pTexture->pTexture = nullptr;
       }
     }
+
+    for (EncodedPackedPropertyTableProperties& packedProperties :
+         propertyTable.packedProperties) {
+      if (packedProperties.pTexture) {
+        packedProperties.pTexture->pTexture = nullptr;
+      }
+    }
   }
 
   for (auto& encodedPropertyTextureIt : encodedMetadata.propertyTextures) {
@@ -1064,6 +1267,15 @@ void SetPropertyTableParameterValues(
           encodedProperty.pTexture->pTexture->getUnrealTexture());
     }
 
+    if (encodedProperty.packIndex != INDEX_NONE) {
+      pMaterial->SetScalarParameterValueByInfo(
+          FMaterialParameterInfo(
+              FName(fullPropertyName + MaterialPropertyRowOffsetSuffix),
+              association,
+              index),
+          static_cast<float>(encodedProperty.packedRowOffset));
+    }
+
     if (!UCesiumMetadataValueBlueprintLibrary::IsEmpty(
             encodedProperty.offset)) {
       FString parameterName = fullPropertyName + MaterialPropertyOffsetSuffix;
@@ -1118,7 +1330,25 @@ void SetPropertyTableParameterValues(
       FString hasValueName = fullPropertyName + MaterialPropertyHasValueSuffix;
       pMaterial->SetScalarParameterValueByInfo(
           FMaterialParameterInfo(FName(hasValueName), association, index),
-          encodedProperty.pTexture ? 1.0 : 0.0);
+          encodedProperty.pTexture ||
+                  encodedProperty.packIndex != INDEX_NONE
+              ? 1.0
+              : 0.0);
+    }
+  }
+
+  for (int32 i = 0; i < encodedPropertyTable.packedProperties.Num(); ++i) {
+    const EncodedPackedPropertyTableProperties& packedProperties =
+        encodedPropertyTable.packedProperties[i];
+    if (packedProperties.pTexture) {
+      pMaterial->SetTextureParameterValueByInfo(
+          FMaterialParameterInfo(
+              FName(getMaterialNameForPackedPropertyTable(
+                  encodedPropertyTable.name,
+                  i)),
+              association,
+              index),
+          packedProperties.pTexture->pTexture->getUnrealTexture());
     }
   }
 }
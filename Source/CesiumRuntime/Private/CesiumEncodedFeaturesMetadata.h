@@ -68,6 +68,16 @@ static const FString MaterialNullFeatureIdSuffix = "_NULL_ID";
  */
 static const FString MaterialPropertyTablePrefix = "PTABLE_";
 
+/**
+ * - Property Table Style: "STYLE_" + PropertyTableName
+ */
+static const FString MaterialPropertyTableStylePrefix = "STYLE_";
+
+/**
+ * - Property Table Style Program: "STYLEPROGRAM_" + PropertyTableName
+ */
+static const FString MaterialPropertyTableStyleProgramPrefix = "STYLEPROGRAM_";
+
 /**
  * - Property Texture Property: "PTEXTURE_" + PropertyTextureName + PropertyName
  * - Property Texture Property UV Index: "PTEXTURE_" + PropertyTextureName +
@@ -95,6 +105,15 @@ static const FString MaterialPropertyNoDataSuffix = "_NO_DATA";
 static const FString MaterialPropertyDefaultValueSuffix = "_DEFAULT";
 static const FString MaterialPropertyHasValueSuffix = "_HAS_VALUE";
 
+/**
+ * Naming convention for property tables whose properties are packed:
+ * - Packed Properties: "PTABLE_" + PropertyTableName + "_PACKED" + PackIndex
+ * - Property Row Offset: "PTABLE_" + PropertyTableName + PropertyName +
+ * "_ROW_OFFSET"
+ */
+static const FString MaterialPackedPropertiesSuffix = "_PACKED";
+static const FString MaterialPropertyRowOffsetSuffix = "_ROW_OFFSET";
+
 /**
  * Naming convention for material inputs (for use in custom functions):
  * - Property Data: PropertyName + "_DATA"
@@ -301,6 +320,49 @@ FString getMaterialNameForPropertyTableProperty(
     const FString& propertyTableName,
     const FString& propertyName);
 
+/**
+ * @brief Generates an HLSL-safe name for a texture of packed properties of a
+ * property table in a glTF model's EXT_structural_metadata. This is formatted
+ * like so:
+ *
+ * "PTABLE_<table name>_PACKED<pack index>"
+ */
+FString getMaterialNameForPackedPropertyTable(
+    const FString& propertyTableName,
+    int32 packIndex);
+
+/**
+ * @brief Gets the pixel formats of the packed textures of a property table,
+ * in the order of their pack indices. A property is packed into the texture
+ * whose format matches its encoding.
+ */
+TArray<EPixelFormat> getPackedPropertyTableFormats(
+    const FCesiumPropertyTableDescription& propertyTableDescription);
+
+/**
+ * @brief Generates an HLSL-safe name for the style of a property table in a
+ * glTF model's EXT_structural_metadata. This is formatted like so:
+ *
+ * "STYLE_<table name>"
+ *
+ * This is used to name the texture parameter that holds the styled color of
+ * each feature in the property table, indexed by feature ID.
+ */
+FString getMaterialNameForPropertyTableStyle(const FString& propertyTableName);
+
+/**
+ * @brief Generates an HLSL-safe name for the style program of a property table
+ * in a glTF model's EXT_structural_metadata. This is formatted like so:
+ *
+ * "STYLEPROGRAM_<table name>"
+ *
+ * This is used to name the texture parameter that holds the instructions of
+ * the tileset's style, which the material runs for each feature of the
+ * property table.
+ */
+FString
+getMaterialNameForPropertyTableStyleProgram(const FString& propertyTableName);
+
 /**
  * @brief Generates an HLSL-safe name for a property texture property in a glTF
  * model's EXT_structural_metadata. This is formatted like so:
@@ -352,6 +414,35 @@ struct EncodedPropertyTableProperty {
    * @brief The property table property's default value.
    */
   FCesiumMetadataValue defaultValue;
+
+  /**
+   * @brief The index of the packed texture that holds this property's values,
+   * or INDEX_NONE if they are in pTexture instead.
+   */
+  int32 packIndex = INDEX_NONE;
+
+  /**
+   * @brief The first row of the packed texture that holds this property's
+   * values.
+   */
+  int32 packedRowOffset = 0;
+};
+
+/**
+ * The properties of a property table that share a pixel format, packed into
+ * consecutive rows of one texture.
+ */
+struct EncodedPackedPropertyTableProperties {
+  /**
+   * @brief The pixel format of the packed properties.
+   */
+  EPixelFormat format = EPixelFormat::PF_Unknown;
+
+  /**
+   * @brief The packed property values, or nullptr if none of the properties
+   * in this pack could be encoded for this table.
+   */
+  TUniquePtr<CesiumTextureUtility::LoadedTextureResult> pTexture;
 };
 
 /**
@@ -368,6 +459,12 @@ struct EncodedPropertyTable {
    * @brief The encoded properties in this property table.
    */
   TArray<EncodedPropertyTableProperty> properties;
+
+  /**
+   * @brief The packed textures of this property table, by pack index. Only
+   * used if the property table's description packs its properties.
+   */
+  TArray<EncodedPackedPropertyTableProperties> packedProperties;
 };
 
 /**
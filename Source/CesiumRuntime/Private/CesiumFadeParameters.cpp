@@ -0,0 +1,154 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumFadeParameters.h"
+#include "CesiumMaterialUserData.h"
+#include "CesiumRuntime.h"
+#include "Materials/MaterialInterface.h"
+#include "SceneTypes.h"
+
+#if WITH_EDITOR
+#include "ComponentReregisterContext.h"
+#include "HAL/IConsoleManager.h"
+#include "Materials/MaterialExpressionScalarParameter.h"
+#include "Materials/MaterialFunction.h"
+#endif
+
+namespace {
+/**
+ * Returns the custom primitive data slot that a scalar parameter of a material
+ * layer is bound to, or INDEX_NONE if it is an ordinary material parameter.
+ */
+int32 findCustomPrimitiveDataIndex(
+    const UMaterialInterface& material,
+    const FName& parameterName,
+    int32 layerIndex) {
+  FMaterialParameterMetadata metadata;
+  if (!material.GetParameterValue(
+          EMaterialParameterType::Scalar,
+          FMemoryImageMaterialParameterInfo(FMaterialParameterInfo(
+              parameterName,
+              EMaterialParameterAssociation::LayerParameter,
+              layerIndex)),
+          metadata)) {
+    return INDEX_NONE;
+  }
+
+  const int32 index = int32(metadata.PrimitiveDataIndex);
+  if (index < 0 ||
+      index >= FCustomPrimitiveData::NumCustomPrimitiveDataFloats) {
+    return INDEX_NONE;
+  }
+  return index;
+}
+} // namespace
+
+/*static*/ CesiumFadeParameters
+CesiumFadeParameters::resolve(UMaterialInterface* pMaterial) {
+  CesiumFadeParameters result;
+  if (!pMaterial) {
+    return result;
+  }
+
+  const UCesiumMaterialUserData* pCesiumData =
+      pMaterial->GetAssetUserData<UCesiumMaterialUserData>();
+  if (!pCesiumData) {
+    return result;
+  }
+
+  result.LayerIndex = pCesiumData->LayerNames.Find("DitherFade");
+  if (result.LayerIndex < 0) {
+    return result;
+  }
+
+  result.FadePercentageDataIndex = findCustomPrimitiveDataIndex(
+      *pMaterial,
+      "FadePercentage",
+      result.LayerIndex);
+  result.FadingTypeDataIndex =
+      findCustomPrimitiveDataIndex(*pMaterial, "FadingType", result.LayerIndex);
+  return result;
+}
+
+#if WITH_EDITOR
+/*static*/ bool CesiumFadeParameters::bindToCustomPrimitiveData(
+    UMaterialFunctionInterface& layer) {
+  UMaterialFunction* pFunction = Cast<UMaterialFunction>(&layer);
+  if (!pFunction) {
+    return false;
+  }
+
+  TArray<UMaterialExpressionScalarParameter*> parameters;
+  TArray<int32> dataIndices;
+  for (UMaterialExpression* pExpression :
+       pFunction->GetExpressionCollection().Expressions) {
+    UMaterialExpressionScalarParameter* pParameter =
+        Cast<UMaterialExpressionScalarParameter>(pExpression);
+    if (!pParameter) {
+      continue;
+    }
+
+    int32 dataIndex = INDEX_NONE;
+    if (pParameter->ParameterName == "FadePercentage") {
+      dataIndex = DefaultFadePercentageDataIndex;
+    } else if (pParameter->ParameterName == "FadingType") {
+      dataIndex = DefaultFadingTypeDataIndex;
+    }
+
+    if (dataIndex >= 0 && (!pParameter->bUseCustomPrimitiveData ||
+                           pParameter->PrimitiveDataIndex != dataIndex)) {
+      parameters.Add(pParameter);
+      dataIndices.Add(dataIndex);
+    }
+  }
+
+  if (parameters.IsEmpty()) {
+    return false;
+  }
+
+  pFunction->PreEditChange(nullptr);
+  for (int32 i = 0; i < parameters.Num(); ++i) {
+    parameters[i]->Modify();
+    parameters[i]->bUseCustomPrimitiveData = true;
+    parameters[i]->PrimitiveDataIndex = uint8(dataIndices[i]);
+  }
+  pFunction->PostEditChange();
+  pFunction->MarkPackageDirty();
+
+  // Make the components that use this layer pick up the recompiled materials.
+  FGlobalComponentReregisterContext RecreateComponents;
+  return true;
+}
+
+namespace {
+FAutoConsoleCommand CCmdBindDitherFade(
+    TEXT("cesium.bindditherfade"),
+    TEXT(
+        "Binds the fade parameters of the plugin's DitherFade material layer, "
+        "or of the layer at the given object path, to custom primitive data. "
+        "Save the layer afterwards to keep the change."),
+    FConsoleCommandWithArgsDelegate::CreateLambda(
+        [](const TArray<FString>& Args) {
+          const FString path =
+              Args.IsEmpty()
+                  ? FString(TEXT("/CesiumForUnreal/Materials/Layers/"
+                                 "ML_DitherFade.ML_DitherFade"))
+                  : Args[0];
+          UMaterialFunctionInterface* pLayer =
+              LoadObject<UMaterialFunctionInterface>(nullptr, *path);
+          if (!pLayer) {
+            UE_LOG(LogCesium, Warning, TEXT("Could not load %s"), *path);
+            return;
+          }
+
+          const bool changed =
+              CesiumFadeParameters::bindToCustomPrimitiveData(*pLayer);
+          UE_LOG(
+              LogCesium,
+              Display,
+              TEXT("%s %s"),
+              *path,
+              changed ? TEXT("now fades through custom primitive data")
+                      : TEXT("has no unbound fade parameters"));
+        }));
+} // namespace
+#endif
@@ -0,0 +1,75 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UMaterialFunctionInterface;
+class UMaterialInterface;
+
+/**
+ * How the LOD transition fade reaches the DitherFade layer of a base
+ * material: through custom primitive data, or through the parameters of each
+ * primitive's dynamic material instance.
+ *
+ * Writing custom primitive data does not invalidate the cached mesh draw
+ * commands the way a material parameter change does, so it is used for each
+ * parameter that the material binds to it.
+ */
+struct CesiumFadeParameters {
+  /**
+   * The custom primitive data slots that the DitherFade layers shipped with
+   * the plugin bind FadePercentage and FadingType to.
+   */
+  static constexpr int32 DefaultFadePercentageDataIndex = 0;
+  static constexpr int32 DefaultFadingTypeDataIndex = 1;
+
+  /**
+   * The index of the DitherFade layer, or INDEX_NONE if the material does not
+   * fade.
+   */
+  int32 LayerIndex = INDEX_NONE;
+
+  /**
+   * The custom primitive data slot of the layer's FadePercentage parameter,
+   * or INDEX_NONE if it is an ordinary material parameter.
+   */
+  int32 FadePercentageDataIndex = INDEX_NONE;
+
+  /**
+   * The custom primitive data slot of the layer's FadingType parameter, or
+   * INDEX_NONE if it is an ordinary material parameter.
+   */
+  int32 FadingTypeDataIndex = INDEX_NONE;
+
+  /**
+   * Whether the material has a DitherFade layer.
+   */
+  bool fades() const { return this->LayerIndex >= 0; }
+
+  /**
+   * Whether any fade parameter must be written to the dynamic material
+   * instance.
+   */
+  bool usesMaterialParameters() const {
+    return this->fades() &&
+           (this->FadePercentageDataIndex < 0 || this->FadingTypeDataIndex < 0);
+  }
+
+  /**
+   * Finds the DitherFade layer of a base material, and the custom primitive
+   * data slots that its fade parameters are bound to.
+   */
+  static CesiumFadeParameters resolve(UMaterialInterface* pMaterial);
+
+#if WITH_EDITOR
+  /**
+   * Binds the FadePercentage and FadingType parameters of a DitherFade
+   * material layer to the default custom primitive data slots. This is how
+   * the shipped layer is set up; it can be applied again to custom layers.
+   *
+   * @returns Whether the layer was changed.
+   */
+  static bool bindToCustomPrimitiveData(UMaterialFunctionInterface& layer);
+#endif
+};
@@ -8,6 +8,7 @@
 #include "CesiumGltfPrimitiveComponent.h"
 #include "CesiumModelMetadata.h"
 #include "CesiumRuntime.h"
+#include "CesiumStyle.h"
 #include "UnrealMetadataConversions.h"
 
 #if WITH_EDITOR
@@ -24,6 +25,7 @@
 #include "Materials/MaterialExpressionCustom.h"
 #include "Materials/MaterialExpressionFunctionInput.h"
 #include "Materials/MaterialExpressionFunctionOutput.h"
+#include "Materials/MaterialExpressionGetMaterialAttributes.h"
 #include "Materials/MaterialExpressionIf.h"
 #include "Materials/MaterialExpressionMaterialFunctionCall.h"
 #include "Materials/MaterialExpressionScalarParameter.h"
@@ -32,6 +34,7 @@
 #include "Materials/MaterialExpressionTextureObjectParameter.h"
 #include "Materials/MaterialExpressionTextureProperty.h"
 #include "Materials/MaterialExpressionVectorParameter.h"
+#include "MaterialShared.h"
 #include "Misc/PackageName.h"
 #include "Modules/ModuleManager.h"
 #include "Subsystems/AssetEditorSubsystem.h"
@@ -1809,7 +1812,8 @@ void GenerateNodesForPropertyTable(
     UMaterialFunctionMaterialLayer* TargetMaterialLayer,
     int32& NodeX,
     int32& NodeY,
-    UMaterialExpressionMaterialFunctionCall* GetFeatureIdCall) {
+    UMaterialExpressionMaterialFunctionCall* GetFeatureIdCall,
+    TArray<FExpressionInput>& FeatureStyles) {
   int32 BeginSectionX = NodeX;
   // This value is used by parameters on the left side of the
   // "GetPropertyValues" function...
@@ -1855,6 +1859,61 @@ void GenerateNodesForPropertyTable(
       PropertyTable.Properties.Num());
 
   FString PropertyTableName = createHlslSafeName(PropertyTable.Name);
+
+  // The properties that the tileset's style program can read, by slot. Slots
+  // of properties that are not generated below stay zero.
+  const std::vector<CesiumStyle::ProgramProperty> ProgramProperties =
+      CesiumStyle::getProgramProperties(PropertyTable);
+  GetPropertyValuesFunction->IncludeFilePaths.AddUnique(
+      "/Plugin/CesiumForUnreal/Private/CesiumStyle.ush");
+  GetPropertyValuesFunction->Code +=
+      "float _czm_styleProperties[CESIUM_STYLE_MAXIMUM_PROPERTIES];\n"
+      "[unroll] for (uint _czm_slot = 0; "
+      "_czm_slot < CESIUM_STYLE_MAXIMUM_PROPERTIES; ++_czm_slot) {\n"
+      "  _czm_styleProperties[_czm_slot] = 0;\n"
+      "}\n";
+
+  // When the properties are packed, each pack is one texture, and each property
+  // is read from its rows of the texture for its pixel format.
+  const TArray<EPixelFormat> PackFormats =
+      PropertyTable.PackProperties
+          ? getPackedPropertyTableFormats(PropertyTable)
+          : TArray<EPixelFormat>();
+  if (PackFormats.Num() > 0) {
+    GetPropertyValuesFunction->Code +=
+        "uint _czm_featureIndex = round(FeatureID);\n";
+  }
+
+  for (int32 PackIndex = 0; PackIndex < PackFormats.Num(); ++PackIndex) {
+    PropertyDataSectionY += Incr;
+
+    UMaterialExpressionTextureObjectParameter* PackData =
+        NewObject<UMaterialExpressionTextureObjectParameter>(
+            TargetMaterialLayer);
+    PackData->ParameterName = FName(
+        getMaterialNameForPackedPropertyTable(PropertyTableName, PackIndex));
+    PackData->MaterialExpressionEditorX = BeginSectionX;
+    PackData->MaterialExpressionEditorY = PropertyDataSectionY;
+    AutoGeneratedNodes.Add(PackData);
+
+    MaximumPropertyDataSectionX = FMath::Max(
+        MaximumPropertyDataSectionX,
+        Incr * GetNameLengthScalar(PackData->ParameterName));
+
+    // Example: "_czm_pack0"
+    FString PackDataName = "_czm_pack" + FString::FromInt(PackIndex);
+    FCustomInput& PackInput =
+        GetPropertyValuesFunction->Inputs.Emplace_GetRef();
+    PackInput.InputName = FName(PackDataName);
+    PackInput.Input.Expression = PackData;
+
+    GetPropertyValuesFunction->Code += "uint " + PackDataName + "_width;\n" +
+                                       "uint " + PackDataName + "_height;\n" +
+                                       PackDataName + ".GetDimensions(" +
+                                       PackDataName + "_width, " +
+                                       PackDataName + "_height);\n";
+  }
+
   bool foundFirstProperty = false;
   for (const FCesiumPropertyTablePropertyDescription& Property :
        PropertyTable.Properties) {
@@ -1864,13 +1923,56 @@ void GenerateNodesForPropertyTable(
       continue;
     }
 
+    const int32 PackIndex = PackFormats.IndexOfByKey(
+        getPixelFormat(
+            Property.EncodingDetails.Type,
+            Property.EncodingDetails.ComponentType)
+            .format);
+    if (PropertyTable.PackProperties && PackIndex == INDEX_NONE) {
+      continue;
+    }
+
     PropertyDataSectionY += Incr;
 
     FString PropertyName = createHlslSafeName(Property.Name);
     // Example: "roofColor_DATA"
     FString PropertyDataName = PropertyName + MaterialPropertyDataSuffix;
+    FString FullPropertyName = getMaterialNameForPropertyTableProperty(
+        PropertyTableName,
+        PropertyName);
 
-    if (!foundFirstProperty) {
+    // Example: "_czm_pack0.Load(int3(_czm_featureIndex % _czm_pack0_width,
+    // uint(roofColor_ROW_OFFSET) + _czm_featureIndex / _czm_pack0_width, 0))"
+    FString LoadCode;
+    if (PackIndex != INDEX_NONE) {
+      UMaterialExpressionScalarParameter* RowOffset =
+          NewObject<UMaterialExpressionScalarParameter>(TargetMaterialLayer);
+      RowOffset->ParameterName =
+          FName(FullPropertyName + MaterialPropertyRowOffsetSuffix);
+      RowOffset->DefaultValue = 0.0f;
+      RowOffset->MaterialExpressionEditorX = BeginSectionX;
+      RowOffset->MaterialExpressionEditorY = PropertyDataSectionY;
+      AutoGeneratedNodes.Add(RowOffset);
+
+      MaximumPropertyDataSectionX = FMath::Max(
+          MaximumPropertyDataSectionX,
+          Incr * GetNameLengthScalar(RowOffset->ParameterName));
+
+      FString RowOffsetName = PropertyName + MaterialPropertyRowOffsetSuffix;
+      FCustomInput& RowOffsetInput =
+          GetPropertyValuesFunction->Inputs.Emplace_GetRef();
+      RowOffsetInput.InputName = FName(RowOffsetName);
+      RowOffsetInput.Input.Expression = RowOffset;
+
+      FString PackDataName = "_czm_pack" + FString::FromInt(PackIndex);
+      LoadCode = PackDataName + ".Load(int3(_czm_featureIndex % " +
+                 PackDataName + "_width, uint(" + RowOffsetName +
+                 ") + _czm_featureIndex / " + PackDataName + "_width, 0))";
+    } else {
+      LoadCode = PropertyDataName + ".Load(int3(_czm_pixelX, _czm_pixelY, 0))";
+    }
+
+    if (PackIndex == INDEX_NONE && !foundFirstProperty) {
       // Get the dimensions of the first valid property. All the properties
       // will have the same pixel dimensions since it is based on the feature
       // count.
@@ -1888,25 +1990,24 @@ void GenerateNodesForPropertyTable(
       foundFirstProperty = true;
     }
 
-    UMaterialExpressionTextureObjectParameter* PropertyData =
-        NewObject<UMaterialExpressionTextureObjectParameter>(
-            TargetMaterialLayer);
-    FString FullPropertyName = getMaterialNameForPropertyTableProperty(
-        PropertyTableName,
-        PropertyName);
-    PropertyData->ParameterName = FName(FullPropertyName);
-    PropertyData->MaterialExpressionEditorX = BeginSectionX;
-    PropertyData->MaterialExpressionEditorY = PropertyDataSectionY;
-    AutoGeneratedNodes.Add(PropertyData);
-
-    MaximumPropertyDataSectionX = FMath::Max(
-        MaximumPropertyDataSectionX,
-        Incr * GetNameLengthScalar(PropertyData->ParameterName));
-
-    FCustomInput& PropertyInput =
-        GetPropertyValuesFunction->Inputs.Emplace_GetRef();
-    PropertyInput.InputName = FName(PropertyDataName);
-    PropertyInput.Input.Expression = PropertyData;
+    if (PackIndex == INDEX_NONE) {
+      UMaterialExpressionTextureObjectParameter* PropertyData =
+          NewObject<UMaterialExpressionTextureObjectParameter>(
+              TargetMaterialLayer);
+      PropertyData->ParameterName = FName(FullPropertyName);
+      PropertyData->MaterialExpressionEditorX = BeginSectionX;
+      PropertyData->MaterialExpressionEditorY = PropertyDataSectionY;
+      AutoGeneratedNodes.Add(PropertyData);
+
+      MaximumPropertyDataSectionX = FMath::Max(
+          MaximumPropertyDataSectionX,
+          Incr * GetNameLengthScalar(PropertyData->ParameterName));
+
+      FCustomInput& PropertyInput =
+          GetPropertyValuesFunction->Inputs.Emplace_GetRef();
+      PropertyInput.InputName = FName(PropertyDataName);
+      PropertyInput.Input.Expression = PropertyData;
+    }
 
     FCustomOutput& PropertyOutput =
         GetPropertyValuesFunction->AdditionalOutputs.Emplace_GetRef();
@@ -1935,9 +2036,19 @@ void GenerateNodesForPropertyTable(
     // Example:
     // "color = asfloat(color_DATA.Load(int3(_czm_pixelX, _czm_pixelY,
     // 0)).rgb);"
-    GetPropertyValuesFunction->Code +=
-        OutputName + " = " + asComponentString + "(" + PropertyDataName +
-        ".Load(int3(_czm_pixelX, _czm_pixelY, 0))" + swizzle + ");\n";
+    GetPropertyValuesFunction->Code += OutputName + " = " + asComponentString +
+                                       "(" + LoadCode + swizzle + ");\n";
+
+    const std::string ProgramPropertyName = TCHAR_TO_UTF8(*Property.Name);
+    for (size_t Slot = 0; Slot < ProgramProperties.size(); ++Slot) {
+      if (ProgramProperties[Slot].name == ProgramPropertyName) {
+        // Example: "_czm_styleProperties[0] = height;"
+        GetPropertyValuesFunction->Code +=
+            "_czm_styleProperties[" + FString::FromInt(int32(Slot)) +
+            "] = " + OutputName + ";\n";
+        break;
+      }
+    }
 
     if (Property.PropertyDetails.HasValueTransforms()) {
       int32 PropertyTransformsSectionX =
@@ -1960,6 +2071,70 @@ void GenerateNodesForPropertyTable(
     }
   }
 
+  // Add the styled color of the feature. The tileset's Style is either run
+  // here, by the program in one texture, or evaluated beforehand for each
+  // feature and written to another. The unused one leaves features white, as
+  // do features beyond the end of the per-feature texture.
+  PropertyDataSectionY += Incr;
+
+  UMaterialExpressionTextureObjectParameter* StyleData =
+      NewObject<UMaterialExpressionTextureObjectParameter>(TargetMaterialLayer);
+  StyleData->ParameterName =
+      FName(getMaterialNameForPropertyTableStyle(PropertyTableName));
+  StyleData->MaterialExpressionEditorX = BeginSectionX;
+  StyleData->MaterialExpressionEditorY = PropertyDataSectionY;
+  AutoGeneratedNodes.Add(StyleData);
+
+  MaximumPropertyDataSectionX = FMath::Max(
+      MaximumPropertyDataSectionX,
+      Incr * GetNameLengthScalar(StyleData->ParameterName));
+
+  FCustomInput& StyleInput = GetPropertyValuesFunction->Inputs.Emplace_GetRef();
+  StyleInput.InputName = FName("_czm_styleData");
+  StyleInput.Input.Expression = StyleData;
+
+  PropertyDataSectionY += Incr;
+
+  UMaterialExpressionTextureObjectParameter* StyleProgram =
+      NewObject<UMaterialExpressionTextureObjectParameter>(TargetMaterialLayer);
+  StyleProgram->ParameterName =
+      FName(getMaterialNameForPropertyTableStyleProgram(PropertyTableName));
+  StyleProgram->MaterialExpressionEditorX = BeginSectionX;
+  StyleProgram->MaterialExpressionEditorY = PropertyDataSectionY;
+  AutoGeneratedNodes.Add(StyleProgram);
+
+  MaximumPropertyDataSectionX = FMath::Max(
+      MaximumPropertyDataSectionX,
+      Incr * GetNameLengthScalar(StyleProgram->ParameterName));
+
+  FCustomInput& StyleProgramInput =
+      GetPropertyValuesFunction->Inputs.Emplace_GetRef();
+  StyleProgramInput.InputName = FName("_czm_styleProgram");
+  StyleProgramInput.Input.Expression = StyleProgram;
+
+  FCustomOutput& StyleOutput =
+      GetPropertyValuesFunction->AdditionalOutputs.Emplace_GetRef();
+  StyleOutput.OutputName = FName("FeatureStyle");
+  StyleOutput.OutputType = ECustomMaterialOutputType::CMOT_Float4;
+  GetPropertyValuesFunction->Outputs.Add(
+      FExpressionOutput(StyleOutput.OutputName));
+
+  FExpressionInput& FeatureStyle = FeatureStyles.Emplace_GetRef();
+  FeatureStyle.Connect(
+      GetPropertyValuesFunction->Outputs.Num() - 1,
+      GetPropertyValuesFunction);
+
+  GetPropertyValuesFunction->Code +=
+      "uint _czm_styleWidth;\nuint _czm_styleHeight;\n"
+      "_czm_styleData.GetDimensions(_czm_styleWidth, _czm_styleHeight);\n"
+      "uint _czm_styleIndex = round(FeatureID);\n"
+      "FeatureStyle = _czm_styleIndex < _czm_styleWidth * _czm_styleHeight\n"
+      "    ? _czm_styleData.Load(int3(_czm_styleIndex % _czm_styleWidth,\n"
+      "          _czm_styleIndex / _czm_styleWidth, 0))\n"
+      "    : float4(1, 1, 1, 1);\n"
+      "FeatureStyle *= CesiumEvaluateStyle(_czm_styleProgram, "
+      "_czm_styleProperties);\n";
+
   // Shift the X of GetPropertyValues depending on the width of the data
   // parameters.
   GetPropertyValuesFunction->MaterialExpressionEditorX +=
@@ -2333,6 +2508,106 @@ void GenerateNodesForPropertyTexture(
   NodeY = FMath::Max(PropertyDataSectionY, PropertyTransformsSectionY) + Incr;
 }
 
+/**
+ * @brief Generates the nodes that apply the styled colors of the features to
+ * the material attributes that the user's nodes produce. The colors multiply
+ * the base color, their alpha multiplies the opacity, and features that the
+ * style hides are masked out. In summary:
+ * - Gets the base color, opacity, and opacity mask of the attributes
+ * - Combines them with each property table's FeatureStyle in a custom node
+ * - Sets the results on the attributes
+ *
+ * @returns The node that outputs the styled material attributes.
+ */
+UMaterialExpression* GenerateNodesForFeatureStyles(
+    const TArray<FExpressionInput>& FeatureStyles,
+    UMaterialExpression* MaterialAttributes,
+    TArray<UMaterialExpression*>& AutoGeneratedNodes,
+    UMaterialFunctionMaterialLayer* TargetMaterialLayer,
+    int32& NodeX,
+    int32 NodeY) {
+  const FGuid AttributeIDs[] = {
+      FMaterialAttributeDefinitionMap::GetID(MP_BaseColor),
+      FMaterialAttributeDefinitionMap::GetID(MP_Opacity),
+      FMaterialAttributeDefinitionMap::GetID(MP_OpacityMask)};
+
+  UMaterialExpressionGetMaterialAttributes* GetAttributes =
+      NewObject<UMaterialExpressionGetMaterialAttributes>(TargetMaterialLayer);
+  GetAttributes->MaterialAttributes.Expression = MaterialAttributes;
+  GetAttributes->MaterialExpressionEditorX = NodeX;
+  GetAttributes->MaterialExpressionEditorY = NodeY + Incr;
+  for (const FGuid& AttributeID : AttributeIDs) {
+    GetAttributes->AttributeGetTypes.Add(AttributeID);
+    const FString& AttributeName =
+        FMaterialAttributeDefinitionMap::GetAttributeName(AttributeID);
+    GetAttributes->Outputs.Add(FExpressionOutput(FName(*AttributeName)));
+  }
+  AutoGeneratedNodes.Add(GetAttributes);
+
+  NodeX += 1.5 * Incr;
+
+  UMaterialExpressionCustom* ApplyStyles =
+      NewObject<UMaterialExpressionCustom>(TargetMaterialLayer);
+  ApplyStyles->Description = "Apply Feature Styles";
+  ApplyStyles->bShowOutputNameOnPin = true;
+  ApplyStyles->OutputType = ECustomMaterialOutputType::CMOT_Float3;
+  ApplyStyles->MaterialExpressionEditorX = NodeX;
+  ApplyStyles->MaterialExpressionEditorY = NodeY + Incr;
+  AutoGeneratedNodes.Add(ApplyStyles);
+
+  ApplyStyles->Inputs[0].InputName = FName("BaseColor");
+  ApplyStyles->Inputs[0].Input.Connect(1, GetAttributes);
+  FCustomInput& OpacityInput = ApplyStyles->Inputs.Emplace_GetRef();
+  OpacityInput.InputName = FName("Opacity");
+  OpacityInput.Input.Connect(2, GetAttributes);
+  FCustomInput& OpacityMaskInput = ApplyStyles->Inputs.Emplace_GetRef();
+  OpacityMaskInput.InputName = FName("OpacityMask");
+  OpacityMaskInput.Input.Connect(3, GetAttributes);
+
+  ApplyStyles->Code = "float4 Style = float4(1, 1, 1, 1);\n";
+  for (int32 i = 0; i < FeatureStyles.Num(); ++i) {
+    // Example: "FeatureStyle0"
+    FString StyleName = "FeatureStyle" + FString::FromInt(i);
+    FCustomInput& StyleInput = ApplyStyles->Inputs.Emplace_GetRef();
+    StyleInput.InputName = FName(StyleName);
+    StyleInput.Input = FeatureStyles[i];
+    ApplyStyles->Code += "Style *= " + StyleName + ";\n";
+  }
+
+  ApplyStyles->Outputs.Reset(3);
+  ApplyStyles->Outputs.Add(FExpressionOutput(TEXT("Styled Base Color")));
+  for (const TCHAR* OutputName : {TEXT("StyledOpacity"), TEXT("StyledMask")}) {
+    FCustomOutput& Output = ApplyStyles->AdditionalOutputs.Emplace_GetRef();
+    Output.OutputName = FName(OutputName);
+    Output.OutputType = ECustomMaterialOutputType::CMOT_Float1;
+    ApplyStyles->Outputs.Add(FExpressionOutput(Output.OutputName));
+  }
+
+  ApplyStyles->Code += "StyledOpacity = Opacity * Style.a;\n"
+                       "StyledMask = Style.a > 0 ? OpacityMask : 0;\n"
+                       "return BaseColor * Style.rgb;";
+
+  NodeX += 1.5 * Incr;
+
+  UMaterialExpressionSetMaterialAttributes* SetAttributes =
+      NewObject<UMaterialExpressionSetMaterialAttributes>(TargetMaterialLayer);
+  SetAttributes->Inputs[0].Expression = MaterialAttributes;
+  SetAttributes->MaterialExpressionEditorX = NodeX;
+  SetAttributes->MaterialExpressionEditorY = NodeY;
+  for (int32 i = 0; i < int32(UE_ARRAY_COUNT(AttributeIDs)); ++i) {
+    SetAttributes->AttributeSetTypes.Add(AttributeIDs[i]);
+    FExpressionInput& Input = SetAttributes->Inputs.Emplace_GetRef();
+    Input.InputName = FName(
+        *FMaterialAttributeDefinitionMap::GetAttributeName(AttributeIDs[i]));
+    Input.Connect(i, ApplyStyles);
+  }
+  AutoGeneratedNodes.Add(SetAttributes);
+
+  NodeX += 2 * Incr;
+
+  return SetAttributes;
+}
+
 void GenerateMaterialNodes(
     UCesiumFeaturesMetadataComponent* pComponent,
     TArray<UMaterialExpression*>& AutoGeneratedNodes,
@@ -2347,6 +2622,8 @@ void GenerateMaterialNodes(
   TSet<FString> GeneratedPropertyTableNames;
   GeneratedPropertyTableNames.Reserve(pComponent->PropertyTables.Num());
 
+  TArray<FExpressionInput> FeatureStyles;
+
   for (const FCesiumFeatureIdSetDescription& featureIdSet :
        pComponent->FeatureIdSets) {
     if (featureIdSet.Type == ECesiumFeatureIdSetType::None) {
@@ -2392,7 +2669,8 @@ void GenerateMaterialNodes(
             pComponent->TargetMaterialLayer,
             NodeX,
             NodeY,
-            GetFeatureIdCall);
+            GetFeatureIdCall,
+            FeatureStyles);
         GeneratedPropertyTableNames.Add(pPropertyTable->Name);
       }
     }
@@ -2431,7 +2709,8 @@ void GenerateMaterialNodes(
           pComponent->TargetMaterialLayer,
           NodeX,
           NodeY,
-          nullptr);
+          nullptr,
+          FeatureStyles);
       MaximumSectionX = FMath::Max(MaximumSectionX, NodeX);
 
       NodeX = BeginSectionX;
@@ -2542,6 +2821,17 @@ void GenerateMaterialNodes(
 
   NodeX += 2 * Incr;
 
+  UMaterialExpression* OutputAttributes = SetMaterialAttributes;
+  if (FeatureStyles.Num() > 0) {
+    OutputAttributes = GenerateNodesForFeatureStyles(
+        FeatureStyles,
+        SetMaterialAttributes,
+        AutoGeneratedNodes,
+        pComponent->TargetMaterialLayer,
+        NodeX,
+        NodeY);
+  }
+
   UMaterialExpressionFunctionOutput* OutputMaterial = nullptr;
   for (const TObjectPtr<UMaterialExpression>& ExistingNode :
        pComponent->TargetMaterialLayer->GetExpressionCollection().Expressions) {
@@ -2562,7 +2852,7 @@ void GenerateMaterialNodes(
   OutputMaterial->MaterialExpressionEditorX = NodeX;
   OutputMaterial->MaterialExpressionEditorY = NodeY;
   OutputMaterial->A = FMaterialAttributesInput();
-  OutputMaterial->A.Expression = SetMaterialAttributes;
+  OutputMaterial->A.Expression = OutputAttributes;
 }
 
 } // namespace
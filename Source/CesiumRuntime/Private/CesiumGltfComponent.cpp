@@ -2,17 +2,29 @@
 
 #include "CesiumGltfComponent.h"
 #include "Async/Async.h"
+#include "Cesium3DTileset.h"
 #include "CesiumCommon.h"
 #include "CesiumEncodedFeaturesMetadata.h"
 #include "CesiumEncodedMetadataUtility.h"
+#include "CesiumFadeParameters.h"
 #include "CesiumFeatureIdSet.h"
 #include "CesiumGltfPointsComponent.h"
 #include "CesiumGltfPrimitiveComponent.h"
 #include "CesiumGltfTextures.h"
 #include "CesiumMaterialUserData.h"
+#include "CesiumMeshContentHash.h"
+#include "CesiumMeshDepot.h"
+#include "CesiumMeshOptimizer.h"
+#include "CesiumPhysicsMeshCooker.h"
+#include "CesiumPolygonClipper.h"
+#include "CesiumPrimitiveMerger.h"
+#include "CesiumPropertyTable.h"
 #include "CesiumRasterOverlays.h"
 #include "CesiumRuntime.h"
+#include "CesiumStats.h"
+#include "CesiumStyle.h"
 #include "CesiumTextureUtility.h"
+#include "CesiumTileObjectPool.h"
 #include "CesiumTransforms.h"
 #include "Chaos/AABBTree.h"
 #include "Chaos/CollisionConvexMesh.h"
@@ -20,6 +32,8 @@
 #include "CreateGltfOptions.h"
 #include "Engine/CollisionProfile.h"
 #include "Engine/StaticMesh.h"
+#include "Engine/Texture2D.h"
+#include "Hash/CityHash.h"
 #include "HttpModule.h"
 #include "Interfaces/IHttpResponse.h"
 #include "LoadGltfResult.h"
@@ -32,6 +46,7 @@
 #include "Runtime/Launch/Resources/Version.h"
 #include "StaticMeshOperations.h"
 #include "StaticMeshResources.h"
+#include "TextureResource.h"
 #include "UObject/ConstructorHelpers.h"
 #include "VecMath.h"
 #include "mikktspace.h"
@@ -314,16 +329,6 @@ static void computeFlatNormals(TArray<FStaticMeshBuildVertex>& vertices) {
   }
 }
 
-template <typename TIndex>
-#if ENGINE_VERSION_5_4_OR_HIGHER
-static Chaos::FTriangleMeshImplicitObjectPtr
-#else
-static TSharedPtr<Chaos::FTriangleMeshImplicitObject, ESPMode::ThreadSafe>
-#endif
-BuildChaosTriangleMeshes(
-    const TArray<FStaticMeshBuildVertex>& vertexData,
-    const TArray<uint32>& indices);
-
 static const CesiumGltf::Material defaultMaterial;
 static const CesiumGltf::MaterialPBRMetallicRoughness
     defaultPbrMetallicRoughness;
@@ -1131,6 +1136,291 @@ constexpr glm::dmat4 yInvertMatrix = {
     1.0};
 } // namespace
 
+/**
+ * @brief Copies the indices of a primitive, converting a triangle strip to a
+ * triangle list.
+ */
+template <class TIndexAccessor>
+static TArray<uint32> copyIndices(
+    const CesiumGltf::MeshPrimitive& primitive,
+    const TIndexAccessor& indicesView) {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::CopyIndices)
+
+  TArray<uint32> indices;
+  if (primitive.mode == CesiumGltf::MeshPrimitive::Mode::TRIANGLES ||
+      primitive.mode == CesiumGltf::MeshPrimitive::Mode::POINTS) {
+    indices.SetNum(static_cast<TArray<uint32>::SizeType>(indicesView.size()));
+
+    for (int32 i = 0; i < indicesView.size(); ++i) {
+      indices[i] = indicesView[i];
+    }
+  } else {
+    // assume TRIANGLE_STRIP because all others are rejected earlier.
+    indices.SetNum(
+        static_cast<TArray<uint32>::SizeType>(3 * (indicesView.size() - 2)));
+    for (int32 i = 0; i < indicesView.size() - 2; ++i) {
+      if (i % 2) {
+        indices[3 * i] = indicesView[i];
+        indices[3 * i + 1] = indicesView[i + 2];
+        indices[3 * i + 2] = indicesView[i + 1];
+      } else {
+        indices[3 * i] = indicesView[i];
+        indices[3 * i + 1] = indicesView[i + 1];
+        indices[3 * i + 2] = indicesView[i + 2];
+      }
+    }
+  }
+
+  return indices;
+}
+
+/**
+ * @brief Removes the triangles that the tileset's polygon clippers discard
+ * entirely, so that they are neither rendered nor used for collision.
+ *
+ * Instanced primitives are never clipped, because their vertices are not
+ * where the glTF places them.
+ */
+static void clipTriangles(
+    const CreatePrimitiveOptions& options,
+    const CesiumGltf::MeshPrimitive& primitive,
+    const glm::dmat4x4& transform,
+    const CesiumGltf::AccessorView<TMeshVector3>& positionView,
+    TArray<uint32>& indices) {
+  const CreateNodeOptions& nodeOptions = *options.pMeshOptions->pNodeOptions;
+  const CreateModelOptions& modelOptions = *nodeOptions.pModelOptions;
+  if (modelOptions.polygonClippers.empty() || indices.IsEmpty() ||
+      primitive.mode == CesiumGltf::MeshPrimitive::Mode::POINTS ||
+      (nodeOptions.pNode &&
+       nodeOptions.pNode
+           ->hasExtension<CesiumGltf::ExtensionExtMeshGpuInstancing>())) {
+    return;
+  }
+
+  std::vector<glm::dvec3> positions(size_t(positionView.size()));
+  for (int64_t i = 0; i < positionView.size(); ++i) {
+    const TMeshVector3& position = positionView[i];
+    positions[size_t(i)] = glm::dvec3(
+        transform * glm::dvec4(position.X, position.Y, position.Z, 1.0));
+  }
+
+  for (const std::shared_ptr<const CesiumPolygonClipper>& pClipper :
+       modelOptions.polygonClippers) {
+    pClipper->removeClippedTriangles(indices, positions);
+  }
+}
+
+/**
+ * @brief Simplifies the given geometry and either cooks it into the
+ * primitive's collision mesh or keeps it to be cooked later.
+ */
+static void createCollisionMesh(
+    LoadPrimitiveResult& primitiveResult,
+    const CreateModelOptions& modelOptions,
+    CesiumCollisionGeometry&& collisionGeometry) {
+  CesiumPhysicsMeshCooker::simplify(
+      collisionGeometry,
+      modelOptions.physicsMeshSimplificationResolution);
+
+  if (modelOptions.deferPhysicsMeshes) {
+    primitiveResult.pDeferredCollisionGeometry =
+        MakeShared<const CesiumCollisionGeometry>(MoveTemp(collisionGeometry));
+  } else {
+    primitiveResult.pCollisionMesh =
+        CesiumPhysicsMeshCooker::cook(collisionGeometry);
+    primitiveResult.collisionMeshBytes =
+        int64(collisionGeometry.getSizeBytes());
+  }
+}
+
+/**
+ * @brief Loads only the collision mesh and, optionally, the features and
+ * metadata of a primitive, for tilesets that are never rendered.
+ *
+ * This skips everything that only serves rendering: normals, tangents, texture
+ * coordinates, vertex colors, textures, and the static mesh render data.
+ */
+template <class TIndexAccessor>
+static void loadCollisionOnlyPrimitive(
+    LoadPrimitiveResult& primitiveResult,
+    const glm::dmat4x4& transform,
+    const CreatePrimitiveOptions& options,
+    CesiumGltf::Model& model,
+    CesiumGltf::MeshPrimitive& primitive,
+    const CesiumGltf::AccessorView<TMeshVector3>& positionView,
+    const TIndexAccessor& indicesView) {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::loadCollisionOnlyPrimitive)
+
+  const CreateModelOptions& modelOptions =
+      *options.pMeshOptions->pNodeOptions->pModelOptions;
+
+  if (primitive.mode == CesiumGltf::MeshPrimitive::Mode::POINTS ||
+      !modelOptions.createPhysicsMeshes) {
+    return;
+  }
+
+  CesiumCollisionGeometry collisionGeometry;
+  collisionGeometry.indices = copyIndices(primitive, indicesView);
+  clipTriangles(
+      options,
+      primitive,
+      transform,
+      positionView,
+      collisionGeometry.indices);
+  if (collisionGeometry.indices.IsEmpty()) {
+    return;
+  }
+
+  FBox bounds(ForceInit);
+  collisionGeometry.positions.SetNum(
+      static_cast<TArray<FVector3f>::SizeType>(positionView.size()));
+  for (int32 i = 0; i < collisionGeometry.positions.Num(); ++i) {
+    const TMeshVector3& pos = positionView[i];
+    FVector3f& position = collisionGeometry.positions[i];
+    position.X = pos.X * CesiumPrimitiveData::positionScaleFactor;
+    position.Y = -pos.Y * CesiumPrimitiveData::positionScaleFactor;
+    position.Z = pos.Z * CesiumPrimitiveData::positionScaleFactor;
+    bounds += FVector(position);
+  }
+
+  double scale = 1.0 / CesiumPrimitiveData::positionScaleFactor;
+  glm::dmat4 scaleMatrix = glm::dmat4(
+      glm::dvec4(scale, 0.0, 0.0, 0.0),
+      glm::dvec4(0.0, scale, 0.0, 0.0),
+      glm::dvec4(0.0, 0.0, scale, 0.0),
+      glm::dvec4(0.0, 0.0, 0.0, 1.0));
+
+  primitiveResult.collisionOnly = true;
+  primitiveResult.collisionBounds = FBoxSphereBounds(bounds);
+  primitiveResult.meshIndex = options.pMeshOptions->meshIndex;
+  primitiveResult.primitiveIndex = options.primitiveIndex;
+  primitiveResult.transform = transform * yInvertMatrix * scaleMatrix;
+
+  if (modelOptions.loadMetadata) {
+    // Without a features and metadata description nothing is encoded, so no
+    // vertices are needed.
+    TArray<FStaticMeshBuildVertex> noVertices;
+    loadPrimitiveFeaturesMetadata(
+        primitiveResult,
+        options,
+        model,
+        primitive,
+        false,
+        noVertices,
+        collisionGeometry.indices);
+  }
+
+  createCollisionMesh(
+      primitiveResult,
+      modelOptions,
+      MoveTemp(collisionGeometry));
+}
+
+static bool
+hasOverlayTextureCoordinates(const CesiumGltf::MeshPrimitive& primitive) {
+  for (size_t i = 0; i < maximumOverlayTextureCoordinateIDs; ++i) {
+    if (primitive.attributes.find("_CESIUMOVERLAY_" + std::to_string(i)) !=
+        primitive.attributes.end()) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * @brief Gets the key under which the converted geometry of a primitive is
+ * shared through the CesiumMeshDepot, or std::nullopt if it is not shared.
+ *
+ * Besides the content of the primitive, the key covers everything that affects
+ * the conversion. Primitives whose vertices depend on the tile, like those with
+ * raster overlay texture coordinates, encoded features, or unlit normals
+ * computed from the ellipsoid, are not shared.
+ */
+static std::optional<uint64> getSharedMeshKey(
+    const CreateModelOptions& modelOptions,
+    const CesiumGltf::Model& model,
+    const CesiumGltf::MeshPrimitive& primitive,
+    bool isUnlit,
+    bool hasNormals,
+    bool needsTangents) {
+  if (!modelOptions.shareMeshes || !modelOptions.polygonClippers.empty() ||
+      primitive.mode == CesiumGltf::MeshPrimitive::Mode::POINTS ||
+      modelOptions.deferPhysicsMeshes || (isUnlit && !hasNormals) ||
+      primitive.hasExtension<CesiumGltf::ExtensionExtMeshFeatures>() ||
+      primitive.hasExtension<
+          CesiumGltf::ExtensionMeshPrimitiveExtStructuralMetadata>() ||
+      hasOverlayTextureCoordinates(primitive)) {
+    return std::nullopt;
+  }
+
+  std::optional<uint64> contentHash =
+      CesiumMeshContentHash::hashPrimitive(model, primitive);
+  if (!contentHash) {
+    return std::nullopt;
+  }
+
+  const uint32 flags = (isUnlit ? 1u : 0u) | (needsTangents ? 2u : 0u) |
+                       (modelOptions.optimizeMeshes ? 4u : 0u) |
+                       (modelOptions.useHalfPrecisionUVs ? 8u : 0u) |
+                       (modelOptions.createPhysicsMeshes ? 16u : 0u);
+  const int32 resolution = modelOptions.physicsMeshSimplificationResolution;
+
+  uint64 key = CityHash64WithSeed(
+      reinterpret_cast<const char*>(&flags),
+      sizeof(flags),
+      *contentHash);
+  return CityHash64WithSeed(
+      reinterpret_cast<const char*>(&resolution),
+      sizeof(resolution),
+      key);
+}
+
+static void loadMaterialTextures(
+    LoadPrimitiveResult& primitiveResult,
+    CesiumGltf::Model& model,
+    const CesiumGltf::Material& material,
+    const CesiumGltf::MaterialPBRMetallicRoughness& pbrMetallicRoughness) {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::loadTextures)
+  primitiveResult.baseColorTexture =
+      loadTexture(model, pbrMetallicRoughness.baseColorTexture, true);
+  primitiveResult.metallicRoughnessTexture =
+      loadTexture(model, pbrMetallicRoughness.metallicRoughnessTexture, false);
+  primitiveResult.normalTexture =
+      loadTexture(model, material.normalTexture, false);
+  primitiveResult.occlusionTexture =
+      loadTexture(model, material.occlusionTexture, false);
+  primitiveResult.emissiveTexture =
+      loadTexture(model, material.emissiveTexture, true);
+}
+
+/**
+ * @brief Sets the parts of a primitive's load result that are the same whether
+ * its geometry was converted or found in the CesiumMeshDepot.
+ */
+static void finishLoadPrimitive(
+    LoadPrimitiveResult& primitiveResult,
+    const CreatePrimitiveOptions& options,
+    const CesiumGltf::Model& model,
+    const CesiumGltf::MeshPrimitive& primitive) {
+  // The instances of identical primitives in other tiles may be rendered by a
+  // single component, as long as nothing about their material is specific to
+  // the tile.
+  if (options.pMeshOptions->pNodeOptions->pModelOptions->aggregateInstances &&
+      primitive.mode != CesiumGltf::MeshPrimitive::Mode::POINTS &&
+      !options.pMeshOptions->pHalfConstructedNodeResult->InstanceTransforms
+           .empty() &&
+      !primitive.hasExtension<CesiumGltf::ExtensionExtMeshFeatures>() &&
+      !primitive.hasExtension<
+          CesiumGltf::ExtensionMeshPrimitiveExtStructuralMetadata>() &&
+      !hasOverlayTextureCoordinates(primitive)) {
+    primitiveResult.InstanceAggregationKey =
+        CesiumMeshContentHash::hashPrimitive(model, primitive).value_or(0);
+  }
+
+  primitiveResult.meshIndex = options.pMeshOptions->meshIndex;
+  primitiveResult.primitiveIndex = options.primitiveIndex;
+}
+
 template <class TIndexAccessor>
 static void loadPrimitive(
     LoadPrimitiveResult& primitiveResult,
@@ -1213,6 +1503,18 @@ static void loadPrimitive(
     }
   }
 
+  if (options.pMeshOptions->pNodeOptions->pModelOptions->collisionOnly) {
+    loadCollisionOnlyPrimitive(
+        primitiveResult,
+        transform,
+        options,
+        model,
+        primitive,
+        positionView,
+        indicesView);
+    return;
+  }
+
   auto normalAccessorIt = primitive.attributes.find("NORMAL");
   CesiumGltf::AccessorView<TMeshVector3> normalAccessor;
   bool hasNormals = false;
@@ -1301,6 +1603,42 @@ static void loadPrimitive(
     needsTangents = true;
   }
 
+  double scale = 1.0 / CesiumPrimitiveData::positionScaleFactor;
+  glm::dmat4 scaleMatrix = glm::dmat4(
+      glm::dvec4(scale, 0.0, 0.0, 0.0),
+      glm::dvec4(0.0, scale, 0.0, 0.0),
+      glm::dvec4(0.0, 0.0, scale, 0.0),
+      glm::dvec4(0.0, 0.0, 0.0, 1.0));
+
+  const std::optional<uint64> sharedMeshKey = getSharedMeshKey(
+      *options.pMeshOptions->pNodeOptions->pModelOptions,
+      model,
+      primitive,
+      primitiveResult.isUnlit,
+      hasNormals,
+      needsTangents);
+  TSharedPtr<CesiumSharedMesh> pSharedMesh =
+      sharedMeshKey ? CesiumMeshDepot::getInstance().find(*sharedMeshKey)
+                    : nullptr;
+  if (pSharedMesh) {
+    // An identical primitive was already converted, so only the textures,
+    // which belong to this tile's material, need to be loaded.
+    loadMaterialTextures(
+        primitiveResult,
+        model,
+        material,
+        pbrMetallicRoughness);
+    primitiveResult.textureCoordinateParameters =
+        pSharedMesh->textureCoordinateParameters;
+    primitiveResult.GltfToUnrealTexCoordMap =
+        pSharedMesh->GltfToUnrealTexCoordMap;
+    primitiveResult.pCollisionMesh = pSharedMesh->pCollisionMesh;
+    primitiveResult.pSharedMesh = MoveTemp(pSharedMesh);
+    finishLoadPrimitive(primitiveResult, options, model, primitive);
+    primitiveResult.transform = transform * yInvertMatrix * scaleMatrix;
+    return;
+  }
+
   TUniquePtr<FStaticMeshRenderData> RenderData =
       MakeUnique<FStaticMeshRenderData>();
   RenderData->AllocateLODResources(1);
@@ -1345,31 +1683,10 @@ static void loadPrimitive(
     RenderData->Bounds.SphereRadius = 0.0f;
   }
 
-  TArray<uint32> indices;
-  if (primitive.mode == CesiumGltf::MeshPrimitive::Mode::TRIANGLES ||
-      primitive.mode == CesiumGltf::MeshPrimitive::Mode::POINTS) {
-    TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::CopyIndices)
-    indices.SetNum(static_cast<TArray<uint32>::SizeType>(indicesView.size()));
-
-    for (int32 i = 0; i < indicesView.size(); ++i) {
-      indices[i] = indicesView[i];
-    }
-  } else {
-    // assume TRIANGLE_STRIP because all others are rejected earlier.
-    TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::CopyIndices)
-    indices.SetNum(
-        static_cast<TArray<uint32>::SizeType>(3 * (indicesView.size() - 2)));
-    for (int32 i = 0; i < indicesView.size() - 2; ++i) {
-      if (i % 2) {
-        indices[3 * i] = indicesView[i];
-        indices[3 * i + 1] = indicesView[i + 2];
-        indices[3 * i + 2] = indicesView[i + 1];
-      } else {
-        indices[3 * i] = indicesView[i];
-        indices[3 * i + 1] = indicesView[i + 1];
-        indices[3 * i + 2] = indicesView[i + 2];
-      }
-    }
+  TArray<uint32> indices = copyIndices(primitive, indicesView);
+  clipTriangles(options, primitive, transform, positionView, indices);
+  if (indices.IsEmpty()) {
+    return;
   }
 
   // If we don't have normals, the gltf spec prescribes that the client
@@ -1453,21 +1770,7 @@ static void loadPrimitive(
       StaticMeshBuildVertices,
       indices);
 
-  {
-    TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::loadTextures)
-    primitiveResult.baseColorTexture =
-        loadTexture(model, pbrMetallicRoughness.baseColorTexture, true);
-    primitiveResult.metallicRoughnessTexture = loadTexture(
-        model,
-        pbrMetallicRoughness.metallicRoughnessTexture,
-        false);
-    primitiveResult.normalTexture =
-        loadTexture(model, material.normalTexture, false);
-    primitiveResult.occlusionTexture =
-        loadTexture(model, material.occlusionTexture, false);
-    primitiveResult.emissiveTexture =
-        loadTexture(model, material.emissiveTexture, true);
-  }
+  loadMaterialTextures(primitiveResult, model, material, pbrMetallicRoughness);
 
   {
     TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::UpdateTextureCoordinates)
@@ -1543,13 +1846,6 @@ static void loadPrimitive(
     }
   }
 
-  double scale = 1.0 / CesiumPrimitiveData::positionScaleFactor;
-  glm::dmat4 scaleMatrix = glm::dmat4(
-      glm::dvec4(scale, 0.0, 0.0, 0.0),
-      glm::dvec4(0.0, scale, 0.0, 0.0),
-      glm::dvec4(0.0, 0.0, scale, 0.0),
-      glm::dvec4(0.0, 0.0, 0.0, 1.0));
-
   // TangentX: Tangent
   // TangentY: Bi-tangent
   // TangentZ: Normal
@@ -1628,14 +1924,61 @@ static void loadPrimitive(
     computeTangentSpace(StaticMeshBuildVertices);
   }
 
+  if (duplicateVertices) {
+    TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::ReverseWindingOrder)
+    for (int32 i = 0; i < indices.Num(); i++) {
+      indices[i] = i;
+    }
+  }
+
+  // The collision mesh keeps the original triangle order, so that the face
+  // indices of hits still match the glTF primitive.
+  if (primitive.mode != CesiumGltf::MeshPrimitive::Mode::POINTS &&
+      options.pMeshOptions->pNodeOptions->pModelOptions->createPhysicsMeshes) {
+    if (StaticMeshBuildVertices.Num() != 0 && indices.Num() != 0) {
+      CesiumCollisionGeometry collisionGeometry;
+      collisionGeometry.positions.Reserve(StaticMeshBuildVertices.Num());
+      for (const FStaticMeshBuildVertex& vertex : StaticMeshBuildVertices) {
+        collisionGeometry.positions.Add(vertex.Position);
+      }
+      collisionGeometry.indices = indices;
+
+      createCollisionMesh(
+          primitiveResult,
+          *options.pMeshOptions->pNodeOptions->pModelOptions,
+          MoveTemp(collisionGeometry));
+    }
+  }
+
+  uint32 numberOfTextureCoordinates =
+      gltfToUnrealTexCoordMap.size() == 0
+          ? 1
+          : uint32(gltfToUnrealTexCoordMap.size());
+
+  if (primitive.mode != CesiumGltf::MeshPrimitive::Mode::POINTS &&
+      options.pMeshOptions->pNodeOptions->pModelOptions->optimizeMeshes) {
+    CesiumMeshOptimizer::optimize(
+        StaticMeshBuildVertices,
+        indices,
+        numberOfTextureCoordinates,
+        hasVertexColors);
+  }
+
   {
     TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::InitBuffers)
 
-    // Set to full precision (32-bit) UVs. This is especially important for
-    // metadata because integer feature IDs can and will lose meaningful
-    // precision when using 16-bit floats.
+    // Use full precision (32-bit) UVs unless half precision UVs are
+    // requested and 16-bit floats represent the UVs well enough. This is
+    // especially important for metadata because integer feature IDs can and
+    // will lose meaningful precision when using 16-bit floats.
+    const bool useHalfPrecisionUVs =
+        options.pMeshOptions->pNodeOptions->pModelOptions
+            ->useHalfPrecisionUVs &&
+        CesiumMeshOptimizer::canUseHalfPrecisionUVs(
+            StaticMeshBuildVertices,
+            numberOfTextureCoordinates);
     LODResources.VertexBuffers.StaticMeshVertexBuffer.SetUseFullPrecisionUVs(
-        true);
+        !useHalfPrecisionUVs);
 
     LODResources.VertexBuffers.PositionVertexBuffer.Init(
         StaticMeshBuildVertices,
@@ -1647,11 +1990,6 @@ static void loadPrimitive(
       ColorVertexBuffer.Init(StaticMeshBuildVertices, false);
     }
 
-    uint32 numberOfTextureCoordinates =
-        gltfToUnrealTexCoordMap.size() == 0
-            ? 1
-            : uint32(gltfToUnrealTexCoordMap.size());
-
     FStaticMeshVertexBuffer& vertexBuffer =
         LODResources.VertexBuffers.StaticMeshVertexBuffer;
     vertexBuffer.Init(
@@ -1695,13 +2033,6 @@ static void loadPrimitive(
   section.bCastShadow = true;
   section.MaterialIndex = 0;
 
-  if (duplicateVertices) {
-    TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::ReverseWindingOrder)
-    for (int32 i = 0; i < indices.Num(); i++) {
-      indices[i] = i;
-    }
-  }
-
   {
     TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::SetIndices)
     LODResources.IndexBuffer.SetIndices(
@@ -1721,27 +2052,26 @@ static void loadPrimitive(
   RenderData->InitializeRayTracingRepresentationFromRenderingLODs();
 #endif
 
-  primitiveResult.meshIndex = options.pMeshOptions->meshIndex;
-  primitiveResult.primitiveIndex = options.primitiveIndex;
-  primitiveResult.RenderData = std::move(RenderData);
-  primitiveResult.pCollisionMesh = nullptr;
+  finishLoadPrimitive(primitiveResult, options, model, primitive);
+
+  if (sharedMeshKey) {
+    // Share the converted geometry with identical primitives loaded later.
+    TSharedRef<CesiumSharedMesh> pNewSharedMesh =
+        MakeShared<CesiumSharedMesh>();
+    pNewSharedMesh->RenderData = std::move(RenderData);
+    pNewSharedMesh->pCollisionMesh = primitiveResult.pCollisionMesh;
+    pNewSharedMesh->PhysicsBytes = primitiveResult.collisionMeshBytes;
+    pNewSharedMesh->textureCoordinateParameters =
+        primitiveResult.textureCoordinateParameters;
+    pNewSharedMesh->GltfToUnrealTexCoordMap =
+        primitiveResult.GltfToUnrealTexCoordMap;
+    primitiveResult.pSharedMesh =
+        CesiumMeshDepot::getInstance().add(*sharedMeshKey, pNewSharedMesh);
+  } else {
+    primitiveResult.RenderData = std::move(RenderData);
+  }
 
   primitiveResult.transform = transform * yInvertMatrix * scaleMatrix;
-
-  if (primitive.mode != CesiumGltf::MeshPrimitive::Mode::POINTS &&
-      options.pMeshOptions->pNodeOptions->pModelOptions->createPhysicsMeshes) {
-    if (StaticMeshBuildVertices.Num() != 0 && indices.Num() != 0) {
-      TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::ChaosCook)
-      primitiveResult.pCollisionMesh =
-          StaticMeshBuildVertices.Num() < TNumericLimits<uint16>::Max()
-              ? BuildChaosTriangleMeshes<uint16>(
-                    StaticMeshBuildVertices,
-                    indices)
-              : BuildChaosTriangleMeshes<int32>(
-                    StaticMeshBuildVertices,
-                    indices);
-    }
-  }
 }
 
 static void loadIndexedPrimitive(
@@ -1882,8 +2212,9 @@ static void loadMesh(
     auto& primitiveResult = result->primitiveResults.emplace_back();
     loadPrimitive(primitiveResult, transform, primitiveOptions, ellipsoid);
 
-    // if it doesn't have render data, then it can't be loaded
-    if (!primitiveResult.RenderData) {
+    // if it has neither render data nor collision, then it can't be loaded
+    if (!primitiveResult.RenderData && !primitiveResult.pSharedMesh &&
+        !primitiveResult.collisionOnly) {
       result->primitiveResults.pop_back();
     }
   }
@@ -2274,6 +2605,64 @@ loadModelMetadata(LoadModelResult& result, const CreateModelOptions& options) {
   PRAGMA_ENABLE_DEPRECATION_WARNINGS
 }
 
+/**
+ * Evaluates a style for the features of each encoded property table of a
+ * model, by property table name. Property tables whose style program runs in
+ * the material are skipped.
+ */
+static TMap<FString, TArray<FColor>> evaluateStyle(
+    const CesiumStyle::Style& style,
+    const FCesiumModelMetadata& metadata,
+    const CesiumEncodedFeaturesMetadata::EncodedModelMetadata&
+        encodedMetadata) {
+  TMap<FString, TArray<FColor>> result;
+
+  const TArray<FCesiumPropertyTable>& propertyTables =
+      UCesiumModelMetadataBlueprintLibrary::GetPropertyTables(metadata);
+
+  for (const CesiumEncodedFeaturesMetadata::EncodedPropertyTable&
+           encodedPropertyTable : encodedMetadata.propertyTables) {
+    if (style.getProgram(encodedPropertyTable.name)) {
+      continue;
+    }
+
+    const FCesiumPropertyTable* pPropertyTable = propertyTables.FindByPredicate(
+        [&name = encodedPropertyTable.name](
+            const FCesiumPropertyTable& propertyTable) {
+          return CesiumEncodedFeaturesMetadata::getNameForPropertyTable(
+                     propertyTable) == name;
+        });
+    if (!pPropertyTable) {
+      continue;
+    }
+
+    const int64 featureCount =
+        UCesiumPropertyTableBlueprintLibrary::GetPropertyTableCount(
+            *pPropertyTable);
+    if (featureCount <= 0) {
+      continue;
+    }
+
+    // Use the same square layout as the encoded property textures, so that
+    // the material finds a feature's style at the same texel as its
+    // properties.
+    const int64 floorSqrtFeatureCount = glm::sqrt(featureCount);
+    const int32 textureDimension =
+        int32((floorSqrtFeatureCount * floorSqrtFeatureCount == featureCount)
+                  ? floorSqrtFeatureCount
+                  : (floorSqrtFeatureCount + 1));
+
+    TArray<FColor>& colors = result.Add(encodedPropertyTable.name);
+    colors.SetNumZeroed(textureDimension * textureDimension);
+    CesiumStyle::evaluatePropertyTable(
+        &style,
+        *pPropertyTable,
+        std::span<FColor>(colors.GetData(), size_t(featureCount)));
+  }
+
+  return result;
+}
+
 static CesiumAsync::Future<UCesiumGltfComponent::CreateOffGameThreadResult>
 loadModelAnyThreadPart(
     const CesiumAsync::AsyncSystem& asyncSystem,
@@ -2288,8 +2677,21 @@ loadModelAnyThreadPart(
           -> UCesiumGltfComponent::CreateOffGameThreadResult {
             auto pHalf = MakeUnique<HalfConstructedReal>();
 
+            if (options.mergePrimitives) {
+              CesiumPrimitiveMerger::mergePrimitives(*options.pModel);
+            }
+
             loadModelMetadata(pHalf->loadModelResult, options);
 
+            if (options.pStyle) {
+              LoadModelResult& modelResult = pHalf->loadModelResult;
+              modelResult.pStyle = options.pStyle;
+              modelResult.StyleColors = evaluateStyle(
+                  *options.pStyle,
+                  modelResult.Metadata,
+                  modelResult.EncodedMetadata);
+            }
+
             glm::dmat4x4 rootTransform = transform;
 
             CesiumGltf::Model& model = *options.pModel;
@@ -2701,6 +3103,9 @@ static void SetFeaturesMetadataParameterValues(
           propertyTexture);
     }
 
+    // The style programs are shared by all of the tileset's tiles.
+    ACesium3DTileset* pTileset =
+        Cast<ACesium3DTileset>(gltfComponent.GetOwner());
     for (const CesiumEncodedFeaturesMetadata::EncodedPropertyTable&
              propertyTable : gltfComponent.EncodedMetadata.propertyTables) {
       CesiumEncodedFeaturesMetadata::SetPropertyTableParameterValues(
@@ -2708,6 +3113,26 @@ static void SetFeaturesMetadataParameterValues(
           association,
           index,
           propertyTable);
+
+      pMaterial->SetTextureParameterValueByInfo(
+          FMaterialParameterInfo(
+              FName(CesiumEncodedFeaturesMetadata::
+                        getMaterialNameForPropertyTableStyle(
+                            propertyTable.name)),
+              association,
+              index),
+          gltfComponent.GetStyleTexture(propertyTable.name));
+
+      if (pTileset) {
+        pMaterial->SetTextureParameterValueByInfo(
+            FMaterialParameterInfo(
+                FName(CesiumEncodedFeaturesMetadata::
+                          getMaterialNameForPropertyTableStyleProgram(
+                              propertyTable.name)),
+                association,
+                index),
+            pTileset->GetStyleProgramTexture(propertyTable.name));
+      }
     }
   }
 }
@@ -2871,6 +3296,128 @@ static void SetMetadataParameterValues_DEPRECATED(
 PRAGMA_ENABLE_DEPRECATION_WARNINGS
 #pragma endregion
 
+namespace {
+/**
+ * @brief Takes a component of the given type from the tileset's object pool,
+ * or creates a new one if the pool has none.
+ */
+template <typename TComponent>
+TComponent* acquireOrCreateComponent(
+    UCesiumTileObjectPool* pObjectPool,
+    UCesiumGltfComponent* pGltf,
+    FName componentName) {
+  if (!pObjectPool) {
+    return NewObject<TComponent>(pGltf, componentName);
+  }
+
+  TComponent* pComponent = Cast<TComponent>(pObjectPool->acquireComponent(
+      TComponent::StaticClass(),
+      pGltf,
+      componentName));
+  if (!pComponent) {
+    pComponent = NewObject<TComponent>(pGltf, componentName);
+    pObjectPool->recordComponentCreated();
+  }
+  return pComponent;
+}
+} // namespace
+
+namespace {
+/**
+ * @brief Moves the features and metadata of a loaded primitive to its
+ * component.
+ */
+void moveFeaturesMetadata(
+    CesiumPrimitiveData& primData,
+    LoadPrimitiveResult& loadResult,
+    const UCesiumGltfComponent& gltf) {
+  primData.Features = std::move(loadResult.Features);
+  primData.Metadata = std::move(loadResult.Metadata);
+
+  primData.EncodedFeatures = std::move(loadResult.EncodedFeatures);
+  primData.EncodedMetadata = std::move(loadResult.EncodedMetadata);
+
+  PRAGMA_DISABLE_DEPRECATION_WARNINGS
+
+  // Doing the above std::move operations invalidates the pointers in the
+  // FCesiumMetadataPrimitive constructed on the loadResult. It's a bit
+  // awkward, but we have to reconstruct the metadata primitive here.
+  primData.Metadata_DEPRECATED = FCesiumMetadataPrimitive{
+      primData.Features,
+      primData.Metadata,
+      gltf.Metadata};
+
+  if (loadResult.EncodedMetadata_DEPRECATED) {
+    primData.EncodedMetadata_DEPRECATED =
+        std::move(loadResult.EncodedMetadata_DEPRECATED);
+  }
+
+  PRAGMA_ENABLE_DEPRECATION_WARNINGS
+}
+
+/**
+ * @brief Sets up the collision of a primitive component and registers it.
+ *
+ * The body setup and navigation collision belong to the static mesh, so they
+ * are only created when the static mesh is new, and not when it is shared
+ * with a component that already created them.
+ */
+void finishPrimitiveComponent(
+    UCesiumGltfComponent* pGltf,
+    UStaticMeshComponent* pMesh,
+    UStaticMesh* pStaticMesh,
+    CesiumPrimitiveData& primData,
+    LoadPrimitiveResult& loadResult,
+    bool createNavCollision,
+    bool initializeStaticMesh = true) {
+  if (initializeStaticMesh) {
+    TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::BodySetup)
+
+    pStaticMesh->CreateBodySetup();
+
+    UBodySetup* pBodySetup = pMesh->GetBodySetup();
+
+    // pMesh->UpdateCollisionFromStaticMesh();
+    pBodySetup->CollisionTraceFlag =
+        ECollisionTraceFlag::CTF_UseComplexAsSimple;
+
+    if (loadResult.pCollisionMesh) {
+#if ENGINE_VERSION_5_4_OR_HIGHER
+      pBodySetup->TriMeshGeometries.Add(loadResult.pCollisionMesh);
+#else
+      pBodySetup->ChaosTriMeshes.Add(loadResult.pCollisionMesh);
+#endif
+    }
+
+    // Mark physics meshes created, no matter if we actually have a collision
+    // mesh or not. We don't want the editor creating collision meshes itself in
+    // the game thread, because that would be slow.
+    pBodySetup->bCreatedPhysicsMeshes = true;
+    pBodySetup->bSupportUVsAndFaceRemap =
+        UPhysicsSettings::Get()->bSupportUVFromHitResults;
+  }
+
+  // A deferred collision mesh is cooked later and added to this body setup by
+  // the tileset's CesiumPhysicsMeshCooker.
+  primData.pPendingCollisionGeometry =
+      MoveTemp(loadResult.pDeferredCollisionGeometry);
+
+  if (createNavCollision && initializeStaticMesh) {
+    TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::CreateNavCollision)
+    pStaticMesh->CreateNavCollision(true);
+  }
+
+  pMesh->SetMobility(pGltf->Mobility);
+
+  pMesh->SetupAttachment(pGltf);
+
+  {
+    TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::RegisterComponent)
+    pMesh->RegisterComponent();
+  }
+}
+} // namespace
+
 static void loadPrimitiveGameThreadPart(
     CesiumGltf::Model& model,
     UCesiumGltfComponent* pGltf,
@@ -2879,6 +3426,7 @@ static void loadPrimitiveGameThreadPart(
     const Cesium3DTilesSelection::Tile& tile,
     bool createNavCollision,
     ACesium3DTileset* pTilesetActor,
+    UCesiumTileObjectPool* pObjectPool,
     const std::vector<FTransform>& instanceTransforms) {
   TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::LoadPrimitive)
 
@@ -2898,7 +3446,10 @@ static void loadPrimitiveGameThreadPart(
   ICesiumPrimitive* pCesiumPrimitive = nullptr;
   if (meshPrimitive.mode == CesiumGltf::MeshPrimitive::Mode::POINTS) {
     UCesiumGltfPointsComponent* pPointMesh =
-        NewObject<UCesiumGltfPointsComponent>(pGltf, componentName);
+        acquireOrCreateComponent<UCesiumGltfPointsComponent>(
+            pObjectPool,
+            pGltf,
+            componentName);
     pPointMesh->UsesAdditiveRefinement =
         tile.getRefine() == Cesium3DTilesSelection::TileRefine::Add;
     pPointMesh->GeometricError = static_cast<float>(tile.getGeometricError());
@@ -2907,21 +3458,33 @@ static void loadPrimitiveGameThreadPart(
     pCesiumPrimitive = pPointMesh;
   } else if (!instanceTransforms.empty()) {
     auto* pInstancedComponent =
-        NewObject<UCesiumGltfInstancedComponent>(pGltf, componentName);
+        acquireOrCreateComponent<UCesiumGltfInstancedComponent>(
+            pObjectPool,
+            pGltf,
+            componentName);
     pMesh = pInstancedComponent;
-    for (const FTransform& transform : instanceTransforms) {
-      pInstancedComponent->AddInstance(transform, false);
-    }
+    pInstancedComponent->TileInstanceTransforms = TArray<FTransform>(
+        instanceTransforms.data(),
+        static_cast<int32>(instanceTransforms.size()));
+    pInstancedComponent->InstanceAggregationKey =
+        loadResult.InstanceAggregationKey;
+    pInstancedComponent->RendersAggregatedInstances = false;
+    pInstancedComponent->AddInstances(
+        pInstancedComponent->TileInstanceTransforms,
+        false);
     pCesiumPrimitive = pInstancedComponent;
   } else {
-    auto* pComponent =
-        NewObject<UCesiumGltfPrimitiveComponent>(pGltf, componentName);
+    auto* pComponent = acquireOrCreateComponent<UCesiumGltfPrimitiveComponent>(
+        pObjectPool,
+        pGltf,
+        componentName);
     pMesh = pComponent;
     pCesiumPrimitive = pComponent;
   }
   CesiumPrimitiveData& primData = pCesiumPrimitive->getPrimitiveData();
 
   UStaticMesh* pStaticMesh;
+  bool initializeStaticMesh = true;
   {
     TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::SetupMesh)
     primData.pTilesetActor = pTilesetActor;
@@ -2946,18 +3509,67 @@ static void loadPrimitiveGameThreadPart(
         pGltf->CustomDepthParameters.CustomDepthStencilWriteMask);
     pMesh->SetCustomDepthStencilValue(
         pGltf->CustomDepthParameters.CustomDepthStencilValue);
-    if (loadResult.isUnlit) {
-      pMesh->bCastDynamicShadow = false;
-    }
+    // Set this for every use, because a component from the pool may have
+    // last been used for an unlit primitive.
+    pMesh->bCastDynamicShadow = !loadResult.isUnlit;
+
+    if (loadResult.pSharedMesh) {
+      // The first component to use a shared mesh creates its static mesh,
+      // which is owned by no component in particular.
+      pStaticMesh = loadResult.pSharedMesh->pStaticMesh;
+      if (pStaticMesh) {
+        initializeStaticMesh = false;
+      } else {
+        pStaticMesh = NewObject<UStaticMesh>(GetTransientPackage());
+        pStaticMesh->SetFlags(
+            RF_Transient | RF_DuplicateTransient | RF_TextExportTransient);
+        pStaticMesh->NeverStream = true;
+
+        CesiumSharedMesh& sharedMesh = *loadResult.pSharedMesh;
+        sharedMesh.MeshBytes =
+            CesiumStats::getRenderDataBytes(sharedMesh.RenderData.Get());
+        INC_MEMORY_STAT_BY(STAT_CesiumMeshMemory, sharedMesh.MeshBytes);
+        INC_MEMORY_STAT_BY(STAT_CesiumPhysicsMemory, sharedMesh.PhysicsBytes);
+
+        pStaticMesh->SetRenderData(MoveTemp(sharedMesh.RenderData));
+        sharedMesh.pStaticMesh = pStaticMesh;
+      }
 
-    pStaticMesh = NewObject<UStaticMesh>(pMesh, componentName);
-    pMesh->SetStaticMesh(pStaticMesh);
+      pMesh->SetStaticMesh(pStaticMesh);
+      primData.pSharedMesh = MoveTemp(loadResult.pSharedMesh);
+    } else {
+      // A component recycled from the pool still owns its (emptied) mesh.
+      pStaticMesh = pMesh->GetStaticMesh();
+      if (!pStaticMesh) {
+        pStaticMesh = NewObject<UStaticMesh>(pMesh, componentName);
+        pMesh->SetStaticMesh(pStaticMesh);
+      }
 
-    pStaticMesh->SetFlags(
-        RF_Transient | RF_DuplicateTransient | RF_TextExportTransient);
-    pStaticMesh->NeverStream = true;
+      pStaticMesh->SetFlags(
+          RF_Transient | RF_DuplicateTransient | RF_TextExportTransient);
+      pStaticMesh->NeverStream = true;
 
-    pStaticMesh->SetRenderData(std::move(loadResult.RenderData));
+      primData.addMemory(
+          CesiumStats::getRenderDataBytes(loadResult.RenderData.Get()),
+          loadResult.collisionMeshBytes);
+      pStaticMesh->SetRenderData(std::move(loadResult.RenderData));
+    }
+  }
+
+  if (loadResult.collisionOnly) {
+    // The primitive is never drawn, so it gets no material and no render
+    // resources. Its bounds come from the collision geometry instead.
+    moveFeaturesMetadata(primData, loadResult, *pGltf);
+    pStaticMesh->SetExtendedBounds(loadResult.collisionBounds);
+    pMesh->SetCastShadow(false);
+    finishPrimitiveComponent(
+        pGltf,
+        pMesh,
+        pStaticMesh,
+        primData,
+        loadResult,
+        createNavCollision);
+    return;
   }
 
   const CesiumGltf::Material& material =
@@ -2999,10 +3611,17 @@ static void loadPrimitiveGameThreadPart(
   {
     TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::SetupMaterial)
 
-    pMaterial = UMaterialInstanceDynamic::Create(
-        pBaseMaterial,
-        nullptr,
-        ImportedSlotName);
+    pMaterial =
+        pObjectPool ? pObjectPool->acquireMaterial(pBaseMaterial) : nullptr;
+    if (!pMaterial) {
+      pMaterial = UMaterialInstanceDynamic::Create(
+          pBaseMaterial,
+          nullptr,
+          ImportedSlotName);
+      if (pObjectPool) {
+        pObjectPool->recordMaterialCreated();
+      }
+    }
 
     pMaterial->SetFlags(
         RF_Transient | RF_DuplicateTransient | RF_TextExportTransient);
@@ -3115,84 +3734,59 @@ static void loadPrimitiveGameThreadPart(
     }
   }
 
-  primData.Features = std::move(loadResult.Features);
-  primData.Metadata = std::move(loadResult.Metadata);
-
-  primData.EncodedFeatures = std::move(loadResult.EncodedFeatures);
-  primData.EncodedMetadata = std::move(loadResult.EncodedMetadata);
-
-  PRAGMA_DISABLE_DEPRECATION_WARNINGS
-
-  // Doing the above std::move operations invalidates the pointers in the
-  // FCesiumMetadataPrimitive constructed on the loadResult. It's a bit
-  // awkward, but we have to reconstruct the metadata primitive here.
-  primData.Metadata_DEPRECATED = FCesiumMetadataPrimitive{
-      primData.Features,
-      primData.Metadata,
-      pGltf->Metadata};
-
-  if (loadResult.EncodedMetadata_DEPRECATED) {
-    primData.EncodedMetadata_DEPRECATED =
-        std::move(loadResult.EncodedMetadata_DEPRECATED);
+  moveFeaturesMetadata(primData, loadResult, *pGltf);
+
+  for (const TUniquePtr<CesiumTextureUtility::LoadedTextureResult>* ppTexture :
+       {&loadResult.baseColorTexture,
+        &loadResult.metallicRoughnessTexture,
+        &loadResult.normalTexture,
+        &loadResult.emissiveTexture,
+        &loadResult.occlusionTexture,
+        &loadResult.waterMaskTexture}) {
+    UTexture2D* pTexture = *ppTexture && (*ppTexture)->pTexture
+                               ? (*ppTexture)->pTexture->getUnrealTexture()
+                               : nullptr;
+    if (pTexture) {
+      pGltf->TileTextures.AddUnique(pTexture);
+    }
   }
 
-  PRAGMA_ENABLE_DEPRECATION_WARNINGS
-
   pMaterial->TwoSided = true;
 
-  pStaticMesh->AddMaterial(pMaterial);
-
-  pStaticMesh->SetLightingGuid();
-
-  {
-    TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::InitResources)
-    pStaticMesh->InitResources();
+  if (primData.pSharedMesh) {
+    // Each component renders a shared mesh with its own material, so the
+    // mesh's slot only holds the base material.
+    if (initializeStaticMesh) {
+      pStaticMesh->AddMaterial(pBaseMaterial);
+    }
+    pMesh->SetMaterial(0, pMaterial);
+  } else {
+    pStaticMesh->AddMaterial(pMaterial);
   }
+  primData.FadeParameters = pGltf->getFadeParameters(pBaseMaterial);
+  pGltf->InitializeFade(pMesh, primData.FadeParameters);
 
-  // Set up RenderData bounds and LOD data
-  pStaticMesh->CalculateExtendedBounds();
-  pStaticMesh->GetRenderData()->ScreenSize[0].Default = 1.0f;
-
-  {
-    TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::BodySetup)
-
-    pStaticMesh->CreateBodySetup();
-
-    UBodySetup* pBodySetup = pMesh->GetBodySetup();
-
-    // pMesh->UpdateCollisionFromStaticMesh();
-    pBodySetup->CollisionTraceFlag =
-        ECollisionTraceFlag::CTF_UseComplexAsSimple;
+  if (initializeStaticMesh) {
+    pStaticMesh->SetLightingGuid();
 
-    if (loadResult.pCollisionMesh) {
-#if ENGINE_VERSION_5_4_OR_HIGHER
-      pBodySetup->TriMeshGeometries.Add(loadResult.pCollisionMesh);
-#else
-      pBodySetup->ChaosTriMeshes.Add(loadResult.pCollisionMesh);
-#endif
+    {
+      TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::InitResources)
+      pStaticMesh->InitResources();
     }
 
-    // Mark physics meshes created, no matter if we actually have a collision
-    // mesh or not. We don't want the editor creating collision meshes itself in
-    // the game thread, because that would be slow.
-    pBodySetup->bCreatedPhysicsMeshes = true;
-    pBodySetup->bSupportUVsAndFaceRemap =
-        UPhysicsSettings::Get()->bSupportUVFromHitResults;
+    // Set up RenderData bounds and LOD data
+    pStaticMesh->CalculateExtendedBounds();
+    pStaticMesh->GetRenderData()->ScreenSize[0].Default = 1.0f;
   }
 
-  if (createNavCollision) {
-    TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::CreateNavCollision)
-    pStaticMesh->CreateNavCollision(true);
-  }
-
-  pMesh->SetMobility(pGltf->Mobility);
-
-  pMesh->SetupAttachment(pGltf);
-
-  {
-    TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::RegisterComponent)
-    pMesh->RegisterComponent();
-  }
+  finishPrimitiveComponent(
+      pGltf,
+      pMesh,
+      pStaticMesh,
+      primData,
+      loadResult,
+      createNavCollision,
+      initializeStaticMesh);
 }
 
 /*static*/ CesiumAsync::Future<UCesiumGltfComponent::CreateOffGameThreadResult>
@@ -3218,7 +3812,8 @@ UCesiumGltfComponent::CreateOffGameThread(
     UMaterialInterface* pBaseWaterMaterial,
     FCustomDepthParameters CustomDepthParameters,
     const Cesium3DTilesSelection::Tile& tile,
-    bool createNavCollision) {
+    bool createNavCollision,
+    UCesiumTileObjectPool* pObjectPool) {
   TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::LoadModel)
 
   HalfConstructedReal* pReal =
@@ -3255,6 +3850,14 @@ UCesiumGltfComponent::CreateOffGameThread(
 
   encodeModelMetadataGameThreadPart(Gltf->EncodedMetadata);
 
+  // The style was evaluated in the load thread, unless it has changed since.
+  const CesiumStyle::Style* pStyle = pTilesetActor->GetCompiledStyle();
+  if (pStyle == pReal->loadModelResult.pStyle.get()) {
+    Gltf->createStyleTextures(MoveTemp(pReal->loadModelResult.StyleColors));
+  } else {
+    Gltf->UpdateStyle(pStyle);
+  }
+
   if (Gltf->EncodedMetadata_DEPRECATED) {
     encodeMetadataGameThreadPart(*Gltf->EncodedMetadata_DEPRECATED);
   }
@@ -3270,6 +3873,7 @@ UCesiumGltfComponent::CreateOffGameThread(
             tile,
             createNavCollision,
             pTilesetActor,
+            pObjectPool,
             node.InstanceTransforms);
       }
     }
@@ -3353,6 +3957,53 @@ void forEachPrimitiveComponent(UCesiumGltfComponent* pGltf, Func&& f) {
 
 } // namespace
 
+namespace {
+
+CesiumOverlayParameters& getOverlayParameters(
+    CesiumPrimitiveData& primData,
+    const UCesiumMaterialUserData* pCesiumData,
+    const std::string& overlayName) {
+  auto [it, added] = primData.OverlayParameters.try_emplace(overlayName);
+  CesiumOverlayParameters& parameters = it->second;
+  if (!added) {
+    return parameters;
+  }
+
+  // If this material uses material layers and has the Cesium user data, the
+  // overlay maps to each material layer with its name.
+  if (pCesiumData) {
+    FString name(UTF8_TO_TCHAR(overlayName.c_str()));
+    for (int32 i = 0; i < pCesiumData->LayerNames.Num(); ++i) {
+      if (pCesiumData->LayerNames[i] != name) {
+        continue;
+      }
+
+      parameters.Texture.Emplace(
+          "Texture",
+          EMaterialParameterAssociation::LayerParameter,
+          i);
+      parameters.TranslationScale.Emplace(
+          "TranslationScale",
+          EMaterialParameterAssociation::LayerParameter,
+          i);
+      parameters.TextureCoordinateIndex.Emplace(
+          "TextureCoordinateIndex",
+          EMaterialParameterAssociation::LayerParameter,
+          i);
+    }
+  } else {
+    parameters.Texture.Emplace(createSafeName(overlayName, "_Texture"));
+    parameters.TranslationScale.Emplace(
+        createSafeName(overlayName, "_TranslationScale"));
+    parameters.TextureCoordinateIndex.Emplace(
+        createSafeName(overlayName, "_TextureCoordinateIndex"));
+  }
+
+  return parameters;
+}
+
+} // namespace
+
 void UCesiumGltfComponent::AttachRasterTile(
     const Cesium3DTilesSelection::Tile& tile,
     const CesiumRasterOverlays::RasterOverlayTile& rasterTile,
@@ -3361,65 +4012,46 @@ void UCesiumGltfComponent::AttachRasterTile(
     const glm::dvec2& scale,
     int32 textureCoordinateID) {
   FVector4 translationAndScale(translation.x, translation.y, scale.x, scale.y);
+  const std::string& overlayName = rasterTile.getOverlay().getName();
+
+  if (pTexture) {
+    this->TileTextures.AddUnique(pTexture);
+  }
 
   forEachPrimitiveComponent(
       this,
-      [&rasterTile, pTexture, &translationAndScale, textureCoordinateID](
+      [&overlayName, pTexture, &translationAndScale, textureCoordinateID](
           UCesiumGltfPrimitiveComponent* pPrimitive,
           UMaterialInstanceDynamic* pMaterial,
           UCesiumMaterialUserData* pCesiumData) {
         CesiumPrimitiveData& primData = pPrimitive->getPrimitiveData();
-        // If this material uses material layers and has the Cesium user data,
-        // set the parameters on each material layer that maps to this overlay
-        // tile.
-        if (pCesiumData) {
-          FString name(
-              UTF8_TO_TCHAR(rasterTile.getOverlay().getName().c_str()));
-
-          for (int32 i = 0; i < pCesiumData->LayerNames.Num(); ++i) {
-            if (pCesiumData->LayerNames[i] != name) {
-              continue;
-            }
+        CesiumOverlayParameters& parameters =
+            getOverlayParameters(primData, pCesiumData, overlayName);
+        if (parameters.Texture.IsEmpty()) {
+          return;
+        }
+
+        check(
+            textureCoordinateID >= 0 &&
+            textureCoordinateID <
+                primData.overlayTextureCoordinateIDToUVIndex.size());
+        const float textureCoordinateIndex = static_cast<float>(
+            primData.overlayTextureCoordinateIDToUVIndex[textureCoordinateID]);
 
-            pMaterial->SetTextureParameterValueByInfo(
-                FMaterialParameterInfo(
-                    "Texture",
-                    EMaterialParameterAssociation::LayerParameter,
-                    i),
-                pTexture);
-            pMaterial->SetVectorParameterValueByInfo(
-                FMaterialParameterInfo(
-                    "TranslationScale",
-                    EMaterialParameterAssociation::LayerParameter,
-                    i),
-                translationAndScale);
-            check(
-                textureCoordinateID >= 0 &&
-                textureCoordinateID <
-                    primData.overlayTextureCoordinateIDToUVIndex.size());
+        for (const FMaterialParameterInfo& info : parameters.Texture) {
+          pMaterial->SetTextureParameterValueByInfo(info, pTexture);
+        }
+        for (const FMaterialParameterInfo& info : parameters.TranslationScale) {
+          pMaterial->SetVectorParameterValueByInfo(info, translationAndScale);
+        }
+        if (parameters.LastTextureCoordinateIndex != textureCoordinateIndex) {
+          for (const FMaterialParameterInfo& info :
+               parameters.TextureCoordinateIndex) {
             pMaterial->SetScalarParameterValueByInfo(
-                FMaterialParameterInfo(
-                    "TextureCoordinateIndex",
-                    EMaterialParameterAssociation::LayerParameter,
-                    i),
-                static_cast<float>(primData.overlayTextureCoordinateIDToUVIndex
-                                       [textureCoordinateID]));
+                info,
+                textureCoordinateIndex);
           }
-        } else {
-          pMaterial->SetTextureParameterValue(
-              createSafeName(rasterTile.getOverlay().getName(), "_Texture"),
-              pTexture);
-          pMaterial->SetVectorParameterValue(
-              createSafeName(
-                  rasterTile.getOverlay().getName(),
-                  "_TranslationScale"),
-              translationAndScale);
-          pMaterial->SetScalarParameterValue(
-              createSafeName(
-                  rasterTile.getOverlay().getName(),
-                  "_TextureCoordinateIndex"),
-              static_cast<float>(primData.overlayTextureCoordinateIDToUVIndex
-                                     [textureCoordinateID]));
+          parameters.LastTextureCoordinateIndex = textureCoordinateIndex;
         }
       });
 }
@@ -3428,33 +4060,23 @@ void UCesiumGltfComponent::DetachRasterTile(
     const Cesium3DTilesSelection::Tile& tile,
     const CesiumRasterOverlays::RasterOverlayTile& rasterTile,
     UTexture2D* pTexture) {
+  const std::string& overlayName = rasterTile.getOverlay().getName();
+
+  this->TileTextures.Remove(pTexture);
+
   forEachPrimitiveComponent(
       this,
-      [this, &rasterTile, pTexture](
+      [this, &overlayName](
           UCesiumGltfPrimitiveComponent* pPrimitive,
           UMaterialInstanceDynamic* pMaterial,
           UCesiumMaterialUserData* pCesiumData) {
-        // If this material uses material layers and has the Cesium user data,
-        // clear the parameters on each material layer that maps to this
-        // overlay tile.
-        if (pCesiumData) {
-          FString name(
-              UTF8_TO_TCHAR(rasterTile.getOverlay().getName().c_str()));
-          for (int32 i = 0; i < pCesiumData->LayerNames.Num(); ++i) {
-            if (pCesiumData->LayerNames[i] != name) {
-              continue;
-            }
-
-            pMaterial->SetTextureParameterValueByInfo(
-                FMaterialParameterInfo(
-                    "Texture",
-                    EMaterialParameterAssociation::LayerParameter,
-                    i),
-                this->Transparent1x1);
-          }
-        } else {
-          pMaterial->SetTextureParameterValue(
-              createSafeName(rasterTile.getOverlay().getName(), "_Texture"),
+        CesiumOverlayParameters& parameters = getOverlayParameters(
+            pPrimitive->getPrimitiveData(),
+            pCesiumData,
+            overlayName);
+        for (const FMaterialParameterInfo& info : parameters.Texture) {
+          pMaterial->SetTextureParameterValueByInfo(
+              info,
               this->Transparent1x1);
         }
       });
@@ -3485,104 +4107,234 @@ void UCesiumGltfComponent::BeginDestroy() {
   Super::BeginDestroy();
 }
 
-void UCesiumGltfComponent::UpdateFade(float fadePercentage, bool fadingIn) {
-  if (!this->IsVisible()) {
-    return;
+const CesiumFadeParameters&
+UCesiumGltfComponent::getFadeParameters(UMaterialInterface* pBaseMaterial) {
+  CesiumFadeParameters* pParameters = this->_fadeParameters.Find(pBaseMaterial);
+  if (!pParameters) {
+    pParameters = &this->_fadeParameters.Add(
+        pBaseMaterial,
+        CesiumFadeParameters::resolve(pBaseMaterial));
   }
+  return *pParameters;
+}
 
-  UCesiumMaterialUserData* pCesiumData =
-      BaseMaterial->GetAssetUserData<UCesiumMaterialUserData>();
+void UCesiumGltfComponent::InitializeFade(
+    UPrimitiveComponent* pPrimitive,
+    const CesiumFadeParameters& fade) const {
+  // Pooled primitives may still hold the fade of the tile they last rendered.
+  if (fade.FadePercentageDataIndex >= 0) {
+    pPrimitive->SetCustomPrimitiveDataFloat(fade.FadePercentageDataIndex, 1.0f);
+  }
+  if (fade.FadingTypeDataIndex >= 0) {
+    pPrimitive->SetCustomPrimitiveDataFloat(fade.FadingTypeDataIndex, 0.0f);
+  }
+}
 
-  if (!pCesiumData) {
-    return;
+namespace {
+UTexture2D* createStyleTexture(int32 textureDimension, const FColor* pColors) {
+  UTexture2D* pTexture = UTexture2D::CreateTransient(
+      textureDimension,
+      textureDimension,
+      PF_B8G8R8A8);
+  pTexture->Filter = TextureFilter::TF_Nearest;
+  pTexture->AddressX = TextureAddress::TA_Clamp;
+  pTexture->AddressY = TextureAddress::TA_Clamp;
+  pTexture->SRGB = true;
+
+  FTexture2DMipMap& mip = pTexture->GetPlatformData()->Mips[0];
+  void* pData = mip.BulkData.Lock(LOCK_READ_WRITE);
+  FMemory::Memcpy(
+      pData,
+      pColors,
+      textureDimension * textureDimension * sizeof(FColor));
+  mip.BulkData.Unlock();
+  pTexture->UpdateResource();
+  return pTexture;
+}
+
+/**
+ * Gets the style texture of property tables without a style. It shows every
+ * feature in white, and is shared by every glTF for the rest of the session.
+ */
+UTexture2D* getDefaultStyleTexture() {
+  static UTexture2D* pTexture = nullptr;
+  if (!pTexture) {
+    const FColor white = FColor::White;
+    pTexture = createStyleTexture(1, &white);
+    pTexture->AddToRoot();
   }
+  return pTexture;
+}
+} // namespace
 
-  int fadeLayerIndex = pCesiumData->LayerNames.Find("DitherFade");
-  if (fadeLayerIndex < 0) {
+void UCesiumGltfComponent::UpdateStyle(const CesiumStyle::Style* pStyle) {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::UpdateStyle)
+
+  if (!pStyle) {
+    if (!this->StyleTextures.IsEmpty()) {
+      this->StyleTextures.Empty();
+      this->bindStyleTextures();
+    }
     return;
   }
 
-  fadePercentage = glm::clamp(fadePercentage, 0.0f, 1.0f);
+  this->createStyleTextures(
+      evaluateStyle(*pStyle, this->Metadata, this->EncodedMetadata));
+}
 
-  for (USceneComponent* pChild : this->GetAttachChildren()) {
-    UCesiumGltfPrimitiveComponent* pPrimitive =
-        Cast<UCesiumGltfPrimitiveComponent>(pChild);
-    if (!pPrimitive || pPrimitive->GetMaterials().IsEmpty()) {
+void UCesiumGltfComponent::createStyleTextures(
+    TMap<FString, TArray<FColor>>&& styleColors) {
+  // Property tables that are no longer evaluated per feature, because the
+  // style now runs in the material, fall back to the default white texture.
+  const int32 removedCount = this->StyleTextures.Num();
+  for (auto it = this->StyleTextures.CreateIterator(); it; ++it) {
+    if (!styleColors.Contains(it.Key())) {
+      it.RemoveCurrent();
+    }
+  }
+  bool texturesReplaced = removedCount != this->StyleTextures.Num();
+
+  for (TPair<FString, TArray<FColor>>& pair : styleColors) {
+    TArray<FColor>& colors = pair.Value;
+    const int32 textureDimension =
+        int32(glm::sqrt(double(colors.Num())) + 0.5);
+    if (textureDimension <= 0 ||
+        textureDimension * textureDimension != colors.Num()) {
       continue;
     }
 
-    UMaterialInstanceDynamic* pMaterial =
-        Cast<UMaterialInstanceDynamic>(pPrimitive->GetMaterials()[0]);
-    if (!pMaterial) {
+    UTexture2D*& pTexture = this->StyleTextures.FindOrAdd(pair.Key, nullptr);
+    if (!pTexture || pTexture->GetSizeX() != textureDimension) {
+      pTexture = createStyleTexture(textureDimension, colors.GetData());
+      texturesReplaced = true;
       continue;
     }
 
-    pMaterial->SetScalarParameterValueByInfo(
-        FMaterialParameterInfo(
-            "FadePercentage",
-            EMaterialParameterAssociation::LayerParameter,
-            fadeLayerIndex),
-        fadePercentage);
-    pMaterial->SetScalarParameterValueByInfo(
-        FMaterialParameterInfo(
-            "FadingType",
-            EMaterialParameterAssociation::LayerParameter,
-            fadeLayerIndex),
-        fadingIn ? 0.0f : 1.0f);
+    // Restyling only uploads new texels. The materials keep referencing the
+    // same texture, so no material parameters change.
+    TArray<FColor>* pPixels = new TArray<FColor>(MoveTemp(colors));
+    FUpdateTextureRegion2D* pRegion = new FUpdateTextureRegion2D(
+        0,
+        0,
+        0,
+        0,
+        textureDimension,
+        textureDimension);
+    pTexture->UpdateTextureRegions(
+        0,
+        1,
+        pRegion,
+        textureDimension * sizeof(FColor),
+        sizeof(FColor),
+        reinterpret_cast<uint8*>(pPixels->GetData()),
+        [pPixels](uint8* pSrcData, const FUpdateTextureRegion2D* pRegions) {
+          delete pPixels;
+          delete pRegions;
+        });
   }
-}
 
-template <typename TIndex>
-#if ENGINE_VERSION_5_4_OR_HIGHER
-static Chaos::FTriangleMeshImplicitObjectPtr
-#else
-static TSharedPtr<Chaos::FTriangleMeshImplicitObject, ESPMode::ThreadSafe>
-#endif
-BuildChaosTriangleMeshes(
-    const TArray<FStaticMeshBuildVertex>& vertexData,
-    const TArray<uint32>& indices) {
-  int32 vertexCount = vertexData.Num();
-  Chaos::TParticles<Chaos::FRealSingle, 3> vertices;
-  vertices.AddParticles(vertexCount);
-  for (int32 i = 0; i < vertexCount; ++i) {
-    vertices.X(i) = vertexData[i].Position;
+  if (texturesReplaced) {
+    this->bindStyleTextures();
   }
+}
+
+void UCesiumGltfComponent::bindStyleTextures() {
+  forEachPrimitiveComponent(
+      this,
+      [this](
+          UCesiumGltfPrimitiveComponent* pPrimitive,
+          UMaterialInstanceDynamic* pMaterial,
+          UCesiumMaterialUserData* pCesiumData) {
+        const int32 index =
+            pCesiumData ? pCesiumData->LayerNames.Find("FeaturesMetadata")
+                        : INDEX_NONE;
+        if (index < 0) {
+          return;
+        }
 
-  int32 triangleCount = indices.Num() / 3;
-  TArray<Chaos::TVector<TIndex, 3>> triangles;
-  triangles.Reserve(triangleCount);
-  TArray<int32> faceRemap;
-  faceRemap.Reserve(triangleCount);
+        for (const CesiumEncodedFeaturesMetadata::EncodedPropertyTable&
+                 propertyTable : this->EncodedMetadata.propertyTables) {
+          pMaterial->SetTextureParameterValueByInfo(
+              FMaterialParameterInfo(
+                  FName(CesiumEncodedFeaturesMetadata::
+                            getMaterialNameForPropertyTableStyle(
+                                propertyTable.name)),
+                  EMaterialParameterAssociation::LayerParameter,
+                  index),
+              this->GetStyleTexture(propertyTable.name));
+        }
+      });
+}
 
-  for (int32 i = 0; i < triangleCount; ++i) {
-    const int32 index0 = 3 * i;
-    int32 vIndex0 = indices[index0 + 1];
-    int32 vIndex1 = indices[index0];
-    int32 vIndex2 = indices[index0 + 2];
+UTexture2D*
+UCesiumGltfComponent::GetStyleTexture(const FString& PropertyTableName) const {
+  UTexture2D* const* ppTexture = this->StyleTextures.Find(PropertyTableName);
+  return ppTexture ? *ppTexture : getDefaultStyleTexture();
+}
 
-    triangles.Add(Chaos::TVector<int32, 3>(vIndex0, vIndex1, vIndex2));
-    faceRemap.Add(i);
+void UCesiumGltfComponent::UpdateFade(float fadePercentage, bool fadingIn) {
+  if (!this->IsVisible()) {
+    return;
   }
 
-  TUniquePtr<TArray<int32>> pFaceRemap = MakeUnique<TArray<int32>>(faceRemap);
-  TArray<uint16> materials;
-  materials.SetNum(triangles.Num());
+  fadePercentage = glm::clamp(fadePercentage, 0.0f, 1.0f);
+  const float fadingType = fadingIn ? 0.0f : 1.0f;
 
-#if ENGINE_VERSION_5_4_OR_HIGHER
-  return new Chaos::FTriangleMeshImplicitObject(
-      MoveTemp(vertices),
-      MoveTemp(triangles),
-      MoveTemp(materials),
-      MoveTemp(pFaceRemap),
-      nullptr,
-      false);
-#else
-  return MakeShared<Chaos::FTriangleMeshImplicitObject, ESPMode::ThreadSafe>(
-      MoveTemp(vertices),
-      MoveTemp(triangles),
-      MoveTemp(materials),
-      MoveTemp(pFaceRemap),
-      nullptr,
-      false);
-#endif
+  for (USceneComponent* pChild : this->GetAttachChildren()) {
+    UCesiumGltfPrimitiveComponent* pPrimitive =
+        Cast<UCesiumGltfPrimitiveComponent>(pChild);
+    if (!pPrimitive) {
+      continue;
+    }
+
+    // The primitives of one glTF may use different base materials, such as
+    // the translucent or water ones, which bind the fade differently.
+    const CesiumFadeParameters& fade =
+        pPrimitive->getPrimitiveData().FadeParameters;
+    if (!fade.fades()) {
+      continue;
+    }
+
+    // Custom primitive data is uploaded with the primitive's scene data, so
+    // setting it does not invalidate the cached mesh draw commands the way a
+    // material parameter change does.
+    if (fade.FadePercentageDataIndex >= 0) {
+      pPrimitive->SetCustomPrimitiveDataFloat(
+          fade.FadePercentageDataIndex,
+          fadePercentage);
+    }
+    if (fade.FadingTypeDataIndex >= 0) {
+      pPrimitive->SetCustomPrimitiveDataFloat(
+          fade.FadingTypeDataIndex,
+          fadingType);
+    }
+
+    if (!fade.usesMaterialParameters() ||
+        pPrimitive->GetMaterials().IsEmpty()) {
+      continue;
+    }
+
+    UMaterialInstanceDynamic* pMaterial =
+        Cast<UMaterialInstanceDynamic>(pPrimitive->GetMaterials()[0]);
+    if (!pMaterial) {
+      continue;
+    }
+
+    if (fade.FadePercentageDataIndex < 0) {
+      pMaterial->SetScalarParameterValueByInfo(
+          FMaterialParameterInfo(
+              "FadePercentage",
+              EMaterialParameterAssociation::LayerParameter,
+              fade.LayerIndex),
+          fadePercentage);
+    }
+    if (fade.FadingTypeDataIndex < 0) {
+      pMaterial->SetScalarParameterValueByInfo(
+          FMaterialParameterInfo(
+              "FadingType",
+              EMaterialParameterAssociation::LayerParameter,
+              fade.LayerIndex),
+          fadingType);
+    }
+  }
 }
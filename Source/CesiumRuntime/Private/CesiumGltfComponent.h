@@ -6,6 +6,7 @@
 #include "Cesium3DTileset.h"
 #include "CesiumEncodedFeaturesMetadata.h"
 #include "CesiumEncodedMetadataUtility.h"
+#include "CesiumFadeParameters.h"
 #include "CesiumModelMetadata.h"
 #include "Components/PrimitiveComponent.h"
 #include "Components/SceneComponent.h"
@@ -20,6 +21,7 @@
 class UMaterialInterface;
 class UTexture2D;
 class UStaticMeshComponent;
+class UCesiumTileObjectPool;
 
 namespace CreateGltfOptions {
 struct CreateModelOptions;
@@ -41,6 +43,10 @@ namespace CesiumGeometry {
 struct Rectangle;
 }
 
+namespace CesiumStyle {
+class Style;
+}
+
 USTRUCT()
 struct FRasterOverlayTile {
   GENERATED_BODY()
@@ -88,7 +94,8 @@ public:
       UMaterialInterface* BaseWaterMaterial,
       FCustomDepthParameters CustomDepthParameters,
       const Cesium3DTilesSelection::Tile& tile,
-      bool createNavCollision);
+      bool createNavCollision,
+      UCesiumTileObjectPool* ObjectPool);
 
   UCesiumGltfComponent();
 
@@ -112,6 +119,13 @@ public:
       EncodedMetadata_DEPRECATED = std::nullopt;
   PRAGMA_ENABLE_DEPRECATION_WARNINGS
 
+  /**
+   * The textures sampled by the primitives of this glTF, including those of
+   * attached raster overlay tiles. The texture mip streamer uses these to find
+   * how large each texture appears on screen.
+   */
+  TArray<TWeakObjectPtr<UTexture2D>> TileTextures;
+
   void UpdateTransformFromCesium(const glm::dmat4& CesiumToUnrealTransform);
 
   void AttachRasterTile(
@@ -134,7 +148,66 @@ public:
 
   void UpdateFade(float fadePercentage, bool fadingIn);
 
+  /**
+   * Resets the custom primitive data of a primitive of this glTF to fully
+   * visible, for the fade parameters of its base material that are bound to
+   * custom primitive data.
+   */
+  void InitializeFade(
+      UPrimitiveComponent* pPrimitive,
+      const CesiumFadeParameters& fade) const;
+
+  /**
+   * Gets how the fade reaches the DitherFade layer of one of this glTF's base
+   * materials. Each base material is resolved once, when the first primitive
+   * that uses it is created, so that fading does not need to look them up
+   * every frame.
+   */
+  const CesiumFadeParameters&
+  getFadeParameters(UMaterialInterface* pBaseMaterial);
+
+  /**
+   * Evaluates a style for the features of each encoded property table of this
+   * glTF, and writes the colors to the property table's style texture. If the
+   * style is nullptr, the property tables go back to the shared default style
+   * texture, in which every feature is white.
+   *
+   * Newly loaded tiles are styled in the load thread, so this is only needed
+   * when the style changes.
+   */
+  void UpdateStyle(const CesiumStyle::Style* pStyle);
+
+  /**
+   * Gets the style texture of an encoded property table, or the shared
+   * default style texture if it does not have one.
+   */
+  UTexture2D* GetStyleTexture(const FString& PropertyTableName) const;
+
 private:
+  /**
+   * Uploads the style colors of each property table, as evaluated by
+   * UpdateStyle or in the load thread. Textures of the right size are updated
+   * in place; otherwise new textures are created and bound to the materials.
+   */
+  void createStyleTextures(TMap<FString, TArray<FColor>>&& styleColors);
+
+  /**
+   * Binds the style texture of each property table to the materials of this
+   * glTF's primitives.
+   */
+  void bindStyleTextures();
+
   UPROPERTY()
   UTexture2D* Transparent1x1 = nullptr;
+
+  /**
+   * The style textures of the encoded property tables, by property table
+   * name. Each texel holds the styled color of one feature.
+   */
+  UPROPERTY()
+  TMap<FString, UTexture2D*> StyleTextures;
+
+  // Only used to identify the base materials, which are held by the
+  // properties above.
+  TMap<UMaterialInterface*, CesiumFadeParameters> _fadeParameters;
 };
@@ -37,6 +37,8 @@ void destroyCesiumPrimitive(UStaticMeshComponent* pComponent) {
   // UObject might not actually get deleted by the garbage collector until
   // much later.
   auto* cesiumPrimitive = Cast<ICesiumPrimitive>(pComponent);
+  const bool hasSharedMesh =
+      cesiumPrimitive->getPrimitiveData().pSharedMesh.IsValid();
   cesiumPrimitive->getPrimitiveData().destroy();
   UMaterialInstanceDynamic* pMaterial =
       Cast<UMaterialInstanceDynamic>(pComponent->GetMaterial(0));
@@ -44,8 +46,9 @@ void destroyCesiumPrimitive(UStaticMeshComponent* pComponent) {
     CesiumLifetime::destroy(pMaterial);
   }
 
+  // A shared mesh belongs to the mesh depot, not to this component.
   UStaticMesh* pMesh = pComponent->GetStaticMesh();
-  if (pMesh) {
+  if (pMesh && !hasSharedMesh) {
     UBodySetup* pBodySetup = pMesh->GetBodySetup();
 
     if (pBodySetup) {
@@ -92,6 +95,9 @@ FBoxSphereBounds UCesiumGltfPrimitiveComponent::CalcBounds(
 
 FBoxSphereBounds UCesiumGltfInstancedComponent::CalcBounds(
     const FTransform& LocalToWorld) const {
+  if (this->RendersAggregatedInstances) {
+    return Super::CalcBounds(LocalToWorld);
+  }
   if (auto bounds = calcBounds(*this, LocalToWorld)) {
     return *bounds;
   }
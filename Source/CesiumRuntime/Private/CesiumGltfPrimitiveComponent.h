@@ -62,6 +62,26 @@ public:
   CesiumPrimitiveData& getPrimitiveData() override;
   const CesiumPrimitiveData& getPrimitiveData() const override;
 
+  /**
+   * The content hash of this primitive when its instances are rendered
+   * together with those of identical primitives in other tiles, or 0 if they
+   * are not. See CesiumInstanceAggregator.
+   */
+  uint64 InstanceAggregationKey = 0;
+
+  /**
+   * The instances of this primitive's own tile, relative to this component.
+   * The component itself may render no instances, or those of several tiles.
+   */
+  TArray<FTransform> TileInstanceTransforms;
+
+  /**
+   * Whether this component currently renders the instances of other tiles, in
+   * which case its bounds are computed from its instances rather than from its
+   * tile's bounding volume.
+   */
+  bool RendersAggregatedInstances = false;
+
 private:
   CesiumPrimitiveData _cesiumData;
 };
@@ -0,0 +1,184 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumInstanceAggregator.h"
+#include "CesiumGltfComponent.h"
+#include "CesiumGltfPrimitiveComponent.h"
+#include <CesiumUtility/Tracing.h>
+
+void CesiumInstanceAggregator::addComponent(UCesiumGltfComponent* pGltf) {
+  if (!pGltf) {
+    return;
+  }
+
+  for (USceneComponent* pChild : pGltf->GetAttachChildren()) {
+    this->add(Cast<UCesiumGltfInstancedComponent>(pChild));
+  }
+}
+
+void CesiumInstanceAggregator::add(UCesiumGltfInstancedComponent* pComponent) {
+  if (!pComponent || pComponent->InstanceAggregationKey == 0) {
+    return;
+  }
+
+  Group& group = this->_groups.FindOrAdd(pComponent->InstanceAggregationKey);
+  group.components.AddUnique(pComponent);
+
+  // A component recycled from the tile object pool may already be in the
+  // group, but with new instances, so its old ones must be replaced.
+  if (group.pLeader.Get() == pComponent) {
+    group.pLeader.Reset();
+  } else if (
+      Member* pMember = group.members.FindByPredicate(
+          [pComponent](const Member& member) {
+            return member.pComponent == pComponent;
+          })) {
+    pMember->stale = true;
+  }
+}
+
+void CesiumInstanceAggregator::update() {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::AggregateInstances)
+
+  for (auto it = this->_groups.CreateIterator(); it; ++it) {
+    updateGroup(it.Key(), it.Value());
+    if (it.Value().components.IsEmpty()) {
+      it.RemoveCurrent();
+    }
+  }
+}
+
+int32 CesiumInstanceAggregator::getComponentCount() const {
+  int32 count = 0;
+  for (const auto& [key, group] : this->_groups) {
+    count += group.components.Num();
+  }
+  return count;
+}
+
+void CesiumInstanceAggregator::updateGroup(uint64 key, Group& group) {
+  // Components are recycled through the tile object pool, so a live component
+  // may have moved on to a different primitive.
+  group.components.RemoveAll(
+      [key](const TWeakObjectPtr<UCesiumGltfInstancedComponent>& pComponent) {
+        return !pComponent.IsValid() || !pComponent->IsRegistered() ||
+               pComponent->InstanceAggregationKey != key;
+      });
+
+  TArray<UCesiumGltfInstancedComponent*> visible;
+  for (const TWeakObjectPtr<UCesiumGltfInstancedComponent>& pComponent :
+       group.components) {
+    if (pComponent->IsVisible()) {
+      visible.Add(pComponent.Get());
+    }
+  }
+
+  UCesiumGltfInstancedComponent* pLeader = group.pLeader.Get();
+  if (!pLeader || !visible.Contains(pLeader)) {
+    rebuildGroup(group, visible);
+    return;
+  }
+
+  const TSet<UCesiumGltfInstancedComponent*> visibleSet(visible);
+
+  // Remove the instances of the members that were hidden, unloaded, or
+  // recycled. The leader keeps the order of the remaining instances.
+  TArray<int32> instancesToRemove;
+  TArray<Member> members;
+  members.Reserve(group.members.Num());
+  TSet<UCesiumGltfInstancedComponent*> memberSet;
+  int32 firstInstance = pLeader->TileInstanceTransforms.Num();
+  for (const Member& member : group.members) {
+    if (!member.stale && visibleSet.Contains(member.pComponent)) {
+      members.Add(member);
+      memberSet.Add(member.pComponent);
+    } else {
+      for (int32 i = 0; i < member.instanceCount; ++i) {
+        instancesToRemove.Add(firstInstance + i);
+      }
+    }
+    firstInstance += member.instanceCount;
+  }
+
+  // Append the instances of the components that were shown or reloaded.
+  TArray<FTransform> transforms;
+  for (UCesiumGltfInstancedComponent* pComponent : visible) {
+    if (pComponent == pLeader || memberSet.Contains(pComponent)) {
+      continue;
+    }
+
+    pComponent->RendersAggregatedInstances = false;
+    if (pComponent->GetInstanceCount() > 0) {
+      pComponent->ClearInstances();
+    }
+
+    appendRelativeTransforms(*pLeader, *pComponent, transforms);
+    members.Add(
+        Member{pComponent, pComponent->TileInstanceTransforms.Num(), false});
+  }
+
+  group.members = MoveTemp(members);
+  pLeader->RendersAggregatedInstances = !group.members.IsEmpty();
+
+  if (!instancesToRemove.IsEmpty()) {
+    pLeader->RemoveInstances(instancesToRemove);
+  }
+  if (!transforms.IsEmpty()) {
+    pLeader->AddInstances(transforms, false);
+  }
+}
+
+void CesiumInstanceAggregator::rebuildGroup(
+    Group& group,
+    const TArray<UCesiumGltfInstancedComponent*>& visible) {
+  UCesiumGltfInstancedComponent* pLeader =
+      visible.IsEmpty() ? nullptr : visible[0];
+  if (!pLeader && !group.pLeader.IsValid() && group.members.IsEmpty()) {
+    // Nothing was rendered for this group, and nothing is visible.
+    return;
+  }
+
+  group.pLeader = pLeader;
+  group.members.Empty();
+
+  for (const TWeakObjectPtr<UCesiumGltfInstancedComponent>& pComponent :
+       group.components) {
+    if (pComponent.Get() == pLeader) {
+      continue;
+    }
+    pComponent->RendersAggregatedInstances = false;
+    if (pComponent->GetInstanceCount() > 0) {
+      pComponent->ClearInstances();
+    }
+  }
+
+  if (!pLeader) {
+    return;
+  }
+
+  TArray<FTransform> transforms = pLeader->TileInstanceTransforms;
+  for (UCesiumGltfInstancedComponent* pComponent : visible) {
+    if (pComponent != pLeader) {
+      appendRelativeTransforms(*pLeader, *pComponent, transforms);
+      group.members.Add(
+          Member{pComponent, pComponent->TileInstanceTransforms.Num(), false});
+    }
+  }
+
+  pLeader->RendersAggregatedInstances = !group.members.IsEmpty();
+  pLeader->ClearInstances();
+  pLeader->AddInstances(transforms, false);
+}
+
+void CesiumInstanceAggregator::appendRelativeTransforms(
+    const UCesiumGltfInstancedComponent& leader,
+    const UCesiumGltfInstancedComponent& component,
+    TArray<FTransform>& transforms) {
+  // All components of a tileset share the same Unreal frame, so the relative
+  // transforms are unaffected by origin shifts and georeference changes.
+  const FTransform& leaderTransform = leader.GetComponentTransform();
+  const FTransform& componentTransform = component.GetComponentTransform();
+  for (const FTransform& instance : component.TileInstanceTransforms) {
+    const FTransform world = instance * componentTransform;
+    transforms.Add(world.GetRelativeTransform(leaderTransform));
+  }
+}
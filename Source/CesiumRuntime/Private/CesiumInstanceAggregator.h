@@ -0,0 +1,99 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/WeakObjectPtr.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+
+class UCesiumGltfComponent;
+class UCesiumGltfInstancedComponent;
+
+/**
+ * Renders the instances of identical instanced primitives from different
+ * tiles of a tileset with a single component.
+ *
+ * Instanced primitives whose geometry and material have the same content hash
+ * form a group. One visible component of each group is its leader, which
+ * renders the instances of every visible component in the group, while the
+ * other components render none. Draw calls and instance buffers therefore
+ * scale with the number of distinct meshes instead of the number of tiles.
+ *
+ * The leader holds the instances of each other component in a contiguous
+ * range, so when tiles are shown or hidden, {@link update} only removes and
+ * adds the instances of those tiles. The instances of a group are only
+ * redistributed when its leader is hidden, unloaded, or reloaded.
+ *
+ * Because the leader's material is used for all instances of a group, only
+ * primitives without raster overlays or encoded features and metadata are
+ * aggregated.
+ */
+class CesiumInstanceAggregator {
+public:
+  /**
+   * Adds the instanced primitives of a newly created glTF component to the
+   * groups given by their InstanceAggregationKey.
+   */
+  void addComponent(UCesiumGltfComponent* pGltf);
+
+  /**
+   * Adds an instanced primitive to the group given by its
+   * InstanceAggregationKey. Primitives whose key is 0 are ignored.
+   */
+  void add(UCesiumGltfInstancedComponent* pComponent);
+
+  /**
+   * Updates the instances of the groups whose visible components have changed
+   * since the last update. This should be called after the visibility of the
+   * tileset's tiles has been updated for the frame.
+   */
+  void update();
+
+  /**
+   * Stops tracking all components. The components keep the instances they
+   * currently render.
+   */
+  void clear() { this->_groups.Empty(); }
+
+  /**
+   * Gets the number of groups of identical primitives.
+   */
+  int32 getGroupCount() const { return this->_groups.Num(); }
+
+  /**
+   * Gets the number of components in all groups.
+   */
+  int32 getComponentCount() const;
+
+private:
+  /**
+   * A component whose instances are rendered by the leader of its group.
+   */
+  struct Member {
+    // Only used to identify the component, which may have been destroyed or
+    // recycled since its instances were added.
+    UCesiumGltfInstancedComponent* pComponent;
+    int32 instanceCount;
+    // Whether the component was recycled with new instances.
+    bool stale;
+  };
+
+  struct Group {
+    TArray<TWeakObjectPtr<UCesiumGltfInstancedComponent>> components;
+    TWeakObjectPtr<UCesiumGltfInstancedComponent> pLeader;
+    // The members in the order of their instances in the leader, which follow
+    // the leader's own instances.
+    TArray<Member> members;
+  };
+
+  static void updateGroup(uint64 key, Group& group);
+  static void rebuildGroup(
+      Group& group,
+      const TArray<UCesiumGltfInstancedComponent*>& visible);
+  static void appendRelativeTransforms(
+      const UCesiumGltfInstancedComponent& leader,
+      const UCesiumGltfInstancedComponent& component,
+      TArray<FTransform>& transforms);
+
+  TMap<uint64, Group> _groups;
+};
@@ -1,14 +1,21 @@
 // Copyright 2020-2024 CesiumGS, Inc. and Contributors
 
 #include "CesiumLifetime.h"
+#include "CesiumGltfComponent.h"
+#include "CesiumPrimitive.h"
 #include "CesiumRuntime.h"
+#include "CesiumRuntimeSettings.h"
+#include "CesiumTileObjectPool.h"
 #if WITH_EDITOR
 #include "Editor.h"
 #include "Editor/EditorEngine.h"
 #include "Engine/Selection.h"
 #endif
+#include "Components/StaticMeshComponent.h"
 #include "Engine/StaticMesh.h"
 #include "Engine/Texture2D.h"
+#include "HAL/PlatformTime.h"
+#include "Materials/MaterialInstanceDynamic.h"
 #include "PhysicsEngine/BodySetup.h"
 #include "Runtime/Launch/Resources/Version.h"
 #include "StaticMeshResources.h"
@@ -22,6 +29,40 @@ AmortizedDestructor CesiumLifetime::amortizedDestructor = AmortizedDestructor();
   amortizedDestructor.destroy(pObject);
 }
 
+/*static*/ void CesiumLifetime::scheduleTileTeardown(
+    TileTeardownQueue& queue,
+    USceneComponent* pComponent,
+    UCesiumTileObjectPool* pPool) {
+  if (!pComponent) {
+    return;
+  }
+
+  // The tile's glTF model is freed as soon as this returns, so make sure
+  // nothing can render or hit this component in the meantime. This is the
+  // same cheap operation that is done when a tile is merely hidden.
+  pComponent->SetVisibility(false, true);
+  TArray<USceneComponent*> children;
+  pComponent->GetChildrenComponents(true, children);
+  for (USceneComponent* pChild : children) {
+    UPrimitiveComponent* pPrimitive = Cast<UPrimitiveComponent>(pChild);
+    if (pPrimitive) {
+      pPrimitive->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+    }
+
+    ICesiumPrimitive* pCesiumPrimitive = Cast<ICesiumPrimitive>(pChild);
+    if (pCesiumPrimitive) {
+      pCesiumPrimitive->getPrimitiveData().releaseModel();
+    }
+  }
+
+  UCesiumGltfComponent* pGltf = Cast<UCesiumGltfComponent>(pComponent);
+  if (pGltf) {
+    pGltf->Metadata = FCesiumModelMetadata();
+  }
+
+  queue.enqueue(pComponent, pPool);
+}
+
 /*static*/ void
 CesiumLifetime::destroyComponentRecursively(USceneComponent* pComponent) {
   TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::DestroyComponent)
@@ -59,6 +100,175 @@ CesiumLifetime::destroyComponentRecursively(USceneComponent* pComponent) {
   UE_LOG(LogCesium, VeryVerbose, TEXT("Destroying scene component done"));
 }
 
+TileTeardownQueue::~TileTeardownQueue() {
+  for (const PendingTeardown& teardown : this->_releaseRenderResources) {
+    this->releaseRenderResources(teardown);
+  }
+
+  // Static meshes wait for their render resources to be released before they
+  // are destroyed, so the objects can be released without waiting here.
+  for (const TArray<PendingTeardown>* pTeardowns :
+       {&this->_releaseObjects,
+        &this->_awaitingRenderThread,
+        &this->_releaseRenderResources}) {
+    for (const PendingTeardown& teardown : *pTeardowns) {
+      this->releaseObjects(teardown);
+    }
+  }
+}
+
+void TileTeardownQueue::Tick(float DeltaTime) {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::TileTeardown)
+
+  if (this->_releaseRenderResources.IsEmpty() &&
+      this->_awaitingRenderThread.IsEmpty() &&
+      this->_releaseObjects.IsEmpty()) {
+    return;
+  }
+
+  // Everything that was waiting for the render thread can now be destroyed or
+  // recycled. A newer fence always completes after an older one, so items
+  // from earlier frames are covered as well.
+  if (!this->_awaitingRenderThread.IsEmpty() &&
+      this->_renderThreadFence.IsFenceComplete()) {
+    this->_releaseObjects.Append(MoveTemp(this->_awaitingRenderThread));
+    this->_awaitingRenderThread.Reset();
+  }
+
+  const double budgetSeconds =
+      FMath::Max(
+          GetDefault<UCesiumRuntimeSettings>()->TileTeardownTimeBudget,
+          0.0f) /
+      1000.0;
+  const double startTime = FPlatformTime::Seconds();
+  auto withinBudget = [startTime, budgetSeconds]() {
+    return FPlatformTime::Seconds() - startTime < budgetSeconds;
+  };
+
+  // Always make some progress in each stage, no matter how small the budget,
+  // so that the queues cannot grow without bound.
+  int32 released = 0;
+  while (released < this->_releaseRenderResources.Num() &&
+         (released == 0 || withinBudget())) {
+    const PendingTeardown& teardown = this->_releaseRenderResources[released];
+    this->releaseRenderResources(teardown);
+    this->_awaitingRenderThread.Add(teardown);
+    ++released;
+  }
+
+  if (released > 0) {
+    this->_releaseRenderResources.RemoveAt(0, released);
+    this->_renderThreadFence.BeginFence();
+  }
+
+  int32 destroyed = 0;
+  while (destroyed < this->_releaseObjects.Num() &&
+         (destroyed == 0 || withinBudget())) {
+    this->releaseObjects(this->_releaseObjects[destroyed]);
+    ++destroyed;
+  }
+
+  if (destroyed > 0) {
+    this->_releaseObjects.RemoveAt(0, destroyed);
+  }
+}
+
+ETickableTickType TileTeardownQueue::GetTickableTickType() const {
+  return ETickableTickType::Always;
+}
+
+bool TileTeardownQueue::IsTickableWhenPaused() const { return true; }
+
+bool TileTeardownQueue::IsTickableInEditor() const { return true; }
+
+TStatId TileTeardownQueue::GetStatId() const { return TStatId(); }
+
+void TileTeardownQueue::enqueue(
+    USceneComponent* pComponent,
+    UCesiumTileObjectPool* pPool) {
+  this->_releaseRenderResources.Add(PendingTeardown{pComponent, pPool});
+}
+
+int32 TileTeardownQueue::getPendingCount() const {
+  return this->_releaseRenderResources.Num() +
+         this->_awaitingRenderThread.Num() + this->_releaseObjects.Num();
+}
+
+void TileTeardownQueue::releaseRenderResources(
+    const PendingTeardown& teardown) const {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::ReleaseTileRenderResources)
+
+  USceneComponent* pComponent = teardown.pComponent.Get();
+  if (!pComponent) {
+    return;
+  }
+
+  TArray<USceneComponent*> children;
+  pComponent->GetChildrenComponents(true, children);
+  for (USceneComponent* pChild : children) {
+    if (pChild->IsRegistered()) {
+      pChild->UnregisterComponent();
+    }
+
+    UStaticMeshComponent* pMeshComponent = Cast<UStaticMeshComponent>(pChild);
+    UStaticMesh* pMesh =
+        pMeshComponent ? pMeshComponent->GetStaticMesh() : nullptr;
+    ICesiumPrimitive* pPrimitive = Cast<ICesiumPrimitive>(pChild);
+    if (pPrimitive && pPrimitive->getPrimitiveData().pSharedMesh) {
+      // Other tiles may still render with a shared mesh, so only let go of
+      // it. The mesh depot releases it once no tile uses it anymore.
+      pMeshComponent->SetStaticMesh(nullptr);
+      pPrimitive->getPrimitiveData().pSharedMesh.Reset();
+    } else if (pMesh) {
+      pMesh->ReleaseResources();
+    }
+  }
+
+  if (pComponent->IsRegistered()) {
+    pComponent->UnregisterComponent();
+  }
+}
+
+void TileTeardownQueue::releaseObjects(const PendingTeardown& teardown) const {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::ReleaseTileObjects)
+
+  USceneComponent* pComponent = teardown.pComponent.Get();
+  if (!pComponent) {
+    return;
+  }
+
+  UCesiumTileObjectPool* pPool = teardown.pPool.Get();
+  if (pPool) {
+    TArray<USceneComponent*> children;
+    pComponent->GetChildrenComponents(true, children);
+    for (USceneComponent* pChild : children) {
+      UStaticMeshComponent* pMeshComponent =
+          Cast<UStaticMeshComponent>(pChild);
+      if (!pMeshComponent || pPool->releaseComponent(pMeshComponent)) {
+        continue;
+      }
+
+      UStaticMesh* pMesh = pMeshComponent->GetStaticMesh();
+      if (!pMesh) {
+        continue;
+      }
+
+      // The material instance is referenced from the mesh's material slots,
+      // so detach it there before the mesh is destroyed along with the
+      // component.
+      for (FStaticMaterial& staticMaterial : pMesh->GetStaticMaterials()) {
+        UMaterialInstanceDynamic* pMaterial =
+            Cast<UMaterialInstanceDynamic>(staticMaterial.MaterialInterface);
+        if (pMaterial && pPool->releaseMaterial(pMaterial)) {
+          staticMaterial.MaterialInterface = nullptr;
+        }
+      }
+    }
+  }
+
+  CesiumLifetime::destroyComponentRecursively(pComponent);
+}
+
 void AmortizedDestructor::Tick(float DeltaTime) { processPending(); }
 
 ETickableTickType AmortizedDestructor::GetTickableTickType() const {
@@ -3,11 +3,13 @@
 #pragma once
 #include "Components/SceneComponent.h"
 #include "Containers/Array.h"
+#include "RenderCommandFence.h"
 #include "Tickable.h"
 #include "UObject/WeakObjectPtrTemplates.h"
 
 class UObject;
 class UTexture;
+class UCesiumTileObjectPool;
 
 class AmortizedDestructor : FTickableGameObject {
 public:
@@ -28,11 +30,68 @@ private:
   TArray<TWeakObjectPtr<UObject>> _nextPending;
 };
 
+/**
+ * Tears down the components of a tileset's unloaded tiles over several frames,
+ * within a per-frame time budget, rather than all at once on the game thread.
+ * Each tileset has its own queue. Anything still pending when the queue is
+ * destroyed is torn down immediately.
+ *
+ * Teardown happens in two stages. First, the components are unregistered and
+ * their meshes' render resources are released. Once the render thread has
+ * caught up, the remaining UObjects are destroyed or recycled into the
+ * tileset's object pool. The first stage always takes priority, so that GPU
+ * memory is given back as early as possible.
+ */
+class TileTeardownQueue : FTickableGameObject {
+public:
+  ~TileTeardownQueue();
+
+  void Tick(float DeltaTime) override;
+  ETickableTickType GetTickableTickType() const override;
+  bool IsTickableWhenPaused() const override;
+  bool IsTickableInEditor() const override;
+  TStatId GetStatId() const;
+
+  void enqueue(USceneComponent* pComponent, UCesiumTileObjectPool* pPool);
+  int32 getPendingCount() const;
+
+private:
+  struct PendingTeardown {
+    TWeakObjectPtr<USceneComponent> pComponent;
+    TWeakObjectPtr<UCesiumTileObjectPool> pPool;
+  };
+
+  void releaseRenderResources(const PendingTeardown& teardown) const;
+  void releaseObjects(const PendingTeardown& teardown) const;
+
+  TArray<PendingTeardown> _releaseRenderResources;
+  TArray<PendingTeardown> _awaitingRenderThread;
+  TArray<PendingTeardown> _releaseObjects;
+  FRenderCommandFence _renderThreadFence;
+};
+
 class CesiumLifetime {
 public:
   static void destroy(UObject* pObject);
   static void destroyComponentRecursively(USceneComponent* pComponent);
 
+  /**
+   * Hides the given tile component and disables its collision immediately,
+   * and schedules the rest of its teardown to happen over the next frames.
+   *
+   * The tile's glTF model is freed as soon as this returns, so everything in
+   * the tile's primitives that refers into the model is cleared right away.
+   *
+   * @param queue The teardown queue of the tileset that the tile belonged to.
+   * @param pComponent The root component of the tile's hierarchy.
+   * @param pPool The pool of the tileset that the tile belonged to, into which
+   * reusable objects are recycled. May be nullptr.
+   */
+  static void scheduleTileTeardown(
+      TileTeardownQueue& queue,
+      USceneComponent* pComponent,
+      UCesiumTileObjectPool* pPool);
+
 private:
   static AmortizedDestructor amortizedDestructor;
 };
@@ -0,0 +1,219 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumMeshContentHash.h"
+#include "Hash/CityHash.h"
+#include <CesiumGltf/ExtensionKhrMaterialsUnlit.h>
+#include <CesiumGltf/Model.h>
+#include <CesiumUtility/Tracing.h>
+#include <map>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+using namespace CesiumGltf;
+
+namespace {
+
+class Hasher {
+public:
+  void add(const void* pData, size_t size) {
+    this->_hash = CityHash64WithSeed(
+        static_cast<const char*>(pData),
+        uint32(size),
+        this->_hash);
+  }
+
+  template <typename T> void add(const T& value) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    this->add(&value, sizeof(T));
+  }
+
+  void add(const std::string& value) {
+    this->add(value.size());
+    this->add(value.data(), value.size());
+  }
+
+  void add(const std::vector<double>& values) {
+    this->add(values.size());
+    this->add(values.data(), values.size() * sizeof(double));
+  }
+
+  uint64 get() const { return this->_hash; }
+
+private:
+  uint64 _hash = 0;
+};
+
+bool addAccessor(Hasher& hasher, const Model& model, int32_t accessorIndex) {
+  const Accessor* pAccessor = Model::getSafe(&model.accessors, accessorIndex);
+  if (!pAccessor || pAccessor->sparse) {
+    return false;
+  }
+
+  const BufferView* pBufferView =
+      Model::getSafe(&model.bufferViews, pAccessor->bufferView);
+  const Buffer* pBuffer =
+      pBufferView ? Model::getSafe(&model.buffers, pBufferView->buffer)
+                  : nullptr;
+  if (!pBuffer) {
+    return false;
+  }
+
+  const int64_t elementSize = pAccessor->computeNumberOfComponents() *
+                              pAccessor->computeByteSizeOfComponent();
+  const int64_t stride = pAccessor->computeByteStride(model);
+  const int64_t start = pBufferView->byteOffset + pAccessor->byteOffset;
+  if (elementSize <= 0 || stride < elementSize || pAccessor->count < 0 ||
+      (pAccessor->count > 0 &&
+       start + stride * (pAccessor->count - 1) + elementSize >
+           int64_t(pBuffer->cesium.data.size()))) {
+    return false;
+  }
+
+  hasher.add(pAccessor->type);
+  hasher.add(pAccessor->componentType);
+  hasher.add(pAccessor->normalized);
+  hasher.add(pAccessor->count);
+
+  const std::byte* pData = pBuffer->cesium.data.data() + start;
+  if (stride == elementSize) {
+    hasher.add(pData, size_t(elementSize * pAccessor->count));
+  } else {
+    for (int64_t i = 0; i < pAccessor->count; ++i) {
+      hasher.add(pData + stride * i, size_t(elementSize));
+    }
+  }
+
+  return true;
+}
+
+bool addTexture(
+    Hasher& hasher,
+    const Model& model,
+    const std::optional<TextureInfo>& maybeTextureInfo) {
+  hasher.add(maybeTextureInfo.has_value());
+  if (!maybeTextureInfo) {
+    return true;
+  }
+
+  const TextureInfo& textureInfo = *maybeTextureInfo;
+  if (!textureInfo.extensions.empty()) {
+    return false;
+  }
+
+  const Texture* pTexture = Model::getSafe(&model.textures, textureInfo.index);
+  const Image* pImage =
+      pTexture ? Model::getSafe(&model.images, pTexture->source) : nullptr;
+  if (!pImage || !pImage->pAsset) {
+    return false;
+  }
+
+  hasher.add(textureInfo.texCoord);
+  hasher.add(reinterpret_cast<uintptr_t>(pImage->pAsset.get()));
+
+  const Sampler* pSampler = Model::getSafe(&model.samplers, pTexture->sampler);
+  hasher.add(pSampler != nullptr);
+  if (pSampler) {
+    hasher.add(pSampler->magFilter.value_or(-1));
+    hasher.add(pSampler->minFilter.value_or(-1));
+    hasher.add(pSampler->wrapS);
+    hasher.add(pSampler->wrapT);
+  }
+
+  return true;
+}
+
+bool addMaterial(Hasher& hasher, const Model& model, int32_t materialIndex) {
+  const Material* pMaterial = Model::getSafe(&model.materials, materialIndex);
+  hasher.add(pMaterial != nullptr);
+  if (!pMaterial) {
+    return true;
+  }
+
+  const Material& material = *pMaterial;
+  for (const auto& [name, extension] : material.extensions) {
+    if (name != ExtensionKhrMaterialsUnlit::ExtensionName) {
+      return false;
+    }
+  }
+  hasher.add(material.hasExtension<ExtensionKhrMaterialsUnlit>());
+
+  hasher.add(material.alphaMode);
+  hasher.add(material.alphaCutoff);
+  hasher.add(material.doubleSided);
+  hasher.add(material.emissiveFactor);
+  if (!addTexture(hasher, model, material.emissiveTexture)) {
+    return false;
+  }
+
+  hasher.add(material.normalTexture.has_value());
+  if (material.normalTexture) {
+    hasher.add(material.normalTexture->scale);
+    if (!addTexture(hasher, model, material.normalTexture)) {
+      return false;
+    }
+  }
+
+  hasher.add(material.occlusionTexture.has_value());
+  if (material.occlusionTexture) {
+    hasher.add(material.occlusionTexture->strength);
+    if (!addTexture(hasher, model, material.occlusionTexture)) {
+      return false;
+    }
+  }
+
+  hasher.add(material.pbrMetallicRoughness.has_value());
+  if (material.pbrMetallicRoughness) {
+    const MaterialPBRMetallicRoughness& pbr = *material.pbrMetallicRoughness;
+    hasher.add(pbr.baseColorFactor);
+    hasher.add(pbr.metallicFactor);
+    hasher.add(pbr.roughnessFactor);
+    if (!addTexture(hasher, model, pbr.baseColorTexture) ||
+        !addTexture(hasher, model, pbr.metallicRoughnessTexture)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+} // namespace
+
+namespace CesiumMeshContentHash {
+
+std::optional<uint64>
+hashPrimitive(const Model& model, const MeshPrimitive& primitive) {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::HashPrimitive)
+
+  if (!primitive.targets.empty()) {
+    return std::nullopt;
+  }
+
+  Hasher hasher;
+  hasher.add(primitive.mode);
+
+  hasher.add(primitive.indices >= 0);
+  if (primitive.indices >= 0 &&
+      !addAccessor(hasher, model, primitive.indices)) {
+    return std::nullopt;
+  }
+
+  // Sort the attributes so that the hash does not depend on their order.
+  const std::map<std::string, int32_t> attributes(
+      primitive.attributes.begin(),
+      primitive.attributes.end());
+  for (const auto& [name, accessorIndex] : attributes) {
+    hasher.add(name);
+    if (!addAccessor(hasher, model, accessorIndex)) {
+      return std::nullopt;
+    }
+  }
+
+  if (!addMaterial(hasher, model, primitive.material)) {
+    return std::nullopt;
+  }
+
+  return hasher.get();
+}
+
+} // namespace CesiumMeshContentHash
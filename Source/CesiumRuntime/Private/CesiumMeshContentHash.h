@@ -0,0 +1,38 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include <optional>
+
+namespace CesiumGltf {
+struct Model;
+struct MeshPrimitive;
+} // namespace CesiumGltf
+
+/**
+ * Computes hashes that identify glTF primitives with identical content, even
+ * when they come from different tiles.
+ */
+namespace CesiumMeshContentHash {
+
+/**
+ * Hashes the geometry and material of a primitive.
+ *
+ * The geometry is hashed from the data of its index and vertex attribute
+ * accessors, not from their indices in the model. The material is hashed from
+ * its factors and the images and samplers of its textures. An image is
+ * identified by its image asset, so textures only match across tiles when
+ * their images are shared, as external images are.
+ *
+ * @param model The model containing the primitive.
+ * @param primitive The primitive to hash.
+ * @return The hash, or std::nullopt if the primitive uses something that is
+ * not considered in the hash, such as sparse accessors, morph targets, texture
+ * transforms, or material extensions other than KHR_materials_unlit.
+ */
+std::optional<uint64> hashPrimitive(
+    const CesiumGltf::Model& model,
+    const CesiumGltf::MeshPrimitive& primitive);
+
+} // namespace CesiumMeshContentHash
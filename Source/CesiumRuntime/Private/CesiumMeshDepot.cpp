@@ -0,0 +1,93 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumMeshDepot.h"
+#include "CesiumStats.h"
+#include "Engine/StaticMesh.h"
+#include "Misc/ScopeLock.h"
+
+CesiumSharedMesh::~CesiumSharedMesh() {
+  if (this->pStaticMesh) {
+    DEC_MEMORY_STAT_BY(STAT_CesiumMeshMemory, this->MeshBytes);
+    DEC_MEMORY_STAT_BY(STAT_CesiumPhysicsMemory, this->PhysicsBytes);
+  }
+}
+
+/*static*/ CesiumMeshDepot& CesiumMeshDepot::getInstance() {
+  // Intentionally leaked, so that it is never unregistered from a garbage
+  // collector that has already shut down.
+  static CesiumMeshDepot* pInstance = new CesiumMeshDepot();
+  return *pInstance;
+}
+
+TSharedPtr<CesiumSharedMesh> CesiumMeshDepot::find(uint64 key) {
+  FScopeLock lock(&this->_lock);
+
+  const TWeakPtr<CesiumSharedMesh>* ppMesh = this->_meshes.Find(key);
+  TSharedPtr<CesiumSharedMesh> pMesh = ppMesh ? ppMesh->Pin() : nullptr;
+  if (pMesh) {
+    ++this->_hitCount;
+  }
+  return pMesh;
+}
+
+TSharedRef<CesiumSharedMesh> CesiumMeshDepot::add(
+    uint64 key,
+    const TSharedRef<CesiumSharedMesh>& pMesh) {
+  FScopeLock lock(&this->_lock);
+
+  TWeakPtr<CesiumSharedMesh>& pExisting = this->_meshes.FindOrAdd(key);
+  TSharedPtr<CesiumSharedMesh> pPinned = pExisting.Pin();
+  if (pPinned) {
+    ++this->_hitCount;
+    return pPinned.ToSharedRef();
+  }
+
+  pExisting = pMesh;
+  return pMesh;
+}
+
+int32 CesiumMeshDepot::getMeshCount() const {
+  FScopeLock lock(&this->_lock);
+
+  int32 count = 0;
+  for (const auto& [key, pMesh] : this->_meshes) {
+    if (pMesh.IsValid()) {
+      ++count;
+    }
+  }
+  return count;
+}
+
+int32 CesiumMeshDepot::getReferenceCount() const {
+  FScopeLock lock(&this->_lock);
+
+  int32 count = 0;
+  for (const auto& [key, pMesh] : this->_meshes) {
+    TSharedPtr<CesiumSharedMesh> pPinned = pMesh.Pin();
+    if (pPinned) {
+      // Don't count the reference held by pPinned itself.
+      count += pPinned.GetSharedReferenceCount() - 1;
+    }
+  }
+  return count;
+}
+
+void CesiumMeshDepot::AddReferencedObjects(FReferenceCollector& Collector) {
+  FScopeLock lock(&this->_lock);
+
+  for (auto it = this->_meshes.CreateIterator(); it; ++it) {
+    TSharedPtr<CesiumSharedMesh> pMesh = it.Value().Pin();
+    if (!pMesh) {
+      it.RemoveCurrent();
+      continue;
+    }
+
+    if (pMesh->pStaticMesh) {
+      Collector.AddReferencedObject(pMesh->pStaticMesh);
+    }
+  }
+}
+
+FString CesiumMeshDepot::GetReferencerName() const {
+  return TEXT("CesiumMeshDepot");
+}
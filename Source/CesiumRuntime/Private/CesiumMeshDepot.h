@@ -0,0 +1,115 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CesiumPhysicsMeshCooker.h"
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include "StaticMeshResources.h"
+#include "Templates/SharedPointer.h"
+#include "UObject/GCObject.h"
+#include "UObject/ObjectPtr.h"
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+class UStaticMesh;
+
+/**
+ * The converted geometry of a glTF primitive, shared by all primitives with
+ * the same content in any tile of any tileset.
+ *
+ * Besides the render data and the collision mesh, this holds everything that
+ * was derived from the vertex data while converting it, so that a primitive
+ * found in the depot can skip the conversion entirely.
+ */
+struct CesiumSharedMesh {
+  /**
+   * The render data, until the first component that uses this mesh creates
+   * the static mesh from it on the game thread.
+   */
+  TUniquePtr<FStaticMeshRenderData> RenderData;
+
+  /**
+   * The static mesh that renders this mesh for all components that share it,
+   * or nullptr if it has not been created yet. This is only accessed from the
+   * game thread.
+   */
+  TObjectPtr<UStaticMesh> pStaticMesh = nullptr;
+
+  CesiumCollisionMeshPtr pCollisionMesh = nullptr;
+
+  std::unordered_map<std::string, uint32_t> textureCoordinateParameters;
+  std::unordered_map<int32_t, uint32_t> GltfToUnrealTexCoordMap;
+
+  /**
+   * The estimated sizes of the static mesh and of the collision mesh. They
+   * are counted in the Cesium stats once, from the time the static mesh is
+   * created until this shared mesh is destroyed.
+   */
+  int64 MeshBytes = 0;
+  int64 PhysicsBytes = 0;
+
+  ~CesiumSharedMesh();
+};
+
+/**
+ * A reference-counted depot of converted primitive geometry, keyed by a hash
+ * of the primitive's content and of the options it was converted with.
+ *
+ * Tiles that reference the same external glTF, such as the trees and signs of
+ * i3dm tilesets or repeated building components, otherwise convert and upload
+ * the same geometry once per tile. A mesh stays in the depot for as long as a
+ * load result or a component references it, and the depot keeps its static
+ * mesh from being garbage collected until then.
+ *
+ * All functions except AddReferencedObjects may be called from any thread.
+ */
+class CesiumMeshDepot : public FGCObject {
+public:
+  /**
+   * Gets the depot shared by all tilesets. It is created on first use, which
+   * should happen on the game thread, and is never destroyed.
+   */
+  static CesiumMeshDepot& getInstance();
+
+  /**
+   * Finds the mesh with the given key, if a live primitive still references
+   * it.
+   */
+  TSharedPtr<CesiumSharedMesh> find(uint64 key);
+
+  /**
+   * Adds a newly converted mesh to the depot. If another thread added a mesh
+   * with the same key in the meantime, that mesh is returned instead and the
+   * given one is discarded.
+   */
+  TSharedRef<CesiumSharedMesh>
+  add(uint64 key, const TSharedRef<CesiumSharedMesh>& pMesh);
+
+  /**
+   * Gets the number of distinct meshes in the depot.
+   */
+  int32 getMeshCount() const;
+
+  /**
+   * Gets the number of load results and components that reference a mesh in
+   * the depot.
+   */
+  int32 getReferenceCount() const;
+
+  /**
+   * Gets the number of times a primitive was found in the depot instead of
+   * being converted.
+   */
+  int64 getHitCount() const { return this->_hitCount; }
+
+  virtual void AddReferencedObjects(FReferenceCollector& Collector) override;
+  virtual FString GetReferencerName() const override;
+
+private:
+  mutable FCriticalSection _lock;
+  TMap<uint64, TWeakPtr<CesiumSharedMesh>> _meshes;
+  std::atomic<int64> _hitCount = 0;
+};
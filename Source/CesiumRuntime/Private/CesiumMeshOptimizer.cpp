@@ -0,0 +1,127 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumMeshOptimizer.h"
+#include "Math/Float16.h"
+#include <CesiumUtility/Tracing.h>
+#include <meshoptimizer.h>
+#include <vector>
+
+namespace {
+
+// How much the vertex cache efficiency may degrade in exchange for less
+// overdraw. This is the value recommended by meshoptimizer.
+const float overdrawThreshold = 1.05f;
+
+// The largest change to a texture coordinate that is accepted when converting
+// it to a 16-bit float. This is a quarter of a texel of a 1024x1024 texture,
+// and the largest error of coordinates between 0.0 and 1.0.
+const float halfPrecisionUVTolerance = 1.0f / 4096.0f;
+
+} // namespace
+
+namespace CesiumMeshOptimizer {
+
+void optimize(
+    TArray<FStaticMeshBuildVertex>& vertices,
+    TArray<uint32>& indices,
+    uint32 numberOfTextureCoordinates,
+    bool hasVertexColors) {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::OptimizeMesh)
+
+  if (vertices.IsEmpty() || indices.Num() < 3 || indices.Num() % 3 != 0) {
+    return;
+  }
+
+  const size_t indexCount = size_t(indices.Num());
+  const size_t vertexCount = size_t(vertices.Num());
+  const size_t stride = sizeof(FStaticMeshBuildVertex);
+
+  // Only compare the attributes that end up in the vertex buffers. The unused
+  // texture coordinate sets are never initialized.
+  const FStaticMeshBuildVertex& first = vertices[0];
+  std::vector<meshopt_Stream> streams{
+      {&first.Position, sizeof(first.Position), stride},
+      {&first.TangentX, sizeof(first.TangentX), stride},
+      {&first.TangentY, sizeof(first.TangentY), stride},
+      {&first.TangentZ, sizeof(first.TangentZ), stride}};
+  if (hasVertexColors) {
+    streams.push_back({&first.Color, sizeof(first.Color), stride});
+  }
+  const uint32 uvCount =
+      FMath::Min(numberOfTextureCoordinates, uint32(MAX_STATIC_TEXCOORDS));
+  for (uint32 i = 0; i < uvCount; ++i) {
+    streams.push_back({&first.UVs[i], sizeof(first.UVs[i]), stride});
+  }
+
+  std::vector<uint32> remap(vertexCount);
+  const size_t uniqueVertexCount = meshopt_generateVertexRemapMulti(
+      remap.data(),
+      indices.GetData(),
+      indexCount,
+      vertexCount,
+      streams.data(),
+      streams.size());
+
+  TArray<FStaticMeshBuildVertex> weldedVertices;
+  weldedVertices.SetNumUninitialized(int32(uniqueVertexCount));
+  meshopt_remapVertexBuffer(
+      weldedVertices.GetData(),
+      vertices.GetData(),
+      vertexCount,
+      stride,
+      remap.data());
+  meshopt_remapIndexBuffer(
+      indices.GetData(),
+      indices.GetData(),
+      indexCount,
+      remap.data());
+
+  meshopt_optimizeVertexCache(
+      indices.GetData(),
+      indices.GetData(),
+      indexCount,
+      uniqueVertexCount);
+  meshopt_optimizeOverdraw(
+      indices.GetData(),
+      indices.GetData(),
+      indexCount,
+      &weldedVertices[0].Position.X,
+      uniqueVertexCount,
+      stride,
+      overdrawThreshold);
+
+  vertices.SetNumUninitialized(int32(uniqueVertexCount));
+  const size_t fetchedVertexCount = meshopt_optimizeVertexFetch(
+      vertices.GetData(),
+      indices.GetData(),
+      indexCount,
+      weldedVertices.GetData(),
+      uniqueVertexCount,
+      stride);
+  vertices.SetNumUninitialized(int32(fetchedVertexCount));
+}
+
+bool canUseHalfPrecisionUVs(
+    const TArray<FStaticMeshBuildVertex>& vertices,
+    uint32 numberOfTextureCoordinates) {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::CheckHalfPrecisionUVs)
+
+  const uint32 uvCount =
+      FMath::Min(numberOfTextureCoordinates, uint32(MAX_STATIC_TEXCOORDS));
+  for (const FStaticMeshBuildVertex& vertex : vertices) {
+    for (uint32 i = 0; i < uvCount; ++i) {
+      const FVector2f& uv = vertex.UVs[i];
+      const FVector2f halfUV(
+          FFloat16(uv.X).GetFloat(),
+          FFloat16(uv.Y).GetFloat());
+      if (FMath::Abs(halfUV.X - uv.X) > halfPrecisionUVTolerance ||
+          FMath::Abs(halfUV.Y - uv.Y) > halfPrecisionUVTolerance) {
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+} // namespace CesiumMeshOptimizer
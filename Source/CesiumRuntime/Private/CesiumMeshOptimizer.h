@@ -0,0 +1,60 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "StaticMeshResources.h"
+
+/**
+ * Reorders the triangles and vertices of a primitive's render mesh so that the
+ * GPU renders it more efficiently. This is done in the load thread, before the
+ * vertex and index buffers are created.
+ */
+namespace CesiumMeshOptimizer {
+
+/**
+ * Optimizes a triangle list in place:
+ *
+ * - Vertices with identical attributes are welded, which mostly benefits
+ *   primitives whose vertices were duplicated to compute flat normals or
+ *   tangents.
+ * - Triangles are reordered for the post-transform vertex cache, and then for
+ *   less overdraw.
+ * - Vertices are reordered in the order that the triangles first use them,
+ *   and vertices that no triangle uses are removed.
+ *
+ * Welding can reduce the number of vertices enough for the primitive to use
+ * 16-bit indices.
+ *
+ * @param vertices The vertices of the primitive.
+ * @param indices Three indices per triangle.
+ * @param numberOfTextureCoordinates The number of texture coordinate sets used
+ * by the vertices. The other sets are ignored when comparing vertices.
+ * @param hasVertexColors Whether the vertex colors are used.
+ */
+void optimize(
+    TArray<FStaticMeshBuildVertex>& vertices,
+    TArray<uint32>& indices,
+    uint32 numberOfTextureCoordinates,
+    bool hasVertexColors);
+
+/**
+ * Determines whether the texture coordinates of a primitive can be stored as
+ * 16-bit floats without visibly changing them.
+ *
+ * Texture coordinate sets are also used to pass integer feature IDs and vertex
+ * IDs to the material. These only survive the conversion while they are small
+ * enough to be represented exactly, so every used coordinate is converted and
+ * compared to the original.
+ *
+ * @param vertices The vertices of the primitive.
+ * @param numberOfTextureCoordinates The number of texture coordinate sets used
+ * by the vertices.
+ * @return Whether the conversion changes no coordinate by more than a quarter
+ * of a texel of a 1024x1024 texture.
+ */
+bool canUseHalfPrecisionUVs(
+    const TArray<FStaticMeshBuildVertex>& vertices,
+    uint32 numberOfTextureCoordinates);
+
+} // namespace CesiumMeshOptimizer
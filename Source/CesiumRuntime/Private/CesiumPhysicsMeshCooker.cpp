@@ -0,0 +1,297 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumPhysicsMeshCooker.h"
+#include "CesiumGltfComponent.h"
+#include "CesiumPrimitive.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "PhysicsEngine/BodySetup.h"
+#include <CesiumAsync/AsyncSystem.h>
+
+namespace {
+template <typename TIndex>
+CesiumCollisionMeshPtr
+buildTriangleMesh(const CesiumCollisionGeometry& geometry) {
+  int32 vertexCount = geometry.positions.Num();
+  Chaos::TParticles<Chaos::FRealSingle, 3> vertices;
+  vertices.AddParticles(vertexCount);
+  for (int32 i = 0; i < vertexCount; ++i) {
+    vertices.X(i) = geometry.positions[i];
+  }
+
+  int32 triangleCount = geometry.indices.Num() / 3;
+  TArray<Chaos::TVector<TIndex, 3>> triangles;
+  triangles.Reserve(triangleCount);
+  TArray<int32> faceRemap;
+  faceRemap.Reserve(triangleCount);
+
+  for (int32 i = 0; i < triangleCount; ++i) {
+    const int32 index0 = 3 * i;
+    int32 vIndex0 = geometry.indices[index0 + 1];
+    int32 vIndex1 = geometry.indices[index0];
+    int32 vIndex2 = geometry.indices[index0 + 2];
+
+    triangles.Add(Chaos::TVector<int32, 3>(vIndex0, vIndex1, vIndex2));
+    faceRemap.Add(geometry.faceRemap.IsEmpty() ? i : geometry.faceRemap[i]);
+  }
+
+  TUniquePtr<TArray<int32>> pFaceRemap = MakeUnique<TArray<int32>>(faceRemap);
+  TArray<uint16> materials;
+  materials.SetNum(triangles.Num());
+
+#if ENGINE_VERSION_5_4_OR_HIGHER
+  return new Chaos::FTriangleMeshImplicitObject(
+      MoveTemp(vertices),
+      MoveTemp(triangles),
+      MoveTemp(materials),
+      MoveTemp(pFaceRemap),
+      nullptr,
+      false);
+#else
+  return MakeShared<Chaos::FTriangleMeshImplicitObject, ESPMode::ThreadSafe>(
+      MoveTemp(vertices),
+      MoveTemp(triangles),
+      MoveTemp(materials),
+      MoveTemp(pFaceRemap),
+      nullptr,
+      false);
+#endif
+}
+
+void addCollisionMesh(
+    UStaticMeshComponent* pComponent,
+    CesiumCollisionMeshPtr&& pCollisionMesh) {
+  UStaticMesh* pMesh = pComponent->GetStaticMesh();
+  UBodySetup* pBodySetup = pMesh ? pMesh->GetBodySetup() : nullptr;
+  if (!pBodySetup || !pCollisionMesh) {
+    return;
+  }
+
+#if ENGINE_VERSION_5_4_OR_HIGHER
+  pBodySetup->TriMeshGeometries.Add(MoveTemp(pCollisionMesh));
+#else
+  pBodySetup->ChaosTriMeshes.Add(MoveTemp(pCollisionMesh));
+#endif
+
+  // The body setup was created without a triangle mesh, so the component's
+  // physics state must be recreated to pick it up.
+  pComponent->RecreatePhysicsState();
+}
+} // namespace
+
+CesiumPhysicsMeshCooker::CesiumPhysicsMeshCooker()
+    : _pending(), _pCookingCount(MakeShared<int32>(0)) {}
+
+/*static*/ CesiumCollisionMeshPtr
+CesiumPhysicsMeshCooker::cook(const CesiumCollisionGeometry& geometry) {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::ChaosCook)
+
+  if (geometry.positions.IsEmpty() || geometry.indices.IsEmpty()) {
+    return nullptr;
+  }
+
+  return geometry.positions.Num() < TNumericLimits<uint16>::Max()
+             ? buildTriangleMesh<uint16>(geometry)
+             : buildTriangleMesh<int32>(geometry);
+}
+
+/*static*/ void CesiumPhysicsMeshCooker::simplify(
+    CesiumCollisionGeometry& geometry,
+    int32 resolution) {
+  if (resolution <= 0 || geometry.positions.IsEmpty()) {
+    return;
+  }
+
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::SimplifyCollisionGeometry)
+
+  FBox3f bounds(geometry.positions);
+  const float longestExtent = bounds.GetSize().GetMax();
+  if (longestExtent <= 0.0f) {
+    return;
+  }
+
+  resolution = FMath::Min(resolution, MaximumSimplificationResolution);
+  const float cellSize = longestExtent / float(resolution);
+  const FVector3f origin = bounds.Min;
+
+  // Each cell is keyed by its integer coordinates, packed into 21 bits each.
+  TMap<uint64, uint32> cellToVertex;
+  cellToVertex.Reserve(geometry.positions.Num());
+
+  TArray<FVector3f> clusteredPositions;
+  TArray<uint32> clusteredCounts;
+  TArray<uint32> vertexRemap;
+  vertexRemap.SetNumUninitialized(geometry.positions.Num());
+
+  for (int32 i = 0; i < geometry.positions.Num(); ++i) {
+    const FVector3f& position = geometry.positions[i];
+    const FVector3f cell = (position - origin) / cellSize;
+    const uint64 x = uint64(FMath::Clamp(int32(cell.X), 0, resolution));
+    const uint64 y = uint64(FMath::Clamp(int32(cell.Y), 0, resolution));
+    const uint64 z = uint64(FMath::Clamp(int32(cell.Z), 0, resolution));
+    const uint64 key = (x << 42) | (y << 21) | z;
+
+    uint32* pClusterIndex = cellToVertex.Find(key);
+    if (pClusterIndex) {
+      clusteredPositions[*pClusterIndex] += position;
+      ++clusteredCounts[*pClusterIndex];
+      vertexRemap[i] = *pClusterIndex;
+    } else {
+      const uint32 clusterIndex = uint32(clusteredPositions.Add(position));
+      clusteredCounts.Add(1);
+      cellToVertex.Add(key, clusterIndex);
+      vertexRemap[i] = clusterIndex;
+    }
+  }
+
+  // Place each clustered vertex at the average of the vertices it replaces.
+  for (int32 i = 0; i < clusteredPositions.Num(); ++i) {
+    clusteredPositions[i] /= float(clusteredCounts[i]);
+  }
+
+  // Remember which render triangle each remaining triangle came from, so that
+  // the face index of a hit can still be used to look up features, metadata,
+  // and texture coordinates.
+  TArray<uint32> clusteredIndices;
+  clusteredIndices.Reserve(geometry.indices.Num());
+  TArray<int32> clusteredFaceRemap;
+  clusteredFaceRemap.Reserve(geometry.indices.Num() / 3);
+  for (int32 i = 0; i + 2 < geometry.indices.Num(); i += 3) {
+    const uint32 i0 = vertexRemap[geometry.indices[i]];
+    const uint32 i1 = vertexRemap[geometry.indices[i + 1]];
+    const uint32 i2 = vertexRemap[geometry.indices[i + 2]];
+    if (i0 == i1 || i1 == i2 || i0 == i2) {
+      continue;
+    }
+    clusteredIndices.Add(i0);
+    clusteredIndices.Add(i1);
+    clusteredIndices.Add(i2);
+
+    const int32 triangle = i / 3;
+    clusteredFaceRemap.Add(
+        geometry.faceRemap.IsEmpty() ? triangle
+                                     : geometry.faceRemap[triangle]);
+  }
+
+  geometry.positions = MoveTemp(clusteredPositions);
+  geometry.indices = MoveTemp(clusteredIndices);
+  geometry.faceRemap = MoveTemp(clusteredFaceRemap);
+}
+
+void CesiumPhysicsMeshCooker::addComponent(UCesiumGltfComponent* pGltf) {
+  if (!pGltf) {
+    return;
+  }
+
+  for (USceneComponent* pChild : pGltf->GetAttachChildren()) {
+    UStaticMeshComponent* pComponent = Cast<UStaticMeshComponent>(pChild);
+    ICesiumPrimitive* pPrimitive = Cast<ICesiumPrimitive>(pChild);
+    if (!pComponent || !pPrimitive) {
+      continue;
+    }
+
+    const CesiumPrimitiveData& primData = pPrimitive->getPrimitiveData();
+    if (primData.pPendingCollisionGeometry) {
+      this->_pending.Add({pComponent, primData.pPendingCollisionGeometry});
+    }
+  }
+}
+
+void CesiumPhysicsMeshCooker::update(
+    const CesiumAsync::AsyncSystem& asyncSystem,
+    const TArray<FVector>& locations,
+    double radius,
+    int32 maximumSimultaneousCooks) {
+  if (this->_pending.IsEmpty() || locations.IsEmpty()) {
+    return;
+  }
+
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::UpdatePhysicsMeshCooking)
+
+  const double radiusSquared = radius * radius;
+
+  // Find the distance to each primitive that is still waiting, and forget the
+  // ones that have been unloaded or reused by another tile.
+  TArray<TPair<double, int32>> candidates;
+  for (int32 i = this->_pending.Num() - 1; i >= 0; --i) {
+    const PendingCook& pending = this->_pending[i];
+    UStaticMeshComponent* pComponent = pending.pComponent.Get();
+    ICesiumPrimitive* pPrimitive = Cast<ICesiumPrimitive>(pComponent);
+    if (!IsValid(pComponent) || !pPrimitive ||
+        pPrimitive->getPrimitiveData().pPendingCollisionGeometry !=
+            pending.pGeometry) {
+      this->_pending.RemoveAtSwap(i);
+      continue;
+    }
+
+    if (!pComponent->IsRegistered() || !pComponent->IsVisible()) {
+      continue;
+    }
+
+    const FBox bounds = pComponent->Bounds.GetBox();
+    double closestSquared = TNumericLimits<double>::Max();
+    for (const FVector& location : locations) {
+      closestSquared = FMath::Min(
+          closestSquared,
+          bounds.ComputeSquaredDistanceToPoint(location));
+    }
+
+    if (closestSquared <= radiusSquared) {
+      candidates.Add(TPair<double, int32>(closestSquared, i));
+    }
+  }
+
+  int32 available = maximumSimultaneousCooks - *this->_pCookingCount;
+  if (candidates.IsEmpty() || available <= 0) {
+    return;
+  }
+
+  candidates.Sort([](const TPair<double, int32>& lhs,
+                     const TPair<double, int32>& rhs) {
+    return lhs.Key < rhs.Key;
+  });
+  candidates.SetNum(FMath::Min(candidates.Num(), available));
+
+  // Remove the started cooks from the back of the pending list first, so
+  // that the remaining indices stay valid.
+  candidates.Sort([](const TPair<double, int32>& lhs,
+                     const TPair<double, int32>& rhs) {
+    return lhs.Value > rhs.Value;
+  });
+
+  for (const TPair<double, int32>& candidate : candidates) {
+    PendingCook pending = MoveTemp(this->_pending[candidate.Value]);
+    this->_pending.RemoveAtSwap(candidate.Value);
+
+    ++*this->_pCookingCount;
+
+    TSharedPtr<const CesiumCollisionGeometry> pGeometry = pending.pGeometry;
+    asyncSystem
+        .runInWorkerThread([pGeometry]() { return cook(*pGeometry); })
+        .thenInMainThread(
+            [pComponent = pending.pComponent,
+             pGeometry,
+             pCookingCount = this->_pCookingCount](
+                CesiumCollisionMeshPtr&& pCollisionMesh) mutable {
+              --*pCookingCount;
+
+              UStaticMeshComponent* pMeshComponent = pComponent.Get();
+              ICesiumPrimitive* pPrimitive =
+                  Cast<ICesiumPrimitive>(pMeshComponent);
+              if (!IsValid(pMeshComponent) || !pPrimitive) {
+                return;
+              }
+
+              CesiumPrimitiveData& primData = pPrimitive->getPrimitiveData();
+              if (primData.pPendingCollisionGeometry != pGeometry) {
+                // The component was recycled for another tile while this
+                // cook was in progress.
+                return;
+              }
+
+              primData.pPendingCollisionGeometry.Reset();
+              primData.addMemory(0, int64(pGeometry->getSizeBytes()));
+              addCollisionMesh(pMeshComponent, MoveTemp(pCollisionMesh));
+            });
+  }
+}
@@ -0,0 +1,140 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CesiumCommon.h"
+#include "Chaos/TriangleMeshImplicitObject.h"
+#include "CoreMinimal.h"
+#include "Templates/SharedPointer.h"
+#include "UObject/WeakObjectPtr.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+
+namespace CesiumAsync {
+class AsyncSystem;
+}
+
+class UCesiumGltfComponent;
+class UStaticMeshComponent;
+
+#if ENGINE_VERSION_5_4_OR_HIGHER
+using CesiumCollisionMeshPtr = Chaos::FTriangleMeshImplicitObjectPtr;
+#else
+using CesiumCollisionMeshPtr =
+    TSharedPtr<Chaos::FTriangleMeshImplicitObject, ESPMode::ThreadSafe>;
+#endif
+
+/**
+ * The geometry from which a primitive's Chaos triangle mesh is cooked. It is
+ * in the same coordinate system as the primitive's render vertices.
+ */
+struct CesiumCollisionGeometry {
+  TArray<FVector3f> positions;
+
+  /**
+   * Three indices per triangle, with the glTF winding order.
+   */
+  TArray<uint32> indices;
+
+  /**
+   * For each triangle, the index of the render triangle that it came from, so
+   * that the face index of a hit still identifies a render triangle after the
+   * geometry is simplified. If empty, each triangle is its own render
+   * triangle.
+   */
+  TArray<int32> faceRemap;
+
+  SIZE_T getSizeBytes() const {
+    return positions.GetAllocatedSize() + indices.GetAllocatedSize() +
+           faceRemap.GetAllocatedSize();
+  }
+};
+
+/**
+ * Cooks the physics meshes of a tileset's primitives on worker threads.
+ *
+ * When a tileset only needs collision near physics-relevant actors, its
+ * primitives keep their collision geometry instead of a cooked triangle mesh.
+ * Each frame, {@link update} cooks the geometry of the closest primitives that
+ * have come within range, a few at a time, and adds the result to the
+ * primitive's existing body setup on the game thread.
+ */
+class CesiumPhysicsMeshCooker {
+public:
+  CesiumPhysicsMeshCooker();
+
+  /**
+   * Cooks a Chaos triangle mesh from collision geometry. This may be called
+   * from any thread.
+   */
+  static CesiumCollisionMeshPtr cook(const CesiumCollisionGeometry& geometry);
+
+  /**
+   * Simplifies collision geometry by clustering its vertices on a uniform grid
+   * that spans the geometry's bounding box, and removing the triangles that
+   * collapse as a result.
+   *
+   * @param geometry The geometry to simplify in place.
+   * @param resolution The number of grid cells along the longest axis of the
+   * bounding box. If zero or negative, the geometry is left unchanged. Values
+   * above {@link MaximumSimplificationResolution} are clamped to it.
+   */
+  static void simplify(CesiumCollisionGeometry& geometry, int32 resolution);
+
+  /**
+   * The largest resolution that {@link simplify} supports. Each cell
+   * coordinate is packed into 21 bits.
+   */
+  static constexpr int32 MaximumSimplificationResolution = (1 << 21) - 1;
+
+  /**
+   * Starts tracking the primitives of a newly created glTF component that are
+   * waiting for their physics meshes to be cooked.
+   */
+  void addComponent(UCesiumGltfComponent* pGltf);
+
+  /**
+   * Starts cooking the physics meshes of the visible primitives closest to the
+   * given locations.
+   *
+   * @param asyncSystem The async system used to cook on worker threads.
+   * @param locations The world locations of the physics-relevant actors.
+   * @param radius The distance, in Unreal units, from a location within which
+   * a primitive's bounds must be for its physics mesh to be cooked.
+   * @param maximumSimultaneousCooks The maximum number of physics meshes
+   * being cooked at the same time.
+   */
+  void update(
+      const CesiumAsync::AsyncSystem& asyncSystem,
+      const TArray<FVector>& locations,
+      double radius,
+      int32 maximumSimultaneousCooks);
+
+  /**
+   * Stops tracking all primitives. Cooks that are already in progress are
+   * still completed, but their results are discarded if the primitive has been
+   * reused in the meantime.
+   */
+  void clear() { this->_pending.Empty(); }
+
+  /**
+   * Gets the number of primitives that are still waiting to be cooked.
+   */
+  int32 getPendingCount() const { return this->_pending.Num(); }
+
+  /**
+   * Gets the number of physics meshes that are currently being cooked.
+   */
+  int32 getCookingCount() const { return *this->_pCookingCount; }
+
+private:
+  struct PendingCook {
+    TWeakObjectPtr<UStaticMeshComponent> pComponent;
+    TSharedPtr<const CesiumCollisionGeometry> pGeometry;
+  };
+
+  TArray<PendingCook> _pending;
+
+  // Shared with the continuations of the cooks that are in flight, which may
+  // outlive this instance.
+  TSharedRef<int32> _pCookingCount;
+};
@@ -0,0 +1,292 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumPolygonClipper.h"
+#include <CesiumUtility/Math.h>
+#include <CesiumUtility/Tracing.h>
+#include <glm/common.hpp>
+#include <glm/geometric.hpp>
+#include <limits>
+#include <optional>
+#include <utility>
+
+namespace {
+
+double cross(const glm::dvec2& o, const glm::dvec2& a, const glm::dvec2& b) {
+  return (a.x - o.x) * (b.y - o.y) - (a.y - o.y) * (b.x - o.x);
+}
+
+// Treats touching and collinear segments as intersecting, which only ever
+// keeps a triangle that could have been removed.
+bool segmentsIntersect(
+    const glm::dvec2& p1,
+    const glm::dvec2& p2,
+    const glm::dvec2& q1,
+    const glm::dvec2& q2) {
+  const double d1 = cross(q1, q2, p1);
+  const double d2 = cross(q1, q2, p2);
+  const double d3 = cross(p1, p2, q1);
+  const double d4 = cross(p1, p2, q2);
+  return d1 * d2 <= 0.0 && d3 * d4 <= 0.0;
+}
+
+bool triangleContains(
+    const glm::dvec2 (&triangle)[3],
+    const glm::dvec2& point) {
+  const double d1 = cross(triangle[0], triangle[1], point);
+  const double d2 = cross(triangle[1], triangle[2], point);
+  const double d3 = cross(triangle[2], triangle[0], point);
+  const bool hasNegative = d1 < 0.0 || d2 < 0.0 || d3 < 0.0;
+  const bool hasPositive = d1 > 0.0 || d2 > 0.0 || d3 > 0.0;
+  return !(hasNegative && hasPositive);
+}
+
+/**
+ * Computes a longitude and latitude rectangle, in radians, that contains all
+ * of the positions, from their bounding sphere. This is much cheaper than
+ * converting every position, and is only used to skip that conversion. No
+ * rectangle is computed if the sphere is too large, reaches a pole, or
+ * crosses the antimeridian.
+ */
+std::optional<std::pair<glm::dvec2, glm::dvec2>> computeCartographicBounds(
+    const std::vector<glm::dvec3>& positions,
+    const CesiumGeospatial::Ellipsoid& ellipsoid) {
+  if (positions.empty()) {
+    return std::nullopt;
+  }
+
+  glm::dvec3 minimum = positions[0];
+  glm::dvec3 maximum = positions[0];
+  for (const glm::dvec3& position : positions) {
+    minimum = glm::min(minimum, position);
+    maximum = glm::max(maximum, position);
+  }
+
+  const glm::dvec3 center = 0.5 * (minimum + maximum);
+  const double radius = 0.5 * glm::length(maximum - minimum);
+  const double distance = glm::length(center);
+  if (radius >= 0.5 * distance) {
+    return std::nullopt;
+  }
+
+  std::optional<CesiumGeospatial::Cartographic> maybeCenter =
+      ellipsoid.cartesianToCartographic(center);
+  if (!maybeCenter) {
+    return std::nullopt;
+  }
+
+  // The sphere spans this angle as seen from the center of the ellipsoid.
+  // Geodetic latitudes change faster than that angle by at most the square of
+  // the ratio of the ellipsoid's radii, plus some slack.
+  const glm::dvec3& radii = ellipsoid.getRadii();
+  const double radiusRatio =
+      glm::max(radii.x, radii.z) / glm::min(radii.x, radii.z);
+  const double angle =
+      1.01 * radiusRatio * radiusRatio * glm::asin(radius / distance);
+
+  const double latitude = maybeCenter->latitude;
+  const double longitude = maybeCenter->longitude;
+  if (glm::abs(latitude) + angle >= CesiumUtility::Math::PiOverTwo) {
+    return std::nullopt;
+  }
+
+  const double longitudeAngle = angle / glm::cos(glm::abs(latitude) + angle);
+  if (longitude - longitudeAngle <= -CesiumUtility::Math::OnePi ||
+      longitude + longitudeAngle >= CesiumUtility::Math::OnePi) {
+    return std::nullopt;
+  }
+
+  return std::make_pair(
+      glm::dvec2(longitude - longitudeAngle, latitude - angle),
+      glm::dvec2(longitude + longitudeAngle, latitude + angle));
+}
+
+} // namespace
+
+CesiumPolygonClipper::CesiumPolygonClipper(
+    const std::vector<CesiumGeospatial::CartographicPolygon>& polygons,
+    bool invertSelection,
+    const CesiumGeospatial::Ellipsoid& ellipsoid)
+    : _polygons(),
+      _invertSelection(invertSelection),
+      _ellipsoid(ellipsoid) {
+  this->_polygons.reserve(polygons.size());
+  for (const CesiumGeospatial::CartographicPolygon& source : polygons) {
+    const std::vector<glm::dvec2>& vertices = source.getVertices();
+    if (vertices.size() < 3) {
+      continue;
+    }
+
+    Polygon& polygon = this->_polygons.emplace_back();
+    polygon.vertices = vertices;
+    polygon.minimum = glm::dvec2(std::numeric_limits<double>::max());
+    polygon.maximum = glm::dvec2(std::numeric_limits<double>::lowest());
+    for (const glm::dvec2& vertex : vertices) {
+      polygon.minimum = glm::min(polygon.minimum, vertex);
+      polygon.maximum = glm::max(polygon.maximum, vertex);
+    }
+  }
+}
+
+int32 CesiumPolygonClipper::removeClippedTriangles(
+    TArray<uint32>& indices,
+    const std::vector<glm::dvec3>& positions) const {
+  if (!this->_invertSelection && this->_polygons.empty()) {
+    return 0;
+  }
+
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::ClipTriangles)
+
+  // Most primitives are nowhere near the polygons, so check their bounds
+  // before converting every vertex. Away from the polygons, nothing is
+  // clipped, or everything is if the selection is inverted.
+  std::optional<std::pair<glm::dvec2, glm::dvec2>> maybeBounds =
+      computeCartographicBounds(positions, this->_ellipsoid);
+  if (maybeBounds &&
+      !this->overlapsPolygons(maybeBounds->first, maybeBounds->second)) {
+    if (!this->_invertSelection) {
+      return 0;
+    }
+
+    const int32 triangleCount = indices.Num() / 3;
+    indices.Reset();
+    return triangleCount;
+  }
+
+  std::vector<std::optional<glm::dvec2>> cartographic(positions.size());
+  for (size_t i = 0; i < positions.size(); ++i) {
+    std::optional<CesiumGeospatial::Cartographic> maybePosition =
+        this->_ellipsoid.cartesianToCartographic(positions[i]);
+    if (maybePosition) {
+      cartographic[i] =
+          glm::dvec2(maybePosition->longitude, maybePosition->latitude);
+    }
+  }
+
+  int32 kept = 0;
+  const int32 triangleCount = indices.Num() / 3;
+  for (int32 i = 0; i < triangleCount; ++i) {
+    const uint32 i0 = indices[3 * i];
+    const uint32 i1 = indices[3 * i + 1];
+    const uint32 i2 = indices[3 * i + 2];
+
+    const bool clipped = i0 < cartographic.size() && cartographic[i0] &&
+                         i1 < cartographic.size() && cartographic[i1] &&
+                         i2 < cartographic.size() && cartographic[i2] &&
+                         this->isTriangleClipped(
+                             *cartographic[i0],
+                             *cartographic[i1],
+                             *cartographic[i2]);
+    if (clipped) {
+      continue;
+    }
+
+    indices[3 * kept] = i0;
+    indices[3 * kept + 1] = i1;
+    indices[3 * kept + 2] = i2;
+    ++kept;
+  }
+
+  indices.SetNum(3 * kept);
+  return triangleCount - kept;
+}
+
+bool CesiumPolygonClipper::isTriangleClipped(
+    const glm::dvec2& a,
+    const glm::dvec2& b,
+    const glm::dvec2& c) const {
+  const glm::dvec2 triangle[3] = {a, b, c};
+  const glm::dvec2 minimum = glm::min(glm::min(a, b), c);
+  const glm::dvec2 maximum = glm::max(glm::max(a, b), c);
+
+  if (!this->_invertSelection) {
+    // The triangle must lie entirely within one of the polygons.
+    for (const Polygon& polygon : this->_polygons) {
+      if (minimum.x < polygon.minimum.x || minimum.y < polygon.minimum.y ||
+          maximum.x > polygon.maximum.x || maximum.y > polygon.maximum.y) {
+        continue;
+      }
+
+      if (contains(polygon, a) && contains(polygon, b) &&
+          contains(polygon, c) && !crossesTriangle(polygon, triangle)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // The triangle must not touch any of the polygons.
+  for (const Polygon& polygon : this->_polygons) {
+    if (maximum.x < polygon.minimum.x || maximum.y < polygon.minimum.y ||
+        minimum.x > polygon.maximum.x || minimum.y > polygon.maximum.y) {
+      continue;
+    }
+
+    if (contains(polygon, a) || contains(polygon, b) || contains(polygon, c) ||
+        crossesTriangle(polygon, triangle) ||
+        triangleContains(triangle, polygon.vertices[0])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool CesiumPolygonClipper::overlapsPolygons(
+    const glm::dvec2& minimum,
+    const glm::dvec2& maximum) const {
+  for (const Polygon& polygon : this->_polygons) {
+    if (maximum.x >= polygon.minimum.x && maximum.y >= polygon.minimum.y &&
+        minimum.x <= polygon.maximum.x && minimum.y <= polygon.maximum.y) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool CesiumPolygonClipper::operator==(const CesiumPolygonClipper& other) const {
+  if (this->_invertSelection != other._invertSelection ||
+      this->_ellipsoid.getRadii() != other._ellipsoid.getRadii() ||
+      this->_polygons.size() != other._polygons.size()) {
+    return false;
+  }
+
+  for (size_t i = 0; i < this->_polygons.size(); ++i) {
+    if (this->_polygons[i].vertices != other._polygons[i].vertices) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/*static*/ bool CesiumPolygonClipper::contains(
+    const Polygon& polygon,
+    const glm::dvec2& point) {
+  bool inside = false;
+  const std::vector<glm::dvec2>& vertices = polygon.vertices;
+  for (size_t i = 0, j = vertices.size() - 1; i < vertices.size(); j = i++) {
+    const glm::dvec2& vi = vertices[i];
+    const glm::dvec2& vj = vertices[j];
+    if ((vi.y > point.y) != (vj.y > point.y) &&
+        point.x < (vj.x - vi.x) * (point.y - vi.y) / (vj.y - vi.y) + vi.x) {
+      inside = !inside;
+    }
+  }
+  return inside;
+}
+
+/*static*/ bool CesiumPolygonClipper::crossesTriangle(
+    const Polygon& polygon,
+    const glm::dvec2 (&triangle)[3]) {
+  const std::vector<glm::dvec2>& vertices = polygon.vertices;
+  for (size_t i = 0, j = vertices.size() - 1; i < vertices.size(); j = i++) {
+    for (size_t k = 0; k < 3; ++k) {
+      if (segmentsIntersect(
+              vertices[j],
+              vertices[i],
+              triangle[k],
+              triangle[(k + 1) % 3])) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
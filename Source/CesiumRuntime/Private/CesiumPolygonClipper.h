@@ -0,0 +1,91 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include <CesiumGeospatial/CartographicPolygon.h>
+#include <CesiumGeospatial/Ellipsoid.h>
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+#include <vector>
+
+/**
+ * Removes the triangles of tile meshes that lie entirely within the area
+ * clipped by a set of cartographic polygons, as the meshes are loaded.
+ *
+ * This is the geometric counterpart of the clipping done by a polygon raster
+ * overlay. The overlay still clips the triangles that cross a polygon edge
+ * per pixel, but the triangles that it would discard entirely are never
+ * uploaded or drawn. Each triangle is tested exactly against the polygon
+ * edges, so a triangle is only removed if no part of it can be visible.
+ *
+ * Polygons that cross the antimeridian are not supported.
+ *
+ * Instances of this class are immutable, and may be used from any thread.
+ */
+class CesiumPolygonClipper {
+public:
+  /**
+   * Creates a clipper for the given polygons.
+   *
+   * @param polygons The polygons, in the cartographic coordinates of the
+   * tileset's frame.
+   * @param invertSelection If false, the area inside the polygons is clipped.
+   * If true, the area outside of all of the polygons is clipped.
+   * @param ellipsoid The ellipsoid of the tileset.
+   */
+  CesiumPolygonClipper(
+      const std::vector<CesiumGeospatial::CartographicPolygon>& polygons,
+      bool invertSelection,
+      const CesiumGeospatial::Ellipsoid& ellipsoid);
+
+  /**
+   * Removes the clipped triangles from a triangle list.
+   *
+   * @param indices The vertex indices of the triangles.
+   * @param positions The positions of the vertices, in the Earth-centered,
+   * Earth-fixed coordinates of the tileset's frame.
+   * @return The number of triangles that were removed.
+   */
+  int32 removeClippedTriangles(
+      TArray<uint32>& indices,
+      const std::vector<glm::dvec3>& positions) const;
+
+  /**
+   * Determines if a triangle, given by the longitude and latitude of its
+   * vertices in radians, lies entirely within the clipped area.
+   */
+  bool isTriangleClipped(
+      const glm::dvec2& a,
+      const glm::dvec2& b,
+      const glm::dvec2& c) const;
+
+  /**
+   * Determines if the bounding boxes of any of the polygons overlap a
+   * rectangle, given by the minimum and maximum longitude and latitude in
+   * radians.
+   */
+  bool
+  overlapsPolygons(const glm::dvec2& minimum, const glm::dvec2& maximum) const;
+
+  /**
+   * Determines if two clippers remove the same triangles.
+   */
+  bool operator==(const CesiumPolygonClipper& other) const;
+
+private:
+  struct Polygon {
+    std::vector<glm::dvec2> vertices;
+    glm::dvec2 minimum;
+    glm::dvec2 maximum;
+  };
+
+  static bool contains(const Polygon& polygon, const glm::dvec2& point);
+  static bool crossesTriangle(
+      const Polygon& polygon,
+      const glm::dvec2 (&triangle)[3]);
+
+  std::vector<Polygon> _polygons;
+  bool _invertSelection;
+  CesiumGeospatial::Ellipsoid _ellipsoid;
+};
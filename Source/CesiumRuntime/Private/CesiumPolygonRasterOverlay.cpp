@@ -6,6 +6,7 @@
 #include "Cesium3DTileset.h"
 #include "CesiumBingMapsRasterOverlay.h"
 #include "CesiumCartographicPolygon.h"
+#include "CesiumPolygonClipper.h"
 #include "CesiumRasterOverlays/RasterizedPolygonsOverlay.h"
 
 using namespace Cesium3DTilesSelection;
@@ -17,9 +18,32 @@ UCesiumPolygonRasterOverlay::UCesiumPolygonRasterOverlay()
   this->MaterialLayerKey = TEXT("Clipping");
 }
 
-std::unique_ptr<CesiumRasterOverlays::RasterOverlay>
-UCesiumPolygonRasterOverlay::CreateOverlay(
-    const CesiumRasterOverlays::RasterOverlayOptions& options) {
+std::shared_ptr<const CesiumPolygonClipper>
+UCesiumPolygonRasterOverlay::CreatePolygonClipper() const {
+  ACesium3DTileset* pTileset = this->GetOwner<ACesium3DTileset>();
+  if (!this->ClipTrianglesOnLoad || !pTileset) {
+    return nullptr;
+  }
+
+  UCesiumEllipsoid* Ellipsoid = pTileset->ResolveGeoreference()->GetEllipsoid();
+  check(IsValid(Ellipsoid));
+
+  return std::make_shared<const CesiumPolygonClipper>(
+      this->CreateCartographicPolygons(),
+      this->InvertSelection,
+      Ellipsoid->GetNativeEllipsoid());
+}
+
+void UCesiumPolygonRasterOverlay::SetClipTrianglesOnLoad(
+    bool bClipTrianglesOnLoad) {
+  if (this->ClipTrianglesOnLoad != bClipTrianglesOnLoad) {
+    this->ClipTrianglesOnLoad = bClipTrianglesOnLoad;
+    this->Refresh();
+  }
+}
+
+std::vector<CartographicPolygon>
+UCesiumPolygonRasterOverlay::CreateCartographicPolygons() const {
   ACesium3DTileset* pTileset = this->GetOwner<ACesium3DTileset>();
 
   FTransform worldToTileset =
@@ -38,6 +62,17 @@ UCesiumPolygonRasterOverlay::CreateOverlay(
     polygons.emplace_back(std::move(polygon));
   }
 
+  return polygons;
+}
+
+std::unique_ptr<CesiumRasterOverlays::RasterOverlay>
+UCesiumPolygonRasterOverlay::CreateOverlay(
+    const CesiumRasterOverlays::RasterOverlayOptions& options) {
+  ACesium3DTileset* pTileset = this->GetOwner<ACesium3DTileset>();
+
+  std::vector<CartographicPolygon> polygons =
+      this->CreateCartographicPolygons();
+
   UCesiumEllipsoid* Ellipsoid = pTileset->ResolveGeoreference()->GetEllipsoid();
   check(IsValid(Ellipsoid));
 
@@ -63,6 +98,14 @@ void UCesiumPolygonRasterOverlay::OnAdd(
         std::make_shared<RasterizedPolygonsTileExcluder>(pPolygons);
     pTileset->getOptions().excluders.push_back(this->_pExcluder);
   }
+
+  // The tileset refreshes itself if this changes the clipping of tiles that
+  // are already loaded. Editing properties in the editor and Refresh both
+  // remove and add the overlay again, so they end up here too.
+  ACesium3DTileset* pActor = this->GetOwner<ACesium3DTileset>();
+  if (pActor) {
+    pActor->SetPolygonClipper(this, this->CreatePolygonClipper());
+  }
 }
 
 void UCesiumPolygonRasterOverlay::OnRemove(
@@ -77,4 +120,9 @@ void UCesiumPolygonRasterOverlay::OnRemove(
 
     this->_pExcluder.reset();
   }
+
+  ACesium3DTileset* pActor = this->GetOwner<ACesium3DTileset>();
+  if (pActor) {
+    pActor->SetPolygonClipper(this, nullptr);
+  }
 }
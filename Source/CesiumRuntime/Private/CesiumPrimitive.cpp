@@ -1,8 +1,86 @@
 // Copyright 2020-2024 CesiumGS, Inc. and Contributors
 
 #include "CesiumPrimitive.h"
+#include "CesiumStats.h"
+
+namespace {
+
+// Each node of an unordered_map holds its value and a pointer to the next
+// node, and the map has an array of buckets.
+template <typename TMap> int64 getMapBytes(const TMap& map) {
+  return int64(
+      map.size() * (sizeof(typename TMap::value_type) + sizeof(void*)) +
+      map.bucket_count() * sizeof(void*));
+}
+
+} // namespace
+
+void CesiumPrimitiveData::addMemory(int64 meshBytes, int64 physicsBytes) {
+  this->MeshBytes += meshBytes;
+  this->PhysicsBytes += physicsBytes;
+  INC_MEMORY_STAT_BY(STAT_CesiumMeshMemory, meshBytes);
+  INC_MEMORY_STAT_BY(STAT_CesiumPhysicsMemory, physicsBytes);
+}
+
+int64 CesiumPrimitiveData::getSizeBytes() const {
+  int64 bytes = int64(sizeof(CesiumPrimitiveData));
+
+  bytes += UCesiumPrimitiveFeaturesBlueprintLibrary::GetFeatureIDSets(
+               this->Features)
+               .GetAllocatedSize();
+  bytes += UCesiumPrimitiveMetadataBlueprintLibrary::GetPropertyTextureIndices(
+               this->Metadata)
+               .GetAllocatedSize();
+  bytes +=
+      UCesiumPrimitiveMetadataBlueprintLibrary::GetPropertyAttributeIndices(
+          this->Metadata)
+          .GetAllocatedSize();
+
+  bytes += this->EncodedFeatures.featureIdSets.GetAllocatedSize();
+  for (const CesiumEncodedFeaturesMetadata::EncodedFeatureIdSet& set :
+       this->EncodedFeatures.featureIdSets) {
+    bytes += set.name.GetAllocatedSize();
+    bytes += set.propertyTableName.GetAllocatedSize();
+  }
+  bytes += this->EncodedMetadata.propertyTextureIndices.GetAllocatedSize();
+
+  bytes += getMapBytes(this->GltfToUnrealTexCoordMap);
+  bytes += getMapBytes(this->TexCoordAccessorMap);
+  bytes += getMapBytes(this->OverlayParameters);
+  for (const auto& [name, parameters] : this->OverlayParameters) {
+    bytes += int64(name.capacity());
+    bytes += parameters.Texture.GetAllocatedSize();
+    bytes += parameters.TranslationScale.GetAllocatedSize();
+    bytes += parameters.TextureCoordinateIndex.GetAllocatedSize();
+  }
+
+  return bytes;
+}
+
+void CesiumPrimitiveData::releaseModel() {
+  this->Features = FCesiumPrimitiveFeatures();
+  this->Metadata = FCesiumPrimitiveMetadata();
+
+  PRAGMA_DISABLE_DEPRECATION_WARNINGS
+  this->Metadata_DEPRECATED = FCesiumMetadataPrimitive();
+  PRAGMA_ENABLE_DEPRECATION_WARNINGS
+
+  this->pModel = nullptr;
+  this->pMeshPrimitive = nullptr;
+  this->PositionAccessor = CesiumGltf::AccessorView<FVector3f>();
+  this->IndexAccessor = CesiumGltf::IndexAccessorType();
+
+  std::unordered_map<int32_t, CesiumGltf::TexCoordAccessorType>
+      emptyAccessorMap;
+  this->TexCoordAccessorMap.swap(emptyAccessorMap);
+}
 
 void CesiumPrimitiveData::destroy() {
+  DEC_MEMORY_STAT_BY(STAT_CesiumMeshMemory, this->MeshBytes);
+  DEC_MEMORY_STAT_BY(STAT_CesiumPhysicsMemory, this->PhysicsBytes);
+  this->MeshBytes = 0;
+  this->PhysicsBytes = 0;
+
   this->Features = FCesiumPrimitiveFeatures();
   this->Metadata = FCesiumPrimitiveMetadata();
   this->EncodedFeatures =
@@ -18,6 +96,8 @@ void CesiumPrimitiveData::destroy() {
   this->pTilesetActor = nullptr;
   this->pModel = nullptr;
   this->pMeshPrimitive = nullptr;
+  this->pPendingCollisionGeometry.Reset();
+  this->pSharedMesh.Reset();
 
   std::unordered_map<int32_t, uint32_t> emptyTexCoordMap;
   this->GltfToUnrealTexCoordMap.swap(emptyTexCoordMap);
@@ -25,4 +105,8 @@ void CesiumPrimitiveData::destroy() {
   std::unordered_map<int32_t, CesiumGltf::TexCoordAccessorType>
       emptyAccessorMap;
   this->TexCoordAccessorMap.swap(emptyAccessorMap);
+
+  std::unordered_map<std::string, CesiumOverlayParameters> emptyOverlayMap;
+  this->OverlayParameters.swap(emptyOverlayMap);
+  this->FadeParameters = CesiumFadeParameters();
 }
@@ -5,14 +5,19 @@
 #include "Cesium3DTileset.h"
 #include "CesiumEncodedFeaturesMetadata.h"
 #include "CesiumEncodedMetadataUtility.h"
+#include "CesiumFadeParameters.h"
+#include "CesiumMeshDepot.h"
 #include "CesiumMetadataPrimitive.h"
+#include "CesiumPhysicsMeshCooker.h"
 #include "CesiumPrimitiveFeatures.h"
 #include "CesiumPrimitiveMetadata.h"
 #include "CesiumRasterOverlays.h"
+#include "MaterialTypes.h"
 #include <CesiumGltf/AccessorUtility.h>
 #include <cstdint>
 #include <glm/mat4x4.hpp>
 #include <optional>
+#include <string>
 #include <unordered_map>
 
 #include "CesiumPrimitive.generated.h"
@@ -22,6 +27,25 @@ struct Model;
 struct MeshPrimitive;
 } // namespace CesiumGltf
 
+/**
+ * The material parameters that bind the tiles of one raster overlay to a
+ * primitive's material. There is one of each for every material layer that
+ * is named after the overlay, or exactly one of each if the material does not
+ * use layers.
+ */
+struct CesiumOverlayParameters {
+  TArray<FMaterialParameterInfo> Texture;
+  TArray<FMaterialParameterInfo> TranslationScale;
+  TArray<FMaterialParameterInfo> TextureCoordinateIndex;
+
+  /**
+   * The texture coordinate index that was last written to the material, or
+   * -1 if none was written yet. It rarely changes when an overlay tile is
+   * replaced, so the write is skipped when it is the same.
+   */
+  float LastTextureCoordinateIndex = -1.0f;
+};
+
 /**
  * Data that is common to the Cesium mesh component classes.
  */
@@ -101,6 +125,34 @@ public:
 
   std::optional<Cesium3DTilesSelection::BoundingVolume> boundingVolume;
 
+  /**
+   * The material parameters of each raster overlay, by overlay name. They are
+   * resolved the first time a tile of the overlay is attached, so that
+   * refining the overlay does not need to build parameter names or search
+   * the material layers again.
+   */
+  std::unordered_map<std::string, CesiumOverlayParameters> OverlayParameters;
+
+  /**
+   * How the LOD transition fade reaches the DitherFade layer of this
+   * primitive's base material.
+   */
+  CesiumFadeParameters FadeParameters;
+
+  /**
+   * The geometry from which this primitive's physics mesh will be cooked, if
+   * cooking was deferred until a physics-relevant actor comes near. This is
+   * reset once the physics mesh has been added to the body setup.
+   */
+  TSharedPtr<const CesiumCollisionGeometry> pPendingCollisionGeometry;
+
+  /**
+   * The depot entry whose static mesh this primitive renders with, if it
+   * shares its mesh with identical primitives in other tiles. A shared mesh
+   * must not be modified, released, or destroyed along with this primitive.
+   */
+  TSharedPtr<CesiumSharedMesh> pSharedMesh;
+
   /**
    * The factor by which the positions in the glTF primitive is scaled up when
    * the Unreal mesh is populated.
@@ -118,6 +170,36 @@ public:
    */
   static constexpr double positionScaleFactor = 1024.0;
 
+  /**
+   * The estimated sizes of the static mesh and of the collision mesh that
+   * belong to this primitive alone, as counted in the Cesium stats. Meshes
+   * shared through the CesiumMeshDepot are counted by the CesiumSharedMesh.
+   */
+  int64 MeshBytes = 0;
+  int64 PhysicsBytes = 0;
+
+  /**
+   * Adds to the estimated sizes of this primitive's meshes. They are removed
+   * from the Cesium stats when the primitive is destroyed.
+   */
+  void addMemory(int64 meshBytes, int64 physicsBytes);
+
+  /**
+   * Estimates the size of this primitive data on the CPU, including the maps
+   * and the feature and metadata descriptions that are copied out of the
+   * glTF. The accessor views themselves refer to the glTF's buffers, which are
+   * counted with the model.
+   */
+  int64 getSizeBytes() const;
+
+  /**
+   * Clears everything that refers into the glTF model, such as the model and
+   * primitive pointers and the accessor views. This is done as soon as a tile
+   * is unloaded, because cesium-native frees its model right away, while the
+   * rest of the primitive is torn down over the following frames.
+   */
+  void releaseModel();
+
   void destroy();
 };
 
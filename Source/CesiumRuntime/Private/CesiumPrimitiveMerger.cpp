@@ -0,0 +1,527 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumPrimitiveMerger.h"
+#include <CesiumGltf/ExtensionExtMeshFeatures.h>
+#include <CesiumGltf/ExtensionExtMeshGpuInstancing.h>
+#include <CesiumGltf/ExtensionMeshPrimitiveExtStructuralMetadata.h>
+#include <CesiumGltf/Model.h>
+#include <CesiumGltfContent/GltfUtilities.h>
+#include <CesiumUtility/Tracing.h>
+#include <algorithm>
+#include <cstring>
+#include <glm/gtc/matrix_inverse.hpp>
+#include <glm/mat3x3.hpp>
+#include <limits>
+#include <map>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace CesiumGltf;
+
+namespace {
+
+struct PrimitiveInstance {
+  int32_t nodeIndex;
+  int32_t meshIndex;
+  int32_t primitiveIndex;
+  glm::dmat4 transform;
+};
+
+const Accessor* getCopyableAccessor(const Model& model, int32_t index) {
+  const Accessor* pAccessor = Model::getSafe(&model.accessors, index);
+  if (!pAccessor || pAccessor->sparse || pAccessor->count <= 0) {
+    return nullptr;
+  }
+
+  const BufferView* pBufferView =
+      Model::getSafe(&model.bufferViews, pAccessor->bufferView);
+  if (!pBufferView) {
+    return nullptr;
+  }
+
+  const Buffer* pBuffer = Model::getSafe(&model.buffers, pBufferView->buffer);
+  if (!pBuffer) {
+    return nullptr;
+  }
+
+  const int64_t elementSize = pAccessor->computeNumberOfComponents() *
+                              pAccessor->computeByteSizeOfComponent();
+  const int64_t stride = pAccessor->computeByteStride(model);
+  if (elementSize <= 0 || stride < elementSize) {
+    return nullptr;
+  }
+
+  const int64_t end = pAccessor->byteOffset +
+                      stride * (pAccessor->count - 1) + elementSize;
+  if (end > pBufferView->byteLength ||
+      pBufferView->byteOffset + pBufferView->byteLength >
+          int64_t(pBuffer->cesium.data.size())) {
+    return nullptr;
+  }
+
+  return pAccessor;
+}
+
+const std::byte* getElement(
+    const Model& model,
+    const Accessor& accessor,
+    int64_t stride,
+    int64_t index) {
+  const BufferView& bufferView = model.bufferViews[accessor.bufferView];
+  const Buffer& buffer = model.buffers[bufferView.buffer];
+  return buffer.cesium.data.data() + bufferView.byteOffset +
+         accessor.byteOffset + stride * index;
+}
+
+bool isFloatAccessor(const Accessor& accessor, const std::string& type) {
+  return accessor.type == type &&
+         accessor.componentType == Accessor::ComponentType::FLOAT;
+}
+
+/**
+ * Describes everything that must be identical for two primitives to be merged,
+ * or returns std::nullopt if the primitive cannot be merged at all.
+ */
+std::optional<std::string> computeMergeKey(
+    const Model& model,
+    const Node& node,
+    const MeshPrimitive& primitive) {
+  if (node.hasExtension<ExtensionExtMeshGpuInstancing>() ||
+      primitive.mode != MeshPrimitive::Mode::TRIANGLES ||
+      !primitive.targets.empty() || !primitive.extras.empty()) {
+    return std::nullopt;
+  }
+
+  for (const auto& [name, extension] : primitive.extensions) {
+    if (name != ExtensionExtMeshFeatures::ExtensionName &&
+        name != ExtensionMeshPrimitiveExtStructuralMetadata::ExtensionName) {
+      return std::nullopt;
+    }
+  }
+
+  auto positionIt = primitive.attributes.find("POSITION");
+  if (positionIt == primitive.attributes.end()) {
+    return std::nullopt;
+  }
+
+  const Accessor* pPosition = getCopyableAccessor(model, positionIt->second);
+  if (!pPosition || !isFloatAccessor(*pPosition, Accessor::Type::VEC3)) {
+    return std::nullopt;
+  }
+
+  if (primitive.indices >= 0) {
+    const Accessor* pIndices = getCopyableAccessor(model, primitive.indices);
+    if (!pIndices || pIndices->type != Accessor::Type::SCALAR ||
+        pIndices->count % 3 != 0 ||
+        (pIndices->componentType != Accessor::ComponentType::UNSIGNED_BYTE &&
+         pIndices->componentType != Accessor::ComponentType::UNSIGNED_SHORT &&
+         pIndices->componentType != Accessor::ComponentType::UNSIGNED_INT)) {
+      return std::nullopt;
+    }
+  } else if (pPosition->count % 3 != 0) {
+    return std::nullopt;
+  }
+
+  std::string key = "material " + std::to_string(primitive.material) + "\n";
+
+  // Sort the attributes so that the key does not depend on their order.
+  const std::map<std::string, int32_t> attributes(
+      primitive.attributes.begin(),
+      primitive.attributes.end());
+  for (const auto& [name, accessorIndex] : attributes) {
+    const Accessor* pAccessor = getCopyableAccessor(model, accessorIndex);
+    if (!pAccessor || pAccessor->count != pPosition->count) {
+      return std::nullopt;
+    }
+    if ((name == "NORMAL" &&
+         !isFloatAccessor(*pAccessor, Accessor::Type::VEC3)) ||
+        (name == "TANGENT" &&
+         !isFloatAccessor(*pAccessor, Accessor::Type::VEC4))) {
+      return std::nullopt;
+    }
+
+    key += "attribute " + name + " " + pAccessor->type + " " +
+           std::to_string(pAccessor->componentType) + " " +
+           std::to_string(pAccessor->normalized) + "\n";
+  }
+
+  const ExtensionExtMeshFeatures* pFeatures =
+      primitive.getExtension<ExtensionExtMeshFeatures>();
+  if (pFeatures) {
+    for (const FeatureId& featureId : pFeatures->featureIds) {
+      key += "featureId";
+      if (featureId.attribute) {
+        key += " attribute " + std::to_string(*featureId.attribute);
+      } else if (featureId.texture && featureId.texture->extensions.empty()) {
+        key += " texture " + std::to_string(featureId.texture->index) + " " +
+               std::to_string(featureId.texture->texCoord) + " channels";
+        for (int64_t channel : featureId.texture->channels) {
+          key += " " + std::to_string(channel);
+        }
+      } else {
+        // Implicit feature IDs are the vertex indices, which change when
+        // primitives are merged.
+        return std::nullopt;
+      }
+
+      if (featureId.propertyTable) {
+        key += " table " + std::to_string(*featureId.propertyTable);
+      }
+      if (featureId.nullFeatureId) {
+        key += " null " + std::to_string(*featureId.nullFeatureId);
+      }
+      if (featureId.label) {
+        key += " label " + *featureId.label;
+      }
+      key += "\n";
+    }
+  }
+
+  const ExtensionMeshPrimitiveExtStructuralMetadata* pMetadata =
+      primitive.getExtension<ExtensionMeshPrimitiveExtStructuralMetadata>();
+  if (pMetadata) {
+    key += "propertyTextures";
+    for (int32_t index : pMetadata->propertyTextures) {
+      key += " " + std::to_string(index);
+    }
+    key += "\npropertyAttributes";
+    for (int32_t index : pMetadata->propertyAttributes) {
+      key += " " + std::to_string(index);
+    }
+    key += "\n";
+  }
+
+  return key;
+}
+
+int32_t addBufferView(
+    Model& model,
+    std::vector<std::byte>& data,
+    int32_t bufferIndex,
+    const std::vector<std::byte>& bytes) {
+  // Keep every buffer view aligned for its largest component type.
+  data.resize((data.size() + 3) & ~size_t(3));
+
+  BufferView& bufferView = model.bufferViews.emplace_back();
+  bufferView.buffer = bufferIndex;
+  bufferView.byteOffset = int64_t(data.size());
+  bufferView.byteLength = int64_t(bytes.size());
+
+  data.insert(data.end(), bytes.begin(), bytes.end());
+  return int32_t(model.bufferViews.size() - 1);
+}
+
+/**
+ * Merges the given primitives into a new primitive, in a new mesh used by a new
+ * node. The new node has the transform of the first primitive, and the
+ * positions of the others are transformed relative to it, so that they keep
+ * their precision.
+ */
+int32_t mergeGroup(
+    Model& model,
+    std::vector<std::byte>& data,
+    int32_t bufferIndex,
+    const std::vector<PrimitiveInstance>& group) {
+  // Copy the first primitive, because adding meshes invalidates references.
+  MeshPrimitive merged =
+      model.meshes[group[0].meshIndex].primitives[group[0].primitiveIndex];
+  const glm::dmat4 inverseBase = glm::inverse(group[0].transform);
+
+  std::vector<glm::dmat4> transforms;
+  std::vector<int64_t> vertexOffsets;
+  int64_t vertexCount = 0;
+  for (const PrimitiveInstance& instance : group) {
+    const MeshPrimitive& primitive =
+        model.meshes[instance.meshIndex].primitives[instance.primitiveIndex];
+    transforms.emplace_back(inverseBase * instance.transform);
+    vertexOffsets.emplace_back(vertexCount);
+    vertexCount +=
+        model.accessors[primitive.attributes.at("POSITION")].count;
+  }
+
+  for (auto& [name, mergedAccessorIndex] : merged.attributes) {
+    const Accessor& firstAccessor = model.accessors[mergedAccessorIndex];
+    const int64_t elementSize = firstAccessor.computeNumberOfComponents() *
+                                firstAccessor.computeByteSizeOfComponent();
+    std::vector<std::byte> bytes(size_t(vertexCount * elementSize));
+
+    const bool isPosition = name == "POSITION";
+    const bool isNormal = name == "NORMAL";
+    const bool isTangent = name == "TANGENT";
+
+    glm::dvec3 min(std::numeric_limits<double>::max());
+    glm::dvec3 max(std::numeric_limits<double>::lowest());
+
+    for (size_t i = 0; i < group.size(); ++i) {
+      const MeshPrimitive& primitive =
+          model.meshes[group[i].meshIndex].primitives[group[i].primitiveIndex];
+      const Accessor& accessor = model.accessors[primitive.attributes.at(name)];
+      const int64_t stride = accessor.computeByteStride(model);
+      const glm::dmat4& transform = transforms[i];
+      const glm::dmat3 normalMatrix =
+          glm::inverseTranspose(glm::dmat3(transform));
+      const double handedness =
+          glm::determinant(glm::dmat3(transform)) < 0.0 ? -1.0 : 1.0;
+
+      for (int64_t j = 0; j < accessor.count; ++j) {
+        const std::byte* pSource = getElement(model, accessor, stride, j);
+        std::byte* pTarget =
+            bytes.data() + (vertexOffsets[i] + j) * elementSize;
+
+        if (isPosition) {
+          glm::vec3 position;
+          std::memcpy(&position, pSource, sizeof(position));
+          const glm::dvec3 transformed =
+              glm::dvec3(transform * glm::dvec4(glm::dvec3(position), 1.0));
+          min = glm::min(min, transformed);
+          max = glm::max(max, transformed);
+          position = glm::vec3(transformed);
+          std::memcpy(pTarget, &position, sizeof(position));
+        } else if (isNormal) {
+          glm::vec3 normal;
+          std::memcpy(&normal, pSource, sizeof(normal));
+          glm::dvec3 transformed = normalMatrix * glm::dvec3(normal);
+          const double length = glm::length(transformed);
+          if (length > 0.0) {
+            transformed /= length;
+          }
+          normal = glm::vec3(transformed);
+          std::memcpy(pTarget, &normal, sizeof(normal));
+        } else if (isTangent) {
+          glm::vec4 tangent;
+          std::memcpy(&tangent, pSource, sizeof(tangent));
+          glm::dvec3 transformed =
+              glm::dmat3(transform) * glm::dvec3(tangent);
+          const double length = glm::length(transformed);
+          if (length > 0.0) {
+            transformed /= length;
+          }
+          // A mirroring transform flips the bitangent.
+          tangent = glm::vec4(
+              glm::vec3(transformed),
+              float(double(tangent.w) * handedness));
+          std::memcpy(pTarget, &tangent, sizeof(tangent));
+        } else {
+          std::memcpy(pTarget, pSource, size_t(elementSize));
+        }
+      }
+    }
+
+    Accessor mergedAccessor;
+    mergedAccessor.bufferView = addBufferView(model, data, bufferIndex, bytes);
+    mergedAccessor.type = firstAccessor.type;
+    mergedAccessor.componentType = firstAccessor.componentType;
+    mergedAccessor.normalized = firstAccessor.normalized;
+    mergedAccessor.count = vertexCount;
+    if (isPosition) {
+      mergedAccessor.min = {min.x, min.y, min.z};
+      mergedAccessor.max = {max.x, max.y, max.z};
+    }
+
+    model.accessors.emplace_back(std::move(mergedAccessor));
+    mergedAccessorIndex = int32_t(model.accessors.size() - 1);
+  }
+
+  std::vector<uint32_t> indices;
+  for (size_t i = 0; i < group.size(); ++i) {
+    const MeshPrimitive& primitive =
+        model.meshes[group[i].meshIndex].primitives[group[i].primitiveIndex];
+    const size_t firstIndex = indices.size();
+    const uint32_t offset = uint32_t(vertexOffsets[i]);
+
+    if (primitive.indices >= 0) {
+      const Accessor& accessor = model.accessors[primitive.indices];
+      const int64_t stride = accessor.computeByteStride(model);
+      const int64_t componentSize = accessor.computeByteSizeOfComponent();
+      for (int64_t j = 0; j < accessor.count; ++j) {
+        const std::byte* pSource = getElement(model, accessor, stride, j);
+        uint32_t index = 0;
+        if (componentSize == 1) {
+          index = uint32_t(*reinterpret_cast<const uint8_t*>(pSource));
+        } else if (componentSize == 2) {
+          uint16_t value;
+          std::memcpy(&value, pSource, sizeof(value));
+          index = uint32_t(value);
+        } else {
+          std::memcpy(&index, pSource, sizeof(index));
+        }
+        indices.emplace_back(index + offset);
+      }
+    } else {
+      const int64_t count =
+          model.accessors[primitive.attributes.at("POSITION")].count;
+      for (int64_t j = 0; j < count; ++j) {
+        indices.emplace_back(uint32_t(j) + offset);
+      }
+    }
+
+    // Baking a mirroring transform into the positions reverses the winding
+    // order of the triangles.
+    if (glm::determinant(glm::dmat3(transforms[i])) < 0.0) {
+      for (size_t j = firstIndex; j + 2 < indices.size(); j += 3) {
+        std::swap(indices[j + 1], indices[j + 2]);
+      }
+    }
+  }
+
+  std::vector<std::byte> indexBytes(indices.size() * sizeof(uint32_t));
+  std::memcpy(indexBytes.data(), indices.data(), indexBytes.size());
+
+  Accessor& indexAccessor = model.accessors.emplace_back();
+  indexAccessor.bufferView =
+      addBufferView(model, data, bufferIndex, indexBytes);
+  indexAccessor.type = Accessor::Type::SCALAR;
+  indexAccessor.componentType = Accessor::ComponentType::UNSIGNED_INT;
+  indexAccessor.count = int64_t(indices.size());
+  merged.indices = int32_t(model.accessors.size() - 1);
+
+  // Each primitive counts its own features, so the merged primitive has at
+  // most the sum of them.
+  ExtensionExtMeshFeatures* pFeatures =
+      merged.getExtension<ExtensionExtMeshFeatures>();
+  if (pFeatures) {
+    for (size_t i = 0; i < pFeatures->featureIds.size(); ++i) {
+      int64_t featureCount = 0;
+      for (const PrimitiveInstance& instance : group) {
+        const ExtensionExtMeshFeatures* pSourceFeatures =
+            model.meshes[instance.meshIndex]
+                .primitives[instance.primitiveIndex]
+                .getExtension<ExtensionExtMeshFeatures>();
+        featureCount += pSourceFeatures->featureIds[i].featureCount;
+      }
+      pFeatures->featureIds[i].featureCount = featureCount;
+    }
+  }
+
+  Mesh& mesh = model.meshes.emplace_back();
+  mesh.primitives.emplace_back(std::move(merged));
+
+  Node& node = model.nodes.emplace_back();
+  node.mesh = int32_t(model.meshes.size() - 1);
+  const glm::dmat4& base = group[0].transform;
+  node.matrix.reserve(16);
+  for (glm::length_t column = 0; column < 4; ++column) {
+    for (glm::length_t row = 0; row < 4; ++row) {
+      node.matrix.emplace_back(base[column][row]);
+    }
+  }
+
+  return int32_t(model.nodes.size() - 1);
+}
+
+} // namespace
+
+namespace CesiumPrimitiveMerger {
+
+int32_t mergePrimitives(Model& model) {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::MergePrimitives)
+
+  // Use the same scene that is loaded. Without a scene, there is nowhere to
+  // add the merged primitives.
+  Scene* pScene = Model::getSafe(&model.scenes, model.scene);
+  if (!pScene && !model.scenes.empty()) {
+    pScene = &model.scenes[0];
+  }
+  if (!pScene) {
+    return 0;
+  }
+  const int32_t sceneIndex = int32_t(pScene - model.scenes.data());
+
+  std::vector<std::string> keys;
+  std::unordered_map<std::string, std::vector<PrimitiveInstance>> groups;
+
+  model.forEachPrimitiveInScene(
+      sceneIndex,
+      [&keys, &groups](
+          Model& gltf,
+          Node& node,
+          Mesh& mesh,
+          MeshPrimitive& primitive,
+          const glm::dmat4& transform) {
+        std::optional<std::string> maybeKey =
+            computeMergeKey(gltf, node, primitive);
+        if (!maybeKey) {
+          return;
+        }
+
+        std::vector<PrimitiveInstance>& group = groups[*maybeKey];
+        if (group.empty()) {
+          keys.emplace_back(std::move(*maybeKey));
+        }
+        group.emplace_back(PrimitiveInstance{
+            int32_t(&node - gltf.nodes.data()),
+            int32_t(&mesh - gltf.meshes.data()),
+            int32_t(&primitive - mesh.primitives.data()),
+            transform});
+      });
+
+  std::vector<std::byte> data;
+  const int32_t bufferIndex = int32_t(model.buffers.size());
+  std::vector<int32_t> mergedNodes;
+  std::unordered_map<int32_t, std::vector<int32_t>> mergedPrimitivesByNode;
+  int32_t mergedCount = 0;
+
+  for (const std::string& key : keys) {
+    const std::vector<PrimitiveInstance>& group = groups[key];
+    if (group.size() < 2) {
+      continue;
+    }
+
+    mergedNodes.emplace_back(mergeGroup(model, data, bufferIndex, group));
+    mergedCount += int32_t(group.size() - 1);
+    for (const PrimitiveInstance& instance : group) {
+      mergedPrimitivesByNode[instance.nodeIndex].emplace_back(
+          instance.primitiveIndex);
+    }
+  }
+
+  if (mergedNodes.empty()) {
+    return 0;
+  }
+
+  Buffer& buffer = model.buffers.emplace_back();
+  buffer.byteLength = int64_t(data.size());
+  buffer.cesium.data = std::move(data);
+
+  // Give each node a new mesh with only the primitives that were not merged,
+  // because its original mesh may also be used by other nodes.
+  for (const auto& [nodeIndex, primitiveIndices] : mergedPrimitivesByNode) {
+    Mesh remaining = model.meshes[model.nodes[nodeIndex].mesh];
+    std::vector<MeshPrimitive> primitives;
+    for (size_t i = 0; i < remaining.primitives.size(); ++i) {
+      if (std::find(
+              primitiveIndices.begin(),
+              primitiveIndices.end(),
+              int32_t(i)) == primitiveIndices.end()) {
+        primitives.emplace_back(std::move(remaining.primitives[i]));
+      }
+    }
+
+    if (primitives.empty()) {
+      model.nodes[nodeIndex].mesh = -1;
+    } else {
+      remaining.primitives = std::move(primitives);
+      model.meshes.emplace_back(std::move(remaining));
+      model.nodes[nodeIndex].mesh = int32_t(model.meshes.size() - 1);
+    }
+  }
+
+  model.scenes[sceneIndex].nodes.insert(
+      model.scenes[sceneIndex].nodes.end(),
+      mergedNodes.begin(),
+      mergedNodes.end());
+
+  // The merged data is a copy, so drop the source data that nothing else
+  // references. Otherwise the tile would hold every merged vertex twice.
+  CesiumGltfContent::GltfUtilities::removeUnusedMeshes(model);
+  CesiumGltfContent::GltfUtilities::removeUnusedAccessors(model);
+  CesiumGltfContent::GltfUtilities::removeUnusedBufferViews(model);
+  CesiumGltfContent::GltfUtilities::removeUnusedBuffers(model);
+  CesiumGltfContent::GltfUtilities::compactBuffers(model);
+
+  return mergedCount;
+}
+
+} // namespace CesiumPrimitiveMerger
@@ -0,0 +1,41 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include <cstdint>
+
+namespace CesiumGltf {
+struct Model;
+}
+
+/**
+ * Combines the primitives of a tile's glTF so that fewer Unreal components,
+ * static meshes, and draw calls are needed to render it. This is done in the
+ * load thread, before the primitives are loaded.
+ */
+namespace CesiumPrimitiveMerger {
+
+/**
+ * Merges the triangle primitives in the scene of the given model that share a
+ * material and a vertex layout into a single primitive each.
+ *
+ * Each merged primitive is added to the scene in a new node, which has the
+ * transform of the first primitive of its group. The positions, normals, and
+ * tangents of the other primitives are transformed relative to that node, so
+ * that they keep their precision. Nodes keep the primitives that were not
+ * merged. The meshes, accessors, and buffer data that only the merged
+ * primitives used are removed from the model.
+ *
+ * Feature ID attributes, feature ID textures, and property attributes are
+ * concatenated like any other vertex attribute, so the feature IDs of every
+ * vertex and face are unchanged. Primitives are only merged when they
+ * reference the same property tables, property textures, and property
+ * attributes in the same way. Primitives with implicit feature IDs, morph
+ * targets, GPU instancing, or other extensions and extras are left alone.
+ *
+ * @param model The model to modify.
+ * @return The number of primitives that were merged into others.
+ */
+int32_t mergePrimitives(CesiumGltf::Model& model);
+
+} // namespace CesiumPrimitiveMerger
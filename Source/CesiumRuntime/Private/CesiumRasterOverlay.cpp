@@ -42,6 +42,13 @@ void UCesiumRasterOverlay::AddToTileset() {
     return;
   }
 
+  // A collision-only tileset never draws its tiles, so there is nothing to
+  // drape this overlay on.
+  ACesium3DTileset* pActor = this->GetOwner<ACesium3DTileset>();
+  if (pActor && pActor->IsCollisionOnly()) {
+    return;
+  }
+
   Cesium3DTilesSelection::Tileset* pTileset = FindTileset();
   if (!pTileset) {
     return;
@@ -178,6 +185,19 @@ void UCesiumRasterOverlay::SetSubTileCacheBytes(int64 Value) {
   }
 }
 
+void UCesiumRasterOverlay::ApplyTileBudgetScale(double Scale) {
+  if (!this->_pOverlay) {
+    return;
+  }
+
+  CesiumRasterOverlays::RasterOverlayOptions& options =
+      this->_pOverlay->getOptions();
+  options.maximumSimultaneousTileLoads = FMath::Max(
+      1,
+      FMath::RoundToInt32(this->MaximumSimultaneousTileLoads * Scale));
+  options.subTileCacheBytes = int64(double(this->SubTileCacheBytes) * Scale);
+}
+
 void UCesiumRasterOverlay::Activate(bool bReset) {
   Super::Activate(bReset);
   this->AddToTileset();
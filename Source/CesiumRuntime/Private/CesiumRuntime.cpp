@@ -4,8 +4,10 @@
 #include "Cesium3DTilesContent/registerAllTileContentTypes.h"
 #include "CesiumAsync/CachingAssetAccessor.h"
 #include "CesiumAsync/GunzipAssetAccessor.h"
+#include "CesiumAsync/ICacheDatabase.h"
 #include "CesiumAsync/SqliteCache.h"
 #include "CesiumRuntimeSettings.h"
+#include "CesiumStats.h"
 #include "CesiumUtility/Tracing.h"
 #include "HAL/FileManager.h"
 #include "HttpModule.h"
@@ -98,6 +100,57 @@ std::string getCacheDatabaseName() {
   return TCHAR_TO_UTF8(*PlatformAbsolutePath);
 }
 
+/**
+ * Counts the responses that the request cache finds, so that the requests it
+ * answers can be told apart from those that reach the UnrealAssetAccessor.
+ * Requests with other verbs than GET never look in the cache.
+ */
+class CountingCacheDatabase : public CesiumAsync::ICacheDatabase {
+public:
+  CountingCacheDatabase(
+      const std::shared_ptr<CesiumAsync::ICacheDatabase>& pCacheDatabase)
+      : _pCacheDatabase(pCacheDatabase) {}
+
+  virtual std::optional<CesiumAsync::CacheItem>
+  getEntry(const std::string& key) const override {
+    std::optional<CesiumAsync::CacheItem> result =
+        this->_pCacheDatabase->getEntry(key);
+    if (result) {
+      CesiumStats::recordCachedResponse();
+    }
+    return result;
+  }
+
+  virtual bool storeEntry(
+      const std::string& key,
+      std::time_t expiryTime,
+      const std::string& url,
+      const std::string& requestMethod,
+      const CesiumAsync::HttpHeaders& requestHeaders,
+      uint16_t statusCode,
+      const CesiumAsync::HttpHeaders& responseHeaders,
+      const std::span<const std::byte>& responseData) override {
+    return this->_pCacheDatabase->storeEntry(
+        key,
+        expiryTime,
+        url,
+        requestMethod,
+        requestHeaders,
+        statusCode,
+        responseHeaders,
+        responseData);
+  }
+
+  virtual bool prune() override { return this->_pCacheDatabase->prune(); }
+
+  virtual bool clearAll() override {
+    return this->_pCacheDatabase->clearAll();
+  }
+
+private:
+  std::shared_ptr<CesiumAsync::ICacheDatabase> _pCacheDatabase;
+};
+
 } // namespace
 
 std::shared_ptr<CesiumAsync::ICacheDatabase>& getCacheDatabase() {
@@ -121,7 +174,7 @@ const std::shared_ptr<CesiumAsync::IAssetAccessor>& getAssetAccessor() {
           std::make_shared<CesiumAsync::CachingAssetAccessor>(
               spdlog::default_logger(),
               std::make_shared<UnrealAssetAccessor>(),
-              getCacheDatabase(),
+              std::make_shared<CountingCacheDatabase>(getCacheDatabase()),
               RequestsPerCachePrune));
   return pAssetAccessor;
 }
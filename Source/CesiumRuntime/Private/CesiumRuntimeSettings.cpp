@@ -6,4 +6,12 @@ UCesiumRuntimeSettings::UCesiumRuntimeSettings(
     const FObjectInitializer& ObjectInitializer)
     : Super(ObjectInitializer) {
   CategoryName = FName(TEXT("Plugins"));
+
+  FCesiumFoveationRing& fovea = FoveationRings.Emplace_GetRef();
+  fovea.Angle = 15.0;
+  fovea.ScreenSpaceErrorScale = 1.0;
+
+  FCesiumFoveationRing& parafovea = FoveationRings.Emplace_GetRef();
+  parafovea.Angle = 35.0;
+  parafovea.ScreenSpaceErrorScale = 2.0;
 }
@@ -0,0 +1,79 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumScreenSpaceErrorGovernor.h"
+
+namespace {
+// The time constant, in seconds, of the exponential moving average applied to
+// the frame time, so that single-frame hitches do not reduce the level of
+// detail.
+constexpr double FrameTimeSmoothingSeconds = 0.5;
+
+double computePressure(double value, double target) {
+  return target > 0.0 ? value / target : 0.0;
+}
+} // namespace
+
+void CesiumScreenSpaceErrorGovernor::update(
+    const CesiumScreenSpaceErrorGovernorTargets& targets,
+    double frameTimeMilliseconds,
+    int64 memoryBytes,
+    int64 tileCount,
+    double deltaTime) {
+  FCesiumAdaptiveScreenSpaceErrorState& state = this->_state;
+  deltaTime = FMath::Max(deltaTime, 0.0);
+
+  if (state.FrameTime <= 0.0) {
+    state.FrameTime = frameTimeMilliseconds;
+  } else {
+    const double alpha =
+        1.0 - FMath::Exp(-deltaTime / FrameTimeSmoothingSeconds);
+    state.FrameTime += alpha * (frameTimeMilliseconds - state.FrameTime);
+  }
+
+  state.FrameTimePressure =
+      computePressure(state.FrameTime, targets.frameTimeMilliseconds);
+  state.MemoryPressure =
+      computePressure(double(memoryBytes), double(targets.memoryBytes));
+  state.TileCountPressure =
+      computePressure(double(tileCount), double(targets.tileCount));
+
+  double pressure = state.FrameTimePressure;
+  ECesiumAdaptiveScreenSpaceErrorLimit limit =
+      ECesiumAdaptiveScreenSpaceErrorLimit::FrameTime;
+  if (state.MemoryPressure > pressure) {
+    pressure = state.MemoryPressure;
+    limit = ECesiumAdaptiveScreenSpaceErrorLimit::Memory;
+  }
+  if (state.TileCountPressure > pressure) {
+    pressure = state.TileCountPressure;
+    limit = ECesiumAdaptiveScreenSpaceErrorLimit::TileCount;
+  }
+
+  const double hysteresis = FMath::Max(targets.hysteresis, 0.0);
+  const double step = 1.0 + FMath::Max(targets.adjustmentRate, 0.0) * deltaTime;
+  const double maximumScale = FMath::Max(targets.maximumScale, 1.0);
+
+  if (pressure > 1.0 + hysteresis) {
+    state.ScreenSpaceErrorScale =
+        FMath::Min(state.ScreenSpaceErrorScale * step, maximumScale);
+    state.LimitingFactor = limit;
+  } else if (pressure < 1.0 - hysteresis) {
+    state.ScreenSpaceErrorScale =
+        FMath::Max(state.ScreenSpaceErrorScale / step, 1.0);
+    state.LimitingFactor = ECesiumAdaptiveScreenSpaceErrorLimit::None;
+  } else {
+    state.ScreenSpaceErrorScale =
+        FMath::Clamp(state.ScreenSpaceErrorScale, 1.0, maximumScale);
+  }
+
+  // Loading tiles costs main thread time, so fewer simultaneous loads only
+  // helps with the frame time, not with memory or the tile count.
+  if (!targets.adjustTileLoads) {
+    state.TileLoadScale = 1.0;
+  } else if (state.FrameTimePressure > 1.0 + hysteresis) {
+    state.TileLoadScale =
+        FMath::Max(state.TileLoadScale / step, MinimumTileLoadScale);
+  } else if (state.FrameTimePressure < 1.0 - hysteresis) {
+    state.TileLoadScale = FMath::Min(state.TileLoadScale * step, 1.0);
+  }
+}
@@ -0,0 +1,96 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CesiumAdaptiveScreenSpaceErrorState.h"
+#include "CoreMinimal.h"
+
+/**
+ * The targets that a {@link CesiumScreenSpaceErrorGovernor} adapts to. A
+ * target of zero is ignored.
+ */
+struct CesiumScreenSpaceErrorGovernorTargets {
+  double frameTimeMilliseconds = 0.0;
+  int64 memoryBytes = 0;
+  int64 tileCount = 0;
+
+  /**
+   * The largest factor that the maximum screen-space error may be multiplied
+   * by.
+   */
+  double maximumScale = 4.0;
+
+  /**
+   * The fraction by which a measurement must be over or under its target
+   * before the governor reacts.
+   */
+  double hysteresis = 0.1;
+
+  /**
+   * The fraction by which the scales change per second while a target is
+   * exceeded or has headroom.
+   */
+  double adjustmentRate = 0.5;
+
+  /**
+   * Whether to also reduce the number of simultaneous tile loads when the
+   * frame time is over its target.
+   */
+  bool adjustTileLoads = false;
+};
+
+/**
+ * Continuously adjusts a tileset's maximum screen-space error, and optionally
+ * its number of simultaneous tile loads, to keep the frame time, tile memory,
+ * and rendered tile count within their targets.
+ *
+ * The level of detail is only reduced while a measurement is over its target
+ * by more than the hysteresis, and only restored while all measurements are
+ * under their targets by more than the hysteresis. Between the two, the
+ * current scales are held, which prevents the level of detail from
+ * oscillating around a target.
+ */
+class CesiumScreenSpaceErrorGovernor {
+public:
+  /**
+   * Updates the scales from this frame's measurements.
+   *
+   * @param targets The targets to adapt to.
+   * @param frameTimeMilliseconds The time taken by the last frame.
+   * @param memoryBytes The size of the tileset's loaded tile data.
+   * @param tileCount The number of tiles rendered this frame.
+   * @param deltaTime The time since the last update, in seconds.
+   */
+  void update(
+      const CesiumScreenSpaceErrorGovernorTargets& targets,
+      double frameTimeMilliseconds,
+      int64 memoryBytes,
+      int64 tileCount,
+      double deltaTime);
+
+  /**
+   * Restores the full level of detail and forgets past measurements.
+   */
+  void reset() { this->_state = FCesiumAdaptiveScreenSpaceErrorState(); }
+
+  double getScreenSpaceErrorScale() const {
+    return this->_state.ScreenSpaceErrorScale;
+  }
+
+  double getTileLoadScale() const { return this->_state.TileLoadScale; }
+
+  const FCesiumAdaptiveScreenSpaceErrorState& getState() const {
+    return this->_state;
+  }
+
+  FCesiumAdaptiveScreenSpaceErrorState& getState() { return this->_state; }
+
+  /**
+   * The smallest factor that the number of simultaneous tile loads may be
+   * multiplied by.
+   */
+  static constexpr double MinimumTileLoadScale = 0.25;
+
+private:
+  FCesiumAdaptiveScreenSpaceErrorState _state;
+};
@@ -0,0 +1,182 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumStats.h"
+#include "CesiumAdaptiveScreenSpaceErrorState.h"
+#include "CoreGlobals.h"
+#include "HAL/CriticalSection.h"
+#include "Misc/ScopeLock.h"
+#include "StaticMeshResources.h"
+#include "Trace/Trace.inl"
+#include <atomic>
+#include <unordered_map>
+
+DEFINE_STAT(STAT_CesiumTilesLoading);
+DEFINE_STAT(STAT_CesiumTilesLoaded);
+DEFINE_STAT(STAT_CesiumTilesRendered);
+DEFINE_STAT(STAT_CesiumTilesCulled);
+DEFINE_STAT(STAT_CesiumTilesOccluded);
+DEFINE_STAT(STAT_CesiumWorkerThreadLoadQueue);
+DEFINE_STAT(STAT_CesiumMainThreadLoadQueue);
+DEFINE_STAT(STAT_CesiumAdaptiveScreenSpaceError);
+DEFINE_STAT(STAT_CesiumAdaptiveScreenSpaceErrorScale);
+DEFINE_STAT(STAT_CesiumAdaptiveTileLoads);
+DEFINE_STAT(STAT_CesiumAdaptiveLimitingFactor);
+DEFINE_STAT(STAT_CesiumAdaptiveFrameTimePressure);
+DEFINE_STAT(STAT_CesiumAdaptiveMemoryPressure);
+DEFINE_STAT(STAT_CesiumAdaptiveTileCountPressure);
+DEFINE_STAT(STAT_CesiumHttpRequestsInFlight);
+DEFINE_STAT(STAT_CesiumCacheHits);
+DEFINE_STAT(STAT_CesiumMeshMemory);
+DEFINE_STAT(STAT_CesiumTextureMemory);
+DEFINE_STAT(STAT_CesiumPhysicsMemory);
+DEFINE_STAT(STAT_CesiumMetadataMemory);
+
+UE_TRACE_CHANNEL_DEFINE(CesiumChannel)
+
+UE_TRACE_EVENT_BEGIN(Cesium, TileStage)
+  UE_TRACE_EVENT_FIELD(uint64, StartCycle)
+  UE_TRACE_EVENT_FIELD(uint64, EndCycle)
+  UE_TRACE_EVENT_FIELD(uint8, Stage)
+  UE_TRACE_EVENT_FIELD(UE::Trace::AnsiString, TileId)
+  UE_TRACE_EVENT_FIELD(UE::Trace::AnsiString, Url)
+UE_TRACE_EVENT_END()
+
+namespace {
+
+std::atomic<int64> cachedResponseCount = 0;
+std::atomic<int64> revalidationCount = 0;
+
+uint64 adaptiveStatsFrame = 0;
+double adaptiveStatsScale = 0.0;
+
+void updateCacheHits() {
+  SET_DWORD_STAT(STAT_CesiumCacheHits, CesiumStats::getCacheHits());
+}
+
+// Requests that are not for tile content, like those of tileset.json files
+// and raster overlay images, are never taken, so only this many are kept.
+constexpr size_t MaximumNetworkRequestEnds = 4096;
+
+FCriticalSection networkRequestEndsLock;
+std::unordered_map<std::string, uint64> networkRequestEnds;
+
+} // namespace
+
+namespace CesiumStats {
+
+void recordCachedResponse() {
+  ++cachedResponseCount;
+  updateCacheHits();
+}
+
+void recordRevalidation() {
+  ++revalidationCount;
+  updateCacheHits();
+}
+
+int64 getCacheHits() {
+  // A revalidation follows the lookup that found its response, so this is
+  // only briefly too high.
+  return FMath::Max<int64>(0, cachedResponseCount - revalidationCount);
+}
+
+void recordAdaptiveScreenSpaceError(
+    const FCesiumAdaptiveScreenSpaceErrorState& state) {
+  // The counters are reset every frame, so only compare against the tilesets
+  // already recorded in this one.
+  if (adaptiveStatsFrame == GFrameCounter &&
+      state.ScreenSpaceErrorScale <= adaptiveStatsScale) {
+    return;
+  }
+  adaptiveStatsFrame = GFrameCounter;
+  adaptiveStatsScale = state.ScreenSpaceErrorScale;
+
+  SET_FLOAT_STAT(
+      STAT_CesiumAdaptiveScreenSpaceError,
+      state.EffectiveMaximumScreenSpaceError);
+  SET_FLOAT_STAT(
+      STAT_CesiumAdaptiveScreenSpaceErrorScale,
+      state.ScreenSpaceErrorScale);
+  SET_DWORD_STAT(
+      STAT_CesiumAdaptiveTileLoads,
+      state.EffectiveMaximumSimultaneousTileLoads);
+  SET_DWORD_STAT(
+      STAT_CesiumAdaptiveLimitingFactor,
+      uint32(state.LimitingFactor));
+  SET_FLOAT_STAT(
+      STAT_CesiumAdaptiveFrameTimePressure,
+      state.FrameTimePressure);
+  SET_FLOAT_STAT(STAT_CesiumAdaptiveMemoryPressure, state.MemoryPressure);
+  SET_FLOAT_STAT(
+      STAT_CesiumAdaptiveTileCountPressure,
+      state.TileCountPressure);
+}
+
+int64 getRenderDataBytes(const FStaticMeshRenderData* pRenderData) {
+  if (!pRenderData) {
+    return 0;
+  }
+
+  FResourceSizeEx size(EResourceSizeMode::Exclusive);
+  pRenderData->GetResourceSizeEx(size);
+  return int64(size.GetTotalMemoryBytes());
+}
+
+} // namespace CesiumStats
+
+namespace CesiumTrace {
+
+bool isEnabled() {
+#if UE_TRACE_ENABLED
+  return UE_TRACE_CHANNELEXPR_IS_ENABLED(CesiumChannel);
+#else
+  return false;
+#endif
+}
+
+void traceTileStage(
+    TileStage stage,
+    uint64 startCycle,
+    uint64 endCycle,
+    const std::string& tileId,
+    const std::string& url) {
+  UE_TRACE_LOG(Cesium, TileStage, CesiumChannel)
+      << TileStage.StartCycle(startCycle) << TileStage.EndCycle(endCycle)
+      << TileStage.Stage(uint8(stage))
+      << TileStage.TileId(tileId.data(), int32(tileId.size()))
+      << TileStage.Url(url.data(), int32(url.size()));
+}
+
+void traceNetworkRequest(
+    const std::string& url,
+    uint64 requestCycle,
+    uint64 startCycle,
+    uint64 endCycle) {
+  traceTileStage(
+      TileStage::Request,
+      requestCycle,
+      startCycle,
+      std::string(),
+      url);
+  traceTileStage(TileStage::Network, startCycle, endCycle, std::string(), url);
+
+  FScopeLock lock(&networkRequestEndsLock);
+  if (networkRequestEnds.size() >= MaximumNetworkRequestEnds) {
+    networkRequestEnds.clear();
+  }
+  networkRequestEnds[url] = endCycle;
+}
+
+std::optional<uint64> takeNetworkRequestEnd(const std::string& url) {
+  FScopeLock lock(&networkRequestEndsLock);
+  auto it = networkRequestEnds.find(url);
+  if (it == networkRequestEnds.end()) {
+    return std::nullopt;
+  }
+
+  uint64 endCycle = it->second;
+  networkRequestEnds.erase(it);
+  return endCycle;
+}
+
+} // namespace CesiumTrace
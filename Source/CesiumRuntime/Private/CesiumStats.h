@@ -0,0 +1,226 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "Trace/Trace.h"
+#include <cstdint>
+#include <optional>
+#include <string>
+
+class FStaticMeshRenderData;
+struct FCesiumAdaptiveScreenSpaceErrorState;
+
+/**
+ * Cesium's counters, shown in the editor and in game with `stat Cesium`.
+ *
+ * The tile counters are reset every frame and summed over all tilesets. The
+ * memory counters are estimates of the memory that tiles use on the CPU and
+ * the GPU, and are also summed over all tilesets. The adaptive screen-space
+ * error counters show the tileset whose level of detail is reduced the most
+ * in the current frame.
+ */
+DECLARE_STATS_GROUP(TEXT("Cesium"), STATGROUP_Cesium, STATCAT_Advanced);
+
+DECLARE_DWORD_COUNTER_STAT_EXTERN(
+    TEXT("Tiles Loading"),
+    STAT_CesiumTilesLoading,
+    STATGROUP_Cesium, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(
+    TEXT("Tiles Loaded"),
+    STAT_CesiumTilesLoaded,
+    STATGROUP_Cesium, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(
+    TEXT("Tiles Rendered"),
+    STAT_CesiumTilesRendered,
+    STATGROUP_Cesium, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(
+    TEXT("Tiles Culled"),
+    STAT_CesiumTilesCulled,
+    STATGROUP_Cesium, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(
+    TEXT("Tiles Occluded"),
+    STAT_CesiumTilesOccluded,
+    STATGROUP_Cesium, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(
+    TEXT("Worker Thread Load Queue"),
+    STAT_CesiumWorkerThreadLoadQueue,
+    STATGROUP_Cesium, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(
+    TEXT("Main Thread Load Queue"),
+    STAT_CesiumMainThreadLoadQueue,
+    STATGROUP_Cesium, );
+
+DECLARE_FLOAT_COUNTER_STAT_EXTERN(
+    TEXT("Adaptive Maximum Screen Space Error"),
+    STAT_CesiumAdaptiveScreenSpaceError,
+    STATGROUP_Cesium, );
+DECLARE_FLOAT_COUNTER_STAT_EXTERN(
+    TEXT("Adaptive Screen Space Error Scale"),
+    STAT_CesiumAdaptiveScreenSpaceErrorScale,
+    STATGROUP_Cesium, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(
+    TEXT("Adaptive Maximum Simultaneous Tile Loads"),
+    STAT_CesiumAdaptiveTileLoads,
+    STATGROUP_Cesium, );
+// The value of ECesiumAdaptiveScreenSpaceErrorLimit: 0 for none, 1 for frame
+// time, 2 for memory, and 3 for tile count.
+DECLARE_DWORD_COUNTER_STAT_EXTERN(
+    TEXT("Adaptive Limiting Factor"),
+    STAT_CesiumAdaptiveLimitingFactor,
+    STATGROUP_Cesium, );
+DECLARE_FLOAT_COUNTER_STAT_EXTERN(
+    TEXT("Adaptive Frame Time Pressure"),
+    STAT_CesiumAdaptiveFrameTimePressure,
+    STATGROUP_Cesium, );
+DECLARE_FLOAT_COUNTER_STAT_EXTERN(
+    TEXT("Adaptive Memory Pressure"),
+    STAT_CesiumAdaptiveMemoryPressure,
+    STATGROUP_Cesium, );
+DECLARE_FLOAT_COUNTER_STAT_EXTERN(
+    TEXT("Adaptive Tile Count Pressure"),
+    STAT_CesiumAdaptiveTileCountPressure,
+    STATGROUP_Cesium, );
+
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(
+    TEXT("HTTP Requests In Flight"),
+    STAT_CesiumHttpRequestsInFlight,
+    STATGROUP_Cesium, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(
+    TEXT("Cache Hits"),
+    STAT_CesiumCacheHits,
+    STATGROUP_Cesium, );
+
+DECLARE_MEMORY_STAT_EXTERN(
+    TEXT("Mesh Memory"),
+    STAT_CesiumMeshMemory,
+    STATGROUP_Cesium, );
+DECLARE_MEMORY_STAT_EXTERN(
+    TEXT("Texture Memory"),
+    STAT_CesiumTextureMemory,
+    STATGROUP_Cesium, );
+DECLARE_MEMORY_STAT_EXTERN(
+    TEXT("Physics Memory"),
+    STAT_CesiumPhysicsMemory,
+    STATGROUP_Cesium, );
+DECLARE_MEMORY_STAT_EXTERN(
+    TEXT("Metadata Memory"),
+    STAT_CesiumMetadataMemory,
+    STATGROUP_Cesium, );
+
+/**
+ * The Unreal Insights channel of Cesium's tile events. Enable it with
+ * `-trace=cesium` on the command line, or `Trace.Enable cesium` in the
+ * console.
+ */
+UE_TRACE_CHANNEL_EXTERN(CesiumChannel)
+
+namespace CesiumStats {
+
+/**
+ * Counts a request whose response was found in the request cache. The
+ * request cache answers it, unless the response must be revalidated first.
+ */
+void recordCachedResponse();
+
+/**
+ * Counts a conditional request that revalidates a response from the request
+ * cache. It waits on the network, so it is not counted as a cache hit.
+ */
+void recordRevalidation();
+
+/**
+ * Gets the number of requests answered by the request cache so far.
+ */
+int64 getCacheHits();
+
+/**
+ * Sets the adaptive screen-space error counters from a tileset's controller,
+ * unless another tileset's level of detail was already reduced more in this
+ * frame. This must be called from the game thread.
+ */
+void recordAdaptiveScreenSpaceError(
+    const FCesiumAdaptiveScreenSpaceErrorState& state);
+
+/**
+ * Estimates the size of the vertex and index buffers of static mesh render
+ * data.
+ */
+int64 getRenderDataBytes(const FStaticMeshRenderData* pRenderData);
+
+} // namespace CesiumStats
+
+namespace CesiumTrace {
+
+/**
+ * The stages of a tile's life that are recorded on the Cesium trace channel.
+ * Each tile stage event carries the stage, its start and end in
+ * FPlatformTime::Cycles64, the tile's URL and, for the MainThread and Visible
+ * stages, the tile's ID.
+ *
+ * The Request, Network, Decode and LoadThread events have no tile ID, because
+ * cesium-native does not tell the asset accessor or the load thread which
+ * tile they work for. The URL is the only key that joins them to the other
+ * events of the same tile.
+ */
+enum class TileStage : uint8 {
+  /**
+   * From the moment that the tile's content is requested from the asset
+   * accessor until the HTTP request starts, which includes the time that it
+   * waits in Unreal's HTTP queue. The time that the tile spends in
+   * cesium-native's load queue before that is not visible to the plugin.
+   */
+  Request,
+  /** The HTTP request of the tile's content, once it has started. */
+  Network,
+  /**
+   * From the end of the request until the content, once parsed and decoded,
+   * reaches the load thread.
+   */
+  Decode,
+  /** The creation of the tile's meshes and textures on a load thread. */
+  LoadThread,
+  /** The creation of the tile's components on the game thread. */
+  MainThread,
+  /**
+   * The frame in which the tile became visible. The first of these after the
+   * main thread stage is the tile's first visible frame.
+   */
+  Visible
+};
+
+/** Determines if the Cesium trace channel is enabled. */
+bool isEnabled();
+
+/** Records a stage of a tile's life on the Cesium trace channel. */
+void traceTileStage(
+    TileStage stage,
+    uint64 startCycle,
+    uint64 endCycle,
+    const std::string& tileId,
+    const std::string& url);
+
+/**
+ * Records the request and network stages of a completed network request, and
+ * remembers when it ended so that the decode stage of the tile it loaded can
+ * be measured.
+ *
+ * @param url The URL of the request.
+ * @param requestCycle When the content was requested from the asset accessor.
+ * @param startCycle When the HTTP request started.
+ * @param endCycle When the HTTP request completed.
+ */
+void traceNetworkRequest(
+    const std::string& url,
+    uint64 requestCycle,
+    uint64 startCycle,
+    uint64 endCycle);
+
+/**
+ * Gets and forgets the end of the network request for the given URL, if one
+ * was recorded.
+ */
+std::optional<uint64> takeNetworkRequestEnd(const std::string& url);
+
+} // namespace CesiumTrace
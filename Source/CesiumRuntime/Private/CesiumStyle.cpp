@@ -0,0 +1,1414 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumStyle.h"
+#include "CesiumFeaturesMetadataComponent.h"
+#include "CesiumMetadataValue.h"
+#include "CesiumPropertyTable.h"
+#include "CesiumPropertyTableProperty.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include <CesiumUtility/Tracing.h>
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <glm/common.hpp>
+#include <limits>
+
+namespace CesiumStyle {
+
+struct Node {
+  enum class Type { Literal, Variable, Unary, Binary, Conditional, Call };
+
+  Type type = Type::Literal;
+
+  /**
+   * @brief The value of a literal.
+   */
+  Value value;
+
+  /**
+   * @brief The name of a variable or function, or the operator.
+   */
+  std::string name;
+
+  std::vector<std::shared_ptr<const Node>> children;
+};
+
+namespace {
+
+constexpr double NaN = std::numeric_limits<double>::quiet_NaN();
+
+/**
+ * The maximum depth of defines that refer to other defines. This stops
+ * defines that refer to themselves.
+ */
+constexpr int32_t MaximumDefineDepth = 8;
+
+struct FunctionSignature {
+  const char* name;
+  size_t minimumArguments;
+  size_t maximumArguments;
+};
+
+const FunctionSignature functionSignatures[] = {
+    {"color", 0, 2},   {"rgb", 3, 3},     {"rgba", 4, 4},
+    {"hsl", 3, 3},     {"hsla", 4, 4},    {"abs", 1, 1},
+    {"sqrt", 1, 1},    {"floor", 1, 1},   {"ceil", 1, 1},
+    {"round", 1, 1},   {"sign", 1, 1},    {"fract", 1, 1},
+    {"exp", 1, 1},     {"log", 1, 1},     {"pow", 2, 2},
+    {"min", 2, 2},     {"max", 2, 2},     {"clamp", 3, 3},
+    {"mix", 3, 3},     {"Boolean", 1, 1}, {"Number", 1, 1},
+    {"String", 1, 1},  {"isNaN", 1, 1},   {"isFinite", 1, 1}};
+
+const FunctionSignature* findFunction(const std::string& name) {
+  for (const FunctionSignature& signature : functionSignatures) {
+    if (name == signature.name) {
+      return &signature;
+    }
+  }
+  return nullptr;
+}
+
+enum class TokenType { Number, String, Identifier, Variable, Operator, End };
+
+struct Token {
+  TokenType type;
+  std::string text;
+  double number = 0.0;
+  size_t position = 0;
+};
+
+// Longer operators come first so that they take precedence over their
+// prefixes.
+const char* const operators[] = {
+    "===", "!==", "==", "!=", "<=", ">=", "&&", "||", "<", ">", "+",
+    "-",   "*",   "/",  "%",  "!",  "?",  ":",  "(",  ")", ","};
+
+std::string trim(const std::string& text) {
+  const size_t begin = text.find_first_not_of(" \t\r\n");
+  if (begin == std::string::npos) {
+    return std::string();
+  }
+  const size_t end = text.find_last_not_of(" \t\r\n");
+  return text.substr(begin, end - begin + 1);
+}
+
+/**
+ * Strips the `feature.` and `feature['...']` forms of a variable down to the
+ * property name.
+ */
+std::string getVariableName(const std::string& text) {
+  std::string name = trim(text);
+  if (name.rfind("feature.", 0) == 0) {
+    return name.substr(8);
+  }
+  if (name.rfind("feature[", 0) == 0 && name.size() > 12 &&
+      name.back() == ']') {
+    const char quote = name[8];
+    if ((quote == '\'' || quote == '"') && name[name.size() - 2] == quote) {
+      return name.substr(9, name.size() - 11);
+    }
+  }
+  return name;
+}
+
+bool tokenize(
+    const std::string& source,
+    std::vector<Token>& tokens,
+    std::string& error) {
+  size_t i = 0;
+  while (i < source.size()) {
+    const char c = source[i];
+    if (std::isspace(static_cast<unsigned char>(c))) {
+      ++i;
+      continue;
+    }
+
+    Token& token = tokens.emplace_back();
+    token.position = i;
+
+    if (std::isdigit(static_cast<unsigned char>(c)) ||
+        (c == '.' && i + 1 < source.size() &&
+         std::isdigit(static_cast<unsigned char>(source[i + 1])))) {
+      const char* pBegin = source.c_str() + i;
+      char* pEnd = nullptr;
+      token.type = TokenType::Number;
+      token.number = std::strtod(pBegin, &pEnd);
+      i += size_t(pEnd - pBegin);
+      continue;
+    }
+
+    if (c == '\'' || c == '"') {
+      token.type = TokenType::String;
+      ++i;
+      while (i < source.size() && source[i] != c) {
+        if (source[i] == '\\' && i + 1 < source.size()) {
+          ++i;
+        }
+        token.text += source[i];
+        ++i;
+      }
+      if (i >= source.size()) {
+        error = "Unterminated string at position " +
+                std::to_string(token.position);
+        return false;
+      }
+      ++i;
+      continue;
+    }
+
+    if (c == '$' && i + 1 < source.size() && source[i + 1] == '{') {
+      const size_t end = source.find('}', i + 2);
+      if (end == std::string::npos) {
+        error = "Unterminated variable at position " +
+                std::to_string(token.position);
+        return false;
+      }
+      token.type = TokenType::Variable;
+      token.text = getVariableName(source.substr(i + 2, end - i - 2));
+      i = end + 1;
+      continue;
+    }
+
+    if (std::isalpha(static_cast<unsigned char>(c)) || c == '_') {
+      token.type = TokenType::Identifier;
+      while (i < source.size() &&
+             (std::isalnum(static_cast<unsigned char>(source[i])) ||
+              source[i] == '_' || source[i] == '.')) {
+        token.text += source[i];
+        ++i;
+      }
+      continue;
+    }
+
+    bool foundOperator = false;
+    for (const char* pOperator : operators) {
+      const size_t length = std::strlen(pOperator);
+      if (source.compare(i, length, pOperator) == 0) {
+        token.type = TokenType::Operator;
+        token.text = pOperator;
+        i += length;
+        foundOperator = true;
+        break;
+      }
+    }
+
+    if (!foundOperator) {
+      error = std::string("Unexpected character '") + c + "' at position " +
+              std::to_string(i);
+      return false;
+    }
+  }
+
+  Token& end = tokens.emplace_back();
+  end.type = TokenType::End;
+  end.position = source.size();
+  return true;
+}
+
+using NodePtr = std::shared_ptr<Node>;
+
+NodePtr makeLiteral(Value value) {
+  NodePtr pNode = std::make_shared<Node>();
+  pNode->type = Node::Type::Literal;
+  pNode->value = std::move(value);
+  return pNode;
+}
+
+NodePtr makeOperation(
+    Node::Type type,
+    const std::string& name,
+    std::vector<std::shared_ptr<const Node>>&& children) {
+  NodePtr pNode = std::make_shared<Node>();
+  pNode->type = type;
+  pNode->name = name;
+  pNode->children = std::move(children);
+  return pNode;
+}
+
+/**
+ * A recursive descent parser with the precedence of the JavaScript operators
+ * that the styling language supports.
+ */
+class Parser {
+public:
+  Parser(
+      const std::vector<Token>& tokens,
+      std::vector<std::string>& variableNames,
+      std::string& error)
+      : _tokens(tokens), _variableNames(variableNames), _error(error) {}
+
+  NodePtr parse() {
+    NodePtr pRoot = this->parseConditional();
+    if (pRoot && this->peek().type != TokenType::End) {
+      this->fail("Unexpected token");
+      return nullptr;
+    }
+    return pRoot;
+  }
+
+private:
+  const Token& peek() const { return this->_tokens[this->_next]; }
+
+  bool acceptOperator(const char* pOperator) {
+    const Token& token = this->peek();
+    if (token.type == TokenType::Operator && token.text == pOperator) {
+      ++this->_next;
+      return true;
+    }
+    return false;
+  }
+
+  NodePtr fail(const std::string& message) {
+    if (this->_error.empty()) {
+      this->_error = message + " at position " +
+                     std::to_string(this->peek().position);
+    }
+    return nullptr;
+  }
+
+  NodePtr parseConditional() {
+    NodePtr pCondition = this->parseBinary(0);
+    if (!pCondition || !this->acceptOperator("?")) {
+      return pCondition;
+    }
+
+    NodePtr pTrue = this->parseConditional();
+    if (!pTrue) {
+      return nullptr;
+    }
+    if (!this->acceptOperator(":")) {
+      return this->fail("Expected ':'");
+    }
+    NodePtr pFalse = this->parseConditional();
+    if (!pFalse) {
+      return nullptr;
+    }
+
+    return makeOperation(
+        Node::Type::Conditional,
+        "?",
+        {pCondition, pTrue, pFalse});
+  }
+
+  /**
+   * Parses the binary operators of the given precedence level and higher.
+   */
+  NodePtr parseBinary(size_t level) {
+    static const std::vector<std::vector<const char*>> levels = {
+        {"||"},
+        {"&&"},
+        {"===", "!==", "==", "!="},
+        {"<=", ">=", "<", ">"},
+        {"+", "-"},
+        {"*", "/", "%"}};
+
+    if (level >= levels.size()) {
+      return this->parseUnary();
+    }
+
+    NodePtr pLeft = this->parseBinary(level + 1);
+    while (pLeft) {
+      const char* pMatched = nullptr;
+      for (const char* pOperator : levels[level]) {
+        if (this->acceptOperator(pOperator)) {
+          pMatched = pOperator;
+          break;
+        }
+      }
+      if (!pMatched) {
+        break;
+      }
+
+      NodePtr pRight = this->parseBinary(level + 1);
+      if (!pRight) {
+        return nullptr;
+      }
+      pLeft = makeOperation(Node::Type::Binary, pMatched, {pLeft, pRight});
+    }
+    return pLeft;
+  }
+
+  NodePtr parseUnary() {
+    for (const char* pOperator : {"!", "-", "+"}) {
+      if (this->acceptOperator(pOperator)) {
+        NodePtr pOperand = this->parseUnary();
+        if (!pOperand) {
+          return nullptr;
+        }
+        return makeOperation(Node::Type::Unary, pOperator, {pOperand});
+      }
+    }
+    return this->parsePrimary();
+  }
+
+  NodePtr parsePrimary() {
+    const Token& token = this->peek();
+    switch (token.type) {
+    case TokenType::Number:
+      ++this->_next;
+      return makeLiteral(token.number);
+    case TokenType::String:
+      ++this->_next;
+      return makeLiteral(token.text);
+    case TokenType::Variable: {
+      ++this->_next;
+      if (std::find(
+              this->_variableNames.begin(),
+              this->_variableNames.end(),
+              token.text) == this->_variableNames.end()) {
+        this->_variableNames.push_back(token.text);
+      }
+      NodePtr pNode = std::make_shared<Node>();
+      pNode->type = Node::Type::Variable;
+      pNode->name = token.text;
+      return pNode;
+    }
+    case TokenType::Identifier:
+      ++this->_next;
+      return this->parseIdentifier(token);
+    case TokenType::Operator:
+      if (this->acceptOperator("(")) {
+        NodePtr pInner = this->parseConditional();
+        if (pInner && !this->acceptOperator(")")) {
+          return this->fail("Expected ')'");
+        }
+        return pInner;
+      }
+      break;
+    default:
+      break;
+    }
+    return this->fail("Unexpected token");
+  }
+
+  NodePtr parseIdentifier(const Token& token) {
+    if (token.text == "true" || token.text == "false") {
+      return makeLiteral(token.text == "true");
+    }
+    if (token.text == "undefined" || token.text == "null") {
+      return makeLiteral(Undefined());
+    }
+    if (token.text == "NaN") {
+      return makeLiteral(NaN);
+    }
+    if (token.text == "Infinity") {
+      return makeLiteral(std::numeric_limits<double>::infinity());
+    }
+    if (token.text == "Math.PI") {
+      return makeLiteral(3.14159265358979323846);
+    }
+    if (token.text == "Math.E") {
+      return makeLiteral(2.71828182845904523536);
+    }
+
+    const FunctionSignature* pFunction = findFunction(token.text);
+    if (!pFunction) {
+      --this->_next;
+      return this->fail("Unknown identifier '" + token.text + "'");
+    }
+    if (!this->acceptOperator("(")) {
+      return this->fail("Expected '('");
+    }
+
+    std::vector<std::shared_ptr<const Node>> arguments;
+    if (!this->acceptOperator(")")) {
+      do {
+        NodePtr pArgument = this->parseConditional();
+        if (!pArgument) {
+          return nullptr;
+        }
+        arguments.push_back(pArgument);
+      } while (this->acceptOperator(","));
+
+      if (!this->acceptOperator(")")) {
+        return this->fail("Expected ')'");
+      }
+    }
+
+    if (arguments.size() < pFunction->minimumArguments ||
+        arguments.size() > pFunction->maximumArguments) {
+      return this->fail(
+          "Wrong number of arguments to '" + token.text + "'");
+    }
+
+    return makeOperation(Node::Type::Call, token.text, std::move(arguments));
+  }
+
+  const std::vector<Token>& _tokens;
+  std::vector<std::string>& _variableNames;
+  std::string& _error;
+  size_t _next = 0;
+};
+
+std::string toString(const Value& value) {
+  if (std::holds_alternative<std::string>(value)) {
+    return std::get<std::string>(value);
+  }
+  if (const bool* pBool = std::get_if<bool>(&value)) {
+    return *pBool ? "true" : "false";
+  }
+  if (const double* pNumber = std::get_if<double>(&value)) {
+    if (std::isnan(*pNumber)) {
+      return "NaN";
+    }
+    if (std::isinf(*pNumber)) {
+      return *pNumber > 0.0 ? "Infinity" : "-Infinity";
+    }
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%.15g", *pNumber);
+    return buffer;
+  }
+  if (const glm::dvec4* pColor = std::get_if<glm::dvec4>(&value)) {
+    return "(" + toString(pColor->x) + ", " + toString(pColor->y) + ", " +
+           toString(pColor->z) + ", " + toString(pColor->w) + ")";
+  }
+  return "undefined";
+}
+
+bool strictEquals(const Value& left, const Value& right) {
+  if (left.index() != right.index()) {
+    return false;
+  }
+  // NaN is not equal to itself, which the double comparison handles.
+  return left == right;
+}
+
+std::optional<glm::dvec4> parseHexColor(const std::string& text) {
+  const size_t digits = text.size() - 1;
+  if (digits != 3 && digits != 6) {
+    return std::nullopt;
+  }
+  for (size_t i = 1; i < text.size(); ++i) {
+    if (!std::isxdigit(static_cast<unsigned char>(text[i]))) {
+      return std::nullopt;
+    }
+  }
+
+  const unsigned long packed = std::strtoul(text.c_str() + 1, nullptr, 16);
+  if (digits == 3) {
+    return glm::dvec4(
+        double((packed >> 8) & 0xF) / 15.0,
+        double((packed >> 4) & 0xF) / 15.0,
+        double(packed & 0xF) / 15.0,
+        1.0);
+  }
+  return glm::dvec4(
+      double((packed >> 16) & 0xFF) / 255.0,
+      double((packed >> 8) & 0xFF) / 255.0,
+      double(packed & 0xFF) / 255.0,
+      1.0);
+}
+
+std::optional<glm::dvec4> parseCssColor(const std::string& source) {
+  std::string text = trim(source);
+  std::transform(text.begin(), text.end(), text.begin(), [](char c) {
+    return char(std::tolower(static_cast<unsigned char>(c)));
+  });
+
+  if (!text.empty() && text[0] == '#') {
+    return parseHexColor(text);
+  }
+
+  struct NamedColor {
+    const char* name;
+    const char* hex;
+  };
+  static const NamedColor namedColors[] = {
+      {"black", "#000000"},   {"white", "#ffffff"},  {"red", "#ff0000"},
+      {"lime", "#00ff00"},    {"blue", "#0000ff"},   {"yellow", "#ffff00"},
+      {"cyan", "#00ffff"},    {"aqua", "#00ffff"},   {"magenta", "#ff00ff"},
+      {"fuchsia", "#ff00ff"}, {"silver", "#c0c0c0"}, {"gray", "#808080"},
+      {"grey", "#808080"},    {"maroon", "#800000"}, {"olive", "#808000"},
+      {"green", "#008000"},   {"purple", "#800080"}, {"teal", "#008080"},
+      {"navy", "#000080"},    {"orange", "#ffa500"}, {"pink", "#ffc0cb"},
+      {"brown", "#a52a2a"},   {"gold", "#ffd700"},   {"violet", "#ee82ee"}};
+
+  for (const NamedColor& namedColor : namedColors) {
+    if (text == namedColor.name) {
+      return parseHexColor(namedColor.hex);
+    }
+  }
+  return std::nullopt;
+}
+
+double hueToRgb(double p, double q, double t) {
+  if (t < 0.0) {
+    t += 1.0;
+  }
+  if (t > 1.0) {
+    t -= 1.0;
+  }
+  if (t < 1.0 / 6.0) {
+    return p + (q - p) * 6.0 * t;
+  }
+  if (t < 0.5) {
+    return q;
+  }
+  if (t < 2.0 / 3.0) {
+    return p + (q - p) * (2.0 / 3.0 - t) * 6.0;
+  }
+  return p;
+}
+
+glm::dvec4 hslToRgb(double h, double s, double l, double a) {
+  h = h - std::floor(h);
+  s = glm::clamp(s, 0.0, 1.0);
+  l = glm::clamp(l, 0.0, 1.0);
+  if (s == 0.0) {
+    return glm::dvec4(l, l, l, a);
+  }
+  const double q = l < 0.5 ? l * (1.0 + s) : l + s - l * s;
+  const double p = 2.0 * l - q;
+  return glm::dvec4(
+      hueToRgb(p, q, h + 1.0 / 3.0),
+      hueToRgb(p, q, h),
+      hueToRgb(p, q, h - 1.0 / 3.0),
+      a);
+}
+
+Value callFunction(const std::string& name, const std::vector<Value>& args) {
+  if (name == "color") {
+    if (args.empty()) {
+      return glm::dvec4(1.0);
+    }
+    const std::string* pText = std::get_if<std::string>(&args[0]);
+    if (!pText) {
+      return Undefined();
+    }
+    std::optional<glm::dvec4> maybeColor = parseCssColor(*pText);
+    if (!maybeColor) {
+      return Undefined();
+    }
+    if (args.size() > 1) {
+      maybeColor->w = glm::clamp(toNumber(args[1]), 0.0, 1.0);
+    }
+    return *maybeColor;
+  }
+
+  std::vector<double> numbers(args.size());
+  std::transform(args.begin(), args.end(), numbers.begin(), toNumber);
+
+  if (name == "rgb" || name == "rgba") {
+    return glm::clamp(
+        glm::dvec4(
+            numbers[0] / 255.0,
+            numbers[1] / 255.0,
+            numbers[2] / 255.0,
+            numbers.size() > 3 ? numbers[3] : 1.0),
+        0.0,
+        1.0);
+  }
+  if (name == "hsl" || name == "hsla") {
+    return hslToRgb(
+        numbers[0],
+        numbers[1],
+        numbers[2],
+        numbers.size() > 3 ? glm::clamp(numbers[3], 0.0, 1.0) : 1.0);
+  }
+
+  if (name == "abs") {
+    return std::abs(numbers[0]);
+  }
+  if (name == "sqrt") {
+    return std::sqrt(numbers[0]);
+  }
+  if (name == "floor") {
+    return std::floor(numbers[0]);
+  }
+  if (name == "ceil") {
+    return std::ceil(numbers[0]);
+  }
+  if (name == "round") {
+    return std::floor(numbers[0] + 0.5);
+  }
+  if (name == "sign") {
+    return numbers[0] > 0.0 ? 1.0 : (numbers[0] < 0.0 ? -1.0 : numbers[0]);
+  }
+  if (name == "fract") {
+    return numbers[0] - std::floor(numbers[0]);
+  }
+  if (name == "exp") {
+    return std::exp(numbers[0]);
+  }
+  if (name == "log") {
+    return std::log(numbers[0]);
+  }
+  if (name == "pow") {
+    return std::pow(numbers[0], numbers[1]);
+  }
+  if (name == "min") {
+    return std::min(numbers[0], numbers[1]);
+  }
+  if (name == "max") {
+    return std::max(numbers[0], numbers[1]);
+  }
+  if (name == "clamp") {
+    return std::min(std::max(numbers[0], numbers[1]), numbers[2]);
+  }
+  if (name == "mix") {
+    return numbers[0] + (numbers[1] - numbers[0]) * numbers[2];
+  }
+  if (name == "Boolean") {
+    return toBoolean(args[0]);
+  }
+  if (name == "Number") {
+    return numbers[0];
+  }
+  if (name == "String") {
+    return toString(args[0]);
+  }
+  if (name == "isNaN") {
+    return std::isnan(numbers[0]);
+  }
+  if (name == "isFinite") {
+    return std::isfinite(numbers[0]);
+  }
+
+  return Undefined();
+}
+
+Value evaluateArithmetic(
+    const std::string& op,
+    const Value& left,
+    const Value& right) {
+  if (op == "+" && (std::holds_alternative<std::string>(left) ||
+                    std::holds_alternative<std::string>(right))) {
+    return toString(left) + toString(right);
+  }
+
+  const glm::dvec4* pLeftColor = std::get_if<glm::dvec4>(&left);
+  const glm::dvec4* pRightColor = std::get_if<glm::dvec4>(&right);
+  if (pLeftColor || pRightColor) {
+    // Colors combine component-wise with other colors, and scale by numbers.
+    const glm::dvec4 a = pLeftColor ? *pLeftColor : glm::dvec4(toNumber(left));
+    const glm::dvec4 b =
+        pRightColor ? *pRightColor : glm::dvec4(toNumber(right));
+    if (op == "+" && pLeftColor && pRightColor) {
+      return a + b;
+    }
+    if (op == "-" && pLeftColor && pRightColor) {
+      return a - b;
+    }
+    if (op == "*") {
+      return a * b;
+    }
+    if (op == "/" && pLeftColor) {
+      return a / b;
+    }
+    return Undefined();
+  }
+
+  const double a = toNumber(left);
+  const double b = toNumber(right);
+  if (op == "+") {
+    return a + b;
+  }
+  if (op == "-") {
+    return a - b;
+  }
+  if (op == "*") {
+    return a * b;
+  }
+  if (op == "/") {
+    return a / b;
+  }
+  return std::fmod(a, b);
+}
+
+Value evaluateComparison(
+    const std::string& op,
+    const Value& left,
+    const Value& right) {
+  const std::string* pLeftString = std::get_if<std::string>(&left);
+  const std::string* pRightString = std::get_if<std::string>(&right);
+  int32_t comparison;
+  if (pLeftString && pRightString) {
+    comparison = pLeftString->compare(*pRightString);
+  } else {
+    const double a = toNumber(left);
+    const double b = toNumber(right);
+    if (std::isnan(a) || std::isnan(b)) {
+      return false;
+    }
+    comparison = a < b ? -1 : (a > b ? 1 : 0);
+  }
+
+  if (op == "<") {
+    return comparison < 0;
+  }
+  if (op == "<=") {
+    return comparison <= 0;
+  }
+  if (op == ">") {
+    return comparison > 0;
+  }
+  return comparison >= 0;
+}
+
+Value evaluateNode(const Node& node, const VariableResolver& resolver) {
+  switch (node.type) {
+  case Node::Type::Literal:
+    return node.value;
+  case Node::Type::Variable:
+    return resolver(node.name);
+  case Node::Type::Unary: {
+    const Value operand = evaluateNode(*node.children[0], resolver);
+    if (node.name == "!") {
+      return !toBoolean(operand);
+    }
+    if (node.name == "-") {
+      if (const glm::dvec4* pColor = std::get_if<glm::dvec4>(&operand)) {
+        return -*pColor;
+      }
+      return -toNumber(operand);
+    }
+    return toNumber(operand);
+  }
+  case Node::Type::Binary: {
+    const Value left = evaluateNode(*node.children[0], resolver);
+
+    // The logical operators short-circuit and return one of their operands,
+    // as in JavaScript.
+    if (node.name == "&&") {
+      return toBoolean(left) ? evaluateNode(*node.children[1], resolver)
+                             : left;
+    }
+    if (node.name == "||") {
+      return toBoolean(left) ? left
+                             : evaluateNode(*node.children[1], resolver);
+    }
+
+    const Value right = evaluateNode(*node.children[1], resolver);
+    if (node.name == "===" || node.name == "==") {
+      return strictEquals(left, right);
+    }
+    if (node.name == "!==" || node.name == "!=") {
+      return !strictEquals(left, right);
+    }
+    if (node.name[0] == '<' || node.name[0] == '>') {
+      return evaluateComparison(node.name, left, right);
+    }
+    return evaluateArithmetic(node.name, left, right);
+  }
+  case Node::Type::Conditional:
+    return toBoolean(evaluateNode(*node.children[0], resolver))
+               ? evaluateNode(*node.children[1], resolver)
+               : evaluateNode(*node.children[2], resolver);
+  case Node::Type::Call: {
+    std::vector<Value> arguments;
+    arguments.reserve(node.children.size());
+    for (const std::shared_ptr<const Node>& pChild : node.children) {
+      arguments.push_back(evaluateNode(*pChild, resolver));
+    }
+    return callFunction(node.name, arguments);
+  }
+  }
+  return Undefined();
+}
+
+std::optional<Expression>
+compileJsonExpression(const TSharedPtr<FJsonValue>& pJson, FString& error) {
+  std::string source;
+  switch (pJson->Type) {
+  case EJson::String:
+    source = TCHAR_TO_UTF8(*pJson->AsString());
+    break;
+  case EJson::Boolean:
+    source = pJson->AsBool() ? "true" : "false";
+    break;
+  case EJson::Number:
+    source = toString(pJson->AsNumber());
+    break;
+  default:
+    error = TEXT("Style expressions must be strings, booleans, or numbers.");
+    return std::nullopt;
+  }
+
+  std::string expressionError;
+  std::optional<Expression> maybeExpression =
+      Expression::parse(source, expressionError);
+  if (!maybeExpression) {
+    error = FString::Printf(
+        TEXT("Invalid style expression \"%s\": %s"),
+        UTF8_TO_TCHAR(source.c_str()),
+        UTF8_TO_TCHAR(expressionError.c_str()));
+  }
+  return maybeExpression;
+}
+
+Value toStyleValue(const FCesiumMetadataValue& value) {
+  const FCesiumMetadataValueType valueType =
+      UCesiumMetadataValueBlueprintLibrary::GetValueType(value);
+  if (valueType.bIsArray) {
+    return Undefined();
+  }
+
+  switch (valueType.Type) {
+  case ECesiumMetadataType::Boolean:
+    return UCesiumMetadataValueBlueprintLibrary::GetBoolean(value, false);
+  case ECesiumMetadataType::Scalar:
+    return UCesiumMetadataValueBlueprintLibrary::GetFloat64(value, NaN);
+  case ECesiumMetadataType::String:
+  case ECesiumMetadataType::Enum:
+    return std::string(TCHAR_TO_UTF8(
+        *UCesiumMetadataValueBlueprintLibrary::GetString(value, FString())));
+  default:
+    return Undefined();
+  }
+}
+
+FColor toColor(const glm::dvec4& color) {
+  const glm::dvec4 bytes = glm::round(glm::clamp(color, 0.0, 1.0) * 255.0);
+  return FColor(uint8(bytes.x), uint8(bytes.y), uint8(bytes.z), uint8(bytes.w));
+}
+
+using DefineResolver = std::function<const Node*(const std::string& name)>;
+
+/**
+ * Compiles expression trees into the instructions of a style program, and
+ * tracks how deep they make its stack.
+ */
+class ProgramCompiler {
+public:
+  ProgramCompiler(
+      const std::vector<ProgramProperty>& properties,
+      const DefineResolver& resolveDefine)
+      : _properties(properties), _resolveDefine(resolveDefine) {}
+
+  /**
+   * Compiles an expression that pushes its value. Defines that are nested
+   * more than MaximumDefineDepth deep are undefined, as when evaluating them.
+   */
+  bool compile(const Node& node, int32_t defineDepth) {
+    switch (node.type) {
+    case Node::Type::Literal:
+      return this->compileLiteral(node.value);
+    case Node::Type::Variable:
+      return this->compileVariable(node.name, defineDepth);
+    case Node::Type::Unary:
+      if (!this->compile(*node.children[0], defineDepth)) {
+        return false;
+      }
+      this->emit(
+          node.name == "!"   ? Opcode::Not
+          : node.name == "-" ? Opcode::Negate
+                             : Opcode::ToNumber,
+          1);
+      return true;
+    case Node::Type::Binary:
+      return this->compile(*node.children[0], defineDepth) &&
+             this->compile(*node.children[1], defineDepth) &&
+             this->emitBinary(node.name);
+    case Node::Type::Conditional:
+      // The program has no jumps, so both branches are computed and one is
+      // selected. This is only possible because expressions have no side
+      // effects.
+      if (!this->compile(*node.children[2], defineDepth) ||
+          !this->compile(*node.children[0], defineDepth) ||
+          !this->compile(*node.children[1], defineDepth)) {
+        return false;
+      }
+      this->emit(Opcode::Conditional, 3);
+      return true;
+    case Node::Type::Call:
+      return this->compileCall(node, defineDepth);
+    }
+    return false;
+  }
+
+  void emit(Opcode opcode, int32_t pops, float operand = 0.0f) {
+    this->_instructions.emplace_back(float(opcode), operand, 0.0f, 0.0f);
+    this->_stackDepth += 1 - pops;
+    this->_maximumStackDepth =
+        std::max(this->_maximumStackDepth, this->_stackDepth);
+  }
+
+  /**
+   * Gets the instructions, or std::nullopt if they do not fit the program
+   * texture or the stack of the material.
+   */
+  std::optional<std::vector<glm::vec4>> finish() {
+    this->_instructions.emplace_back(float(Opcode::End), 0.0f, 0.0f, 0.0f);
+    if (int64_t(this->_instructions.size()) > MaximumProgramLength ||
+        this->_maximumStackDepth > MaximumProgramStackDepth) {
+      return std::nullopt;
+    }
+    return std::move(this->_instructions);
+  }
+
+private:
+  bool compileLiteral(const Value& value) {
+    if (std::holds_alternative<Undefined>(value)) {
+      this->emit(Opcode::Undefined, 0);
+    } else if (const bool* pBool = std::get_if<bool>(&value)) {
+      this->emit(Opcode::Boolean, 0, *pBool ? 1.0f : 0.0f);
+    } else if (const double* pNumber = std::get_if<double>(&value)) {
+      this->emit(Opcode::Number, 0, float(*pNumber));
+    } else {
+      // The material has no strings.
+      return false;
+    }
+    return true;
+  }
+
+  bool compileVariable(const std::string& name, int32_t defineDepth) {
+    if (const Node* pDefine = this->_resolveDefine(name)) {
+      if (defineDepth >= MaximumDefineDepth) {
+        this->emit(Opcode::Undefined, 0);
+        return true;
+      }
+      return this->compile(*pDefine, defineDepth + 1);
+    }
+
+    for (size_t i = 0; i < this->_properties.size(); ++i) {
+      if (this->_properties[i].name == name) {
+        this->emit(
+            this->_properties[i].isBoolean ? Opcode::BooleanProperty
+                                           : Opcode::Property,
+            0,
+            float(i));
+        return true;
+      }
+    }
+
+    // The feature may still have this property, but the material does not.
+    return false;
+  }
+
+  bool emitBinary(const std::string& op) {
+    static const std::unordered_map<std::string, Opcode> opcodes = {
+        {"&&", Opcode::And},
+        {"||", Opcode::Or},
+        {"===", Opcode::Equal},
+        {"==", Opcode::Equal},
+        {"!==", Opcode::NotEqual},
+        {"!=", Opcode::NotEqual},
+        {"<", Opcode::Less},
+        {"<=", Opcode::LessEqual},
+        {">", Opcode::Greater},
+        {">=", Opcode::GreaterEqual},
+        {"+", Opcode::Add},
+        {"-", Opcode::Subtract},
+        {"*", Opcode::Multiply},
+        {"/", Opcode::Divide},
+        {"%", Opcode::Modulo}};
+
+    auto it = opcodes.find(op);
+    if (it == opcodes.end()) {
+      return false;
+    }
+    this->emit(it->second, 2);
+    return true;
+  }
+
+  bool compileCall(const Node& node, int32_t defineDepth) {
+    if (node.name == "color") {
+      return this->compileColor(node, defineDepth);
+    }
+
+    static const std::unordered_map<std::string, Opcode> opcodes = {
+        {"rgb", Opcode::Rgb},          {"rgba", Opcode::Rgba},
+        {"hsl", Opcode::Hsl},          {"hsla", Opcode::Hsla},
+        {"abs", Opcode::Abs},          {"sqrt", Opcode::Sqrt},
+        {"floor", Opcode::Floor},      {"ceil", Opcode::Ceil},
+        {"round", Opcode::Round},      {"sign", Opcode::Sign},
+        {"fract", Opcode::Fract},      {"exp", Opcode::Exp},
+        {"log", Opcode::Log},          {"pow", Opcode::Pow},
+        {"min", Opcode::Min},          {"max", Opcode::Max},
+        {"clamp", Opcode::Clamp},      {"mix", Opcode::Mix},
+        {"Boolean", Opcode::ToBoolean}, {"Number", Opcode::ToNumber},
+        {"isNaN", Opcode::IsNaN},      {"isFinite", Opcode::IsFinite}};
+
+    auto it = opcodes.find(node.name);
+    if (it == opcodes.end()) {
+      return false;
+    }
+
+    for (const std::shared_ptr<const Node>& pArgument : node.children) {
+      if (!this->compile(*pArgument, defineDepth)) {
+        return false;
+      }
+    }
+    this->emit(it->second, int32_t(node.children.size()));
+    return true;
+  }
+
+  /**
+   * Compiles a call to `color`, whose CSS color must be a string literal so
+   * that it can be parsed here.
+   */
+  bool compileColor(const Node& node, int32_t defineDepth) {
+    glm::dvec4 color(1.0);
+    if (!node.children.empty()) {
+      const Node& text = *node.children[0];
+      const std::string* pText = text.type == Node::Type::Literal
+                                     ? std::get_if<std::string>(&text.value)
+                                     : nullptr;
+      if (!pText) {
+        return false;
+      }
+
+      std::optional<glm::dvec4> maybeColor = parseCssColor(*pText);
+      if (!maybeColor) {
+        this->emit(Opcode::Undefined, 0);
+        return true;
+      }
+      color = *maybeColor;
+    }
+
+    this->emit(Opcode::Number, 0, float(color.x));
+    this->emit(Opcode::Number, 0, float(color.y));
+    this->emit(Opcode::Number, 0, float(color.z));
+    if (node.children.size() > 1) {
+      if (!this->compile(*node.children[1], defineDepth)) {
+        return false;
+      }
+    } else {
+      this->emit(Opcode::Number, 0, float(color.w));
+    }
+    this->emit(Opcode::Color, 4);
+    return true;
+  }
+
+  const std::vector<ProgramProperty>& _properties;
+  const DefineResolver& _resolveDefine;
+  std::vector<glm::vec4> _instructions;
+  int32_t _stackDepth = 0;
+  int32_t _maximumStackDepth = 0;
+};
+
+} // namespace
+
+std::vector<ProgramProperty>
+getProgramProperties(const FCesiumPropertyTableDescription& propertyTable) {
+  std::vector<ProgramProperty> properties;
+  for (const FCesiumPropertyTablePropertyDescription& property :
+       propertyTable.Properties) {
+    if (properties.size() >= size_t(MaximumProgramProperties)) {
+      break;
+    }
+
+    const FCesiumMetadataPropertyDetails& details = property.PropertyDetails;
+    const FCesiumMetadataEncodingDetails& encoding = property.EncodingDetails;
+    if (encoding.Conversion == ECesiumEncodedMetadataConversion::None ||
+        !encoding.HasValidType() ||
+        encoding.Type != ECesiumEncodedMetadataType::Scalar ||
+        details.bIsArray || details.HasValueTransforms()) {
+      continue;
+    }
+
+    if (details.Type != ECesiumMetadataType::Scalar &&
+        details.Type != ECesiumMetadataType::Boolean) {
+      continue;
+    }
+
+    properties.push_back(ProgramProperty{
+        TCHAR_TO_UTF8(*property.Name),
+        details.Type == ECesiumMetadataType::Boolean});
+  }
+  return properties;
+}
+
+bool toBoolean(const Value& value) {
+  if (const bool* pBool = std::get_if<bool>(&value)) {
+    return *pBool;
+  }
+  if (const double* pNumber = std::get_if<double>(&value)) {
+    return *pNumber != 0.0 && !std::isnan(*pNumber);
+  }
+  if (const std::string* pString = std::get_if<std::string>(&value)) {
+    return !pString->empty();
+  }
+  return std::holds_alternative<glm::dvec4>(value);
+}
+
+double toNumber(const Value& value) {
+  if (const double* pNumber = std::get_if<double>(&value)) {
+    return *pNumber;
+  }
+  if (const bool* pBool = std::get_if<bool>(&value)) {
+    return *pBool ? 1.0 : 0.0;
+  }
+  if (const std::string* pString = std::get_if<std::string>(&value)) {
+    const std::string text = trim(*pString);
+    if (text.empty()) {
+      return 0.0;
+    }
+    char* pEnd = nullptr;
+    const double number = std::strtod(text.c_str(), &pEnd);
+    return *pEnd == '\0' ? number : NaN;
+  }
+  return NaN;
+}
+
+/*static*/ std::optional<Expression>
+Expression::parse(const std::string& source, std::string& error) {
+  std::vector<Token> tokens;
+  if (!tokenize(source, tokens, error)) {
+    return std::nullopt;
+  }
+
+  Expression expression;
+  Parser parser(tokens, expression._variableNames, error);
+  expression._pRoot = parser.parse();
+  if (!expression._pRoot) {
+    return std::nullopt;
+  }
+  return expression;
+}
+
+Value Expression::evaluate(const VariableResolver& resolver) const {
+  return evaluateNode(*this->_pRoot, resolver);
+}
+
+/*static*/ std::optional<Style>
+Style::parse(const FString& json, FString& error) {
+  TSharedPtr<FJsonObject> pObject;
+  TSharedRef<TJsonReader<>> pReader = TJsonReaderFactory<>::Create(json);
+  if (!FJsonSerializer::Deserialize(pReader, pObject) || !pObject.IsValid()) {
+    error = TEXT("The style is not a valid JSON object.");
+    return std::nullopt;
+  }
+
+  Style style;
+
+  const TSharedPtr<FJsonObject>* ppDefines;
+  if (pObject->TryGetObjectField(TEXT("defines"), ppDefines)) {
+    for (const auto& define : (*ppDefines)->Values) {
+      std::optional<Expression> maybeDefine =
+          compileJsonExpression(define.Value, error);
+      if (!maybeDefine) {
+        return std::nullopt;
+      }
+      style._defines.emplace(TCHAR_TO_UTF8(*define.Key), *maybeDefine);
+    }
+  }
+
+  if (TSharedPtr<FJsonValue> pShow = pObject->TryGetField(TEXT("show"))) {
+    style._show = compileJsonExpression(pShow, error);
+    if (!style._show) {
+      return std::nullopt;
+    }
+  }
+
+  if (TSharedPtr<FJsonValue> pColor = pObject->TryGetField(TEXT("color"))) {
+    if (pColor->Type != EJson::Object) {
+      style._color = compileJsonExpression(pColor, error);
+      if (!style._color) {
+        return std::nullopt;
+      }
+    } else {
+      const TArray<TSharedPtr<FJsonValue>>* pConditions;
+      if (!pColor->AsObject()->TryGetArrayField(
+              TEXT("conditions"),
+              pConditions)) {
+        error = TEXT("A color object must have a conditions array.");
+        return std::nullopt;
+      }
+
+      for (const TSharedPtr<FJsonValue>& pCondition : *pConditions) {
+        const TArray<TSharedPtr<FJsonValue>>* pPair;
+        if (!pCondition->TryGetArray(pPair) || pPair->Num() != 2) {
+          error = TEXT("Each color condition must be a [condition, color] "
+                       "pair.");
+          return std::nullopt;
+        }
+
+        std::optional<Expression> maybeCondition =
+            compileJsonExpression((*pPair)[0], error);
+        std::optional<Expression> maybeColor =
+            maybeCondition ? compileJsonExpression((*pPair)[1], error)
+                           : std::nullopt;
+        if (!maybeColor) {
+          return std::nullopt;
+        }
+        style._colorConditions.push_back(
+            Condition{std::move(*maybeCondition), std::move(*maybeColor)});
+      }
+    }
+  }
+
+  // Collect the feature properties that the style reads, so that only those
+  // are fetched for each feature.
+  auto addPropertyNames = [&style](const Expression& expression) {
+    for (const std::string& name : expression.getVariableNames()) {
+      if (style._defines.find(name) == style._defines.end() &&
+          std::find(
+              style._propertyNames.begin(),
+              style._propertyNames.end(),
+              name) == style._propertyNames.end()) {
+        style._propertyNames.push_back(name);
+      }
+    }
+  };
+
+  for (const auto& define : style._defines) {
+    addPropertyNames(define.second);
+  }
+  if (style._show) {
+    addPropertyNames(*style._show);
+  }
+  if (style._color) {
+    addPropertyNames(*style._color);
+  }
+  for (const Condition& condition : style._colorConditions) {
+    addPropertyNames(condition.condition);
+    addPropertyNames(condition.color);
+  }
+
+  return style;
+}
+
+Value Style::resolve(
+    const std::string& name,
+    const VariableResolver& resolver,
+    int32_t depth) const {
+  auto defineIt = this->_defines.find(name);
+  if (defineIt == this->_defines.end()) {
+    return resolver(name);
+  }
+  if (depth >= MaximumDefineDepth) {
+    return Undefined();
+  }
+  return defineIt->second.evaluate(
+      [this, &resolver, depth](const std::string& innerName) {
+        return this->resolve(innerName, resolver, depth + 1);
+      });
+}
+
+glm::dvec4 Style::evaluate(const VariableResolver& resolver) const {
+  const VariableResolver resolveVariable =
+      [this, &resolver](const std::string& name) {
+        return this->resolve(name, resolver, 0);
+      };
+
+  if (this->_show && !toBoolean(this->_show->evaluate(resolveVariable))) {
+    return glm::dvec4(0.0);
+  }
+
+  Value color = glm::dvec4(1.0);
+  if (this->_color) {
+    color = this->_color->evaluate(resolveVariable);
+  } else {
+    for (const Condition& condition : this->_colorConditions) {
+      if (toBoolean(condition.condition.evaluate(resolveVariable))) {
+        color = condition.color.evaluate(resolveVariable);
+        break;
+      }
+    }
+  }
+
+  const glm::dvec4* pColor = std::get_if<glm::dvec4>(&color);
+  return pColor ? *pColor : glm::dvec4(1.0);
+}
+
+std::optional<std::vector<glm::vec4>>
+Style::compileProgram(const std::vector<ProgramProperty>& properties) const {
+  const DefineResolver resolveDefine =
+      [this](const std::string& name) -> const Node* {
+    auto defineIt = this->_defines.find(name);
+    return defineIt != this->_defines.end() ? defineIt->second._pRoot.get()
+                                            : nullptr;
+  };
+  ProgramCompiler compiler(properties, resolveDefine);
+
+  // The color comes first. Conditions are compiled from the last to the
+  // first, each selecting between its color and the result of the ones after
+  // it, so that the stack does not grow with the number of conditions.
+  if (this->_color) {
+    if (!compiler.compile(*this->_color->_pRoot, 0)) {
+      return std::nullopt;
+    }
+  } else {
+    compiler.emit(Opcode::Undefined, 0);
+    for (auto it = this->_colorConditions.rbegin();
+         it != this->_colorConditions.rend();
+         ++it) {
+      if (!compiler.compile(*it->condition._pRoot, 0) ||
+          !compiler.compile(*it->color._pRoot, 0)) {
+        return std::nullopt;
+      }
+      compiler.emit(Opcode::Conditional, 3);
+    }
+  }
+
+  if (this->_show) {
+    if (!compiler.compile(*this->_show->_pRoot, 0)) {
+      return std::nullopt;
+    }
+  } else {
+    compiler.emit(Opcode::Boolean, 0, 1.0f);
+  }
+
+  return compiler.finish();
+}
+
+void Style::compilePrograms(
+    const TArray<FCesiumPropertyTableDescription>& propertyTables) {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::CompileStylePrograms)
+
+  this->_programs.clear();
+  for (const FCesiumPropertyTableDescription& propertyTable : propertyTables) {
+    std::optional<std::vector<glm::vec4>> maybeProgram =
+        this->compileProgram(getProgramProperties(propertyTable));
+    if (maybeProgram) {
+      this->_programs.emplace(
+          TCHAR_TO_UTF8(*propertyTable.Name),
+          std::move(*maybeProgram));
+    }
+  }
+}
+
+const std::vector<glm::vec4>*
+Style::getProgram(const FString& propertyTableName) const {
+  auto it = this->_programs.find(TCHAR_TO_UTF8(*propertyTableName));
+  return it != this->_programs.end() ? &it->second : nullptr;
+}
+
+void evaluatePropertyTable(
+    const Style* pStyle,
+    const FCesiumPropertyTable& propertyTable,
+    std::span<FColor> colors) {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::EvaluateStyle)
+
+  if (!pStyle) {
+    std::fill(colors.begin(), colors.end(), FColor::White);
+    return;
+  }
+
+  const TMap<FString, FCesiumPropertyTableProperty>& properties =
+      UCesiumPropertyTableBlueprintLibrary::GetProperties(propertyTable);
+
+  std::unordered_map<std::string, const FCesiumPropertyTableProperty*>
+      referencedProperties;
+  for (const std::string& name : pStyle->getPropertyNames()) {
+    referencedProperties.emplace(
+        name,
+        properties.Find(UTF8_TO_TCHAR(name.c_str())));
+  }
+
+  int64 featureID = 0;
+  const VariableResolver resolver =
+      [&referencedProperties, &featureID](const std::string& name) -> Value {
+    auto it = referencedProperties.find(name);
+    if (it == referencedProperties.end() || !it->second) {
+      return Undefined();
+    }
+    return toStyleValue(
+        UCesiumPropertyTablePropertyBlueprintLibrary::GetValue(
+            *it->second,
+            featureID));
+  };
+
+  for (size_t i = 0; i < colors.size(); ++i) {
+    featureID = int64(i);
+    colors[i] = toColor(pStyle->evaluate(resolver));
+  }
+}
+
+} // namespace CesiumStyle
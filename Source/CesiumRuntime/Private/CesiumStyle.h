@@ -0,0 +1,324 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "Containers/Array.h"
+#include "Containers/UnrealString.h"
+#include "Math/Color.h"
+#include <glm/vec4.hpp>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <variant>
+#include <vector>
+
+struct FCesiumPropertyTable;
+struct FCesiumPropertyTableDescription;
+
+/**
+ * @brief Compiles and evaluates 3D Tiles style expressions, as described in
+ * the 3D Tiles Styling specification.
+ *
+ * A style is compiled once, when it is set on a tileset. For each property
+ * table that has been encoded for the GPU, it is also compiled into a program
+ * that the tileset's material runs for every pixel, if the material has all of
+ * the values that the style reads. Changing such a style only uploads its new
+ * program. Otherwise, the style is evaluated for every feature of the property
+ * table, producing a lookup texture of colors that the material samples by
+ * feature ID. In both cases, the tiles and their materials are left in place.
+ */
+namespace CesiumStyle {
+
+/**
+ * @brief The value of an expression that could not be computed, such as a
+ * property that a feature does not have.
+ */
+struct Undefined {
+  bool operator==(const Undefined&) const noexcept { return true; }
+};
+
+/**
+ * @brief The value of an expression. Colors are RGBA with components in the
+ * range [0, 1].
+ */
+using Value = std::variant<Undefined, bool, double, std::string, glm::dvec4>;
+
+/**
+ * @brief Resolves a `${name}` variable of an expression to the value of the
+ * feature that is being styled.
+ */
+using VariableResolver = std::function<Value(const std::string& name)>;
+
+struct Node;
+
+/**
+ * @brief The instructions of a style program, which runs on a stack of values
+ * in the material. Each instruction is one RGBA32F texel of the program
+ * texture: its opcode, followed by its operand, if any.
+ *
+ * Shaders/Private/CesiumStyle.ush interprets these, so the two must be kept
+ * in sync.
+ */
+enum class Opcode : uint8_t {
+  /**
+   * @brief Ends the program. The stack holds the color, then whether the
+   * feature is shown.
+   */
+  End = 0,
+  Undefined,
+  Boolean,
+  Number,
+  /**
+   * @brief Pushes the number in the property slot given by the operand.
+   */
+  Property,
+  /**
+   * @brief Pushes the boolean in the property slot given by the operand.
+   */
+  BooleanProperty,
+  /**
+   * @brief Pops the red, green, blue, and alpha components of a color, in the
+   * range [0, 1], and pushes the color.
+   */
+  Color,
+  Not,
+  Negate,
+  ToNumber,
+  ToBoolean,
+  And,
+  Or,
+  Equal,
+  NotEqual,
+  Less,
+  LessEqual,
+  Greater,
+  GreaterEqual,
+  Add,
+  Subtract,
+  Multiply,
+  Divide,
+  Modulo,
+  /**
+   * @brief Pops the value if true, the condition, and the value if false, and
+   * pushes one of the values. The value if false is below the others so that
+   * chains of conditions do not deepen the stack.
+   */
+  Conditional,
+  Rgb,
+  Rgba,
+  Hsl,
+  Hsla,
+  Abs,
+  Sqrt,
+  Floor,
+  Ceil,
+  Round,
+  Sign,
+  Fract,
+  Exp,
+  Log,
+  Pow,
+  Min,
+  Max,
+  Clamp,
+  Mix,
+  IsNaN,
+  IsFinite
+};
+
+/**
+ * @brief The maximum number of instructions in a style program, including its
+ * End. This is the width of the program texture.
+ */
+constexpr int32_t MaximumProgramLength = 256;
+
+/**
+ * @brief The maximum number of values on the stack of a style program.
+ */
+constexpr int32_t MaximumProgramStackDepth = 16;
+
+/**
+ * @brief The maximum number of properties that a style program can read.
+ */
+constexpr int32_t MaximumProgramProperties = 16;
+
+/**
+ * @brief A property that a style program can read. The material provides it
+ * as a plain number, in the slot of its index.
+ */
+struct ProgramProperty {
+  std::string name;
+  bool isBoolean = false;
+};
+
+/**
+ * @brief Gets the properties of a property table that the generated material
+ * provides to style programs, in slot order. These are the scalar and boolean
+ * properties that are encoded as single numbers without value transforms, up
+ * to MaximumProgramProperties of them. Their values are the ones that the
+ * material sees, so integers that are coerced to a narrower type are styled by
+ * the coerced values.
+ */
+std::vector<ProgramProperty>
+getProgramProperties(const FCesiumPropertyTableDescription& propertyTable);
+
+/**
+ * @brief A compiled style expression, such as
+ * `${height} > 100 ? color('red') : color('white', 0.5)`.
+ *
+ * The supported subset of the styling language includes number, string, and
+ * boolean literals; `${name}` variables; the unary, arithmetic, comparison,
+ * logical, and conditional operators; the `color`, `rgb`, `rgba`, `hsl`, and
+ * `hsla` color constructors; and the built-in math and conversion functions.
+ * Regular expressions and vector types are not supported.
+ */
+class Expression {
+public:
+  /**
+   * @brief Compiles an expression.
+   *
+   * @param source The text of the expression.
+   * @param error Receives a description of the problem if the expression
+   * cannot be compiled.
+   * @returns The compiled expression, or std::nullopt on error.
+   */
+  static std::optional<Expression>
+  parse(const std::string& source, std::string& error);
+
+  /**
+   * @brief Evaluates this expression, using the given resolver for its
+   * variables.
+   */
+  Value evaluate(const VariableResolver& resolver) const;
+
+  /**
+   * @brief Gets the names of the variables referenced by this expression.
+   */
+  const std::vector<std::string>& getVariableNames() const noexcept {
+    return this->_variableNames;
+  }
+
+private:
+  friend class Style;
+
+  std::shared_ptr<const Node> _pRoot;
+  std::vector<std::string> _variableNames;
+};
+
+/**
+ * @brief Converts a value to a boolean, following the rules of JavaScript.
+ */
+bool toBoolean(const Value& value);
+
+/**
+ * @brief Converts a value to a number, following the rules of JavaScript.
+ * Values that cannot be converted become NaN.
+ */
+double toNumber(const Value& value);
+
+/**
+ * @brief A compiled 3D Tiles style, with its `defines`, `show`, and `color`.
+ */
+class Style {
+public:
+  /**
+   * @brief Compiles a style from its JSON representation, for example:
+   *
+   * ```
+   * {
+   *   "defines": { "tall": "${height} > 100" },
+   *   "show": "${type} !== 'tree'",
+   *   "color": {
+   *     "conditions": [
+   *       ["${tall}", "color('red')"],
+   *       ["true", "color('white')"]
+   *     ]
+   *   }
+   * }
+   * ```
+   *
+   * @param json The JSON text of the style.
+   * @param error Receives a description of the problem if the style cannot be
+   * compiled.
+   * @returns The compiled style, or std::nullopt on error.
+   */
+  static std::optional<Style> parse(const FString& json, FString& error);
+
+  /**
+   * @brief Evaluates the color of a feature. The alpha of the result is zero
+   * if the feature is hidden. Features without a color are white.
+   */
+  glm::dvec4 evaluate(const VariableResolver& resolver) const;
+
+  /**
+   * @brief Gets the names of the feature properties referenced by this style,
+   * not including its defines.
+   */
+  const std::vector<std::string>& getPropertyNames() const noexcept {
+    return this->_propertyNames;
+  }
+
+  /**
+   * @brief Compiles this style into a program that the material runs for each
+   * pixel, with the instructions described by Opcode.
+   *
+   * @param properties The properties that the program can read, by slot.
+   * @returns The instructions, or std::nullopt if the style needs a value
+   * that the material does not have, such as a string or another property, or
+   * if the program would be too long.
+   */
+  std::optional<std::vector<glm::vec4>>
+  compileProgram(const std::vector<ProgramProperty>& properties) const;
+
+  /**
+   * @brief Compiles a program for each of the given property tables whose
+   * properties allow it. Called once, before the style is shared with the
+   * tiles.
+   */
+  void compilePrograms(
+      const TArray<FCesiumPropertyTableDescription>& propertyTables);
+
+  /**
+   * @brief Gets the program compiled for a property table, or nullptr if the
+   * style must be evaluated for each of its features instead.
+   */
+  const std::vector<glm::vec4>*
+  getProgram(const FString& propertyTableName) const;
+
+private:
+  struct Condition {
+    Expression condition;
+    Expression color;
+  };
+
+  Value resolve(
+      const std::string& name,
+      const VariableResolver& resolver,
+      int32_t depth) const;
+
+  std::unordered_map<std::string, Expression> _defines;
+  std::optional<Expression> _show;
+  std::optional<Expression> _color;
+  std::vector<Condition> _colorConditions;
+  std::vector<std::string> _propertyNames;
+  std::unordered_map<std::string, std::vector<glm::vec4>> _programs;
+};
+
+/**
+ * @brief Evaluates a style for every feature of a property table, writing one
+ * color per feature ID. If the style is nullptr, every feature is white.
+ *
+ * @param pStyle The style, or nullptr.
+ * @param propertyTable The property table whose features are styled.
+ * @param colors The colors of the features, indexed by feature ID. Its size
+ * should not exceed the number of features in the property table.
+ */
+void evaluatePropertyTable(
+    const Style* pStyle,
+    const FCesiumPropertyTable& propertyTable,
+    std::span<FColor> colors);
+
+} // namespace CesiumStyle
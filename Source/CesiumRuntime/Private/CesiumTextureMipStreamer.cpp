@@ -0,0 +1,183 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumTextureMipStreamer.h"
+#include "CesiumGltfComponent.h"
+#include "CesiumTextureResource.h"
+#include "Components/PrimitiveComponent.h"
+#include "Engine/Texture2D.h"
+#include <Cesium3DTilesSelection/Tile.h>
+#include <CesiumUtility/Tracing.h>
+#include <limits>
+
+namespace {
+
+struct TextureRequest {
+  TSharedPtr<FCesiumTextureResource> pResource;
+  double screenPixels = 0.0;
+};
+
+struct MipChange {
+  TSharedPtr<FCesiumTextureResource> pResource;
+  uint32 firstMip;
+  bool addsDetail;
+  uint32 mipDelta;
+};
+
+bool getTileBounds(const UCesiumGltfComponent& gltf, FBoxSphereBounds& bounds) {
+  bool found = false;
+  for (const USceneComponent* pChild : gltf.GetAttachChildren()) {
+    const UPrimitiveComponent* pPrimitive = Cast<UPrimitiveComponent>(pChild);
+    if (!pPrimitive || !pPrimitive->IsRegistered()) {
+      continue;
+    }
+    bounds = found ? bounds + pPrimitive->Bounds : pPrimitive->Bounds;
+    found = true;
+  }
+  return found;
+}
+
+} // namespace
+
+/*static*/ void CesiumTextureMipStreamer::update(
+    const std::vector<Cesium3DTilesSelection::Tile*>& tiles,
+    const std::vector<FCesiumCamera>& cameras,
+    int32 maximumUpdates) {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::StreamTextureMips)
+
+  if (cameras.empty() || maximumUpdates <= 0) {
+    return;
+  }
+
+  // A texture may be used by several tiles, such as a shared glTF image or a
+  // raster overlay tile draped over several geometry tiles, so it needs the
+  // detail of the tile that appears largest.
+  TMap<FCesiumTextureResource*, TextureRequest> requests;
+  for (Cesium3DTilesSelection::Tile* pTile : tiles) {
+    const Cesium3DTilesSelection::TileRenderContent* pRenderContent =
+        pTile->getContent().getRenderContent();
+    if (!pRenderContent) {
+      continue;
+    }
+
+    UCesiumGltfComponent* pGltf = static_cast<UCesiumGltfComponent*>(
+        pRenderContent->getRenderResources());
+    FBoxSphereBounds bounds;
+    if (!pGltf || pGltf->TileTextures.IsEmpty() ||
+        !getTileBounds(*pGltf, bounds)) {
+      continue;
+    }
+
+    const double screenPixels = computeScreenPixels(bounds, cameras);
+
+    for (const TWeakObjectPtr<UTexture2D>& pTexture : pGltf->TileTextures) {
+      if (!pTexture.IsValid()) {
+        continue;
+      }
+
+      // The textures of tiles are always created by CesiumTextureUtility,
+      // which gives them an FCesiumTextureResource wrapping the resource of
+      // their image.
+      FCesiumTextureResource* pWrapper =
+          static_cast<FCesiumTextureResource*>(pTexture->GetResource());
+      TSharedPtr<FCesiumTextureResource> pResource =
+          pWrapper ? pWrapper->GetWrappedResource() : nullptr;
+      if (!pResource || !pResource->CanStreamMips()) {
+        continue;
+      }
+
+      TextureRequest& request = requests.FindOrAdd(pResource.Get());
+      request.pResource = pResource;
+      request.screenPixels = FMath::Max(request.screenPixels, screenPixels);
+    }
+  }
+
+  TArray<MipChange> changes;
+  for (const auto& [pKey, request] : requests) {
+    const FCesiumTextureResource& resource = *request.pResource;
+    const uint32 current = resource.GetFirstResidentMip();
+    const uint32 desired = computeFirstResidentMip(
+        resource.GetSizeX(),
+        resource.GetSizeY(),
+        resource.GetFullMipCount(),
+        request.screenPixels);
+
+    if (desired < current) {
+      changes.Add({request.pResource, desired, true, current - desired});
+      continue;
+    }
+
+    // Only drop mips that would not be needed even at twice the size on
+    // screen, so that small camera movements don't keep uploading and
+    // dropping the same mip.
+    const uint32 dropped = computeFirstResidentMip(
+        resource.GetSizeX(),
+        resource.GetSizeY(),
+        resource.GetFullMipCount(),
+        request.screenPixels * 2.0);
+    if (dropped > current) {
+      changes.Add({request.pResource, dropped, false, dropped - current});
+    }
+  }
+
+  changes.Sort([](const MipChange& a, const MipChange& b) {
+    if (a.addsDetail != b.addsDetail) {
+      return a.addsDetail;
+    }
+    return a.mipDelta > b.mipDelta;
+  });
+
+  const int32 count = FMath::Min(changes.Num(), maximumUpdates);
+  for (int32 i = 0; i < count; ++i) {
+    FCesiumTextureResource::SetFirstResidentMip(
+        changes[i].pResource,
+        changes[i].firstMip);
+  }
+}
+
+/*static*/ double CesiumTextureMipStreamer::computeScreenPixels(
+    const FBoxSphereBounds& bounds,
+    const std::vector<FCesiumCamera>& cameras) {
+  double result = 0.0;
+  for (const FCesiumCamera& camera : cameras) {
+    const double distance =
+        FVector::Distance(camera.Location, bounds.Origin) - bounds.SphereRadius;
+    if (distance <= 0.0) {
+      return std::numeric_limits<double>::infinity();
+    }
+
+    // The field of view is horizontal, so it spans the viewport's width.
+    const double tanHalfFov =
+        FMath::Tan(FMath::DegreesToRadians(camera.FieldOfViewDegrees) * 0.5);
+    if (tanHalfFov <= 0.0) {
+      continue;
+    }
+
+    const double pixels =
+        bounds.SphereRadius / (distance * tanHalfFov) * camera.ViewportSize.X;
+    result = FMath::Max(result, pixels);
+  }
+  return result;
+}
+
+/*static*/ uint32 CesiumTextureMipStreamer::computeFirstResidentMip(
+    uint32 width,
+    uint32 height,
+    uint32 mipCount,
+    double screenPixels) {
+  const uint32 longestSide = FMath::Max(width, height);
+  if (mipCount <= 1 || longestSide <= MinimumResidentSize ||
+      screenPixels >= double(longestSide)) {
+    return 0;
+  }
+
+  // Each mip halves the texture, so the GPU samples the mip where one texel
+  // covers about one pixel.
+  const double texelsPerPixel =
+      double(longestSide) / FMath::Max(screenPixels, 1.0);
+  uint32 firstMip = uint32(FMath::FloorToInt(FMath::Log2(texelsPerPixel)));
+
+  while (firstMip > 0 && (longestSide >> firstMip) < MinimumResidentSize) {
+    --firstMip;
+  }
+  return FMath::Min(firstMip, mipCount - 1);
+}
@@ -0,0 +1,64 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CesiumCamera.h"
+#include "CoreMinimal.h"
+#include <vector>
+
+namespace Cesium3DTilesSelection {
+class Tile;
+}
+
+/**
+ * Chooses which mips of the textures of a tileset's rendered tiles are
+ * resident in GPU memory, based on how large each tile appears on screen.
+ *
+ * Cesium textures do not take part in Unreal's texture streaming, because
+ * their data does not come from cooked bulk data. Instead, when texture mip
+ * streaming is enabled in the runtime settings, their resources keep their
+ * pixel data in system memory and recreate their RHI textures with fewer mips
+ * when {@link update} finds that the most detailed mips cannot be seen. The
+ * mips are uploaded again as soon as the tiles that use them come closer.
+ *
+ * Only the textures of rendered tiles are considered, so the textures of
+ * hidden tiles keep the mips they had when they were last rendered.
+ */
+class CesiumTextureMipStreamer {
+public:
+  /**
+   * The size, in texels, below which the longest side of a texture is never
+   * reduced.
+   */
+  static constexpr uint32 MinimumResidentSize = 64;
+
+  /**
+   * Changes the resident mips of the textures of the given tiles, at most
+   * `maximumUpdates` textures at a time. Textures that need more detail are
+   * updated before textures that can drop mips.
+   */
+  static void update(
+      const std::vector<Cesium3DTilesSelection::Tile*>& tiles,
+      const std::vector<FCesiumCamera>& cameras,
+      int32 maximumUpdates);
+
+  /**
+   * Estimates the size, in pixels, of the diameter of a bounding sphere in
+   * the view of the camera that sees it largest. Returns infinity if a camera
+   * is inside the sphere, and 0 if there are no cameras.
+   */
+  static double computeScreenPixels(
+      const FBoxSphereBounds& bounds,
+      const std::vector<FCesiumCamera>& cameras);
+
+  /**
+   * Computes the index of the most detailed mip that a texture with the given
+   * size and mip count needs in order to cover the given number of pixels on
+   * screen.
+   */
+  static uint32 computeFirstResidentMip(
+      uint32 width,
+      uint32 height,
+      uint32 mipCount,
+      double screenPixels);
+};
@@ -2,6 +2,8 @@
 
 #include "CesiumTextureResource.h"
 #include "CesiumRuntime.h"
+#include "CesiumRuntimeSettings.h"
+#include "CesiumStats.h"
 #include "CesiumTextureUtility.h"
 #include "Misc/CoreStats.h"
 #include "RenderUtils.h"
@@ -35,7 +37,7 @@ public:
       bool isPrimary);
 
   FCesiumUseExistingTextureResource(
-      const TSharedPtr<FTextureResource>& pExistingTexture,
+      const TSharedPtr<FCesiumTextureResource>& pExistingTexture,
       TextureGroup textureGroup,
       uint32 width,
       uint32 height,
@@ -48,11 +50,18 @@ public:
       uint32 extData,
       bool isPrimary);
 
+  virtual void ReleaseRHI() override;
+
+  virtual TSharedPtr<FCesiumTextureResource>
+  GetWrappedResource() const override {
+    return this->_pExistingTexture;
+  }
+
 protected:
   virtual FTextureRHIRef InitializeTextureRHI() override;
 
 private:
-  TSharedPtr<FTextureResource> _pExistingTexture;
+  TSharedPtr<FCesiumTextureResource> _pExistingTexture;
 };
 
 /**
@@ -64,7 +73,8 @@ private:
  *
  * Upon passing an `ImageAsset` to this class's constructor, its `pixelData` and
  * `mipPositions` fields are cleared. That is, this class takes ownership of
- * that data.
+ * that data. The data is freed once the RHI texture is created, unless it is
+ * retained so that the resident mips can be changed later.
  */
 class FCesiumCreateNewTextureResource : public FCesiumTextureResource {
 public:
@@ -79,7 +89,20 @@ public:
       TextureAddress addressY,
       bool sRGB,
       bool useMipsIfAvailable,
-      uint32 extData);
+      uint32 extData,
+      bool retainPixelData = false);
+
+  virtual bool CanStreamMips() const override {
+    return this->_retainPixelData && this->_fullMipCount > 1;
+  }
+
+  virtual uint32 GetFullMipCount() const override {
+    return this->_fullMipCount;
+  }
+
+  virtual uint64 GetRetainedPixelBytes() const override {
+    return this->_retainPixelData ? this->_pixelData.size() : 0;
+  }
 
 protected:
   virtual FTextureRHIRef InitializeTextureRHI() override;
@@ -87,6 +110,8 @@ protected:
 private:
   std::vector<CesiumGltf::ImageAssetMipPosition> _mipPositions;
   std::vector<std::byte> _pixelData;
+  uint32 _fullMipCount;
+  bool _retainPixelData;
 };
 
 ESamplerFilter convertFilter(TextureFilter filter) {
@@ -317,7 +342,8 @@ void FCesiumTextureResourceDeleter::operator()(FCesiumTextureResource* p) {
     TextureAddress addressX,
     TextureAddress addressY,
     bool sRGB,
-    bool needsMipMaps) {
+    bool needsMipMaps,
+    bool keepPixelData) {
   if (imageCesium.pixelData.empty()) {
     return nullptr;
   }
@@ -354,7 +380,14 @@ void FCesiumTextureResourceDeleter::operator()(FCesiumTextureResource* p) {
   // caching purposes.
   imageCesium.sizeBytes = int64_t(imageCesium.pixelData.size());
 
-  if (GRHISupportsAsyncTextureCreation) {
+  // A texture that streams its mips must be able to recreate its RHI texture
+  // from the pixel data at any time, so it is always created on the render
+  // thread, by a resource that owns the pixel data.
+  const bool streamMips =
+      !keepPixelData && imageCesium.mipPositions.size() > 1 &&
+      GetDefault<UCesiumRuntimeSettings>()->EnableTextureMipStreaming;
+
+  if (GRHISupportsAsyncTextureCreation && !streamMips) {
     // Create RHI texture resource on this worker
     // thread, and then hand it off to the renderer
     // thread.
@@ -379,23 +412,33 @@ void FCesiumTextureResourceDeleter::operator()(FCesiumTextureResource* p) {
             0,
             true));
 
-    // Clear the now-unnecessary copy of the pixel data.
-    // Calling clear() isn't good enough because it
-    // won't actually release the memory.
-    std::vector<std::byte> pixelData;
-    imageCesium.pixelData.swap(pixelData);
+    if (!keepPixelData) {
+      // Clear the now-unnecessary copy of the pixel data.
+      // Calling clear() isn't good enough because it
+      // won't actually release the memory.
+      std::vector<std::byte> pixelData;
+      imageCesium.pixelData.swap(pixelData);
 
-    std::vector<CesiumGltf::ImageAssetMipPosition> mipPositions;
-    imageCesium.mipPositions.swap(mipPositions);
+      std::vector<CesiumGltf::ImageAssetMipPosition> mipPositions;
+      imageCesium.mipPositions.swap(mipPositions);
+    }
 
     return pResult;
   } else {
+    // The new texture resource takes ownership of the pixel data, so it must
+    // be given a copy if the image needs to keep its own.
+    CesiumGltf::ImageAsset pixelDataCopy;
+    if (keepPixelData) {
+      pixelDataCopy.pixelData = imageCesium.pixelData;
+      pixelDataCopy.mipPositions = imageCesium.mipPositions;
+    }
+
     // The RHI texture will be created later on the
     // render thread, directly from this texture source.
     // We need valid pixelData here, though.
     auto pResult =
         FCesiumTextureResourceUniquePtr(new FCesiumCreateNewTextureResource(
-            imageCesium,
+            keepPixelData ? pixelDataCopy : imageCesium,
             textureGroup,
             imageCesium.width,
             imageCesium.height,
@@ -405,7 +448,8 @@ void FCesiumTextureResourceDeleter::operator()(FCesiumTextureResource* p) {
             addressY,
             sRGB,
             needsMipMaps,
-            0));
+            0,
+            streamMips));
     return pResult;
   }
 }
@@ -468,7 +512,11 @@ FCesiumTextureResource::FCesiumTextureResource(
       _addressY(convertAddressMode(addressY)),
       _useMipsIfAvailable(useMipsIfAvailable),
       _platformExtData(extData),
-      _isPrimary(isPrimary) {
+      _textureSize(0),
+      _isPrimary(isPrimary),
+      _firstResidentMip(0),
+      _requestedFirstMip(0),
+      _residentBytes(0) {
   this->bGreyScaleFormat = (_format == PF_G8) || (_format == PF_BC4);
   this->bSRGB = sRGB;
   STAT(this->_lodGroupStatName = TextureGroupStatFNames[this->_textureGroup]);
@@ -513,45 +561,126 @@ void FCesiumTextureResource::InitRHI() {
 
   RHIUpdateTextureReference(TextureReferenceRHI, this->TextureRHI);
 
-#if STATS
-  if (this->_isPrimary) {
-    ETextureCreateFlags textureFlags = TexCreate_ShaderResource;
-    if (this->bSRGB) {
-      textureFlags |= TexCreate_SRGB;
-    }
+  this->addTextureStats();
+}
 
-    const FIntPoint MipExtents =
-        CalcMipMapExtent(this->_width, this->_height, this->_format, 0);
-    const FRHIResourceCreateInfo CreateInfo(this->_platformExtData);
+void FCesiumTextureResource::ReleaseRHI() {
+  this->removeTextureStats();
 
-    uint32 alignment;
-    this->_textureSize = RHICalcTexture2DPlatformSize(
-        MipExtents.X,
-        MipExtents.Y,
-        this->_format,
-        this->GetCurrentMipCount(),
-        1,
-        textureFlags,
-        FRHIResourceCreateInfo(this->_platformExtData),
-        alignment);
+  RHIUpdateTextureReference(TextureReferenceRHI, nullptr);
+
+  FTextureResource::ReleaseRHI();
+}
 
-    INC_DWORD_STAT_BY(STAT_TextureMemory, this->_textureSize);
-    INC_DWORD_STAT_FNAME_BY(this->_lodGroupStatName, this->_textureSize);
+/*static*/ void FCesiumTextureResource::SetFirstResidentMip(
+    const TSharedPtr<FCesiumTextureResource>& pResource,
+    uint32 firstMip) {
+  if (!pResource || !pResource->CanStreamMips()) {
+    return;
   }
-#endif
+
+  firstMip = FMath::Min(firstMip, pResource->GetFullMipCount() - 1);
+  if (firstMip == pResource->_requestedFirstMip) {
+    return;
+  }
+  pResource->_requestedFirstMip = firstMip;
+
+  ENQUEUE_RENDER_COMMAND(Cesium_UpdateResidentMips)
+  ([pResource, firstMip](FRHICommandListImmediate& RHICmdList) {
+    pResource->updateResidentMips(firstMip);
+  });
 }
 
-void FCesiumTextureResource::ReleaseRHI() {
+void FCesiumTextureResource::AddDependent(FCesiumTextureResource* pDependent) {
+  this->_dependents.AddUnique(pDependent);
+}
+
+void FCesiumTextureResource::RemoveDependent(
+    FCesiumTextureResource* pDependent) {
+  this->_dependents.RemoveSingleSwap(pDependent);
+}
+
+void FCesiumTextureResource::updateResidentMips(uint32 firstMip) {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::UpdateResidentMips)
+
+  this->_firstResidentMip = firstMip;
+  if (!this->IsInitialized()) {
+    // InitRHI will create the texture with these mips.
+    return;
+  }
+
+  this->removeTextureStats();
+
+  this->TextureRHI = this->InitializeTextureRHI();
+  RHIUpdateTextureReference(this->TextureReferenceRHI, this->TextureRHI);
+
+  for (FCesiumTextureResource* pDependent : this->_dependents) {
+    pDependent->TextureRHI = this->TextureRHI;
+    RHIUpdateTextureReference(
+        pDependent->TextureReferenceRHI,
+        pDependent->TextureRHI);
+  }
+
+  this->addTextureStats();
+}
+
+void FCesiumTextureResource::addTextureStats() {
+  if (!this->_isPrimary) {
+    return;
+  }
+
+  ETextureCreateFlags textureFlags = TexCreate_ShaderResource;
+  if (this->bSRGB) {
+    textureFlags |= TexCreate_SRGB;
+  }
+
+  const FIntPoint MipExtents = CalcMipMapExtent(
+      this->_width,
+      this->_height,
+      this->_format,
+      this->_firstResidentMip);
+
+  uint32 alignment;
+  this->_textureSize = RHICalcTexture2DPlatformSize(
+      MipExtents.X,
+      MipExtents.Y,
+      this->_format,
+      this->GetCurrentMipCount(),
+      1,
+      textureFlags,
+      FRHIResourceCreateInfo(this->_platformExtData),
+      alignment);
+  this->_residentBytes = this->_textureSize;
+
 #if STATS
-  if (this->_isPrimary) {
-    DEC_DWORD_STAT_BY(STAT_TextureMemory, this->_textureSize);
-    DEC_DWORD_STAT_FNAME_BY(this->_lodGroupStatName, this->_textureSize);
+  INC_DWORD_STAT_BY(STAT_TextureMemory, this->_textureSize);
+  INC_DWORD_STAT_FNAME_BY(this->_lodGroupStatName, this->_textureSize);
+
+  // Encoded features and metadata are the only 8-bit data textures.
+  if (this->_textureGroup == TEXTUREGROUP_8BitData) {
+    INC_MEMORY_STAT_BY(STAT_CesiumMetadataMemory, this->_textureSize);
+  } else {
+    INC_MEMORY_STAT_BY(STAT_CesiumTextureMemory, this->_textureSize);
   }
 #endif
+}
 
-  RHIUpdateTextureReference(TextureReferenceRHI, nullptr);
+void FCesiumTextureResource::removeTextureStats() {
+  if (!this->_isPrimary) {
+    return;
+  }
 
-  FTextureResource::ReleaseRHI();
+#if STATS
+  DEC_DWORD_STAT_BY(STAT_TextureMemory, this->_textureSize);
+  DEC_DWORD_STAT_FNAME_BY(this->_lodGroupStatName, this->_textureSize);
+  if (this->_textureGroup == TEXTUREGROUP_8BitData) {
+    DEC_MEMORY_STAT_BY(STAT_CesiumMetadataMemory, this->_textureSize);
+  } else {
+    DEC_MEMORY_STAT_BY(STAT_CesiumTextureMemory, this->_textureSize);
+  }
+#endif
+  this->_textureSize = 0;
+  this->_residentBytes = 0;
 }
 
 #if STATS
@@ -611,7 +740,7 @@ FCesiumUseExistingTextureResource::FCesiumUseExistingTextureResource(
 }
 
 FCesiumUseExistingTextureResource::FCesiumUseExistingTextureResource(
-    const TSharedPtr<FTextureResource>& pExistingTexture,
+    const TSharedPtr<FCesiumTextureResource>& pExistingTexture,
     TextureGroup textureGroup,
     uint32 width,
     uint32 height,
@@ -639,12 +768,22 @@ FCesiumUseExistingTextureResource::FCesiumUseExistingTextureResource(
 
 FTextureRHIRef FCesiumUseExistingTextureResource::InitializeTextureRHI() {
   if (this->_pExistingTexture) {
+    // Follow the existing texture if its resident mips change.
+    this->_pExistingTexture->AddDependent(this);
     return this->_pExistingTexture->TextureRHI;
   } else {
     return this->TextureRHI;
   }
 }
 
+void FCesiumUseExistingTextureResource::ReleaseRHI() {
+  if (this->_pExistingTexture) {
+    this->_pExistingTexture->RemoveDependent(this);
+  }
+
+  FCesiumTextureResource::ReleaseRHI();
+}
+
 FCesiumCreateNewTextureResource::FCesiumCreateNewTextureResource(
     CesiumGltf::ImageAsset& image,
     TextureGroup textureGroup,
@@ -656,7 +795,8 @@ FCesiumCreateNewTextureResource::FCesiumCreateNewTextureResource(
     TextureAddress addressY,
     bool sRGB,
     bool useMipsIfAvailable,
-    uint32 extData)
+    uint32 extData,
+    bool retainPixelData)
     : FCesiumTextureResource(
           textureGroup,
           width,
@@ -670,7 +810,11 @@ FCesiumCreateNewTextureResource::FCesiumCreateNewTextureResource(
           extData,
           true),
       _mipPositions(std::move(image.mipPositions)),
-      _pixelData(std::move(image.pixelData)) {}
+      _pixelData(std::move(image.pixelData)),
+      _fullMipCount(FMath::Max<uint32>(
+          1,
+          static_cast<uint32>(this->_mipPositions.size()))),
+      _retainPixelData(retainPixelData) {}
 
 FTextureRHIRef FCesiumCreateNewTextureResource::InitializeTextureRHI() {
   // Use the asset ID as the name of the texture so it will be visible in the
@@ -702,8 +846,12 @@ FTextureRHIRef FCesiumCreateNewTextureResource::InitializeTextureRHI() {
     textureFlags |= TexCreate_SRGB;
   }
 
-  uint32 mipCount =
-      FMath::Max(1, static_cast<int32>(this->_mipPositions.size()));
+  // Leave out the mips that are more detailed than the first resident one.
+  const uint32 firstMip =
+      FMath::Min(this->_firstResidentMip, this->_fullMipCount - 1);
+  const uint32 mipCount = this->_fullMipCount - firstMip;
+  const uint32 width = FMath::Max<uint32>(this->_width >> firstMip, 1);
+  const uint32 height = FMath::Max<uint32>(this->_height >> firstMip, 1);
 
   // Create a new RHI texture, initially empty.
 
@@ -712,7 +860,7 @@ FTextureRHIRef FCesiumCreateNewTextureResource::InitializeTextureRHI() {
   // Cesium Native's mip-map generation to obey a standard memory layout.
   FTexture2DRHIRef rhiTexture =
       RHICreateTexture(FRHITextureCreateDesc::Create2D(createInfo.DebugName)
-                           .SetExtent(int32(this->_width), int32(this->_height))
+                           .SetExtent(int32(width), int32(height))
                            .SetFormat(this->_format)
                            .SetNumMips(uint8(mipCount))
                            .SetNumSamples(1)
@@ -735,10 +883,14 @@ FTextureRHIRef FCesiumCreateNewTextureResource::InitializeTextureRHI() {
         this->_height,
         this->_pixelData,
         this->_mipPositions,
-        i);
+        i + firstMip);
     RHIUnlockTexture2D(rhiTexture, i, false);
   }
 
+  if (this->_retainPixelData) {
+    return rhiTexture;
+  }
+
   // Clear the now-unnecessary copy of the pixel data. Calling clear() isn't
   // good enough because it won't actually release the memory.
   std::vector<std::byte> pixelData;
@@ -7,6 +7,7 @@
 #include "TextureResource.h"
 #include <CesiumAsync/SharedAssetDepot.h>
 #include <CesiumGltf/ImageAsset.h>
+#include <atomic>
 
 class FCesiumTextureResource;
 
@@ -31,7 +32,8 @@ public:
    *
    * @param imageCesium The image data from which to create the texture
    * resource. After this method returns, the `pixelData` will be empty, and
-   * `sizeBytes` will be set to its previous size.
+   * `sizeBytes` will be set to its previous size, unless `keepPixelData` is
+   * true.
    * @param textureGroup The texture group in which to create this texture.
    * @param overridePixelFormat Overrides the pixel format. If std::nullopt, the
    * format is inferred from the `ImageAsset`.
@@ -44,6 +46,14 @@ public:
    * as sRGB.
    * @param needsMipMaps True if this texture requires mipmaps. They will be
    * generated if they don't already exist.
+   * @param keepPixelData True if the `pixelData` of the image should be left
+   * in place, because it is still read on the CPU. This is the case for
+   * feature ID and property textures.
+   *
+   * If texture mip streaming is enabled in the runtime settings, a texture with
+   * multiple mips that does not keep its pixel data is created on the render
+   * thread, and its resource retains the pixel data so that it can later
+   * change which mips are resident with `SetFirstResidentMip`.
    * @return The created texture resource, or nullptr if a texture could not be
    * created.
    */
@@ -55,7 +65,8 @@ public:
       TextureAddress addressX,
       TextureAddress addressY,
       bool sRGB,
-      bool needsMipMaps);
+      bool needsMipMaps,
+      bool keepPixelData = false);
 
   /**
    * Create a new FCesiumTextureResource wrapping an existing one and providing
@@ -95,6 +106,8 @@ public:
 
   uint32 GetSizeX() const override { return this->_width; }
   uint32 GetSizeY() const override { return this->_height; }
+  EPixelFormat GetPixelFormat() const { return this->_format; }
+  TextureGroup GetTextureGroup() const { return this->_textureGroup; }
 
 #if ENGINE_VERSION_5_3_OR_HIGHER
   virtual void InitRHI(FRHICommandListBase& RHICmdList) override;
@@ -103,6 +116,69 @@ public:
 #endif
   virtual void ReleaseRHI() override;
 
+  /**
+   * Gets the resource whose RHI texture this resource uses, or nullptr if this
+   * resource created its own.
+   */
+  virtual TSharedPtr<FCesiumTextureResource> GetWrappedResource() const {
+    return nullptr;
+  }
+
+  /**
+   * Returns true if this resource can change which of its mips are resident
+   * with `SetFirstResidentMip`.
+   */
+  virtual bool CanStreamMips() const { return false; }
+
+  /**
+   * Gets the number of mips of this texture, including the ones that are not
+   * resident.
+   */
+  virtual uint32 GetFullMipCount() const { return 1; }
+
+  /**
+   * Gets the index of the most detailed mip that was last requested to be
+   * resident. This must be called from the game thread.
+   */
+  uint32 GetFirstResidentMip() const { return this->_requestedFirstMip; }
+
+  /**
+   * Gets the estimated size of the RHI texture that this resource created, or
+   * 0 if it uses the texture of another resource or its texture has not been
+   * created yet. This may be called from any thread.
+   */
+  uint64 GetResidentBytes() const { return this->_residentBytes; }
+
+  /**
+   * Gets the size of the pixel data that this resource keeps on the CPU so
+   * that it can recreate its RHI texture with different mips.
+   */
+  virtual uint64 GetRetainedPixelBytes() const { return 0; }
+
+  /**
+   * Recreates the RHI texture of a resource, and of all resources that wrap
+   * it, so that only the mips starting at the given index are resident. This
+   * must be called from the game thread, and does nothing if `CanStreamMips`
+   * is false. The resource is kept alive until the render thread is done with
+   * it.
+   */
+  static void SetFirstResidentMip(
+      const TSharedPtr<FCesiumTextureResource>& pResource,
+      uint32 firstMip);
+
+  /**
+   * Registers a resource that uses this resource's RHI texture, so that it is
+   * updated when the resident mips change. This must be called from the
+   * render thread.
+   */
+  void AddDependent(FCesiumTextureResource* pDependent);
+
+  /**
+   * Unregisters a resource added with `AddDependent`. This must be called from
+   * the render thread.
+   */
+  void RemoveDependent(FCesiumTextureResource* pDependent);
+
 #if STATS
   static FName TextureGroupStatFNames[TEXTUREGROUP_MAX];
 #endif
@@ -122,4 +198,20 @@ protected:
   FName _lodGroupStatName;
   uint64 _textureSize;
   bool _isPrimary;
+
+  /**
+   * The index of the most detailed resident mip, accessed only from the render
+   * thread.
+   */
+  uint32 _firstResidentMip;
+
+private:
+  void addTextureStats();
+  void removeTextureStats();
+
+  void updateResidentMips(uint32 firstMip);
+
+  uint32 _requestedFirstMip;
+  std::atomic<uint64> _residentBytes;
+  TArray<FCesiumTextureResource*> _dependents;
 };
@@ -310,7 +310,32 @@ TUniquePtr<LoadedTextureResult> loadTextureAnyThreadPart(
           sRGB,
           useMipMapsIfAvailable,
           overridePixelFormat);
-  check(extension.getFuture().isReady());
+  return loadTextureAnyThreadPart(
+      extension,
+      addressX,
+      addressY,
+      filter,
+      useMipMapsIfAvailable,
+      group,
+      sRGB);
+}
+
+TUniquePtr<LoadedTextureResult> loadTextureAnyThreadPart(
+    const ExtensionImageAssetUnreal& extension,
+    TextureAddress addressX,
+    TextureAddress addressY,
+    TextureFilter filter,
+    bool useMipMapsIfAvailable,
+    TextureGroup group,
+    bool sRGB) {
+  const CesiumAsync::SharedFuture<void>& future = extension.getFuture();
+  if (!future.isReady()) {
+    // Images can be shared with tiles that are loading in other threads, one
+    // of which may still be creating the resource. It does so without waiting
+    // on anything else, so this does not wait for long.
+    future.wait();
+  }
+
   if (extension.getTextureResource() == nullptr) {
     return nullptr;
   }
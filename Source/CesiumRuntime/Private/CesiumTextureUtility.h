@@ -21,6 +21,8 @@ struct ImageAsset;
 struct Texture;
 } // namespace CesiumGltf
 
+struct ExtensionImageAssetUnreal;
+
 namespace CesiumTextureUtility {
 
 // A slightly roundabout way to a hold a UTexture2D.
@@ -145,6 +147,24 @@ TUniquePtr<LoadedTextureResult> loadTextureAnyThreadPart(
     bool sRGB,
     std::optional<EPixelFormat> overridePixelFormat);
 
+/**
+ * @brief Does the asynchronous part of renderer resource preparation for a
+ * texture that wraps the resource of an image extension, such as an
+ * {@link ExtensionImageAssetUnrealMetadata}. If another thread is still
+ * creating that resource, this waits for it. This method should be called in
+ * a background thread.
+ *
+ * @return The loaded texture, or nullptr if the image has no resource.
+ */
+TUniquePtr<LoadedTextureResult> loadTextureAnyThreadPart(
+    const ExtensionImageAssetUnreal& extension,
+    TextureAddress addressX,
+    TextureAddress addressY,
+    TextureFilter filter,
+    bool useMipMapsIfAvailable,
+    TextureGroup group,
+    bool sRGB);
+
 /**
  * @brief Does the main-thread part of render resource preparation for this
  * image and queues up any required render-thread tasks to finish preparing the
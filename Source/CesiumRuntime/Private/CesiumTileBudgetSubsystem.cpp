@@ -0,0 +1,156 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumTileBudgetSubsystem.h"
+#include "Cesium3DTileset.h"
+#include "CesiumRuntimeSettings.h"
+#include "Engine/Engine.h"
+#include "HAL/IConsoleManager.h"
+
+namespace {
+TAutoConsoleVariable<bool> CVarShowTileBudget(
+    TEXT("cesium.ShowTileBudget"),
+    false,
+    TEXT("Shows how the world tile budget is allocated among tilesets."));
+
+// Tilesets that have not reported their usage for this many frames, such as
+// tilesets that are no longer ticking, are dropped from the budget.
+constexpr uint64 StaleReportFrames = 60;
+} // namespace
+
+/*static*/ bool UCesiumTileBudgetSubsystem::IsWorldTileBudgetEnabled() {
+  return GetDefault<UCesiumRuntimeSettings>()->EnableWorldTileBudget;
+}
+
+TArray<FCesiumTilesetBudgetUsage>
+UCesiumTileBudgetSubsystem::GetTilesetBudgetUsage() const {
+  TArray<FCesiumTilesetBudgetUsage> result;
+  result.Reserve(this->_tilesets.Num());
+  for (const TilesetEntry& entry : this->_tilesets) {
+    if (entry.pTileset.IsValid()) {
+      result.Add(entry.usage);
+    }
+  }
+  return result;
+}
+
+void UCesiumTileBudgetSubsystem::reportTilesetUsage(
+    ACesium3DTileset* pTileset,
+    int64 usedBytes,
+    int32 tilesWaiting,
+    uint64 frameNumber) {
+  TilesetEntry* pEntry = this->_tilesets.FindByPredicate(
+      [pTileset](const TilesetEntry& entry) {
+        return entry.pTileset.Get() == pTileset;
+      });
+
+  if (!pEntry) {
+    pEntry = &this->_tilesets.AddDefaulted_GetRef();
+    pEntry->pTileset = pTileset;
+    pEntry->usage.Tileset = pTileset;
+
+    // Force the allocations to be recomputed to include the new tileset.
+    this->_allocationFrame = TNumericLimits<uint64>::Max();
+  }
+
+  pEntry->usage.UsedBytes = usedBytes;
+  pEntry->usage.TilesWaiting = tilesWaiting;
+  pEntry->lastReportFrame = frameNumber;
+}
+
+const FCesiumTilesetBudgetUsage*
+UCesiumTileBudgetSubsystem::getTilesetAllocation(
+    const ACesium3DTileset* pTileset,
+    uint64 frameNumber) {
+  if (this->_allocationFrame != frameNumber) {
+    this->updateAllocations(frameNumber);
+  }
+
+  const TilesetEntry* pEntry = this->_tilesets.FindByPredicate(
+      [pTileset](const TilesetEntry& entry) {
+        return entry.pTileset.Get() == pTileset;
+      });
+  return pEntry ? &pEntry->usage : nullptr;
+}
+
+void UCesiumTileBudgetSubsystem::removeTileset(
+    const ACesium3DTileset* pTileset) {
+  int32 removed =
+      this->_tilesets.RemoveAll([pTileset](const TilesetEntry& entry) {
+        return entry.pTileset.Get() == pTileset;
+      });
+  if (removed > 0) {
+    this->_allocationFrame = TNumericLimits<uint64>::Max();
+  }
+}
+
+void UCesiumTileBudgetSubsystem::updateAllocations(uint64 frameNumber) {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::UpdateTileBudget)
+
+  this->_allocationFrame = frameNumber;
+
+  this->_tilesets.RemoveAll([frameNumber](const TilesetEntry& entry) {
+    return !entry.pTileset.IsValid() ||
+           entry.lastReportFrame + StaleReportFrames < frameNumber;
+  });
+
+  if (this->_tilesets.IsEmpty()) {
+    return;
+  }
+
+  const UCesiumRuntimeSettings* pSettings = GetDefault<UCesiumRuntimeSettings>();
+  const double totalBytes = double(pSettings->WorldMaximumCachedBytes);
+  const double totalLoads =
+      double(pSettings->WorldMaximumSimultaneousTileLoads);
+
+  // A tileset's demand is the number of tiles it is waiting on, plus one so
+  // that a fully refined tileset still has some weight.
+  double totalDemand = 0.0;
+  for (const TilesetEntry& entry : this->_tilesets) {
+    totalDemand += 1.0 + double(entry.usage.TilesWaiting);
+  }
+
+  const double evenShare =
+      EvenlyDividedFraction / double(this->_tilesets.Num());
+  for (TilesetEntry& entry : this->_tilesets) {
+    const double demand = 1.0 + double(entry.usage.TilesWaiting);
+    const double share = evenShare + (1.0 - EvenlyDividedFraction) *
+                                         demand / totalDemand;
+
+    entry.usage.Share = float(share);
+    entry.usage.AllocatedBytes = int64(totalBytes * share);
+    entry.usage.AllocatedTileLoads =
+        FMath::Max(1, FMath::RoundToInt32(totalLoads * share));
+  }
+
+  if (CVarShowTileBudget.GetValueOnGameThread()) {
+    this->showAllocations();
+  }
+}
+
+void UCesiumTileBudgetSubsystem::showAllocations() const {
+  if (!GEngine) {
+    return;
+  }
+
+  for (const TilesetEntry& entry : this->_tilesets) {
+    const ACesium3DTileset* pTileset = entry.pTileset.Get();
+    if (!pTileset) {
+      continue;
+    }
+
+    const FCesiumTilesetBudgetUsage& usage = entry.usage;
+    GEngine->AddOnScreenDebugMessage(
+        uint64(pTileset->GetUniqueID()),
+        1.0f,
+        usage.UsedBytes > usage.AllocatedBytes ? FColor::Yellow
+                                               : FColor::White,
+        FString::Printf(
+            TEXT("%s: %.0f%% share, %.1f / %.1f MiB, %d tiles waiting, %d loads"),
+            *pTileset->GetActorNameOrLabel(),
+            usage.Share * 100.0f,
+            double(usage.UsedBytes) / (1024.0 * 1024.0),
+            double(usage.AllocatedBytes) / (1024.0 * 1024.0),
+            usage.TilesWaiting,
+            usage.AllocatedTileLoads));
+  }
+}
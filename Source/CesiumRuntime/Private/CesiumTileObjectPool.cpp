@@ -0,0 +1,199 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumTileObjectPool.h"
+#include "CesiumLifetime.h"
+#include "CesiumPrimitive.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Materials/MaterialInstanceDynamic.h"
+#include "PhysicsEngine/BodySetup.h"
+
+namespace {
+constexpr ERenameFlags PoolRenameFlags =
+    REN_DontCreateRedirectors | REN_ForceNoResetLoaders | REN_NonTransactional |
+    REN_DoNotDirty;
+
+// Don't destroy more than this many excess objects at once, so that a
+// shrinking working set does not cause a hitch of its own.
+constexpr int32 MaximumTrimPerCall = 8;
+} // namespace
+
+UStaticMeshComponent* UCesiumTileObjectPool::acquireComponent(
+    UClass* pClass,
+    UObject* pOuter,
+    FName name) {
+  for (int32 i = this->PooledComponents.Num() - 1; i >= 0; --i) {
+    UStaticMeshComponent* pComponent = this->PooledComponents[i];
+    if (!IsValid(pComponent)) {
+      this->PooledComponents.RemoveAtSwap(i);
+      continue;
+    }
+
+    if (pComponent->GetClass() != pClass) {
+      continue;
+    }
+
+    this->PooledComponents.RemoveAtSwap(i);
+    pComponent->Rename(
+        name.IsNone() ? nullptr : *name.ToString(),
+        pOuter,
+        PoolRenameFlags);
+
+    ++this->_componentsInUse;
+    ++this->_stats.componentsReused;
+    return pComponent;
+  }
+
+  return nullptr;
+}
+
+bool UCesiumTileObjectPool::releaseComponent(UStaticMeshComponent* pComponent) {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::RecycleComponent)
+
+  --this->_componentsInUse;
+
+  ICesiumPrimitive* pCesiumPrimitive = Cast<ICesiumPrimitive>(pComponent);
+  if (!IsValid(pComponent) || !pCesiumPrimitive ||
+      this->PooledComponents.Num() >= this->getComponentCapacity()) {
+    ++this->_stats.objectsDiscarded;
+    this->trim();
+    return false;
+  }
+
+  UStaticMesh* pMesh = pComponent->GetStaticMesh();
+  if (pMesh) {
+    for (FStaticMaterial& staticMaterial : pMesh->GetStaticMaterials()) {
+      UMaterialInstanceDynamic* pMaterial =
+          Cast<UMaterialInstanceDynamic>(staticMaterial.MaterialInterface);
+      if (pMaterial && !this->releaseMaterial(pMaterial)) {
+        CesiumLifetime::destroy(pMaterial);
+      }
+    }
+    pMesh->GetStaticMaterials().Empty();
+
+    UBodySetup* pBodySetup = pMesh->GetBodySetup();
+    if (pBodySetup) {
+      pMesh->SetBodySetup(nullptr);
+      CesiumLifetime::destroy(pBodySetup);
+    }
+    pMesh->SetNavCollision(nullptr);
+
+    // The render resources were released before the component was handed to
+    // the pool, so the CPU-side render data can be freed now.
+    pMesh->SetRenderData(nullptr);
+  }
+
+  // A component that rendered a shared mesh has no mesh of its own anymore,
+  // and its material instance is an override.
+  for (UMaterialInterface* pOverride : pComponent->OverrideMaterials) {
+    UMaterialInstanceDynamic* pMaterial =
+        Cast<UMaterialInstanceDynamic>(pOverride);
+    if (pMaterial && !this->releaseMaterial(pMaterial)) {
+      CesiumLifetime::destroy(pMaterial);
+    }
+  }
+  pComponent->EmptyOverrideMaterials();
+
+  pCesiumPrimitive->getPrimitiveData().destroy();
+  pCesiumPrimitive->getPrimitiveData() = CesiumPrimitiveData();
+
+  UInstancedStaticMeshComponent* pInstanced =
+      Cast<UInstancedStaticMeshComponent>(pComponent);
+  if (pInstanced) {
+    pInstanced->ClearInstances();
+  }
+
+  // Loading a tile changes some state only for some primitives, such as the
+  // shadows of unlit and collision-only primitives, so restore the class
+  // defaults before the component is used for another tile.
+  const UStaticMeshComponent* pDefaults = Cast<UStaticMeshComponent>(
+      pComponent->GetClass()->GetDefaultObject());
+  if (pDefaults) {
+    pComponent->CastShadow = pDefaults->CastShadow;
+    pComponent->bCastDynamicShadow = pDefaults->bCastDynamicShadow;
+    pComponent->bCastStaticShadow = pDefaults->bCastStaticShadow;
+    pComponent->SetRenderCustomDepth(pDefaults->bRenderCustomDepth);
+    pComponent->SetCustomDepthStencilValue(
+        pDefaults->CustomDepthStencilValue);
+    pComponent->SetCollisionEnabled(pDefaults->GetCollisionEnabled());
+    pComponent->SetCollisionResponseToChannels(
+        pDefaults->GetCollisionResponseToChannels());
+  }
+
+  pComponent->DetachFromComponent(
+      FDetachmentTransformRules::KeepRelativeTransform);
+  pComponent->SetVisibility(false);
+  pComponent->Rename(nullptr, this, PoolRenameFlags);
+
+  this->PooledComponents.Add(pComponent);
+  return true;
+}
+
+UMaterialInstanceDynamic*
+UCesiumTileObjectPool::acquireMaterial(UMaterialInterface* pParent) {
+  // Search from the back so that recently released instances, which are the
+  // most likely to still be in the CPU cache, are reused first.
+  for (int32 i = this->PooledMaterials.Num() - 1; i >= 0; --i) {
+    UMaterialInstanceDynamic* pMaterial = this->PooledMaterials[i];
+    if (!IsValid(pMaterial)) {
+      this->PooledMaterials.RemoveAtSwap(i);
+      continue;
+    }
+
+    if (pMaterial->Parent == pParent) {
+      this->PooledMaterials.RemoveAtSwap(i);
+      ++this->_stats.materialsReused;
+      return pMaterial;
+    }
+  }
+
+  return nullptr;
+}
+
+bool UCesiumTileObjectPool::releaseMaterial(
+    UMaterialInstanceDynamic* pMaterial) {
+  if (!IsValid(pMaterial) ||
+      this->PooledMaterials.Num() >= this->getComponentCapacity()) {
+    ++this->_stats.objectsDiscarded;
+    return false;
+  }
+
+  // Drop references to the previous tile's textures now, rather than when the
+  // material instance is reused.
+  pMaterial->ClearParameterValues();
+  this->PooledMaterials.Add(pMaterial);
+  return true;
+}
+
+int32 UCesiumTileObjectPool::getComponentCapacity() const {
+  // Keep enough in reserve to replace half of the components in use, which
+  // covers the tiles that are swapped out by typical camera movement.
+  return static_cast<int32>(FMath::Clamp(
+      this->_componentsInUse / 2,
+      int64(MinimumCapacity),
+      int64(MaximumCapacity)));
+}
+
+void UCesiumTileObjectPool::trim() {
+  const int32 capacity = this->getComponentCapacity();
+
+  int32 trimmed = 0;
+  while (this->PooledComponents.Num() > capacity &&
+         trimmed < MaximumTrimPerCall) {
+    UStaticMeshComponent* pComponent = this->PooledComponents.Pop();
+    if (IsValid(pComponent)) {
+      CesiumLifetime::destroyComponentRecursively(pComponent);
+    }
+    ++trimmed;
+  }
+
+  while (this->PooledMaterials.Num() > capacity &&
+         trimmed < MaximumTrimPerCall) {
+    UMaterialInstanceDynamic* pMaterial = this->PooledMaterials.Pop();
+    if (IsValid(pMaterial)) {
+      CesiumLifetime::destroy(pMaterial);
+    }
+    ++trimmed;
+  }
+}
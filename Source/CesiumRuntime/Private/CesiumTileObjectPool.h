@@ -0,0 +1,193 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "CesiumTileObjectPool.generated.h"
+
+class UMaterialInstanceDynamic;
+class UMaterialInterface;
+class UStaticMeshComponent;
+
+/**
+ * Counters describing how effectively a {@link UCesiumTileObjectPool} avoids
+ * creating new objects.
+ */
+struct CesiumTileObjectPoolStats {
+  /**
+   * The number of primitive components, with their static meshes, that were
+   * taken from the pool instead of being created.
+   */
+  int64 componentsReused = 0;
+
+  /**
+   * The number of primitive components, with their static meshes, that had to
+   * be created because the pool had none of the right type.
+   */
+  int64 componentsCreated = 0;
+
+  /**
+   * The number of dynamic material instances that were taken from the pool
+   * instead of being created.
+   */
+  int64 materialsReused = 0;
+
+  /**
+   * The number of dynamic material instances that had to be created because
+   * the pool had none with the right parent.
+   */
+  int64 materialsCreated = 0;
+
+  /**
+   * The number of recycled objects that were destroyed because the pool was
+   * already at its capacity.
+   */
+  int64 objectsDiscarded = 0;
+
+  /**
+   * The fraction of requested components that were reused, between 0.0 and
+   * 1.0.
+   */
+  double getComponentReuseRate() const {
+    int64 total = componentsReused + componentsCreated;
+    return total > 0 ? double(componentsReused) / double(total) : 0.0;
+  }
+
+  /**
+   * The number of UObjects that were never allocated, and so never had to be
+   * collected by the garbage collector, thanks to reuse. Each reused component
+   * saves the component itself and its static mesh.
+   */
+  int64 getObjectsNotAllocated() const {
+    return componentsReused * 2 + materialsReused;
+  }
+};
+
+/**
+ * A per-tileset pool of Unreal objects that are recycled from unloaded tiles
+ * and reused when new tiles are loaded, instead of leaving them to the garbage
+ * collector and creating new ones with NewObject.
+ *
+ * Objects are only returned to the pool once their render resources have been
+ * released, see {@link CesiumLifetime::scheduleTileTeardown}. The pool's
+ * capacity follows the number of components that the tileset currently uses,
+ * so that it is large enough to absorb the churn of a camera move without
+ * holding on to memory after the working set shrinks.
+ */
+UCLASS()
+class UCesiumTileObjectPool : public UObject {
+  GENERATED_BODY()
+
+public:
+  /**
+   * Takes a primitive component of exactly the given class from the pool and
+   * moves it into the given outer. The component is unregistered and has been
+   * reset, but still owns a static mesh that can be filled in again.
+   *
+   * @param pClass The class of the component.
+   * @param pOuter The new outer of the component.
+   * @param name The new name of the component, or NAME_None for a unique name.
+   * @return The component, or nullptr if the pool has none of this class. In
+   * that case, the caller creates a new component and reports it with
+   * {@link recordComponentCreated}.
+   */
+  UStaticMeshComponent*
+  acquireComponent(UClass* pClass, UObject* pOuter, FName name);
+
+  /**
+   * Resets a primitive component whose render resources have been released
+   * and takes it into the pool, along with its static mesh and material
+   * instances.
+   *
+   * @param pComponent The unregistered component.
+   * @return True if the pool took ownership of the component, or false if the
+   * pool is full and the caller should destroy it instead.
+   */
+  bool releaseComponent(UStaticMeshComponent* pComponent);
+
+  /**
+   * Records that a new component had to be created because the pool had none
+   * to reuse.
+   */
+  void recordComponentCreated() {
+    ++this->_componentsInUse;
+    ++this->_stats.componentsCreated;
+  }
+
+  /**
+   * Takes a dynamic material instance of the given parent material from the
+   * pool. Its parameter values have already been cleared.
+   *
+   * @param pParent The parent material that the instance must have.
+   * @return The material instance, or nullptr if the pool has none for this
+   * parent. In that case, the caller creates a new material instance and
+   * reports it with {@link recordMaterialCreated}.
+   */
+  UMaterialInstanceDynamic* acquireMaterial(UMaterialInterface* pParent);
+
+  /**
+   * Returns a dynamic material instance that is no longer used by any
+   * component to the pool.
+   *
+   * @param pMaterial The material instance.
+   * @return True if the pool took ownership of the material instance, or false
+   * if the pool is full and the caller should destroy it instead.
+   */
+  bool releaseMaterial(UMaterialInstanceDynamic* pMaterial);
+
+  /**
+   * Records that a new material instance had to be created because the pool
+   * had none to reuse.
+   */
+  void recordMaterialCreated() { ++this->_stats.materialsCreated; }
+
+  /**
+   * Gets the number of components currently waiting in the pool.
+   */
+  int32 getPooledComponentCount() const { return PooledComponents.Num(); }
+
+  /**
+   * Gets the number of material instances currently waiting in the pool.
+   */
+  int32 getPooledMaterialCount() const { return PooledMaterials.Num(); }
+
+  /**
+   * Gets the number of components that the pool is currently willing to hold.
+   */
+  int32 getComponentCapacity() const;
+
+  const CesiumTileObjectPoolStats& getStats() const { return this->_stats; }
+
+  /**
+   * The smallest number of components and material instances that the pool
+   * will hold, regardless of the working set.
+   */
+  static constexpr int32 MinimumCapacity = 64;
+
+  /**
+   * The largest number of components and material instances that the pool
+   * will hold, regardless of the working set.
+   */
+  static constexpr int32 MaximumCapacity = 4096;
+
+private:
+  /**
+   * Destroys pooled objects beyond the current capacity, a few at a time.
+   */
+  void trim();
+
+  UPROPERTY()
+  TArray<UStaticMeshComponent*> PooledComponents;
+
+  UPROPERTY()
+  TArray<UMaterialInstanceDynamic*> PooledMaterials;
+
+  /**
+   * The number of components created or reused that have not been released
+   * back to the pool or destroyed yet.
+   */
+  int64 _componentsInUse = 0;
+
+  CesiumTileObjectPoolStats _stats;
+};
@@ -0,0 +1,124 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumTilesetMemory.h"
+#include "CesiumGltfComponent.h"
+#include "CesiumPrimitive.h"
+#include "CesiumTextureResource.h"
+#include "CesiumTextureUtility.h"
+#include "Engine/Texture.h"
+
+CesiumTilesetMemoryAccumulator::CesiumTilesetMemoryAccumulator(
+    FCesiumTilesetMemoryReport& report)
+    : _report(report), _counted() {}
+
+void CesiumTilesetMemoryAccumulator::addGltf(UCesiumGltfComponent& gltf) {
+  for (USceneComponent* pChild : gltf.GetAttachChildren()) {
+    ICesiumPrimitive* pPrimitive = Cast<ICesiumPrimitive>(pChild);
+    if (!pPrimitive) {
+      continue;
+    }
+
+    const CesiumPrimitiveData& primData = pPrimitive->getPrimitiveData();
+    this->addPrimitive(primData);
+
+    for (const CesiumEncodedFeaturesMetadata::EncodedFeatureIdSet& set :
+         primData.EncodedFeatures.featureIdSets) {
+      if (set.texture) {
+        this->addTexture(set.texture->pTexture.Get());
+      }
+    }
+  }
+
+  for (const CesiumEncodedFeaturesMetadata::EncodedPropertyTable& table :
+       gltf.EncodedMetadata.propertyTables) {
+    for (const CesiumEncodedFeaturesMetadata::EncodedPropertyTableProperty&
+             property : table.properties) {
+      this->addTexture(property.pTexture.Get());
+    }
+    for (const CesiumEncodedFeaturesMetadata::
+             EncodedPackedPropertyTableProperties& packed :
+         table.packedProperties) {
+      this->addTexture(packed.pTexture.Get());
+    }
+  }
+
+  for (const CesiumEncodedFeaturesMetadata::EncodedPropertyTexture& texture :
+       gltf.EncodedMetadata.propertyTextures) {
+    for (const CesiumEncodedFeaturesMetadata::EncodedPropertyTextureProperty&
+             property : texture.properties) {
+      this->addTexture(property.pTexture.Get());
+    }
+  }
+
+  for (const TWeakObjectPtr<UTexture2D>& pTexture : gltf.TileTextures) {
+    this->addTexture(pTexture.Get());
+  }
+}
+
+void CesiumTilesetMemoryAccumulator::addPrimitive(
+    const CesiumPrimitiveData& primData) {
+  this->_report.MeshBytes += primData.MeshBytes;
+  this->_report.PhysicsBytes += primData.PhysicsBytes;
+  this->_report.PrimitiveDataBytes += primData.getSizeBytes();
+
+  const CesiumSharedMesh* pSharedMesh = primData.pSharedMesh.Get();
+  if (pSharedMesh) {
+    bool alreadyCounted = false;
+    this->_counted.Add(pSharedMesh, &alreadyCounted);
+    if (!alreadyCounted) {
+      this->_report.MeshBytes += pSharedMesh->MeshBytes;
+      this->_report.PhysicsBytes += pSharedMesh->PhysicsBytes;
+    }
+  }
+}
+
+void CesiumTilesetMemoryAccumulator::addTexture(
+    const FCesiumTextureResource* pResource) {
+  if (!pResource) {
+    return;
+  }
+
+  TSharedPtr<FCesiumTextureResource> pWrapped =
+      pResource->GetWrappedResource();
+  if (pWrapped) {
+    pResource = pWrapped.Get();
+  }
+
+  bool alreadyCounted = false;
+  this->_counted.Add(pResource, &alreadyCounted);
+  if (alreadyCounted) {
+    return;
+  }
+
+  // Encoded features and metadata are the only 8-bit data textures.
+  const int64 bytes = int64(pResource->GetResidentBytes());
+  if (pResource->GetTextureGroup() == TEXTUREGROUP_8BitData) {
+    this->_report.MetadataBytes += bytes;
+  } else {
+    this->_report.TextureBytes += bytes;
+  }
+  this->_report.TextureBytes += int64(pResource->GetRetainedPixelBytes());
+}
+
+void CesiumTilesetMemoryAccumulator::finish() {
+  this->_report.TotalBytes =
+      this->_report.ModelBytes + this->_report.MeshBytes +
+      this->_report.PhysicsBytes + this->_report.TextureBytes +
+      this->_report.MetadataBytes + this->_report.PrimitiveDataBytes;
+}
+
+void CesiumTilesetMemoryAccumulator::addTexture(UTexture* pTexture) {
+  // The textures of tiles are always created by CesiumTextureUtility, which
+  // gives them an FCesiumTextureResource.
+  if (pTexture) {
+    this->addTexture(
+        static_cast<const FCesiumTextureResource*>(pTexture->GetResource()));
+  }
+}
+
+void CesiumTilesetMemoryAccumulator::addTexture(
+    const CesiumTextureUtility::LoadedTextureResult* pLoadedTexture) {
+  if (pLoadedTexture && pLoadedTexture->pTexture) {
+    this->addTexture(pLoadedTexture->pTexture->getUnrealTexture().Get());
+  }
+}
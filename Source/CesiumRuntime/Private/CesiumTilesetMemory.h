@@ -0,0 +1,61 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CesiumTilesetMemoryReport.h"
+#include "CoreMinimal.h"
+
+class CesiumPrimitiveData;
+class FCesiumTextureResource;
+class UCesiumGltfComponent;
+class UTexture;
+
+namespace CesiumTextureUtility {
+struct LoadedTextureResult;
+}
+
+/**
+ * Adds up the memory of a tileset's loaded tiles into an
+ * FCesiumTilesetMemoryReport.
+ *
+ * Meshes that are shared through the CesiumMeshDepot, and textures that are
+ * used by several tiles or wrapped by several texture resources, are counted
+ * only once. This must be used from the game thread.
+ */
+class CesiumTilesetMemoryAccumulator {
+public:
+  /**
+   * Creates an accumulator that adds to the given report.
+   */
+  explicit CesiumTilesetMemoryAccumulator(FCesiumTilesetMemoryReport& report);
+
+  /**
+   * Adds a tile's glTF, including its primitives, their encoded features, the
+   * encoded metadata of the model, and the textures of the tile and of its
+   * raster overlays.
+   */
+  void addGltf(UCesiumGltfComponent& gltf);
+
+  /**
+   * Adds a primitive's meshes and the data it copies out of the glTF.
+   */
+  void addPrimitive(const CesiumPrimitiveData& primData);
+
+  /**
+   * Adds a texture resource, or the resource that it wraps.
+   */
+  void addTexture(const FCesiumTextureResource* pResource);
+
+  /**
+   * Updates the report's TotalBytes from its other sizes.
+   */
+  void finish();
+
+private:
+  void addTexture(UTexture* pTexture);
+  void
+  addTexture(const CesiumTextureUtility::LoadedTextureResult* pLoadedTexture);
+
+  FCesiumTilesetMemoryReport& _report;
+  TSet<const void*> _counted;
+};
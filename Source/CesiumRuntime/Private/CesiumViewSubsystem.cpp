@@ -0,0 +1,570 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumViewSubsystem.h"
+#include "CesiumRuntimeSettings.h"
+#include "CesiumGeospatial/Ellipsoid.h"
+#include "Components/SceneCaptureComponent2D.h"
+#include "Engine/Engine.h"
+#include "Engine/GameViewportClient.h"
+#include "Engine/Level.h"
+#include "Engine/LocalPlayer.h"
+#include "Engine/SceneCapture2D.h"
+#include "Engine/TextureRenderTarget2D.h"
+#include "Engine/World.h"
+#include "EyeTrackerFunctionLibrary.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/WorldSettings.h"
+#include "StereoRendering.h"
+#include <cmath>
+#include <glm/geometric.hpp>
+#include <glm/trigonometric.hpp>
+#include <glm/vec4.hpp>
+
+#if WITH_EDITOR
+#include "Editor.h"
+#include "EditorViewportClient.h"
+#endif
+
+namespace {
+// Eye tracker gaze samples with a lower confidence are ignored, and the view
+// direction is used for foveation instead.
+constexpr float MinimumGazeConfidence = 0.5f;
+
+struct StereoEye {
+  FVector2D size;
+  FVector location;
+  FRotator rotation;
+  FMatrix projection;
+};
+
+/**
+ * Creates a single camera whose frustum covers both eyes of a stereo view,
+ * with the pixel density of the denser eye. The eyes' projections may be
+ * asymmetric, so the extent of each side of each frustum is taken from its
+ * projection matrix.
+ */
+FCesiumCamera mergeStereoEyes(
+    const StereoEye& left,
+    const StereoEye& right,
+    const FRotator& headRotation) {
+  double halfTangentX = 0.0;
+  double halfTangentY = 0.0;
+  double pixelsPerTangent = 0.0;
+
+  for (const StereoEye* pEye : {&left, &right}) {
+    const FMatrix& projection = pEye->projection;
+    const double leftTangent =
+        FMath::Abs((1.0 + projection.M[2][0]) / projection.M[0][0]);
+    const double rightTangent =
+        FMath::Abs((1.0 - projection.M[2][0]) / projection.M[0][0]);
+    const double upTangent =
+        FMath::Abs((1.0 + projection.M[2][1]) / projection.M[1][1]);
+    const double downTangent =
+        FMath::Abs((1.0 - projection.M[2][1]) / projection.M[1][1]);
+
+    halfTangentX = FMath::Max3(halfTangentX, leftTangent, rightTangent);
+    halfTangentY = FMath::Max3(halfTangentY, upTangent, downTangent);
+    pixelsPerTangent = FMath::Max(
+        pixelsPerTangent,
+        pEye->size.X / (leftTangent + rightTangent));
+  }
+
+  return FCesiumCamera(
+      FVector2D(
+          pixelsPerTangent * 2.0 * halfTangentX,
+          pixelsPerTangent * 2.0 * halfTangentY),
+      (left.location + right.location) * 0.5,
+      headRotation,
+      glm::degrees(2.0 * glm::atan(halfTangentX)));
+}
+} // namespace
+
+/*static*/ CesiumCollectedView
+CesiumCollectedView::fromCamera(const FCesiumCamera& camera) {
+  CesiumCollectedView view;
+  view.camera = camera;
+
+  view.horizontalFieldOfView =
+      FMath::DegreesToRadians(camera.FieldOfViewDegrees);
+
+  double actualAspectRatio;
+  view.viewportSize = glm::dvec2(camera.ViewportSize.X, camera.ViewportSize.Y);
+
+  if (camera.OverrideAspectRatio != 0.0f) {
+    // Use aspect ratio and recompute effective viewport size after black bars
+    // are added.
+    actualAspectRatio = camera.OverrideAspectRatio;
+    double computedX = actualAspectRatio * camera.ViewportSize.Y;
+    double computedY = camera.ViewportSize.Y / actualAspectRatio;
+
+    double barWidth = camera.ViewportSize.X - computedX;
+    double barHeight = camera.ViewportSize.Y - computedY;
+
+    if (barWidth > 0.0 && barWidth > barHeight) {
+      // Black bars on the sides
+      view.viewportSize.x = computedX;
+    } else if (barHeight > 0.0 && barHeight > barWidth) {
+      // Black bars on the top and bottom
+      view.viewportSize.y = computedY;
+    }
+  } else {
+    actualAspectRatio = camera.ViewportSize.X / camera.ViewportSize.Y;
+  }
+
+  view.verticalFieldOfView =
+      atan(tan(view.horizontalFieldOfView * 0.5) / actualAspectRatio) * 2.0;
+
+  FVector direction = camera.Rotation.RotateVector(FVector(1.0f, 0.0f, 0.0f));
+  FVector up = camera.Rotation.RotateVector(FVector(0.0f, 0.0f, 1.0f));
+
+  view.location =
+      glm::dvec3(camera.Location.X, camera.Location.Y, camera.Location.Z);
+  view.direction = glm::dvec3(direction.X, direction.Y, direction.Z);
+  view.up = glm::dvec3(up.X, up.Y, up.Z);
+
+  return view;
+}
+
+Cesium3DTilesSelection::ViewState CesiumCollectedView::createViewState(
+    const glm::dmat4& unrealWorldToTileset,
+    const CesiumGeospatial::Ellipsoid& ellipsoid) const {
+  glm::dvec3 tilesetCameraLocation =
+      glm::dvec3(unrealWorldToTileset * glm::dvec4(this->location, 1.0));
+  glm::dvec3 tilesetCameraFront = glm::normalize(
+      glm::dvec3(unrealWorldToTileset * glm::dvec4(this->direction, 0.0)));
+  glm::dvec3 tilesetCameraUp = glm::normalize(
+      glm::dvec3(unrealWorldToTileset * glm::dvec4(this->up, 0.0)));
+
+  return Cesium3DTilesSelection::ViewState::create(
+      tilesetCameraLocation,
+      tilesetCameraFront,
+      tilesetCameraUp,
+      this->viewportSize,
+      this->horizontalFieldOfView,
+      this->verticalFieldOfView,
+      ellipsoid);
+}
+
+void UCesiumViewSubsystem::Initialize(FSubsystemCollectionBase& Collection) {
+  Super::Initialize(Collection);
+
+  UWorld* pWorld = this->GetWorld();
+  if (pWorld) {
+    this->_actorSpawnedHandle = pWorld->AddOnActorSpawnedHandler(
+        FOnActorSpawned::FDelegate::CreateUObject(
+            this,
+            &UCesiumViewSubsystem::registerSceneCaptureActor));
+  }
+
+  this->_levelAddedHandle = FWorldDelegates::LevelAddedToWorld.AddUObject(
+      this,
+      &UCesiumViewSubsystem::onLevelAddedToWorld);
+}
+
+void UCesiumViewSubsystem::Deinitialize() {
+  UWorld* pWorld = this->GetWorld();
+  if (pWorld) {
+    pWorld->RemoveOnActorSpawnedHandler(this->_actorSpawnedHandle);
+  }
+  FWorldDelegates::LevelAddedToWorld.Remove(this->_levelAddedHandle);
+
+  this->_sceneCaptures.Empty();
+  for (ViewCache& cache : this->_viewCaches) {
+    cache = ViewCache();
+  }
+
+  Super::Deinitialize();
+}
+
+void UCesiumViewSubsystem::RegisterSceneCapture(
+    USceneCaptureComponent2D* SceneCapture) {
+  if (IsValid(SceneCapture)) {
+    this->_sceneCaptures.AddUnique(SceneCapture);
+  }
+}
+
+void UCesiumViewSubsystem::UnregisterSceneCapture(
+    USceneCaptureComponent2D* SceneCapture) {
+  this->_sceneCaptures.Remove(SceneCapture);
+}
+
+const std::vector<CesiumCollectedView>&
+UCesiumViewSubsystem::GetViews(bool scaleUsingDPI, uint64 frameNumber) {
+  ViewCache& cache = this->_viewCaches[scaleUsingDPI ? 1 : 0];
+  if (cache.frameNumber == frameNumber) {
+    return cache.views;
+  }
+
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::CollectCameras)
+
+  std::vector<FCesiumCamera> cameras;
+  this->collectPlayerCameras(scaleUsingDPI, cameras);
+  this->collectSceneCaptures(cameras);
+#if WITH_EDITOR
+  this->collectEditorCameras(scaleUsingDPI, cameras);
+#endif
+
+  cache.frameNumber = frameNumber;
+  cache.views.clear();
+  cache.views.reserve(cameras.size());
+  for (const FCesiumCamera& camera : cameras) {
+    cache.views.push_back(CesiumCollectedView::fromCamera(camera));
+  }
+
+  return cache.views;
+}
+
+void UCesiumViewSubsystem::collectPlayerCameras(
+    bool scaleUsingDPI,
+    std::vector<FCesiumCamera>& cameras) const {
+  UWorld* pWorld = this->GetWorld();
+  if (!pWorld) {
+    return;
+  }
+
+  double worldToMeters = 100.0;
+  AWorldSettings* pWorldSettings = pWorld->GetWorldSettings();
+  if (pWorldSettings) {
+    worldToMeters = pWorldSettings->WorldToMeters;
+  }
+
+  TSharedPtr<IStereoRendering, ESPMode::ThreadSafe> pStereoRendering = nullptr;
+  if (GEngine) {
+    pStereoRendering = GEngine->StereoRenderingDevice;
+  }
+
+  bool useStereoRendering = false;
+  if (pStereoRendering && pStereoRendering->IsStereoEnabled()) {
+    useStereoRendering = true;
+  }
+
+  const UCesiumRuntimeSettings* pSettings = GetDefault<UCesiumRuntimeSettings>();
+
+  cameras.reserve(cameras.size() + pWorld->GetNumPlayerControllers());
+
+  for (auto playerControllerIt = pWorld->GetPlayerControllerIterator();
+       playerControllerIt;
+       playerControllerIt++) {
+    const TWeakObjectPtr<APlayerController> pPlayerController =
+        *playerControllerIt;
+    if (pPlayerController == nullptr) {
+      continue;
+    }
+
+    const APlayerCameraManager* pPlayerCameraManager =
+        pPlayerController->PlayerCameraManager;
+
+    if (!pPlayerCameraManager) {
+      continue;
+    }
+
+    double fov = pPlayerCameraManager->GetFOVAngle();
+
+    FVector location;
+    FRotator rotation;
+    pPlayerController->GetPlayerViewPoint(location, rotation);
+
+    int32 sizeX, sizeY;
+    pPlayerController->GetViewportSize(sizeX, sizeY);
+    if (sizeX < 1 || sizeY < 1) {
+      continue;
+    }
+
+    float dpiScalingFactor = 1.0f;
+    if (scaleUsingDPI) {
+      ULocalPlayer* LocPlayer = Cast<ULocalPlayer>(pPlayerController->Player);
+      if (LocPlayer && LocPlayer->ViewportClient) {
+        dpiScalingFactor = LocPlayer->ViewportClient->GetDPIScale();
+      }
+    }
+
+    // The views of this player, before foveation.
+    std::vector<FCesiumCamera> playerCameras;
+
+    if (useStereoRendering) {
+      StereoEye eyes[2];
+      int32 eyeCount = 0;
+      for (EStereoscopicEye eye :
+           {EStereoscopicEye::eSSE_LEFT_EYE,
+            EStereoscopicEye::eSSE_RIGHT_EYE}) {
+        int32 _x;
+        int32 _y;
+        uint32 stereoSizeX = static_cast<uint32>(sizeX);
+        uint32 stereoSizeY = static_cast<uint32>(sizeY);
+        pStereoRendering->AdjustViewRect(eye, _x, _y, stereoSizeX, stereoSizeY);
+
+        if (stereoSizeX < 1 || stereoSizeY < 1) {
+          continue;
+        }
+
+        StereoEye& stereoEye = eyes[eyeCount++];
+        stereoEye.size = FVector2D(stereoSizeX, stereoSizeY);
+        stereoEye.location = location;
+        stereoEye.rotation = rotation;
+        pStereoRendering->CalculateStereoViewOffset(
+            eye,
+            stereoEye.rotation,
+            worldToMeters,
+            stereoEye.location);
+        stereoEye.projection = pStereoRendering->GetStereoProjectionMatrix(eye);
+      }
+
+      if (eyeCount == 2 && pSettings->MergeStereoViews) {
+        playerCameras.push_back(mergeStereoEyes(eyes[0], eyes[1], rotation));
+      } else {
+        for (int32 i = 0; i < eyeCount; ++i) {
+          // TODO: consider assymetric frustums using 4 fovs
+          double one_over_tan_half_hfov = eyes[i].projection.M[0][0];
+
+          double hfov =
+              glm::degrees(2.0 * glm::atan(1.0 / one_over_tan_half_hfov));
+
+          playerCameras.emplace_back(
+              eyes[i].size,
+              eyes[i].location,
+              eyes[i].rotation,
+              hfov);
+        }
+      }
+    } else {
+      playerCameras.emplace_back(
+          FVector2D(sizeX / dpiScalingFactor, sizeY / dpiScalingFactor),
+          location,
+          rotation,
+          fov);
+    }
+
+    if (!pSettings->EnableFoveatedTileSelection) {
+      cameras.insert(cameras.end(), playerCameras.begin(), playerCameras.end());
+      continue;
+    }
+
+    FRotator gazeRotation = rotation;
+    if (pSettings->UseEyeTrackingForFoveation) {
+      FEyeTrackerGazeData gazeData;
+      if (UEyeTrackerFunctionLibrary::GetGazeData(
+              gazeData,
+              pPlayerController.Get()) &&
+          gazeData.ConfidenceValue >= MinimumGazeConfidence) {
+        gazeRotation = gazeData.GazeDirection.Rotation();
+      }
+    }
+
+    for (const FCesiumCamera& camera : playerCameras) {
+      UCesiumViewSubsystem::appendFoveatedCameras(
+          camera,
+          gazeRotation,
+          pSettings->FoveationRings,
+          pSettings->PeripheralScreenSpaceErrorScale,
+          cameras);
+    }
+  }
+}
+
+/*static*/ void UCesiumViewSubsystem::appendFoveatedCameras(
+    const FCesiumCamera& camera,
+    const FRotator& gazeRotation,
+    const TArray<FCesiumFoveationRing>& rings,
+    double peripheralScreenSpaceErrorScale,
+    std::vector<FCesiumCamera>& cameras) {
+  // The screen-space error of a tile is proportional to the number of pixels
+  // per unit of view-plane distance, so shrinking a view's viewport relaxes
+  // its screen-space error by the same factor. Tile selection refines a tile
+  // if any view requires it, so the narrow ring views keep the detail near
+  // the gaze while the relaxed full view covers the periphery.
+  const double pixelsPerTangent =
+      camera.ViewportSize.X /
+      (2.0 * FMath::Tan(FMath::DegreesToRadians(camera.FieldOfViewDegrees) *
+                        0.5));
+
+  FCesiumCamera peripheral = camera;
+  peripheral.ViewportSize =
+      camera.ViewportSize / FMath::Max(peripheralScreenSpaceErrorScale, 1.0);
+  cameras.push_back(peripheral);
+
+  const double maximumAngle = camera.FieldOfViewDegrees * 0.5;
+  for (const FCesiumFoveationRing& ring : rings) {
+    const double angle = FMath::Min(ring.Angle, maximumAngle);
+    const double size = pixelsPerTangent * 2.0 *
+                        FMath::Tan(FMath::DegreesToRadians(angle)) /
+                        FMath::Max(ring.ScreenSpaceErrorScale, 1.0);
+    if (size < 1.0) {
+      continue;
+    }
+
+    cameras.emplace_back(
+        FVector2D(size, size),
+        camera.Location,
+        gazeRotation,
+        angle * 2.0);
+  }
+}
+
+/*static*/ void UCesiumViewSubsystem::appendCubeFaceCameras(
+    const FVector& location,
+    std::vector<FCesiumCamera>& cameras) {
+  static const FRotator cubeFaces[] = {
+      FRotator(0.0, 0.0, 0.0),
+      FRotator(0.0, 90.0, 0.0),
+      FRotator(0.0, 180.0, 0.0),
+      FRotator(0.0, 270.0, 0.0),
+      FRotator(90.0, 0.0, 0.0),
+      FRotator(-90.0, 0.0, 0.0)};
+  const FVector2D viewportSize(1024.0, 1024.0);
+
+  for (const FRotator& rotation : cubeFaces) {
+    cameras.emplace_back(viewportSize, location, rotation, 90.0);
+  }
+}
+
+void UCesiumViewSubsystem::collectSceneCaptures(
+    std::vector<FCesiumCamera>& cameras) {
+  if (!this->_sceneCapturesScanned) {
+    // Scene capture actors that already exist when the subsystem is created
+    // are registered once here; later ones are registered as they spawn.
+    this->_sceneCapturesScanned = true;
+    UWorld* pWorld = this->GetWorld();
+    if (pWorld) {
+      for (ULevel* pLevel : pWorld->GetLevels()) {
+        this->registerSceneCapturesInLevel(pLevel);
+      }
+    }
+  }
+
+  cameras.reserve(cameras.size() + this->_sceneCaptures.Num());
+
+  for (int32 i = this->_sceneCaptures.Num() - 1; i >= 0; --i) {
+    USceneCaptureComponent2D* pSceneCaptureComponent =
+        this->_sceneCaptures[i].Get();
+    if (!IsValid(pSceneCaptureComponent)) {
+      this->_sceneCaptures.RemoveAtSwap(i);
+      continue;
+    }
+
+    if (pSceneCaptureComponent->ProjectionType !=
+        ECameraProjectionMode::Type::Perspective) {
+      continue;
+    }
+
+    UTextureRenderTarget2D* pRenderTarget =
+        pSceneCaptureComponent->TextureTarget;
+    if (!pRenderTarget) {
+      continue;
+    }
+
+    FVector2D renderTargetSize(pRenderTarget->SizeX, pRenderTarget->SizeY);
+    if (renderTargetSize.X < 1.0 || renderTargetSize.Y < 1.0) {
+      continue;
+    }
+
+    FVector captureLocation = pSceneCaptureComponent->GetComponentLocation();
+    FRotator captureRotation = pSceneCaptureComponent->GetComponentRotation();
+    double captureFov = pSceneCaptureComponent->FOVAngle;
+
+    cameras.emplace_back(
+        renderTargetSize,
+        captureLocation,
+        captureRotation,
+        captureFov);
+  }
+}
+
+void UCesiumViewSubsystem::registerSceneCaptureActor(AActor* pActor) {
+  ASceneCapture2D* pSceneCapture = Cast<ASceneCapture2D>(pActor);
+  if (pSceneCapture) {
+    this->RegisterSceneCapture(pSceneCapture->GetCaptureComponent2D());
+  }
+}
+
+void UCesiumViewSubsystem::registerSceneCapturesInLevel(ULevel* pLevel) {
+  if (!pLevel) {
+    return;
+  }
+
+  for (AActor* pActor : pLevel->Actors) {
+    this->registerSceneCaptureActor(pActor);
+  }
+}
+
+void UCesiumViewSubsystem::onLevelAddedToWorld(
+    ULevel* pLevel,
+    UWorld* pWorld) {
+  if (pWorld == this->GetWorld() && this->_sceneCapturesScanned) {
+    this->registerSceneCapturesInLevel(pLevel);
+  }
+}
+
+#if WITH_EDITOR
+void UCesiumViewSubsystem::collectEditorCameras(
+    bool scaleUsingDPI,
+    std::vector<FCesiumCamera>& cameras) const {
+  if (!GEditor) {
+    return;
+  }
+
+  UWorld* pWorld = this->GetWorld();
+  if (!IsValid(pWorld)) {
+    return;
+  }
+
+  // Do not include editor cameras when running in a game world (which includes
+  // Play-in-Editor)
+  if (pWorld->IsGameWorld()) {
+    return;
+  }
+
+  const TArray<FEditorViewportClient*>& viewportClients =
+      GEditor->GetAllViewportClients();
+
+  cameras.reserve(cameras.size() + viewportClients.Num());
+
+  for (FEditorViewportClient* pEditorViewportClient : viewportClients) {
+    if (!pEditorViewportClient) {
+      continue;
+    }
+
+    if (!pEditorViewportClient->IsVisible() ||
+        !pEditorViewportClient->IsRealtime() ||
+        !pEditorViewportClient->IsPerspective()) {
+      continue;
+    }
+
+    FRotator rotation;
+    if (pEditorViewportClient->bUsingOrbitCamera) {
+      rotation = (pEditorViewportClient->GetLookAtLocation() -
+                  pEditorViewportClient->GetViewLocation())
+                     .Rotation();
+    } else {
+      rotation = pEditorViewportClient->GetViewRotation();
+    }
+
+    const FVector& location = pEditorViewportClient->GetViewLocation();
+    double fov = pEditorViewportClient->ViewFOV;
+    FIntPoint offset;
+    FIntPoint size;
+    pEditorViewportClient->GetViewportDimensions(offset, size);
+
+    if (size.X < 1 || size.Y < 1) {
+      continue;
+    }
+
+    if (scaleUsingDPI) {
+      float dpiScalingFactor = pEditorViewportClient->GetDPIScale();
+      size.X = static_cast<float>(size.X) / dpiScalingFactor;
+      size.Y = static_cast<float>(size.Y) / dpiScalingFactor;
+    }
+
+    if (pEditorViewportClient->IsAspectRatioConstrained()) {
+      cameras.emplace_back(
+          size,
+          location,
+          rotation,
+          fov,
+          pEditorViewportClient->AspectRatio);
+    } else {
+      cameras.emplace_back(size, location, rotation, fov);
+    }
+  }
+}
+#endif
+
@@ -0,0 +1,22 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumWarmStart.h"
+#include <algorithm>
+
+namespace CesiumWarmStart {
+
+void applyToOptions(
+    Cesium3DTilesSelection::TilesetOptions& options,
+    int32 maximumSimultaneousTileLoads,
+    int32 loadingDescendantLimit) {
+  options.preloadAncestors = false;
+  options.preloadSiblings = false;
+  options.loadingDescendantLimit = std::max(
+      options.loadingDescendantLimit,
+      static_cast<uint32_t>(FMath::Max(0, loadingDescendantLimit)));
+  options.maximumSimultaneousTileLoads = std::max(
+      options.maximumSimultaneousTileLoads,
+      static_cast<uint32_t>(FMath::Max(0, maximumSimultaneousTileLoads)));
+}
+
+} // namespace CesiumWarmStart
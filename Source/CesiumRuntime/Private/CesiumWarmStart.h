@@ -0,0 +1,30 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include <Cesium3DTilesSelection/TilesetOptions.h>
+
+namespace CesiumWarmStart {
+
+/**
+ * Changes the options of a tileset that is warm-starting from a tile
+ * selection snapshot, so that the snapshot's whole refinement frontier is
+ * requested at once rather than one level of detail at a time.
+ *
+ * Ancestors and siblings are not preloaded, and the loading descendant limit
+ * and the number of simultaneous tile loads are raised to at least the given
+ * values. Options that are already larger are kept.
+ *
+ * @param options The tileset options to change.
+ * @param maximumSimultaneousTileLoads The number of tiles that may be loaded
+ * at once while warm-starting.
+ * @param loadingDescendantLimit The loading descendant limit while
+ * warm-starting.
+ */
+void applyToOptions(
+    Cesium3DTilesSelection::TilesetOptions& options,
+    int32 maximumSimultaneousTileLoads,
+    int32 loadingDescendantLimit);
+
+} // namespace CesiumWarmStart
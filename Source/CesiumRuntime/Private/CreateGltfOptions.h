@@ -8,6 +8,14 @@
 #include "CesiumGltf/Model.h"
 #include "CesiumGltf/Node.h"
 #include "LoadGltfResult.h"
+#include <memory>
+#include <vector>
+
+class CesiumPolygonClipper;
+
+namespace CesiumStyle {
+class Style;
+}
 
 // TODO: internal documentation
 namespace CreateGltfOptions {
@@ -21,7 +29,18 @@ struct CreateModelOptions {
   PRAGMA_ENABLE_DEPRECATION_WARNINGS
   bool alwaysIncludeTangents = false;
   bool createPhysicsMeshes = true;
+  bool deferPhysicsMeshes = false;
+  int32_t physicsMeshSimplificationResolution = 0;
   bool ignoreKhrMaterialsUnlit = false;
+  bool optimizeMeshes = false;
+  bool useHalfPrecisionUVs = false;
+  bool mergePrimitives = false;
+  bool aggregateInstances = false;
+  bool shareMeshes = false;
+  bool collisionOnly = false;
+  bool loadMetadata = true;
+  std::vector<std::shared_ptr<const CesiumPolygonClipper>> polygonClippers;
+  std::shared_ptr<const CesiumStyle::Style> pStyle;
 
   Cesium3DTilesSelection::TileLoadResult tileLoadResult;
 
@@ -37,7 +56,19 @@ public:
             other.pEncodedMetadataDescription_DEPRECATED),
         alwaysIncludeTangents(other.alwaysIncludeTangents),
         createPhysicsMeshes(other.createPhysicsMeshes),
+        deferPhysicsMeshes(other.deferPhysicsMeshes),
+        physicsMeshSimplificationResolution(
+            other.physicsMeshSimplificationResolution),
         ignoreKhrMaterialsUnlit(other.ignoreKhrMaterialsUnlit),
+        optimizeMeshes(other.optimizeMeshes),
+        useHalfPrecisionUVs(other.useHalfPrecisionUVs),
+        mergePrimitives(other.mergePrimitives),
+        aggregateInstances(other.aggregateInstances),
+        shareMeshes(other.shareMeshes),
+        collisionOnly(other.collisionOnly),
+        loadMetadata(other.loadMetadata),
+        polygonClippers(std::move(other.polygonClippers)),
+        pStyle(std::move(other.pStyle)),
         tileLoadResult(std::move(other.tileLoadResult)) {
     pModel = std::get_if<CesiumGltf::Model>(&this->tileLoadResult.contentKind);
   }
@@ -11,22 +11,23 @@ namespace {
 
 std::mutex createExtensionMutex;
 
-std::pair<ExtensionImageAssetUnreal&, std::optional<Promise<void>>>
-getOrCreateImageFuture(
+template <typename TExtension>
+std::pair<TExtension&, std::optional<Promise<void>>> getOrCreateImageFuture(
     const AsyncSystem& asyncSystem,
     CesiumGltf::ImageAsset& imageCesium);
 
 } // namespace
 
-/*static*/ const ExtensionImageAssetUnreal&
-ExtensionImageAssetUnreal::getOrCreate(
+template <typename TExtension>
+/*static*/ const TExtension& ExtensionImageAssetUnreal::getOrCreateExtension(
     const CesiumAsync::AsyncSystem& asyncSystem,
     CesiumGltf::ImageAsset& imageCesium,
     bool sRGB,
     bool needsMipMaps,
-    const std::optional<EPixelFormat>& overridePixelFormat) {
+    const std::optional<EPixelFormat>& overridePixelFormat,
+    bool keepPixelData) {
   auto [extension, maybePromise] =
-      getOrCreateImageFuture(asyncSystem, imageCesium);
+      getOrCreateImageFuture<TExtension>(asyncSystem, imageCesium);
   if (!maybePromise) {
     // Another thread is already working on this image.
     return extension;
@@ -42,7 +43,8 @@ ExtensionImageAssetUnreal::getOrCreate(
           TextureAddress::TA_Clamp,
           TextureAddress::TA_Clamp,
           sRGB,
-          needsMipMaps);
+          needsMipMaps,
+          keepPixelData);
 
   extension._pTextureResource =
       MakeShareable(pResource.Release(), [](FCesiumTextureResource* p) {
@@ -70,6 +72,35 @@ ExtensionImageAssetUnreal::getOrCreate(
   return extension;
 }
 
+/*static*/ const ExtensionImageAssetUnreal&
+ExtensionImageAssetUnreal::getOrCreate(
+    const CesiumAsync::AsyncSystem& asyncSystem,
+    CesiumGltf::ImageAsset& imageCesium,
+    bool sRGB,
+    bool needsMipMaps,
+    const std::optional<EPixelFormat>& overridePixelFormat) {
+  return getOrCreateExtension<ExtensionImageAssetUnreal>(
+      asyncSystem,
+      imageCesium,
+      sRGB,
+      needsMipMaps,
+      overridePixelFormat,
+      false);
+}
+
+/*static*/ const ExtensionImageAssetUnrealMetadata&
+ExtensionImageAssetUnrealMetadata::getOrCreate(
+    const CesiumAsync::AsyncSystem& asyncSystem,
+    CesiumGltf::ImageAsset& imageCesium) {
+  return getOrCreateExtension<ExtensionImageAssetUnrealMetadata>(
+      asyncSystem,
+      imageCesium,
+      false,
+      false,
+      PixelFormat,
+      true);
+}
+
 ExtensionImageAssetUnreal::ExtensionImageAssetUnreal(
     const CesiumAsync::SharedFuture<void>& future)
     : _pTextureResource(nullptr), _futureCreateResource(future) {}
@@ -94,20 +125,18 @@ namespace {
 // already exist. It _may_ also return a Promise, in which case the calling
 // thread is responsible for doing the loading and should resolve the Promise
 // when it's done.
-std::pair<ExtensionImageAssetUnreal&, std::optional<Promise<void>>>
-getOrCreateImageFuture(
+template <typename TExtension>
+std::pair<TExtension&, std::optional<Promise<void>>> getOrCreateImageFuture(
     const AsyncSystem& asyncSystem,
     CesiumGltf::ImageAsset& imageCesium) {
   std::scoped_lock lock(createExtensionMutex);
 
-  ExtensionImageAssetUnreal* pExtension =
-      imageCesium.getExtension<ExtensionImageAssetUnreal>();
+  TExtension* pExtension = imageCesium.getExtension<TExtension>();
   if (!pExtension) {
     // This thread will work on this image.
     Promise<void> promise = asyncSystem.createPromise<void>();
-    ExtensionImageAssetUnreal& extension =
-        imageCesium.addExtension<ExtensionImageAssetUnreal>(
-            promise.getFuture().share());
+    TExtension& extension =
+        imageCesium.addExtension<TExtension>(promise.getFuture().share());
     return {extension, std::move(promise)};
   } else {
     // Another thread is already working on this image.
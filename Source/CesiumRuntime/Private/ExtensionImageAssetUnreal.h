@@ -84,7 +84,55 @@ struct ExtensionImageAssetUnreal {
    */
   const CesiumAsync::SharedFuture<void>& getFuture() const;
 
+protected:
+  template <typename TExtension>
+  static const TExtension& getOrCreateExtension(
+      const CesiumAsync::AsyncSystem& asyncSystem,
+      CesiumGltf::ImageAsset& imageCesium,
+      bool sRGB,
+      bool needsMipMaps,
+      const std::optional<EPixelFormat>& overridePixelFormat,
+      bool keepPixelData);
+
 private:
   TSharedPtr<FCesiumTextureResource> _pTextureResource;
   CesiumAsync::SharedFuture<void> _futureCreateResource;
 };
+
+/**
+ * @brief An extension attached to an ImageAsset that holds feature IDs or
+ * property values, to hold the Unreal resource that Unreal materials read
+ * them from.
+ *
+ * This resource is always in PF_R8G8B8A8_UINT, so it is kept apart from the
+ * image's ExtensionImageAssetUnreal. An image that is both sampled as a color
+ * texture and read as metadata, possibly by different tiles that share it,
+ * gets one resource in each format. The image keeps its `pixelData`, which
+ * the feature ID and property texture views still read on the CPU.
+ */
+struct ExtensionImageAssetUnrealMetadata : public ExtensionImageAssetUnreal {
+  static inline constexpr const char* TypeName =
+      "ExtensionImageAssetUnrealMetadata";
+  static inline constexpr const char* ExtensionName =
+      "PRIVATE_ImageAsset_Unreal_Metadata";
+
+  /**
+   * @brief The pixel format of the metadata texture resource. This assumes
+   * that the image only contains one byte per channel.
+   */
+  static inline constexpr EPixelFormat PixelFormat =
+      EPixelFormat::PF_R8G8B8A8_UINT;
+
+  /**
+   * @brief Gets the metadata texture resource of the given `ImageAsset`,
+   * creating it if necessary. Like
+   * {@link ExtensionImageAssetUnreal::getOrCreate}, this is safe to call from
+   * multiple threads, and the returned extension may still be waiting for
+   * another thread to create its resource.
+   */
+  static const ExtensionImageAssetUnrealMetadata& getOrCreate(
+      const CesiumAsync::AsyncSystem& asyncSystem,
+      CesiumGltf::ImageAsset& imageCesium);
+
+  using ExtensionImageAssetUnreal::ExtensionImageAssetUnreal;
+};
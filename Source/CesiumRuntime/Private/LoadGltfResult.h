@@ -4,8 +4,10 @@
 
 #include "CesiumCommon.h"
 #include "CesiumEncodedFeaturesMetadata.h"
+#include "CesiumMeshDepot.h"
 #include "CesiumMetadataPrimitive.h"
 #include "CesiumModelMetadata.h"
+#include "CesiumPhysicsMeshCooker.h"
 #include "CesiumPrimitiveFeatures.h"
 #include "CesiumPrimitiveMetadata.h"
 #include "CesiumRasterOverlays.h"
@@ -23,11 +25,16 @@
 #include <CesiumGltf/Model.h>
 #include <cstdint>
 #include <glm/mat4x4.hpp>
+#include <memory>
 #include <optional>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
+namespace CesiumStyle {
+class Style;
+}
+
 namespace LoadGltfResult {
 /**
  * Represents the result of loading a glTF primitive on a game thread.
@@ -44,6 +51,12 @@ struct LoadPrimitiveResult {
    */
   TUniquePtr<FStaticMeshRenderData> RenderData = nullptr;
 
+  /**
+   * The shared mesh to render this primitive with instead of its own render
+   * data, if the primitive's geometry is shared through the CesiumMeshDepot.
+   */
+  TSharedPtr<CesiumSharedMesh> pSharedMesh;
+
   /**
    * The index of the material for this primitive within the parent model, or -1
    * if none.
@@ -51,12 +64,18 @@ struct LoadPrimitiveResult {
   int32_t materialIndex = -1;
 
   glm::dmat4x4 transform{1.0};
-#if ENGINE_VERSION_5_4_OR_HIGHER
-  Chaos::FTriangleMeshImplicitObjectPtr pCollisionMesh = nullptr;
-#else
-  TSharedPtr<Chaos::FTriangleMeshImplicitObject, ESPMode::ThreadSafe>
-      pCollisionMesh = nullptr;
-#endif
+  CesiumCollisionMeshPtr pCollisionMesh = nullptr;
+
+  /**
+   * The estimated size of pCollisionMesh, for the Cesium stats.
+   */
+  int64 collisionMeshBytes = 0;
+
+  /**
+   * The geometry to cook the collision mesh from later, if cooking was
+   * deferred until a physics-relevant actor comes near the primitive.
+   */
+  TSharedPtr<const CesiumCollisionGeometry> pDeferredCollisionGeometry;
   std::string name{};
 
   TUniquePtr<CesiumTextureUtility::LoadedTextureResult> baseColorTexture;
@@ -88,12 +107,31 @@ struct LoadPrimitiveResult {
    */
   glm::vec3 dimensions;
 
+  /**
+   * Whether only the collision mesh of this primitive was loaded, without any
+   * render data or material.
+   */
+  bool collisionOnly = false;
+
+  /**
+   * The bounds of a collision-only primitive, which has no render data to
+   * take them from.
+   */
+  FBoxSphereBounds collisionBounds{ForceInit};
+
 #pragma endregion
 
 #pragma region CesiumGltfPrimitiveComponent data
   int32_t meshIndex = -1;
   int32_t primitiveIndex = -1;
 
+  /**
+   * The content hash under which the instances of this primitive are
+   * aggregated with those of identical primitives in other tiles, or 0 if
+   * they are not aggregated.
+   */
+  uint64 InstanceAggregationKey = 0;
+
   /** Parses EXT_mesh_features from a mesh primitive.*/
   FCesiumPrimitiveFeatures Features{};
   /** Parses EXT_structural_metadata from a mesh primitive.*/
@@ -183,5 +221,12 @@ struct LoadModelResult {
   // For backwards compatibility with CesiumEncodedMetadataComponent.
   std::optional<CesiumEncodedMetadataUtility::EncodedMetadata>
       EncodedMetadata_DEPRECATED{};
+
+  // The style that StyleColors were evaluated with.
+  std::shared_ptr<const CesiumStyle::Style> pStyle{};
+
+  // The style of each feature of each encoded property table, by property
+  // table name.
+  TMap<FString, TArray<FColor>> StyleColors{};
 };
 } // namespace LoadGltfResult
@@ -0,0 +1,90 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumCameraPath.h"
+#include "Misc/AutomationTest.h"
+
+BEGIN_DEFINE_SPEC(
+    FCesiumCameraPathSpec,
+    "Cesium.Unit.CameraPath",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext |
+        EAutomationTestFlags::ServerContext |
+        EAutomationTestFlags::CommandletContext |
+        EAutomationTestFlags::ProductFilter)
+
+TArray<FCesiumCameraPathPoint> path;
+
+END_DEFINE_SPEC(FCesiumCameraPathSpec)
+
+void FCesiumCameraPathSpec::Define() {
+  BeforeEach([this]() {
+    path.Empty();
+
+    FCesiumCameraPathPoint& start = path.AddDefaulted_GetRef();
+    start.Time = 1.0;
+    start.Camera = FCesiumCamera(
+        FVector2D(1000.0, 500.0),
+        FVector(0.0, 0.0, 0.0),
+        FRotator(0.0, 0.0, 0.0),
+        60.0);
+
+    FCesiumCameraPathPoint& end = path.AddDefaulted_GetRef();
+    end.Time = 3.0;
+    end.Camera = FCesiumCamera(
+        FVector2D(1000.0, 500.0),
+        FVector(100.0, 200.0, 0.0),
+        FRotator(0.0, 90.0, 0.0),
+        90.0);
+  });
+
+  Describe("interpolate", [this]() {
+    It("interpolates between the nearest points", [this]() {
+      FCesiumCamera camera = CesiumCameraPath::interpolate(path, 2.0);
+      TestEqual("location", camera.Location, FVector(50.0, 100.0, 0.0));
+      TestEqual("yaw", camera.Rotation.Yaw, 45.0, 1e-6);
+      TestEqual("field of view", camera.FieldOfViewDegrees, 75.0, 1e-6);
+    });
+
+    It("returns the end points outside of the path", [this]() {
+      TestEqual(
+          "before",
+          CesiumCameraPath::interpolate(path, 0.0).Location,
+          FVector(0.0, 0.0, 0.0));
+      TestEqual(
+          "after",
+          CesiumCameraPath::interpolate(path, 10.0).Location,
+          FVector(100.0, 200.0, 0.0));
+    });
+
+    It("returns the pose of a point at its exact time", [this]() {
+      TestEqual(
+          "location",
+          CesiumCameraPath::interpolate(path, 3.0).Location,
+          FVector(100.0, 200.0, 0.0));
+    });
+
+    It("handles points with the same time", [this]() {
+      path[1].Time = path[0].Time;
+      FCesiumCamera camera = CesiumCameraPath::interpolate(path, 1.0);
+      TestTrue("finite", !camera.Location.ContainsNaN());
+    });
+  });
+
+  Describe("canPrefetch", [this]() {
+    It("keeps prefetching when the cache is full", [this]() {
+      TestTrue(
+          "full cache",
+          CesiumCameraPath::canPrefetch(100, 100, 50, 0, 10));
+    });
+
+    It("stops once the prefetch share is used up", [this]() {
+      TestFalse(
+          "over budget",
+          CesiumCameraPath::canPrefetch(150, 100, 50, 0, 10));
+    });
+
+    It("pauses while many tiles are waiting to load", [this]() {
+      TestFalse("busy", CesiumCameraPath::canPrefetch(0, 100, 50, 11, 10));
+      TestTrue("not busy", CesiumCameraPath::canPrefetch(0, 100, 50, 10, 10));
+    });
+  });
+}
@@ -0,0 +1,241 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "Cesium3DTileset.h"
+#include "CesiumCommon.h"
+#include "CesiumDebugColorizeTilesRasterOverlay.h"
+#include "CesiumGltfComponent.h"
+#include "CesiumGltfSpecUtility.h"
+#include "CesiumRuntime.h"
+#include "CesiumTestHelpers.h"
+#include "CesiumViewSubsystem.h"
+#include "Components/StaticMeshComponent.h"
+#include "CreateGltfOptions.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/World.h"
+#include "Misc/AutomationTest.h"
+#include "PhysicsEngine/BodySetup.h"
+#include <Cesium3DTilesSelection/Tile.h>
+#include <Cesium3DTilesSelection/Tileset.h>
+
+BEGIN_DEFINE_SPEC(
+    FCesiumCollisionOnlySpec,
+    "Cesium.Unit.CollisionOnly",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext |
+        EAutomationTestFlags::ServerContext |
+        EAutomationTestFlags::CommandletContext |
+        EAutomationTestFlags::ProductFilter)
+
+TObjectPtr<ACesium3DTileset> pTileset;
+
+UCesiumGltfComponent* loadTriangle(bool collisionOnly);
+
+END_DEFINE_SPEC(FCesiumCollisionOnlySpec)
+
+UCesiumGltfComponent*
+FCesiumCollisionOnlySpec::loadTriangle(bool collisionOnly) {
+  CesiumGltf::Model model;
+  CesiumGltf::Mesh& mesh = model.meshes.emplace_back();
+  CesiumGltf::MeshPrimitive& primitive = mesh.primitives.emplace_back();
+  primitive.mode = CesiumGltf::MeshPrimitive::Mode::TRIANGLES;
+
+  std::vector<glm::vec3> positions{
+      glm::vec3(0.0f, 0.0f, 0.0f),
+      glm::vec3(1.0f, 0.0f, 0.0f),
+      glm::vec3(0.0f, 1.0f, 0.0f)};
+  CreateAttributeForPrimitive(
+      model,
+      primitive,
+      "POSITION",
+      CesiumGltf::AccessorSpec::Type::VEC3,
+      CesiumGltf::AccessorSpec::ComponentType::FLOAT,
+      positions);
+  CreateIndicesForPrimitive(
+      model,
+      primitive,
+      CesiumGltf::AccessorSpec::ComponentType::UNSIGNED_SHORT,
+      std::vector<uint16_t>{0, 1, 2});
+
+  CesiumGltf::Node& node = model.nodes.emplace_back();
+  node.mesh = 0;
+  CesiumGltf::Scene& scene = model.scenes.emplace_back();
+  scene.nodes.push_back(0);
+  model.scene = 0;
+
+  Cesium3DTilesSelection::TileLoadResult tileLoadResult =
+      Cesium3DTilesSelection::TileLoadResult::createFailedResult(
+          nullptr,
+          nullptr);
+  tileLoadResult.contentKind = std::move(model);
+  tileLoadResult.state = Cesium3DTilesSelection::TileLoadResultState::Success;
+
+  CreateGltfOptions::CreateModelOptions options(std::move(tileLoadResult));
+  options.collisionOnly = collisionOnly;
+  options.loadMetadata = false;
+
+  UCesiumGltfComponent::CreateOffGameThreadResult result =
+      UCesiumGltfComponent::CreateOffGameThread(
+          getAsyncSystem(),
+          glm::dmat4(1.0),
+          std::move(options))
+          .wait();
+
+  CesiumGltf::Model* pModel =
+      std::get_if<CesiumGltf::Model>(&result.TileLoadResult.contentKind);
+  if (!pModel) {
+    return nullptr;
+  }
+
+  Cesium3DTilesSelection::Tile tile(nullptr);
+  return UCesiumGltfComponent::CreateOnGameThread(
+      *pModel,
+      pTileset,
+      MoveTemp(result.HalfConstructed),
+      glm::dmat4(1.0),
+      nullptr,
+      nullptr,
+      nullptr,
+      FCustomDepthParameters(),
+      tile,
+      false,
+      nullptr);
+}
+
+void FCesiumCollisionOnlySpec::Define() {
+  BeforeEach([this]() {
+    UWorld* pWorld = CesiumTestHelpers::getGlobalWorldContext();
+    pTileset = pWorld->SpawnActor<ACesium3DTileset>();
+    pTileset->SetTilesetSource(ETilesetSource::FromUrl);
+    pTileset->SetUrl(TEXT("file:///nonexistent/tileset.json"));
+  });
+
+  AfterEach([this]() { pTileset->Destroy(); });
+
+  Describe("appendCubeFaceCameras", [this]() {
+    It("looks through each of the six faces of a cube", [this]() {
+      const FVector location(10.0, 20.0, 30.0);
+      std::vector<FCesiumCamera> cameras;
+      UCesiumViewSubsystem::appendCubeFaceCameras(location, cameras);
+      if (!TestEqual("count", cameras.size(), size_t(6))) {
+        return;
+      }
+
+      const FVector expectedDirections[] = {
+          FVector(1.0, 0.0, 0.0),
+          FVector(0.0, 1.0, 0.0),
+          FVector(-1.0, 0.0, 0.0),
+          FVector(0.0, -1.0, 0.0),
+          FVector(0.0, 0.0, 1.0),
+          FVector(0.0, 0.0, -1.0)};
+
+      for (size_t i = 0; i < cameras.size(); ++i) {
+        const FCesiumCamera& camera = cameras[i];
+        TestEqual("location", camera.Location, location);
+        TestEqual("field of view", camera.FieldOfViewDegrees, 90.0);
+        TestEqual("square", camera.ViewportSize.X, camera.ViewportSize.Y);
+        TestTrue(
+            "direction",
+            camera.Rotation.Vector().Equals(expectedDirections[i], 1e-6));
+      }
+    });
+
+    It("appends to the existing cameras", [this]() {
+      std::vector<FCesiumCamera> cameras;
+      UCesiumViewSubsystem::appendCubeFaceCameras(FVector::ZeroVector, cameras);
+      UCesiumViewSubsystem::appendCubeFaceCameras(FVector::OneVector, cameras);
+      TestEqual("count", cameras.size(), size_t(12));
+    });
+  });
+
+  Describe("IsCollisionOnly", [this]() {
+    It("follows the collision-only mode", [this]() {
+      TestFalse("default", pTileset->IsCollisionOnly());
+      pTileset->SetCollisionOnlyMode(ECesiumCollisionOnlyMode::Always);
+      TestTrue("always", pTileset->IsCollisionOnly());
+      pTileset->SetCollisionOnlyMode(ECesiumCollisionOnlyMode::Never);
+      TestFalse("never", pTileset->IsCollisionOnly());
+    });
+  });
+
+  Describe("Raster overlays", [this]() {
+    BeforeEach([this]() {
+      UCesiumDebugColorizeTilesRasterOverlay* pOverlay =
+          NewObject<UCesiumDebugColorizeTilesRasterOverlay>(pTileset);
+      pTileset->AddInstanceComponent(pOverlay);
+      pOverlay->RegisterComponent();
+      pOverlay->Activate();
+    });
+
+    It("are added to a rendered tileset", [this]() {
+      // Sampling heights loads the tileset without ticking it.
+      pTileset->SampleHeightMostDetailed({}, {});
+      const Cesium3DTilesSelection::Tileset* pNative = pTileset->GetTileset();
+      if (TestNotNull("tileset", pNative)) {
+        TestEqual("overlays", pNative->getOverlays().size(), size_t(1));
+      }
+    });
+
+    It("are not added to a collision-only tileset", [this]() {
+      pTileset->SetCollisionOnlyMode(ECesiumCollisionOnlyMode::Always);
+      pTileset->SampleHeightMostDetailed({}, {});
+      const Cesium3DTilesSelection::Tileset* pNative = pTileset->GetTileset();
+      if (TestNotNull("tileset", pNative)) {
+        TestEqual("overlays", pNative->getOverlays().size(), size_t(0));
+      }
+    });
+  });
+
+  Describe("Collision-only primitives", [this]() {
+    It("have a physics mesh but no material or render data", [this]() {
+      UCesiumGltfComponent* pGltf = loadTriangle(true);
+      if (!TestNotNull("glTF", pGltf)) {
+        return;
+      }
+
+      const TArray<USceneComponent*>& children = pGltf->GetAttachChildren();
+      if (!TestEqual("primitives", children.Num(), 1)) {
+        return;
+      }
+
+      UStaticMeshComponent* pMesh = Cast<UStaticMeshComponent>(children[0]);
+      if (!TestNotNull("static mesh component", pMesh)) {
+        return;
+      }
+
+      TestNull("material", pMesh->GetMaterial(0));
+      TestFalse("casts shadow", pMesh->CastShadow);
+
+      UStaticMesh* pStaticMesh = pMesh->GetStaticMesh();
+      if (!TestNotNull("static mesh", pStaticMesh)) {
+        return;
+      }
+
+      TestNull("render data", pStaticMesh->GetRenderData());
+      UBodySetup* pBodySetup = pStaticMesh->GetBodySetup();
+      if (TestNotNull("body setup", pBodySetup)) {
+#if ENGINE_VERSION_5_4_OR_HIGHER
+        TestEqual("physics meshes", pBodySetup->TriMeshGeometries.Num(), 1);
+#else
+        TestEqual("physics meshes", pBodySetup->ChaosTriMeshes.Num(), 1);
+#endif
+      }
+    });
+
+    It("are loaded for rendering otherwise", [this]() {
+      UCesiumGltfComponent* pGltf = loadTriangle(false);
+      if (!TestNotNull("glTF", pGltf)) {
+        return;
+      }
+
+      const TArray<USceneComponent*>& children = pGltf->GetAttachChildren();
+      if (!TestEqual("primitives", children.Num(), 1)) {
+        return;
+      }
+
+      UStaticMeshComponent* pMesh = Cast<UStaticMeshComponent>(children[0]);
+      if (TestNotNull("static mesh component", pMesh)) {
+        TestNotNull("material", pMesh->GetMaterial(0));
+        TestTrue("casts shadow", pMesh->CastShadow);
+      }
+    });
+  });
+}
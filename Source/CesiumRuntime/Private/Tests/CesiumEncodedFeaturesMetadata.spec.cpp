@@ -0,0 +1,280 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumEncodedFeaturesMetadata.h"
+#include "CesiumFeaturesMetadataComponent.h"
+#include "CesiumGltf/ExtensionModelExtStructuralMetadata.h"
+#include "CesiumGltf/Model.h"
+#include "CesiumGltfSpecUtility.h"
+#include "CesiumPropertyTable.h"
+#include "CesiumTextureResource.h"
+#include "CesiumTextureUtility.h"
+#include "Misc/AutomationTest.h"
+#include <vector>
+
+using namespace CesiumEncodedFeaturesMetadata;
+
+BEGIN_DEFINE_SPEC(
+    FCesiumEncodedFeaturesMetadataSpec,
+    "Cesium.Unit.EncodedFeaturesMetadata",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext |
+        EAutomationTestFlags::ServerContext |
+        EAutomationTestFlags::CommandletContext |
+        EAutomationTestFlags::ProductFilter)
+CesiumGltf::Model model;
+CesiumGltf::PropertyTable* pPropertyTable;
+FCesiumPropertyTableDescription description;
+
+template <typename T>
+void addScalarProperty(
+    const FString& name,
+    const std::string& componentType,
+    ECesiumMetadataComponentType metadataComponentType,
+    ECesiumEncodedMetadataComponentType encodedComponentType,
+    const std::vector<T>& values);
+
+EncodedPropertyTable encode();
+
+void testPackSize(
+    const EncodedPropertyTable& encoded,
+    int32 packIndex,
+    int32 width,
+    int32 height);
+
+void testRowOffsets(
+    const EncodedPropertyTable& encoded,
+    const TArray<int32>& expected);
+END_DEFINE_SPEC(FCesiumEncodedFeaturesMetadataSpec)
+
+template <typename T>
+void FCesiumEncodedFeaturesMetadataSpec::addScalarProperty(
+    const FString& name,
+    const std::string& componentType,
+    ECesiumMetadataComponentType metadataComponentType,
+    ECesiumEncodedMetadataComponentType encodedComponentType,
+    const std::vector<T>& values) {
+  AddPropertyTablePropertyToModel(
+      model,
+      *pPropertyTable,
+      TCHAR_TO_UTF8(*name),
+      CesiumGltf::ClassProperty::Type::SCALAR,
+      componentType,
+      values);
+
+  FCesiumPropertyTablePropertyDescription& property =
+      description.Properties.Emplace_GetRef();
+  property.Name = name;
+  property.PropertyDetails = FCesiumMetadataPropertyDetails(
+      ECesiumMetadataType::Scalar,
+      metadataComponentType,
+      false);
+  property.EncodingDetails = FCesiumMetadataEncodingDetails(
+      ECesiumEncodedMetadataType::Scalar,
+      encodedComponentType,
+      ECesiumEncodedMetadataConversion::Coerce);
+}
+
+EncodedPropertyTable FCesiumEncodedFeaturesMetadataSpec::encode() {
+  FCesiumPropertyTable propertyTable(model, *pPropertyTable);
+  return encodePropertyTableAnyThreadPart(description, propertyTable);
+}
+
+void FCesiumEncodedFeaturesMetadataSpec::testPackSize(
+    const EncodedPropertyTable& encoded,
+    int32 packIndex,
+    int32 width,
+    int32 height) {
+  if (!TestTrue(
+          "pack exists",
+          encoded.packedProperties.IsValidIndex(packIndex))) {
+    return;
+  }
+
+  const CesiumTextureUtility::LoadedTextureResult* pLoaded =
+      encoded.packedProperties[packIndex].pTexture.Get();
+  if (!TestTrue(
+          "texture resource",
+          pLoaded && pLoaded->pTexture &&
+              pLoaded->pTexture->getTextureResource())) {
+    return;
+  }
+
+  const FCesiumTextureResourceUniquePtr& pResource =
+      pLoaded->pTexture->getTextureResource();
+  TestEqual("width", int32(pResource->GetSizeX()), width);
+  TestEqual("height", int32(pResource->GetSizeY()), height);
+}
+
+void FCesiumEncodedFeaturesMetadataSpec::testRowOffsets(
+    const EncodedPropertyTable& encoded,
+    const TArray<int32>& expected) {
+  // The order of the properties follows the glTF, so compare them sorted.
+  TArray<int32> rowOffsets;
+  for (const EncodedPropertyTableProperty& property : encoded.properties) {
+    rowOffsets.Add(property.packedRowOffset);
+  }
+  rowOffsets.Sort();
+
+  if (!TestEqual("properties", rowOffsets.Num(), expected.Num())) {
+    return;
+  }
+  for (int32 i = 0; i < expected.Num(); ++i) {
+    TestEqual("row offset", rowOffsets[i], expected[i]);
+  }
+}
+
+void FCesiumEncodedFeaturesMetadataSpec::Define() {
+  BeforeEach([this]() {
+    model = CesiumGltf::Model();
+    CesiumGltf::ExtensionModelExtStructuralMetadata& extension =
+        model.addExtension<CesiumGltf::ExtensionModelExtStructuralMetadata>();
+    extension.schema.emplace();
+    pPropertyTable = &extension.propertyTables.emplace_back();
+    pPropertyTable->classProperty = "testClass";
+
+    description = FCesiumPropertyTableDescription();
+    description.Name = "testTable";
+    description.PackProperties = true;
+  });
+
+  Describe("getMaterialNameForPackedPropertyTable", [this]() {
+    It("appends the pack index to the table name", [this]() {
+      TestEqual(
+          "name",
+          getMaterialNameForPackedPropertyTable("houses", 1),
+          FString("PTABLE_houses_PACKED1"));
+    });
+
+    It("names the row offset of a packed property", [this]() {
+      TestEqual(
+          "name",
+          getMaterialNameForPropertyTableProperty("houses", "height") +
+              MaterialPropertyRowOffsetSuffix,
+          FString("PTABLE_houses_height_ROW_OFFSET"));
+    });
+  });
+
+  Describe("encodePropertyTableAnyThreadPart", [this]() {
+    It("packs properties of the same format into one texture", [this]() {
+      pPropertyTable->count = 10;
+      const std::vector<uint8_t> values{0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+      addScalarProperty(
+          "first",
+          CesiumGltf::ClassProperty::ComponentType::UINT8,
+          ECesiumMetadataComponentType::Uint8,
+          ECesiumEncodedMetadataComponentType::Uint8,
+          values);
+      addScalarProperty(
+          "second",
+          CesiumGltf::ClassProperty::ComponentType::UINT8,
+          ECesiumMetadataComponentType::Uint8,
+          ECesiumEncodedMetadataComponentType::Uint8,
+          values);
+
+      EncodedPropertyTable encoded = encode();
+      if (!TestEqual("properties", encoded.properties.Num(), 2) ||
+          !TestEqual("packs", encoded.packedProperties.Num(), 1)) {
+        return;
+      }
+
+      TestTrue(
+          "format",
+          encoded.packedProperties[0].format == EPixelFormat::PF_R8_UINT);
+      for (const EncodedPropertyTableProperty& property :
+           encoded.properties) {
+        TestEqual("pack index", property.packIndex, 0);
+        TestNull("own texture", property.pTexture.Get());
+      }
+    });
+
+    It("shares a width between packs, sized for the largest", [this]() {
+      // The largest pack holds 2 * 10 values, so the width is
+      // ceil(sqrt(20)) = 5 and each property needs ceil(10 / 5) = 2 rows.
+      pPropertyTable->count = 10;
+      const std::vector<uint8_t> bytes{0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+      const std::vector<float> floats{0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+      addScalarProperty(
+          "first",
+          CesiumGltf::ClassProperty::ComponentType::UINT8,
+          ECesiumMetadataComponentType::Uint8,
+          ECesiumEncodedMetadataComponentType::Uint8,
+          bytes);
+      addScalarProperty(
+          "second",
+          CesiumGltf::ClassProperty::ComponentType::UINT8,
+          ECesiumMetadataComponentType::Uint8,
+          ECesiumEncodedMetadataComponentType::Uint8,
+          bytes);
+      addScalarProperty(
+          "third",
+          CesiumGltf::ClassProperty::ComponentType::FLOAT32,
+          ECesiumMetadataComponentType::Float32,
+          ECesiumEncodedMetadataComponentType::Float,
+          floats);
+
+      EncodedPropertyTable encoded = encode();
+      if (!TestEqual("packs", encoded.packedProperties.Num(), 2)) {
+        return;
+      }
+
+      testPackSize(encoded, 0, 5, 4);
+      testPackSize(encoded, 1, 5, 2);
+    });
+
+    It("gives each property of a pack its own rows", [this]() {
+      pPropertyTable->count = 10;
+      const std::vector<uint8_t> values{0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+      for (const char* name : {"first", "second", "third"}) {
+        addScalarProperty(
+            name,
+            CesiumGltf::ClassProperty::ComponentType::UINT8,
+            ECesiumMetadataComponentType::Uint8,
+            ECesiumEncodedMetadataComponentType::Uint8,
+            values);
+      }
+
+      // ceil(sqrt(30)) = 6 texels wide, so ceil(10 / 6) = 2 rows each.
+      EncodedPropertyTable encoded = encode();
+      testPackSize(encoded, 0, 6, 6);
+      testRowOffsets(encoded, {0, 2, 4});
+    });
+
+    It("is never wider than the feature count", [this]() {
+      // sqrt(2 * 4) rounds up to 3, which would leave a column unused.
+      pPropertyTable->count = 2;
+      const std::vector<uint8_t> values{0, 1};
+      for (const char* name : {"a", "b", "c", "d"}) {
+        addScalarProperty(
+            name,
+            CesiumGltf::ClassProperty::ComponentType::UINT8,
+            ECesiumMetadataComponentType::Uint8,
+            ECesiumEncodedMetadataComponentType::Uint8,
+            values);
+      }
+
+      EncodedPropertyTable encoded = encode();
+      testPackSize(encoded, 0, 2, 4);
+      testRowOffsets(encoded, {0, 1, 2, 3});
+    });
+
+    It("gives each property its own texture when not packing", [this]() {
+      description.PackProperties = false;
+      pPropertyTable->count = 4;
+      addScalarProperty(
+          "first",
+          CesiumGltf::ClassProperty::ComponentType::UINT8,
+          ECesiumMetadataComponentType::Uint8,
+          ECesiumEncodedMetadataComponentType::Uint8,
+          std::vector<uint8_t>{0, 1, 2, 3});
+
+      EncodedPropertyTable encoded = encode();
+      TestEqual("packs", encoded.packedProperties.Num(), 0);
+      if (TestEqual("properties", encoded.properties.Num(), 1)) {
+        TestEqual(
+            "pack index",
+            encoded.properties[0].packIndex,
+            int32(INDEX_NONE));
+        TestNotNull("own texture", encoded.properties[0].pTexture.Get());
+      }
+    });
+  });
+}
@@ -0,0 +1,118 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumFadeParameters.h"
+#include "CesiumMaterialUserData.h"
+#include "Materials/Material.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_EDITOR
+#include "Materials/MaterialExpressionScalarParameter.h"
+#include "Materials/MaterialFunctionMaterialLayer.h"
+#endif
+
+BEGIN_DEFINE_SPEC(
+    FCesiumFadeParametersSpec,
+    "Cesium.Unit.FadeParameters",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext |
+        EAutomationTestFlags::ServerContext |
+        EAutomationTestFlags::CommandletContext |
+        EAutomationTestFlags::ProductFilter)
+
+UMaterial* createMaterial(const TArray<FString>& layerNames);
+
+END_DEFINE_SPEC(FCesiumFadeParametersSpec)
+
+UMaterial*
+FCesiumFadeParametersSpec::createMaterial(const TArray<FString>& layerNames) {
+  UMaterial* pMaterial = NewObject<UMaterial>();
+  UCesiumMaterialUserData* pUserData =
+      NewObject<UCesiumMaterialUserData>(pMaterial);
+  pUserData->LayerNames = layerNames;
+  pMaterial->AddAssetUserData(pUserData);
+  return pMaterial;
+}
+
+void FCesiumFadeParametersSpec::Define() {
+  Describe("resolve", [this]() {
+    It("does not fade without a material", [this]() {
+      const CesiumFadeParameters fade = CesiumFadeParameters::resolve(nullptr);
+      TestFalse("fades", fade.fades());
+      TestFalse("uses material parameters", fade.usesMaterialParameters());
+    });
+
+    It("does not fade without Cesium material user data", [this]() {
+      const CesiumFadeParameters fade =
+          CesiumFadeParameters::resolve(NewObject<UMaterial>());
+      TestFalse("fades", fade.fades());
+    });
+
+    It("does not fade without a DitherFade layer", [this]() {
+      const CesiumFadeParameters fade =
+          CesiumFadeParameters::resolve(createMaterial({"Clipping"}));
+      TestFalse("fades", fade.fades());
+    });
+
+    It("uses material parameters when they are not bound", [this]() {
+      const CesiumFadeParameters fade = CesiumFadeParameters::resolve(
+          createMaterial({"Clipping", "DitherFade"}));
+      TestEqual("layer", fade.LayerIndex, 1);
+      TestEqual(
+          "fade percentage slot",
+          fade.FadePercentageDataIndex,
+          int32(INDEX_NONE));
+      TestEqual(
+          "fading type slot",
+          fade.FadingTypeDataIndex,
+          int32(INDEX_NONE));
+      TestTrue("uses material parameters", fade.usesMaterialParameters());
+    });
+
+    It("finds the layer of each material separately", [this]() {
+      // Like the opaque and translucent base materials of a tileset, whose
+      // layer stacks may differ.
+      const CesiumFadeParameters opaque =
+          CesiumFadeParameters::resolve(createMaterial({"DitherFade"}));
+      const CesiumFadeParameters translucent = CesiumFadeParameters::resolve(
+          createMaterial({"Overlay0", "Overlay1", "DitherFade"}));
+      TestEqual("opaque layer", opaque.LayerIndex, 0);
+      TestEqual("translucent layer", translucent.LayerIndex, 2);
+    });
+  });
+
+#if WITH_EDITOR
+  Describe("bindToCustomPrimitiveData", [this]() {
+    It("binds the fade parameters of a layer to their slots", [this]() {
+      UMaterialFunctionMaterialLayer* pLayer =
+          NewObject<UMaterialFunctionMaterialLayer>();
+      TArray<UMaterialExpressionScalarParameter*> parameters;
+      for (const TCHAR* name :
+           {TEXT("FadePercentage"), TEXT("FadingType"), TEXT("Other")}) {
+        UMaterialExpressionScalarParameter* pParameter =
+            NewObject<UMaterialExpressionScalarParameter>(pLayer);
+        pParameter->ParameterName = name;
+        pLayer->GetExpressionCollection().AddExpression(pParameter);
+        parameters.Add(pParameter);
+      }
+
+      TestTrue(
+          "changed",
+          CesiumFadeParameters::bindToCustomPrimitiveData(*pLayer));
+      TestTrue("fade percentage", bool(parameters[0]->bUseCustomPrimitiveData));
+      TestEqual(
+          "fade percentage slot",
+          int32(parameters[0]->PrimitiveDataIndex),
+          CesiumFadeParameters::DefaultFadePercentageDataIndex);
+      TestTrue("fading type", bool(parameters[1]->bUseCustomPrimitiveData));
+      TestEqual(
+          "fading type slot",
+          int32(parameters[1]->PrimitiveDataIndex),
+          CesiumFadeParameters::DefaultFadingTypeDataIndex);
+      TestFalse("other", bool(parameters[2]->bUseCustomPrimitiveData));
+
+      TestFalse(
+          "changed again",
+          CesiumFadeParameters::bindToCustomPrimitiveData(*pLayer));
+    });
+  });
+#endif
+}
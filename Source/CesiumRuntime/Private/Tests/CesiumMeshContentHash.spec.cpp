@@ -0,0 +1,107 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumMeshContentHash.h"
+#include "CesiumGltfSpecUtility.h"
+#include "Misc/AutomationTest.h"
+
+using namespace CesiumGltf;
+
+BEGIN_DEFINE_SPEC(
+    FCesiumMeshContentHashSpec,
+    "Cesium.Unit.MeshContentHash",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext |
+        EAutomationTestFlags::ServerContext |
+        EAutomationTestFlags::CommandletContext |
+        EAutomationTestFlags::ProductFilter)
+Model modelA;
+Model modelB;
+
+MeshPrimitive&
+AddTriangle(Model& model, const glm::vec3& offset, bool padFirst = false);
+END_DEFINE_SPEC(FCesiumMeshContentHashSpec)
+
+MeshPrimitive& FCesiumMeshContentHashSpec::AddTriangle(
+    Model& model,
+    const glm::vec3& offset,
+    bool padFirst) {
+  if (padFirst) {
+    // Unrelated data in front, so that the accessor indices differ.
+    AddBufferToModel(
+        model,
+        AccessorSpec::Type::SCALAR,
+        AccessorSpec::ComponentType::FLOAT,
+        GetValuesAsBytes(std::vector<float>{1.0f, 2.0f}));
+  }
+
+  MeshPrimitive& primitive =
+      model.meshes.emplace_back().primitives.emplace_back();
+  CreateAttributeForPrimitive(
+      model,
+      primitive,
+      "POSITION",
+      AccessorSpec::Type::VEC3,
+      AccessorSpec::ComponentType::FLOAT,
+      std::vector<glm::vec3>{
+          offset,
+          offset + glm::vec3(1.0f, 0.0f, 0.0f),
+          offset + glm::vec3(0.0f, 1.0f, 0.0f)});
+  CreateIndicesForPrimitive(
+      model,
+      primitive,
+      AccessorSpec::ComponentType::UNSIGNED_SHORT,
+      std::vector<uint16_t>{0, 1, 2});
+  return primitive;
+}
+
+void FCesiumMeshContentHashSpec::Define() {
+  BeforeEach([this]() {
+    modelA = Model();
+    modelB = Model();
+  });
+
+  It("matches identical primitives in different models", [this]() {
+    const MeshPrimitive& a = AddTriangle(modelA, glm::vec3(0.0f));
+    const MeshPrimitive& b = AddTriangle(modelB, glm::vec3(0.0f), true);
+
+    std::optional<uint64> hashA =
+        CesiumMeshContentHash::hashPrimitive(modelA, a);
+    std::optional<uint64> hashB =
+        CesiumMeshContentHash::hashPrimitive(modelB, b);
+    if (TestTrue("hashed", hashA.has_value() && hashB.has_value())) {
+      TestTrue("same hash", *hashA == *hashB);
+    }
+  });
+
+  It("distinguishes different geometry", [this]() {
+    const MeshPrimitive& a = AddTriangle(modelA, glm::vec3(0.0f));
+    const MeshPrimitive& b = AddTriangle(modelB, glm::vec3(0.0f, 0.0f, 1.0f));
+
+    TestTrue(
+        "different hash",
+        CesiumMeshContentHash::hashPrimitive(modelA, a).value_or(0) !=
+            CesiumMeshContentHash::hashPrimitive(modelB, b).value_or(0));
+  });
+
+  It("distinguishes different materials", [this]() {
+    MeshPrimitive& a = AddTriangle(modelA, glm::vec3(0.0f));
+    MeshPrimitive& b = AddTriangle(modelB, glm::vec3(0.0f));
+    a.material = 0;
+    modelA.materials.emplace_back().doubleSided = true;
+    b.material = 0;
+    modelB.materials.emplace_back().doubleSided = false;
+
+    TestTrue(
+        "different hash",
+        CesiumMeshContentHash::hashPrimitive(modelA, a).value_or(0) !=
+            CesiumMeshContentHash::hashPrimitive(modelB, b).value_or(0));
+  });
+
+  It("does not hash primitives with morph targets", [this]() {
+    MeshPrimitive& a = AddTriangle(modelA, glm::vec3(0.0f));
+    a.targets.emplace_back();
+
+    TestFalse(
+        "hashed",
+        CesiumMeshContentHash::hashPrimitive(modelA, a).has_value());
+  });
+}
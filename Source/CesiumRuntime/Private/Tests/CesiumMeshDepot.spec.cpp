@@ -0,0 +1,44 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumMeshDepot.h"
+#include "Misc/AutomationTest.h"
+
+BEGIN_DEFINE_SPEC(
+    FCesiumMeshDepotSpec,
+    "Cesium.Unit.MeshDepot",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext |
+        EAutomationTestFlags::ServerContext |
+        EAutomationTestFlags::CommandletContext |
+        EAutomationTestFlags::ProductFilter)
+END_DEFINE_SPEC(FCesiumMeshDepotSpec)
+
+void FCesiumMeshDepotSpec::Define() {
+  It("finds meshes while they are referenced", [this]() {
+    CesiumMeshDepot depot;
+    TSharedPtr<CesiumSharedMesh> pMesh =
+        depot.add(1, MakeShared<CesiumSharedMesh>());
+
+    TestTrue("found", depot.find(1) == pMesh);
+    TestFalse("other key found", depot.find(2).IsValid());
+    TestEqual("mesh count", depot.getMeshCount(), 1);
+    TestEqual("reference count", depot.getReferenceCount(), 1);
+    TestEqual("hit count", int32(depot.getHitCount()), 1);
+
+    pMesh.Reset();
+    TestFalse("found after release", depot.find(1).IsValid());
+    TestEqual("mesh count after release", depot.getMeshCount(), 0);
+  });
+
+  It("keeps the first of two meshes added with the same key", [this]() {
+    CesiumMeshDepot depot;
+    TSharedRef<CesiumSharedMesh> pFirst = MakeShared<CesiumSharedMesh>();
+    TSharedRef<CesiumSharedMesh> pSecond = MakeShared<CesiumSharedMesh>();
+
+    TSharedPtr<CesiumSharedMesh> pAddedFirst = depot.add(7, pFirst);
+    TSharedPtr<CesiumSharedMesh> pAddedSecond = depot.add(7, pSecond);
+
+    TestTrue("first added", pAddedFirst == pFirst);
+    TestTrue("second replaced by first", pAddedSecond == pFirst);
+    TestEqual("mesh count", depot.getMeshCount(), 1);
+  });
+}
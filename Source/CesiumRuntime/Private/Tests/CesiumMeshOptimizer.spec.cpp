@@ -0,0 +1,102 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumMeshOptimizer.h"
+#include "Misc/AutomationTest.h"
+
+BEGIN_DEFINE_SPEC(
+    FCesiumMeshOptimizerSpec,
+    "Cesium.Unit.MeshOptimizer",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext |
+        EAutomationTestFlags::ServerContext |
+        EAutomationTestFlags::CommandletContext |
+        EAutomationTestFlags::ProductFilter)
+TArray<FStaticMeshBuildVertex> vertices;
+TArray<uint32> indices;
+END_DEFINE_SPEC(FCesiumMeshOptimizerSpec)
+
+void FCesiumMeshOptimizerSpec::Define() {
+  BeforeEach([this]() {
+    // A flat 4x4 grid of quads, with every triangle using its own three
+    // vertices, as when flat normals are generated.
+    const int32 size = 5;
+    vertices.Empty();
+    indices.Empty();
+
+    auto addVertex = [this](int32 x, int32 y) {
+      FStaticMeshBuildVertex& vertex = vertices.AddZeroed_GetRef();
+      vertex.Position = FVector3f(float(x), float(y), 0.0f);
+      vertex.TangentZ = FVector3f(0.0f, 0.0f, 1.0f);
+      vertex.UVs[0] = FVector2f(float(x), float(y));
+      // Texture coordinate sets that are not used may hold anything.
+      vertex.UVs[1] = FVector2f(float(vertices.Num()), 0.0f);
+      indices.Add(uint32(vertices.Num() - 1));
+    };
+
+    for (int32 y = 0; y + 1 < size; ++y) {
+      for (int32 x = 0; x + 1 < size; ++x) {
+        addVertex(x, y);
+        addVertex(x + 1, y);
+        addVertex(x, y + 1);
+        addVertex(x + 1, y);
+        addVertex(x + 1, y + 1);
+        addVertex(x, y + 1);
+      }
+    }
+  });
+
+  It("welds identical vertices", [this]() {
+    CesiumMeshOptimizer::optimize(vertices, indices, 1, false);
+    TestEqual("vertices", vertices.Num(), 25);
+    TestEqual("indices", indices.Num(), 4 * 4 * 6);
+    for (uint32 index : indices) {
+      TestTrue("index in range", index < uint32(vertices.Num()));
+    }
+  });
+
+  It("keeps vertices that differ in a used attribute", [this]() {
+    CesiumMeshOptimizer::optimize(vertices, indices, 2, false);
+    TestEqual("vertices", vertices.Num(), 4 * 4 * 6);
+  });
+
+  It("keeps every triangle", [this]() {
+    TSet<FVector3f> centroids;
+    for (int32 i = 0; i < indices.Num(); i += 3) {
+      centroids.Add(
+          vertices[indices[i]].Position + vertices[indices[i + 1]].Position +
+          vertices[indices[i + 2]].Position);
+    }
+
+    CesiumMeshOptimizer::optimize(vertices, indices, 1, false);
+
+    for (int32 i = 0; i < indices.Num(); i += 3) {
+      TestTrue(
+          "triangle exists",
+          centroids.Contains(
+              vertices[indices[i]].Position +
+              vertices[indices[i + 1]].Position +
+              vertices[indices[i + 2]].Position));
+    }
+  });
+
+  It("allows half precision for small texture coordinates", [this]() {
+    for (FStaticMeshBuildVertex& vertex : vertices) {
+      vertex.UVs[0] /= 4.0f;
+    }
+    TestTrue(
+        "half precision",
+        CesiumMeshOptimizer::canUseHalfPrecisionUVs(vertices, 1));
+  });
+
+  It("requires full precision for large feature IDs", [this]() {
+    TestTrue(
+        "half precision",
+        CesiumMeshOptimizer::canUseHalfPrecisionUVs(vertices, 2));
+    vertices[0].UVs[1] = FVector2f(4097.0f, 0.0f);
+    TestFalse(
+        "half precision",
+        CesiumMeshOptimizer::canUseHalfPrecisionUVs(vertices, 2));
+    TestTrue(
+        "unused set is ignored",
+        CesiumMeshOptimizer::canUseHalfPrecisionUVs(vertices, 1));
+  });
+}
@@ -0,0 +1,101 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumPhysicsMeshCooker.h"
+#include "Misc/AutomationTest.h"
+
+BEGIN_DEFINE_SPEC(
+    FCesiumPhysicsMeshCookerSpec,
+    "Cesium.Unit.PhysicsMeshCooker",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext |
+        EAutomationTestFlags::ServerContext |
+        EAutomationTestFlags::CommandletContext |
+        EAutomationTestFlags::ProductFilter)
+CesiumCollisionGeometry grid;
+END_DEFINE_SPEC(FCesiumPhysicsMeshCookerSpec)
+
+void FCesiumPhysicsMeshCookerSpec::Define() {
+  BeforeEach([this]() {
+    // A flat 8x8 grid of quads, with two triangles per quad.
+    const int32 size = 9;
+    grid = CesiumCollisionGeometry();
+    for (int32 y = 0; y < size; ++y) {
+      for (int32 x = 0; x < size; ++x) {
+        grid.positions.Add(FVector3f(float(x), float(y), 0.0f));
+      }
+    }
+
+    for (int32 y = 0; y + 1 < size; ++y) {
+      for (int32 x = 0; x + 1 < size; ++x) {
+        const uint32 i0 = uint32(y * size + x);
+        const uint32 i1 = i0 + 1;
+        const uint32 i2 = i0 + size;
+        const uint32 i3 = i2 + 1;
+        grid.indices.Append({i0, i1, i2, i1, i3, i2});
+      }
+    }
+  });
+
+  Describe("simplify", [this]() {
+    It("leaves geometry unchanged with a resolution of zero", [this]() {
+      CesiumPhysicsMeshCooker::simplify(grid, 0);
+      TestEqual("vertices", grid.positions.Num(), 81);
+      TestEqual("indices", grid.indices.Num(), 8 * 8 * 6);
+    });
+
+    It("clusters vertices and removes collapsed triangles", [this]() {
+      CesiumPhysicsMeshCooker::simplify(grid, 2);
+      TestTrue("fewer vertices", grid.positions.Num() < 81);
+      TestTrue("fewer indices", grid.indices.Num() < 8 * 8 * 6);
+      TestTrue("some triangles remain", grid.indices.Num() > 0);
+      TestEqual("whole triangles", grid.indices.Num() % 3, 0);
+
+      for (uint32 index : grid.indices) {
+        TestTrue("index in range", index < uint32(grid.positions.Num()));
+      }
+    });
+
+    It("maps each remaining triangle to its render triangle", [this]() {
+      const CesiumCollisionGeometry original = grid;
+      CesiumPhysicsMeshCooker::simplify(grid, 2);
+      if (!TestEqual(
+              "face remap size",
+              grid.faceRemap.Num(),
+              grid.indices.Num() / 3)) {
+        return;
+      }
+
+      int32 previous = -1;
+      for (int32 face : grid.faceRemap) {
+        TestTrue("face in range", face >= 0 && face < 8 * 8 * 2);
+        TestTrue("faces in order", face > previous);
+        previous = face;
+      }
+
+      // Simplifying again keeps referring to the original triangles.
+      CesiumPhysicsMeshCooker::simplify(grid, 1);
+      for (int32 face : grid.faceRemap) {
+        TestTrue(
+            "face in original range",
+            face >= 0 && face < original.indices.Num() / 3);
+      }
+    });
+
+    It("clamps resolutions that are too large to pack", [this]() {
+      CesiumPhysicsMeshCooker::simplify(grid, TNumericLimits<int32>::Max());
+      TestEqual("vertices", grid.positions.Num(), 81);
+      TestEqual("indices", grid.indices.Num(), 8 * 8 * 6);
+    });
+  });
+
+  Describe("cook", [this]() {
+    It("returns nothing for empty geometry", [this]() {
+      TestFalse(
+          "collision mesh",
+          bool(CesiumPhysicsMeshCooker::cook(CesiumCollisionGeometry())));
+    });
+
+    It("cooks a triangle mesh", [this]() {
+      TestTrue("collision mesh", bool(CesiumPhysicsMeshCooker::cook(grid)));
+    });
+  });
+}
@@ -0,0 +1,174 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumPolygonClipper.h"
+#include "Misc/AutomationTest.h"
+
+using namespace CesiumGeospatial;
+
+BEGIN_DEFINE_SPEC(
+    FCesiumPolygonClipperSpec,
+    "Cesium.Unit.PolygonClipper",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext |
+        EAutomationTestFlags::ServerContext |
+        EAutomationTestFlags::CommandletContext |
+        EAutomationTestFlags::ProductFilter)
+
+std::vector<CartographicPolygon> polygons;
+
+END_DEFINE_SPEC(FCesiumPolygonClipperSpec)
+
+void FCesiumPolygonClipperSpec::Define() {
+  BeforeEach([this]() {
+    polygons = {CartographicPolygon(std::vector<glm::dvec2>{
+        glm::dvec2(0.0, 0.0),
+        glm::dvec2(0.1, 0.0),
+        glm::dvec2(0.1, 0.1),
+        glm::dvec2(0.0, 0.1)})};
+  });
+
+  Describe("isTriangleClipped", [this]() {
+    It("clips triangles inside the polygons", [this]() {
+      CesiumPolygonClipper clipper(polygons, false, Ellipsoid::WGS84);
+      TestTrue(
+          "inside",
+          clipper.isTriangleClipped(
+              glm::dvec2(0.02, 0.02),
+              glm::dvec2(0.08, 0.02),
+              glm::dvec2(0.05, 0.08)));
+      TestFalse(
+          "crossing",
+          clipper.isTriangleClipped(
+              glm::dvec2(0.02, 0.02),
+              glm::dvec2(0.2, 0.02),
+              glm::dvec2(0.05, 0.08)));
+      TestFalse(
+          "outside",
+          clipper.isTriangleClipped(
+              glm::dvec2(0.2, 0.2),
+              glm::dvec2(0.3, 0.2),
+              glm::dvec2(0.25, 0.3)));
+    });
+
+    It("keeps triangles whose vertices are inside a concave polygon",
+       [this]() {
+         std::vector<CartographicPolygon> concave{
+             CartographicPolygon(std::vector<glm::dvec2>{
+                 glm::dvec2(0.0, 0.0),
+                 glm::dvec2(0.1, 0.0),
+                 glm::dvec2(0.05, 0.05),
+                 glm::dvec2(0.1, 0.1),
+                 glm::dvec2(0.0, 0.1)})};
+         CesiumPolygonClipper clipper(concave, false, Ellipsoid::WGS84);
+         TestFalse(
+             "spans the notch",
+             clipper.isTriangleClipped(
+                 glm::dvec2(0.04, 0.01),
+                 glm::dvec2(0.085, 0.01),
+                 glm::dvec2(0.08, 0.09)));
+       });
+
+    It("clips triangles outside the polygons when inverted", [this]() {
+      CesiumPolygonClipper clipper(polygons, true, Ellipsoid::WGS84);
+      TestTrue(
+          "outside",
+          clipper.isTriangleClipped(
+              glm::dvec2(0.2, 0.2),
+              glm::dvec2(0.3, 0.2),
+              glm::dvec2(0.25, 0.3)));
+      TestFalse(
+          "inside",
+          clipper.isTriangleClipped(
+              glm::dvec2(0.02, 0.02),
+              glm::dvec2(0.08, 0.02),
+              glm::dvec2(0.05, 0.08)));
+      TestFalse(
+          "covering",
+          clipper.isTriangleClipped(
+              glm::dvec2(-1.0, -1.0),
+              glm::dvec2(1.0, -1.0),
+              glm::dvec2(0.0, 1.0)));
+    });
+  });
+
+  Describe("removeClippedTriangles", [this]() {
+    It("removes only the clipped triangles", [this]() {
+      CesiumPolygonClipper clipper(polygons, false, Ellipsoid::WGS84);
+
+      std::vector<glm::dvec3> positions;
+      for (const glm::dvec2& vertex : std::vector<glm::dvec2>{
+               glm::dvec2(0.02, 0.02),
+               glm::dvec2(0.08, 0.02),
+               glm::dvec2(0.05, 0.08),
+               glm::dvec2(0.2, 0.2),
+               glm::dvec2(0.3, 0.2),
+               glm::dvec2(0.25, 0.3)}) {
+        positions.emplace_back(Ellipsoid::WGS84.cartographicToCartesian(
+            Cartographic(vertex.x, vertex.y, 100.0)));
+      }
+
+      TArray<uint32> indices{0, 1, 2, 3, 4, 5};
+      TestEqual(
+          "removed",
+          clipper.removeClippedTriangles(indices, positions),
+          1);
+      TestTrue("indices", indices == TArray<uint32>{3, 4, 5});
+    });
+
+    It("skips primitives far from the polygons", [this]() {
+      std::vector<glm::dvec3> positions;
+      for (const glm::dvec2& vertex : std::vector<glm::dvec2>{
+               glm::dvec2(1.0, 0.5),
+               glm::dvec2(1.001, 0.5),
+               glm::dvec2(1.0, 0.501)}) {
+        positions.emplace_back(Ellipsoid::WGS84.cartographicToCartesian(
+            Cartographic(vertex.x, vertex.y, 100.0)));
+      }
+
+      CesiumPolygonClipper clipper(polygons, false, Ellipsoid::WGS84);
+      TArray<uint32> indices{0, 1, 2};
+      TestEqual(
+          "removed",
+          clipper.removeClippedTriangles(indices, positions),
+          0);
+      TestEqual("indices", indices.Num(), 3);
+
+      CesiumPolygonClipper inverted(polygons, true, Ellipsoid::WGS84);
+      TestEqual(
+          "removed when inverted",
+          inverted.removeClippedTriangles(indices, positions),
+          1);
+      TestTrue("no indices", indices.IsEmpty());
+    });
+  });
+
+  Describe("overlapsPolygons", [this]() {
+    It("compares rectangles to the polygon bounds", [this]() {
+      CesiumPolygonClipper clipper(polygons, false, Ellipsoid::WGS84);
+      TestTrue(
+          "overlapping",
+          clipper.overlapsPolygons(
+              glm::dvec2(0.05, 0.05),
+              glm::dvec2(0.2, 0.2)));
+      TestFalse(
+          "disjoint",
+          clipper.overlapsPolygons(
+              glm::dvec2(0.2, 0.2),
+              glm::dvec2(0.3, 0.3)));
+    });
+  });
+
+  Describe("operator==", [this]() {
+    It("compares the clipping", [this]() {
+      CesiumPolygonClipper clipper(polygons, false, Ellipsoid::WGS84);
+      TestTrue(
+          "same",
+          clipper == CesiumPolygonClipper(polygons, false, Ellipsoid::WGS84));
+      TestFalse(
+          "inverted",
+          clipper == CesiumPolygonClipper(polygons, true, Ellipsoid::WGS84));
+      TestFalse(
+          "no polygons",
+          clipper == CesiumPolygonClipper({}, false, Ellipsoid::WGS84));
+    });
+  });
+}
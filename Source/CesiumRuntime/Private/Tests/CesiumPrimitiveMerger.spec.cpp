@@ -0,0 +1,194 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumPrimitiveMerger.h"
+#include "CesiumGltf/AccessorView.h"
+#include "CesiumGltfSpecUtility.h"
+#include "Misc/AutomationTest.h"
+
+using namespace CesiumGltf;
+
+BEGIN_DEFINE_SPEC(
+    FCesiumPrimitiveMergerSpec,
+    "Cesium.Unit.PrimitiveMerger",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext |
+        EAutomationTestFlags::ServerContext |
+        EAutomationTestFlags::CommandletContext |
+        EAutomationTestFlags::ProductFilter)
+Model model;
+
+MeshPrimitive& AddTriangle(const std::vector<double>& translation);
+const MeshPrimitive* FindOnlyPrimitive();
+END_DEFINE_SPEC(FCesiumPrimitiveMergerSpec)
+
+MeshPrimitive& FCesiumPrimitiveMergerSpec::AddTriangle(
+    const std::vector<double>& translation) {
+  Node& node = model.nodes.emplace_back();
+  node.translation = translation;
+  node.mesh = static_cast<int32_t>(model.meshes.size());
+  model.scenes[0].nodes.push_back(
+      static_cast<int32_t>(model.nodes.size() - 1));
+
+  MeshPrimitive& primitive =
+      model.meshes.emplace_back().primitives.emplace_back();
+  primitive.material = 0;
+  CreateAttributeForPrimitive(
+      model,
+      primitive,
+      "POSITION",
+      AccessorSpec::Type::VEC3,
+      AccessorSpec::ComponentType::FLOAT,
+      std::vector<glm::vec3>{
+          glm::vec3(0.0f, 0.0f, 0.0f),
+          glm::vec3(1.0f, 0.0f, 0.0f),
+          glm::vec3(0.0f, 1.0f, 0.0f)});
+  return primitive;
+}
+
+const MeshPrimitive* FCesiumPrimitiveMergerSpec::FindOnlyPrimitive() {
+  const MeshPrimitive* pResult = nullptr;
+  int32_t count = 0;
+  model.forEachPrimitiveInScene(
+      0,
+      [&pResult, &count](
+          Model&,
+          Node&,
+          Mesh&,
+          MeshPrimitive& primitive,
+          const glm::dmat4&) {
+        pResult = &primitive;
+        ++count;
+      });
+  return count == 1 ? pResult : nullptr;
+}
+
+void FCesiumPrimitiveMergerSpec::Define() {
+  BeforeEach([this]() {
+    model = Model();
+    model.materials.emplace_back();
+    model.materials.emplace_back();
+    model.scenes.emplace_back();
+    model.scene = 0;
+  });
+
+  It("merges primitives that share a material", [this]() {
+    AddTriangle({0.0, 0.0, 0.0});
+    AddTriangle({10.0, 0.0, 0.0});
+
+    TestEqual("merged", CesiumPrimitiveMerger::mergePrimitives(model), 1);
+
+    const MeshPrimitive* pPrimitive = FindOnlyPrimitive();
+    if (!TestNotNull("primitive", pPrimitive)) {
+      return;
+    }
+
+    AccessorView<glm::vec3> positions(
+        model,
+        pPrimitive->attributes.at("POSITION"));
+    AccessorView<uint32_t> indices(model, pPrimitive->indices);
+    TestEqual("vertices", positions.size(), int64_t(6));
+    TestEqual("indices", indices.size(), int64_t(6));
+    TestEqual("second triangle moved", positions[4].x, 11.0f);
+    TestEqual("last index", int32(indices[5]), 5);
+  });
+
+  It("places the merged primitive at the first primitive's node", [this]() {
+    AddTriangle({5.0, 0.0, 0.0});
+    AddTriangle({15.0, 0.0, 0.0});
+    CesiumPrimitiveMerger::mergePrimitives(model);
+
+    glm::dmat4 nodeTransform(1.0);
+    const MeshPrimitive* pPrimitive = nullptr;
+    model.forEachPrimitiveInScene(
+        0,
+        [&nodeTransform, &pPrimitive](
+            Model&,
+            Node&,
+            Mesh&,
+            MeshPrimitive& primitive,
+            const glm::dmat4& transform) {
+          nodeTransform = transform;
+          pPrimitive = &primitive;
+        });
+    if (!TestNotNull("primitive", pPrimitive)) {
+      return;
+    }
+
+    AccessorView<glm::vec3> positions(
+        model,
+        pPrimitive->attributes.at("POSITION"));
+    TestEqual("node translation", nodeTransform[3].x, 5.0);
+    TestEqual("first triangle", positions[1].x, 1.0f);
+    TestEqual("second triangle", positions[4].x, 11.0f);
+  });
+
+  It("drops the data that only the merged primitives used", [this]() {
+    AddTriangle({0.0, 0.0, 0.0});
+    AddTriangle({10.0, 0.0, 0.0});
+    CesiumPrimitiveMerger::mergePrimitives(model);
+
+    // Only the merged positions and indices remain.
+    TestEqual("meshes", model.meshes.size(), size_t(1));
+    TestEqual("accessors", model.accessors.size(), size_t(2));
+    TestEqual("buffer views", model.bufferViews.size(), size_t(2));
+    TestEqual("buffers", model.buffers.size(), size_t(1));
+  });
+
+  It("keeps the feature IDs of every vertex", [this]() {
+    AddFeatureIDsAsAttributeToModel(
+        model,
+        AddTriangle({0.0, 0.0, 0.0}),
+        {0, 0, 1},
+        2,
+        0);
+    AddFeatureIDsAsAttributeToModel(
+        model,
+        AddTriangle({0.0, 5.0, 0.0}),
+        {2, 3, 3},
+        2,
+        0);
+
+    TestEqual("merged", CesiumPrimitiveMerger::mergePrimitives(model), 1);
+
+    const MeshPrimitive* pPrimitive = FindOnlyPrimitive();
+    if (!TestNotNull("primitive", pPrimitive)) {
+      return;
+    }
+
+    AccessorView<uint8_t> featureIDs(
+        model,
+        pPrimitive->attributes.at("_FEATURE_ID_0"));
+    const std::vector<uint8_t> expected{0, 0, 1, 2, 3, 3};
+    TestEqual("count", featureIDs.size(), int64_t(expected.size()));
+    for (int64_t i = 0; i < featureIDs.size(); ++i) {
+      TestEqual("feature ID", int32(featureIDs[i]), int32(expected[i]));
+    }
+
+    const ExtensionExtMeshFeatures* pFeatures =
+        pPrimitive->getExtension<ExtensionExtMeshFeatures>();
+    if (TestNotNull("features", pFeatures)) {
+      TestEqual(
+          "featureCount",
+          pFeatures->featureIds[0].featureCount,
+          int64_t(4));
+    }
+  });
+
+  It("does not merge primitives with different materials", [this]() {
+    AddTriangle({0.0, 0.0, 0.0});
+    AddTriangle({10.0, 0.0, 0.0}).material = 1;
+
+    TestEqual("merged", CesiumPrimitiveMerger::mergePrimitives(model), 0);
+    TestEqual("nodes", int32(model.scenes[0].nodes.size()), 2);
+  });
+
+  It("does not merge primitives with implicit feature IDs", [this]() {
+    for (int i = 0; i < 2; ++i) {
+      MeshPrimitive& primitive = AddTriangle({0.0, 0.0, 0.0});
+      primitive.addExtension<ExtensionExtMeshFeatures>()
+          .featureIds.emplace_back()
+          .featureCount = 3;
+    }
+
+    TestEqual("merged", CesiumPrimitiveMerger::mergePrimitives(model), 0);
+  });
+}
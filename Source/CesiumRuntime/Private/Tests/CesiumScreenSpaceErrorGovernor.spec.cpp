@@ -0,0 +1,63 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumScreenSpaceErrorGovernor.h"
+#include "Misc/AutomationTest.h"
+
+BEGIN_DEFINE_SPEC(
+    FCesiumScreenSpaceErrorGovernorSpec,
+    "Cesium.Unit.ScreenSpaceErrorGovernor",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext |
+        EAutomationTestFlags::ServerContext |
+        EAutomationTestFlags::CommandletContext |
+        EAutomationTestFlags::ProductFilter)
+CesiumScreenSpaceErrorGovernorTargets targets;
+END_DEFINE_SPEC(FCesiumScreenSpaceErrorGovernorSpec)
+
+void FCesiumScreenSpaceErrorGovernorSpec::Define() {
+  BeforeEach([this]() {
+    targets = CesiumScreenSpaceErrorGovernorTargets();
+    targets.frameTimeMilliseconds = 10.0;
+    targets.memoryBytes = 1000;
+    targets.maximumScale = 2.0;
+    targets.adjustTileLoads = true;
+  });
+
+  It("raises the screen-space error up to its maximum while over budget",
+     [this]() {
+       CesiumScreenSpaceErrorGovernor governor;
+       for (int32 i = 0; i < 100; ++i) {
+         governor.update(targets, 20.0, 500, 0, 0.1);
+       }
+
+       const FCesiumAdaptiveScreenSpaceErrorState& state = governor.getState();
+       TestEqual("scale", state.ScreenSpaceErrorScale, 2.0);
+       TestEqual(
+           "tile loads",
+           state.TileLoadScale,
+           CesiumScreenSpaceErrorGovernor::MinimumTileLoadScale);
+       TestEqual(
+           "limit",
+           state.LimitingFactor,
+           ECesiumAdaptiveScreenSpaceErrorLimit::FrameTime);
+     });
+
+  It("holds the screen-space error within the hysteresis band", [this]() {
+    CesiumScreenSpaceErrorGovernor governor;
+    governor.update(targets, 5.0, 2000, 0, 1.0);
+    const double raised = governor.getScreenSpaceErrorScale();
+    TestTrue("raised", raised > 1.0);
+    TestEqual(
+        "limit",
+        governor.getState().LimitingFactor,
+        ECesiumAdaptiveScreenSpaceErrorLimit::Memory);
+
+    governor.update(targets, 5.0, 1050, 0, 1.0);
+    TestEqual("held", governor.getScreenSpaceErrorScale(), raised);
+
+    for (int32 i = 0; i < 20; ++i) {
+      governor.update(targets, 5.0, 500, 0, 1.0);
+    }
+    TestEqual("restored", governor.getScreenSpaceErrorScale(), 1.0);
+    TestEqual("tile loads", governor.getTileLoadScale(), 1.0);
+  });
+}
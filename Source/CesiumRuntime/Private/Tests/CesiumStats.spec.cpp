@@ -0,0 +1,51 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumStats.h"
+#include "Misc/AutomationTest.h"
+
+BEGIN_DEFINE_SPEC(
+    FCesiumStatsSpec,
+    "Cesium.Unit.Stats",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext |
+        EAutomationTestFlags::ServerContext |
+        EAutomationTestFlags::CommandletContext |
+        EAutomationTestFlags::ProductFilter)
+END_DEFINE_SPEC(FCesiumStatsSpec)
+
+void FCesiumStatsSpec::Define() {
+  Describe("takeNetworkRequestEnd", [this]() {
+    It("returns the end of a traced request only once", [this]() {
+      const std::string url = "https://example.com/Cesium.Unit.Stats/0.glb";
+      CesiumTrace::traceNetworkRequest(url, 5, 10, 20);
+
+      std::optional<uint64> end = CesiumTrace::takeNetworkRequestEnd(url);
+      TestTrue("has end", end.has_value());
+      TestEqual("end", end.value_or(0), uint64(20));
+      TestFalse("taken", CesiumTrace::takeNetworkRequestEnd(url).has_value());
+    });
+
+    It("knows nothing of requests that were not traced", [this]() {
+      TestFalse(
+          "has end",
+          CesiumTrace::takeNetworkRequestEnd(
+              "https://example.com/Cesium.Unit.Stats/untraced.glb")
+              .has_value());
+    });
+  });
+
+  Describe("getCacheHits", [this]() {
+    It("counts cached responses that were not revalidated", [this]() {
+      const int64 before = CesiumStats::getCacheHits();
+      CesiumStats::recordCachedResponse();
+      CesiumStats::recordCachedResponse();
+      CesiumStats::recordRevalidation();
+      TestEqual("hits", CesiumStats::getCacheHits() - before, int64(1));
+    });
+  });
+
+  Describe("getRenderDataBytes", [this]() {
+    It("is zero without render data", [this]() {
+      TestEqual("bytes", CesiumStats::getRenderDataBytes(nullptr), int64(0));
+    });
+  });
+}
@@ -0,0 +1,256 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumStyle.h"
+#include "CesiumFeaturesMetadataComponent.h"
+#include "Misc/AutomationTest.h"
+
+BEGIN_DEFINE_SPEC(
+    FCesiumStyleSpec,
+    "Cesium.Unit.Style",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext |
+        EAutomationTestFlags::ServerContext |
+        EAutomationTestFlags::CommandletContext |
+        EAutomationTestFlags::ProductFilter)
+CesiumStyle::VariableResolver resolver;
+const std::vector<CesiumStyle::ProgramProperty> heightProperty{
+    CesiumStyle::ProgramProperty{"height", false}};
+END_DEFINE_SPEC(FCesiumStyleSpec)
+
+void FCesiumStyleSpec::Define() {
+  BeforeEach([this]() {
+    resolver = [](const std::string& name) -> CesiumStyle::Value {
+      if (name == "height") {
+        return 150.0;
+      }
+      if (name == "type") {
+        return std::string("tree");
+      }
+      return CesiumStyle::Undefined();
+    };
+  });
+
+  Describe("Expression", [this]() {
+    It("evaluates operators with JavaScript precedence", [this]() {
+      std::string error;
+      std::optional<CesiumStyle::Expression> maybeExpression =
+          CesiumStyle::Expression::parse(
+              "1 + 2 * 3 === 7 && !(${height} < 100) ? 'tall' : 'short'",
+              error);
+      TestTrue("parsed", maybeExpression.has_value());
+      if (!maybeExpression) {
+        return;
+      }
+
+      CesiumStyle::Value value = maybeExpression->evaluate(resolver);
+      TestTrue("string", std::holds_alternative<std::string>(value));
+      if (std::holds_alternative<std::string>(value)) {
+        TestEqual(
+            "value",
+            FString(UTF8_TO_TCHAR(std::get<std::string>(value).c_str())),
+            FString(TEXT("tall")));
+      }
+      TestEqual(
+          "variables",
+          maybeExpression->getVariableNames().size(),
+          size_t(1));
+    });
+
+    It("treats missing properties as undefined", [this]() {
+      std::string error;
+      std::optional<CesiumStyle::Expression> maybeExpression =
+          CesiumStyle::Expression::parse("${feature['missing']} > 1", error);
+      TestTrue("parsed", maybeExpression.has_value());
+      if (!maybeExpression) {
+        return;
+      }
+      TestEqual(
+          "variable",
+          FString(UTF8_TO_TCHAR(
+              maybeExpression->getVariableNames()[0].c_str())),
+          FString(TEXT("missing")));
+      TestFalse(
+          "comparison",
+          CesiumStyle::toBoolean(maybeExpression->evaluate(resolver)));
+    });
+
+    It("reports syntax errors", [this]() {
+      std::string error;
+      TestFalse(
+          "unknown function",
+          CesiumStyle::Expression::parse("foo(1)", error).has_value());
+      TestFalse("error", error.empty());
+
+      error.clear();
+      TestFalse(
+          "unbalanced",
+          CesiumStyle::Expression::parse("(1 + 2", error).has_value());
+      TestFalse("error", error.empty());
+    });
+  });
+
+  Describe("Style", [this]() {
+    It("evaluates defines, show, and color conditions", [this]() {
+      FString error;
+      std::optional<CesiumStyle::Style> maybeStyle =
+          CesiumStyle::Style::parse(
+              TEXT("{"
+                   "\"defines\": {\"tall\": \"${height} > 100\"},"
+                   "\"show\": \"${type} !== 'rock'\","
+                   "\"color\": {\"conditions\": ["
+                   "[\"${tall}\", \"color('#ff0000', 0.5)\"],"
+                   "[\"true\", \"rgb(0, 0, 255)\"]]}"
+                   "}"),
+              error);
+      TestTrue("parsed", maybeStyle.has_value());
+      if (!maybeStyle) {
+        return;
+      }
+
+      TestEqual(
+          "properties",
+          maybeStyle->getPropertyNames().size(),
+          size_t(2));
+
+      glm::dvec4 color = maybeStyle->evaluate(resolver);
+      TestEqual("red", color.x, 1.0);
+      TestEqual("green", color.y, 0.0);
+      TestEqual("alpha", color.w, 0.5);
+    });
+
+    It("hides features whose show is false", [this]() {
+      FString error;
+      std::optional<CesiumStyle::Style> maybeStyle = CesiumStyle::Style::parse(
+          TEXT("{\"show\": \"${type} !== 'tree'\"}"),
+          error);
+      TestTrue("parsed", maybeStyle.has_value());
+      if (maybeStyle) {
+        TestEqual("alpha", maybeStyle->evaluate(resolver).w, 0.0);
+      }
+    });
+
+    It("rejects a color that is not an expression", [this]() {
+      FString error;
+      std::optional<CesiumStyle::Style> maybeStyle = CesiumStyle::Style::parse(
+          TEXT("{\"show\": \"${type} === 'tree'\", \"color\": [1]}"),
+          error);
+      TestFalse("parsed", maybeStyle.has_value());
+      TestFalse("error", error.IsEmpty());
+    });
+  });
+
+  Describe("Program", [this]() {
+    It("compiles a style that only reads numbers", [this]() {
+      FString error;
+      std::optional<CesiumStyle::Style> maybeStyle = CesiumStyle::Style::parse(
+          TEXT("{\"show\": \"${height} > 100\","
+               "\"color\": \"color('#ff0000', 0.5)\"}"),
+          error);
+      TestTrue("parsed", maybeStyle.has_value());
+      if (!maybeStyle) {
+        return;
+      }
+
+      std::optional<std::vector<glm::vec4>> maybeProgram =
+          maybeStyle->compileProgram(heightProperty);
+      TestTrue("compiled", maybeProgram.has_value());
+      if (maybeProgram) {
+        TestFalse("empty", maybeProgram->empty());
+        TestEqual(
+            "end",
+            maybeProgram->back().x,
+            float(CesiumStyle::Opcode::End));
+      }
+    });
+
+    It("does not compile strings or unknown properties", [this]() {
+      FString error;
+      std::optional<CesiumStyle::Style> maybeStyle = CesiumStyle::Style::parse(
+          TEXT("{\"show\": \"${type} === 'tree'\"}"),
+          error);
+      TestTrue("parsed", maybeStyle.has_value());
+      if (maybeStyle) {
+        TestFalse(
+            "string",
+            maybeStyle
+                ->compileProgram({CesiumStyle::ProgramProperty{"type", false}})
+                .has_value());
+      }
+
+      maybeStyle = CesiumStyle::Style::parse(
+          TEXT("{\"show\": \"${missing} > 1\"}"),
+          error);
+      TestTrue("parsed", maybeStyle.has_value());
+      if (maybeStyle) {
+        TestFalse(
+            "unknown property",
+            maybeStyle->compileProgram(heightProperty).has_value());
+      }
+    });
+
+    It("keeps the stack shallow for many conditions", [this]() {
+      FString conditions;
+      for (int32 i = 0; i < 2 * CesiumStyle::MaximumProgramStackDepth; ++i) {
+        conditions += FString::Printf(
+            TEXT("[\"${height} > %d\", \"rgb(%d, 0, 0)\"],"),
+            i,
+            i);
+      }
+      conditions += TEXT("[\"true\", \"rgb(0, 0, 255)\"]");
+
+      FString error;
+      std::optional<CesiumStyle::Style> maybeStyle = CesiumStyle::Style::parse(
+          TEXT("{\"color\": {\"conditions\": [") + conditions + TEXT("]}}"),
+          error);
+      TestTrue("parsed", maybeStyle.has_value());
+      if (maybeStyle) {
+        TestTrue(
+            "compiled",
+            maybeStyle->compileProgram(heightProperty).has_value());
+      }
+    });
+
+    It("only reads plain scalar and boolean properties", [this]() {
+      FCesiumPropertyTableDescription propertyTable;
+      propertyTable.Name = TEXT("buildings");
+
+      FCesiumPropertyTablePropertyDescription& height =
+          propertyTable.Properties.Emplace_GetRef();
+      height.Name = TEXT("height");
+      height.PropertyDetails.Type = ECesiumMetadataType::Scalar;
+      height.PropertyDetails.ComponentType =
+          ECesiumMetadataComponentType::Float32;
+      height.EncodingDetails.Type = ECesiumEncodedMetadataType::Scalar;
+      height.EncodingDetails.ComponentType =
+          ECesiumEncodedMetadataComponentType::Float;
+      height.EncodingDetails.Conversion =
+          ECesiumEncodedMetadataConversion::Coerce;
+
+      FCesiumPropertyTablePropertyDescription& scaled =
+          propertyTable.Properties.Add_GetRef(height);
+      scaled.Name = TEXT("scaled");
+      scaled.PropertyDetails.bHasScale = true;
+
+      FCesiumPropertyTablePropertyDescription& unencoded =
+          propertyTable.Properties.Add_GetRef(height);
+      unencoded.Name = TEXT("unencoded");
+      unencoded.EncodingDetails.Conversion =
+          ECesiumEncodedMetadataConversion::None;
+
+      FCesiumPropertyTablePropertyDescription& tall =
+          propertyTable.Properties.Add_GetRef(height);
+      tall.Name = TEXT("tall");
+      tall.PropertyDetails.Type = ECesiumMetadataType::Boolean;
+      tall.PropertyDetails.ComponentType = ECesiumMetadataComponentType::None;
+
+      std::vector<CesiumStyle::ProgramProperty> properties =
+          CesiumStyle::getProgramProperties(propertyTable);
+      TestEqual("count", properties.size(), size_t(2));
+      if (properties.size() == 2) {
+        TestTrue("height", properties[0].name == "height");
+        TestFalse("height is boolean", properties[0].isBoolean);
+        TestTrue("tall", properties[1].name == "tall");
+        TestTrue("tall is boolean", properties[1].isBoolean);
+      }
+    });
+  });
+}
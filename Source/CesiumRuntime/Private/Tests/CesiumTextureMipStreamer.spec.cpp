@@ -0,0 +1,89 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumTextureMipStreamer.h"
+#include "Misc/AutomationTest.h"
+
+BEGIN_DEFINE_SPEC(
+    FCesiumTextureMipStreamerSpec,
+    "Cesium.Unit.TextureMipStreamer",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext |
+        EAutomationTestFlags::ServerContext |
+        EAutomationTestFlags::CommandletContext |
+        EAutomationTestFlags::ProductFilter)
+END_DEFINE_SPEC(FCesiumTextureMipStreamerSpec)
+
+void FCesiumTextureMipStreamerSpec::Define() {
+  Describe("computeFirstResidentMip", [this]() {
+    It("keeps all mips of textures that cover enough pixels", [this]() {
+      TestEqual(
+          "first mip",
+          CesiumTextureMipStreamer::computeFirstResidentMip(
+              1024,
+              1024,
+              11,
+              2000.0),
+          0u);
+    });
+
+    It("drops the mips that are more detailed than the screen", [this]() {
+      TestEqual(
+          "first mip",
+          CesiumTextureMipStreamer::computeFirstResidentMip(
+              1024,
+              512,
+              11,
+              256.0),
+          2u);
+    });
+
+    It("never drops below the minimum resident size", [this]() {
+      TestEqual(
+          "first mip",
+          CesiumTextureMipStreamer::computeFirstResidentMip(
+              1024,
+              1024,
+              11,
+              1.0),
+          4u);
+      TestEqual(
+          "first mip of a small texture",
+          CesiumTextureMipStreamer::computeFirstResidentMip(64, 64, 7, 1.0),
+          0u);
+    });
+  });
+
+  Describe("computeScreenPixels", [this]() {
+    It("shrinks with distance", [this]() {
+      FCesiumCamera camera(
+          FVector2D(1000.0, 500.0),
+          FVector::ZeroVector,
+          FRotator::ZeroRotator,
+          90.0);
+      std::vector<FCesiumCamera> cameras{camera};
+
+      const double near = CesiumTextureMipStreamer::computeScreenPixels(
+          FBoxSphereBounds(FVector(200.0, 0.0, 0.0), FVector(10.0), 100.0),
+          cameras);
+      const double far = CesiumTextureMipStreamer::computeScreenPixels(
+          FBoxSphereBounds(FVector(1100.0, 0.0, 0.0), FVector(10.0), 100.0),
+          cameras);
+
+      TestEqual("near", near, 1000.0, 1e-6);
+      TestEqual("far", far, 100.0, 1e-6);
+    });
+
+    It("is infinite inside the bounds", [this]() {
+      std::vector<FCesiumCamera> cameras{FCesiumCamera(
+          FVector2D(1000.0, 500.0),
+          FVector::ZeroVector,
+          FRotator::ZeroRotator,
+          90.0)};
+
+      TestTrue(
+          "infinite",
+          FMath::IsFinite(CesiumTextureMipStreamer::computeScreenPixels(
+              FBoxSphereBounds(FVector::ZeroVector, FVector(10.0), 100.0),
+              cameras)) == false);
+    });
+  });
+}
@@ -227,6 +227,39 @@ void CesiumTextureUtilitySpec::RunTests() {
     CheckGroup(pRefCountedTexture, TextureGroup::TEXTUREGROUP_World);
   });
 
+  It("Metadata and color resources of one image", [this]() {
+    const ExtensionImageAssetUnrealMetadata& metadata =
+        ExtensionImageAssetUnrealMetadata::getOrCreate(
+            CesiumAsync::AsyncSystem(nullptr),
+            *pImageAsset);
+    TestTrue("metadata ready", metadata.getFuture().isReady());
+    TestFalse("pixels kept", pImageAsset->pixelData.empty());
+
+    const ExtensionImageAssetUnreal& color =
+        ExtensionImageAssetUnreal::getOrCreate(
+            CesiumAsync::AsyncSystem(nullptr),
+            *pImageAsset,
+            true,
+            false,
+            std::nullopt);
+    const FCesiumTextureResource* pMetadataResource =
+        metadata.getTextureResource().Get();
+    const FCesiumTextureResource* pColorResource =
+        color.getTextureResource().Get();
+    if (!TestNotNull("metadata resource", pMetadataResource) ||
+        !TestNotNull("color resource", pColorResource)) {
+      return;
+    }
+
+    TestTrue("separate resources", pMetadataResource != pColorResource);
+    TestTrue(
+        "metadata format",
+        pMetadataResource->GetPixelFormat() == EPixelFormat::PF_R8G8B8A8_UINT);
+    TestTrue(
+        "color format",
+        pColorResource->GetPixelFormat() != EPixelFormat::PF_R8G8B8A8_UINT);
+  });
+
   It("Two textures referencing one image", [this]() {
     CesiumGltf::Model model;
 
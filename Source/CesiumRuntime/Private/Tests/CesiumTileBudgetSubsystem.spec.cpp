@@ -0,0 +1,88 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumTileBudgetSubsystem.h"
+#include "Cesium3DTileset.h"
+#include "CesiumRuntimeSettings.h"
+#include "CesiumTestHelpers.h"
+#include "Engine/World.h"
+#include "Misc/AutomationTest.h"
+
+BEGIN_DEFINE_SPEC(
+    FCesiumTileBudgetSubsystemSpec,
+    "Cesium.Unit.TileBudgetSubsystem",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext |
+        EAutomationTestFlags::ServerContext |
+        EAutomationTestFlags::CommandletContext |
+        EAutomationTestFlags::ProductFilter)
+TObjectPtr<UCesiumTileBudgetSubsystem> pBudget;
+TObjectPtr<ACesium3DTileset> pIdle;
+TObjectPtr<ACesium3DTileset> pBusy;
+END_DEFINE_SPEC(FCesiumTileBudgetSubsystemSpec)
+
+void FCesiumTileBudgetSubsystemSpec::Define() {
+  BeforeEach([this]() {
+    UWorld* pWorld = CesiumTestHelpers::getGlobalWorldContext();
+    pBudget = NewObject<UCesiumTileBudgetSubsystem>();
+    pIdle = pWorld->SpawnActor<ACesium3DTileset>();
+    pBusy = pWorld->SpawnActor<ACesium3DTileset>();
+  });
+
+  AfterEach([this]() {
+    pIdle->Destroy();
+    pBusy->Destroy();
+  });
+
+  It("allocates more of the budget to the tileset with more tiles waiting",
+     [this]() {
+       pBudget->reportTilesetUsage(pIdle, 100, 0, 1);
+       pBudget->reportTilesetUsage(pBusy, 100, 6, 1);
+
+       const FCesiumTilesetBudgetUsage* pIdleUsage =
+           pBudget->getTilesetAllocation(pIdle, 2);
+       const FCesiumTilesetBudgetUsage* pBusyUsage =
+           pBudget->getTilesetAllocation(pBusy, 2);
+       TestNotNull("idle", pIdleUsage);
+       TestNotNull("busy", pBusyUsage);
+       if (!pIdleUsage || !pBusyUsage) {
+         return;
+       }
+
+       // A quarter is divided evenly, the rest by demand (1 and 7 of 8).
+       TestEqual("idle share", pIdleUsage->Share, 0.21875f);
+       TestEqual("busy share", pBusyUsage->Share, 0.78125f);
+
+       const UCesiumRuntimeSettings* pSettings =
+           GetDefault<UCesiumRuntimeSettings>();
+       TestEqual(
+           "total bytes",
+           double(pIdleUsage->AllocatedBytes + pBusyUsage->AllocatedBytes),
+           double(pSettings->WorldMaximumCachedBytes),
+           2.0);
+       TestTrue("idle loads", pIdleUsage->AllocatedTileLoads >= 1);
+     });
+
+  It("gives a removed tileset's share to the others", [this]() {
+    pBudget->reportTilesetUsage(pIdle, 100, 0, 1);
+    pBudget->reportTilesetUsage(pBusy, 100, 6, 1);
+    pBudget->removeTileset(pBusy);
+
+    TestNull("busy", pBudget->getTilesetAllocation(pBusy, 2));
+    const FCesiumTilesetBudgetUsage* pIdleUsage =
+        pBudget->getTilesetAllocation(pIdle, 2);
+    TestNotNull("idle", pIdleUsage);
+    if (pIdleUsage) {
+      TestEqual("idle share", pIdleUsage->Share, 1.0f);
+    }
+    TestEqual("tileset count", pBudget->getTilesetCount(), 1);
+  });
+
+  It("drops tilesets that stop reporting their usage", [this]() {
+    pBudget->reportTilesetUsage(pIdle, 100, 0, 1);
+    pBudget->reportTilesetUsage(pBusy, 100, 6, 1);
+    pBudget->reportTilesetUsage(pIdle, 100, 0, 100);
+
+    TestNull("busy", pBudget->getTilesetAllocation(pBusy, 100));
+    TestNotNull("idle", pBudget->getTilesetAllocation(pIdle, 100));
+    TestEqual("tileset count", pBudget->getTilesetCount(), 1);
+  });
+}
@@ -0,0 +1,98 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumTileObjectPool.h"
+#include "CesiumGltfPrimitiveComponent.h"
+#include "Materials/Material.h"
+#include "Materials/MaterialInstanceDynamic.h"
+#include "Misc/AutomationTest.h"
+
+BEGIN_DEFINE_SPEC(
+    FCesiumTileObjectPoolSpec,
+    "Cesium.Unit.TileObjectPool",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext |
+        EAutomationTestFlags::ServerContext |
+        EAutomationTestFlags::CommandletContext |
+        EAutomationTestFlags::ProductFilter)
+TObjectPtr<UCesiumTileObjectPool> pPool;
+TObjectPtr<UMaterialInterface> pParent;
+END_DEFINE_SPEC(FCesiumTileObjectPoolSpec)
+
+void FCesiumTileObjectPoolSpec::Define() {
+  BeforeEach([this]() {
+    pPool = NewObject<UCesiumTileObjectPool>();
+    pParent = UMaterial::GetDefaultMaterial(EMaterialDomain::MD_Surface);
+  });
+
+  Describe("Materials", [this]() {
+    It("returns nothing from an empty pool", [this]() {
+      TestNull("acquired", pPool->acquireMaterial(pParent));
+    });
+
+    It("reuses a released material with the same parent", [this]() {
+      UMaterialInstanceDynamic* pMaterial =
+          UMaterialInstanceDynamic::Create(pParent, nullptr);
+      TestTrue("released", pPool->releaseMaterial(pMaterial));
+      TestEqual("pooled count", pPool->getPooledMaterialCount(), 1);
+
+      TestEqual("acquired", pPool->acquireMaterial(pParent), pMaterial);
+      TestEqual("pooled count", pPool->getPooledMaterialCount(), 0);
+      TestEqual("materialsReused", pPool->getStats().materialsReused, 1LL);
+    });
+
+    It("does not reuse a material with a different parent", [this]() {
+      UMaterialInstanceDynamic* pMaterial =
+          UMaterialInstanceDynamic::Create(pParent, nullptr);
+      pPool->releaseMaterial(pMaterial);
+
+      UMaterialInterface* pOtherParent =
+          UMaterial::GetDefaultMaterial(EMaterialDomain::MD_DeferredDecal);
+      TestNull("acquired", pPool->acquireMaterial(pOtherParent));
+      TestEqual("pooled count", pPool->getPooledMaterialCount(), 1);
+    });
+
+    It("stops accepting materials at capacity", [this]() {
+      const int32 capacity = pPool->getComponentCapacity();
+      TestEqual("capacity", capacity, UCesiumTileObjectPool::MinimumCapacity);
+
+      for (int32 i = 0; i < capacity; ++i) {
+        pPool->releaseMaterial(
+            UMaterialInstanceDynamic::Create(pParent, nullptr));
+      }
+
+      TestFalse(
+          "released beyond capacity",
+          pPool->releaseMaterial(
+              UMaterialInstanceDynamic::Create(pParent, nullptr)));
+      TestEqual("pooled count", pPool->getPooledMaterialCount(), capacity);
+    });
+  });
+
+  Describe("Components", [this]() {
+    It("reuses a released component of the same class", [this]() {
+      UCesiumGltfPrimitiveComponent* pComponent =
+          NewObject<UCesiumGltfPrimitiveComponent>(pPool);
+      pPool->recordComponentCreated();
+      TestTrue("released", pPool->releaseComponent(pComponent));
+
+      TestNull(
+          "acquired instanced",
+          pPool->acquireComponent(
+              UCesiumGltfInstancedComponent::StaticClass(),
+              pPool,
+              NAME_None));
+
+      UStaticMeshComponent* pAcquired = pPool->acquireComponent(
+          UCesiumGltfPrimitiveComponent::StaticClass(),
+          pPool,
+          NAME_None);
+      TestEqual(
+          "acquired",
+          pAcquired,
+          static_cast<UStaticMeshComponent*>(pComponent));
+      TestEqual(
+          "reuse rate",
+          pPool->getStats().getComponentReuseRate(),
+          0.5);
+    });
+  });
+}
@@ -0,0 +1,66 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumTilesetMemory.h"
+#include "CesiumPrimitive.h"
+#include "Misc/AutomationTest.h"
+
+BEGIN_DEFINE_SPEC(
+    FCesiumTilesetMemorySpec,
+    "Cesium.Unit.TilesetMemory",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext |
+        EAutomationTestFlags::ServerContext |
+        EAutomationTestFlags::CommandletContext |
+        EAutomationTestFlags::ProductFilter)
+END_DEFINE_SPEC(FCesiumTilesetMemorySpec)
+
+void FCesiumTilesetMemorySpec::Define() {
+  Describe("CesiumTilesetMemoryAccumulator", [this]() {
+    It("adds the meshes of each primitive", [this]() {
+      CesiumPrimitiveData first;
+      first.MeshBytes = 100;
+      first.PhysicsBytes = 10;
+      CesiumPrimitiveData second;
+      second.MeshBytes = 200;
+
+      FCesiumTilesetMemoryReport report;
+      CesiumTilesetMemoryAccumulator accumulator(report);
+      accumulator.addPrimitive(first);
+      accumulator.addPrimitive(second);
+      accumulator.finish();
+
+      TestEqual("mesh", report.MeshBytes, int64(300));
+      TestEqual("physics", report.PhysicsBytes, int64(10));
+      TestTrue("primitive data", report.PrimitiveDataBytes > 0);
+      TestEqual(
+          "total",
+          report.TotalBytes,
+          int64(310) + report.PrimitiveDataBytes);
+    });
+
+    It("counts a shared mesh once", [this]() {
+      TSharedPtr<CesiumSharedMesh> pSharedMesh =
+          MakeShared<CesiumSharedMesh>();
+      pSharedMesh->MeshBytes = 1000;
+      pSharedMesh->PhysicsBytes = 500;
+
+      CesiumPrimitiveData first;
+      first.pSharedMesh = pSharedMesh;
+      CesiumPrimitiveData second;
+      second.pSharedMesh = pSharedMesh;
+
+      FCesiumTilesetMemoryReport report;
+      report.ModelBytes = 42;
+      CesiumTilesetMemoryAccumulator accumulator(report);
+      accumulator.addPrimitive(first);
+      accumulator.addPrimitive(second);
+      accumulator.finish();
+
+      TestEqual("mesh", report.MeshBytes, int64(1000));
+      TestEqual("physics", report.PhysicsBytes, int64(500));
+      TestEqual(
+          "unreal",
+          report.GetUnrealBytes(),
+          int64(1500) + report.PrimitiveDataBytes);
+    });
+  });
+}
@@ -0,0 +1,129 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumViewSubsystem.h"
+#include "CesiumTestHelpers.h"
+#include "Components/SceneCaptureComponent2D.h"
+#include "Engine/TextureRenderTarget2D.h"
+#include "Engine/World.h"
+#include "Misc/AutomationTest.h"
+
+BEGIN_DEFINE_SPEC(
+    FCesiumViewSubsystemSpec,
+    "Cesium.Unit.ViewSubsystem",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext |
+        EAutomationTestFlags::ServerContext |
+        EAutomationTestFlags::CommandletContext |
+        EAutomationTestFlags::ProductFilter)
+END_DEFINE_SPEC(FCesiumViewSubsystemSpec)
+
+void FCesiumViewSubsystemSpec::Define() {
+  Describe("CesiumCollectedView", [this]() {
+    It("excludes black bars from the viewport size", [this]() {
+      FCesiumCamera camera(
+          FVector2D(2000.0, 1000.0),
+          FVector::ZeroVector,
+          FRotator::ZeroRotator,
+          90.0,
+          1.0);
+      CesiumCollectedView view = CesiumCollectedView::fromCamera(camera);
+      TestEqual("width", view.viewportSize.x, 1000.0);
+      TestEqual("height", view.viewportSize.y, 1000.0);
+      TestEqual(
+          "vertical field of view",
+          view.verticalFieldOfView,
+          view.horizontalFieldOfView);
+    });
+
+    It("uses the camera's rotation for its directions", [this]() {
+      FCesiumCamera camera(
+          FVector2D(100.0, 100.0),
+          FVector(1.0, 2.0, 3.0),
+          FRotator(0.0, 90.0, 0.0),
+          60.0);
+      CesiumCollectedView view = CesiumCollectedView::fromCamera(camera);
+      TestEqual("location", view.location.y, 2.0);
+      TestEqual("direction x", view.direction.x, 0.0, 1e-6);
+      TestEqual("direction y", view.direction.y, 1.0, 1e-6);
+      TestEqual("up z", view.up.z, 1.0, 1e-6);
+    });
+  });
+
+  Describe("appendFoveatedCameras", [this]() {
+    It("relaxes the periphery and keeps detail toward the gaze", [this]() {
+      FCesiumCamera camera(
+          FVector2D(1000.0, 1000.0),
+          FVector::ZeroVector,
+          FRotator::ZeroRotator,
+          90.0);
+      FRotator gaze(0.0, 20.0, 0.0);
+
+      TArray<FCesiumFoveationRing> rings;
+      FCesiumFoveationRing& fovea = rings.Emplace_GetRef();
+      fovea.Angle = 15.0;
+      fovea.ScreenSpaceErrorScale = 1.0;
+      FCesiumFoveationRing& outer = rings.Emplace_GetRef();
+      outer.Angle = 60.0;
+      outer.ScreenSpaceErrorScale = 2.0;
+
+      std::vector<FCesiumCamera> cameras;
+      UCesiumViewSubsystem::appendFoveatedCameras(
+          camera,
+          gaze,
+          rings,
+          4.0,
+          cameras);
+      TestEqual("count", cameras.size(), size_t(3));
+      if (cameras.size() != 3) {
+        return;
+      }
+
+      TestEqual("peripheral size", cameras[0].ViewportSize.X, 250.0, 1e-6);
+      TestEqual("peripheral rotation", cameras[0].Rotation, camera.Rotation);
+
+      // 500 pixels per unit tangent, over 2 * tan(15 degrees).
+      TestEqual("fovea size", cameras[1].ViewportSize.X, 267.949, 1e-3);
+      TestEqual("fovea field of view", cameras[1].FieldOfViewDegrees, 30.0);
+      TestEqual("fovea rotation", cameras[1].Rotation, gaze);
+
+      // Rings wider than the camera are clamped to its field of view.
+      TestEqual("outer field of view", cameras[2].FieldOfViewDegrees, 90.0);
+      TestEqual("outer size", cameras[2].ViewportSize.X, 500.0, 1e-6);
+    });
+  });
+
+  Describe("GetViews", [this]() {
+    It("includes registered scene captures", [this]() {
+      UWorld* pWorld = CesiumTestHelpers::getGlobalWorldContext();
+      UCesiumViewSubsystem* pSubsystem =
+          pWorld->GetSubsystem<UCesiumViewSubsystem>();
+      TestNotNull("subsystem", pSubsystem);
+      if (!pSubsystem) {
+        return;
+      }
+
+      // Use frame numbers that the tilesets in the world will not use, so
+      // that this doesn't depend on or disturb their cached views.
+      uint64 frame = TNumericLimits<uint64>::Max() - 10;
+      const size_t before = pSubsystem->GetViews(false, frame).size();
+
+      UTextureRenderTarget2D* pTarget = NewObject<UTextureRenderTarget2D>();
+      pTarget->InitAutoFormat(64, 32);
+      USceneCaptureComponent2D* pCapture =
+          NewObject<USceneCaptureComponent2D>(pWorld);
+      pCapture->TextureTarget = pTarget;
+      pSubsystem->RegisterSceneCapture(pCapture);
+
+      // The views are cached for the rest of the frame.
+      TestEqual("cached", pSubsystem->GetViews(false, frame).size(), before);
+      ++frame;
+      TestEqual(
+          "collected",
+          pSubsystem->GetViews(false, frame).size(),
+          before + 1);
+
+      pSubsystem->UnregisterSceneCapture(pCapture);
+      ++frame;
+      TestEqual("removed", pSubsystem->GetViews(false, frame).size(), before);
+    });
+  });
+}
@@ -0,0 +1,72 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumWarmStart.h"
+#include "Misc/AutomationTest.h"
+
+BEGIN_DEFINE_SPEC(
+    FCesiumWarmStartSpec,
+    "Cesium.Unit.WarmStart",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext |
+        EAutomationTestFlags::ServerContext |
+        EAutomationTestFlags::CommandletContext |
+        EAutomationTestFlags::ProductFilter)
+END_DEFINE_SPEC(FCesiumWarmStartSpec)
+
+void FCesiumWarmStartSpec::Define() {
+  Describe("applyToOptions", [this]() {
+    It("raises the limits and stops preloading", [this]() {
+      Cesium3DTilesSelection::TilesetOptions options;
+      options.preloadAncestors = true;
+      options.preloadSiblings = true;
+      options.loadingDescendantLimit = 20;
+      options.maximumSimultaneousTileLoads = 20;
+
+      CesiumWarmStart::applyToOptions(options, 64, 500);
+
+      TestFalse("preloadAncestors", options.preloadAncestors);
+      TestFalse("preloadSiblings", options.preloadSiblings);
+      TestEqual(
+          "loadingDescendantLimit",
+          options.loadingDescendantLimit,
+          uint32_t(500));
+      TestEqual(
+          "maximumSimultaneousTileLoads",
+          options.maximumSimultaneousTileLoads,
+          uint32_t(64));
+    });
+
+    It("keeps limits that are already larger", [this]() {
+      Cesium3DTilesSelection::TilesetOptions options;
+      options.loadingDescendantLimit = 20000;
+      options.maximumSimultaneousTileLoads = 100;
+
+      CesiumWarmStart::applyToOptions(options, 64, 10000);
+
+      TestEqual(
+          "loadingDescendantLimit",
+          options.loadingDescendantLimit,
+          uint32_t(20000));
+      TestEqual(
+          "maximumSimultaneousTileLoads",
+          options.maximumSimultaneousTileLoads,
+          uint32_t(100));
+    });
+
+    It("ignores negative limits", [this]() {
+      Cesium3DTilesSelection::TilesetOptions options;
+      options.loadingDescendantLimit = 20;
+      options.maximumSimultaneousTileLoads = 20;
+
+      CesiumWarmStart::applyToOptions(options, -1, -1);
+
+      TestEqual(
+          "loadingDescendantLimit",
+          options.loadingDescendantLimit,
+          uint32_t(20));
+      TestEqual(
+          "maximumSimultaneousTileLoads",
+          options.maximumSimultaneousTileLoads,
+          uint32_t(20));
+    });
+  });
+}
@@ -12,6 +12,9 @@
 #include "CesiumRuntime.h"
 #include "CesiumSunSky.h"
 #include "GlobeAwareDefaultPawn.h"
+#include "RHI.h"
+#include <array>
+#include <memory>
 
 using namespace Cesium;
 
@@ -35,6 +38,11 @@ IMPLEMENT_SIMPLE_AUTOMATION_TEST(
     "Cesium.Performance.Tileset Loading.Melbourne photogrammetry (open data), vary max tile loads",
     EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
 
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FLoadTilesetMelbourneOptimizeMeshes,
+    "Cesium.Performance.Tileset Loading.Melbourne photogrammetry (open data), optimize meshes",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
 void samplesClearCache(SceneGenerationContext&, TestPass::TestingParameter) {
   std::shared_ptr<CesiumAsync::ICacheDatabase> pCacheDatabase =
       getCacheDatabase();
@@ -47,6 +55,15 @@ void samplesRefreshTilesets(
   context.refreshTilesets();
 }
 
+void samplesWarmStartTilesets(
+    SceneGenerationContext& context,
+    TestPass::TestingParameter parameter) {
+  for (ACesium3DTileset* pTileset : context.tilesets) {
+    pTileset->CaptureTileSelectionSnapshot();
+  }
+  context.refreshTilesets();
+}
+
 void setupForDenver(SceneGenerationContext& context) {
   context.setCommonProperties(
       FVector(-104.988892, 39.743462, 1798.679443),
@@ -150,6 +167,8 @@ bool FLoadTilesetDenver::RunTest(const FString& Parameters) {
   std::vector<TestPass> testPasses;
   testPasses.push_back(TestPass{"Cold Cache", samplesClearCache, nullptr});
   testPasses.push_back(TestPass{"Warm Cache", samplesRefreshTilesets, nullptr});
+  testPasses.push_back(
+      TestPass{"Warm Start", samplesWarmStartTilesets, nullptr});
 
   return RunLoadTest(
       GetBeautifiedTestName(),
@@ -163,6 +182,8 @@ bool FLoadTilesetMelbourne::RunTest(const FString& Parameters) {
   std::vector<TestPass> testPasses;
   testPasses.push_back(TestPass{"Cold Cache", samplesClearCache, nullptr});
   testPasses.push_back(TestPass{"Warm Cache", samplesRefreshTilesets, nullptr});
+  testPasses.push_back(
+      TestPass{"Warm Start", samplesWarmStartTilesets, nullptr});
 
   return RunLoadTest(
       GetBeautifiedTestName(),
@@ -277,4 +298,90 @@ bool FLoadTilesetMelbourneVaryMaxTileLoads::RunTest(const FString& Parameters) {
       768,
       reportStep);
 }
+
+bool FLoadTilesetMelbourneOptimizeMeshes::RunTest(const FString& Parameters) {
+  // The number of frames over which the GPU time of each pass is averaged,
+  // once its tiles are loaded.
+  const int32 gpuTimingFrames = 120;
+
+  struct GpuTiming {
+    // When the pass's tiles finished loading, before the timing frames.
+    double loadEndMark = 0.0;
+    int32 frames = 0;
+    double totalMilliseconds = 0.0;
+  };
+  auto pTimings = std::make_shared<std::array<GpuTiming, 2>>();
+
+  auto setupPass = [](SceneGenerationContext& context,
+                      TestPass::TestingParameter parameter) {
+    const bool optimizeMeshes = swl::get<int>(parameter) != 0;
+    for (ACesium3DTileset* pTileset : context.tilesets) {
+      pTileset->SetOptimizeMeshes(optimizeMeshes);
+    }
+    context.refreshTilesets();
+  };
+
+  auto measureGpuTime = [pTimings, gpuTimingFrames](
+                            SceneGenerationContext& creationContext,
+                            SceneGenerationContext& playContext,
+                            TestPass::TestingParameter parameter) {
+    GpuTiming& timing = (*pTimings)[swl::get<int>(parameter)];
+    // Skip the frame in which loading finished, which may still include
+    // uploads.
+    if (timing.loadEndMark == 0.0) {
+      timing.loadEndMark = FPlatformTime::Seconds();
+      return false;
+    }
+    ++timing.frames;
+    timing.totalMilliseconds +=
+        FPlatformTime::ToMilliseconds(RHIGetGPUFrameCycles());
+    return timing.frames >= gpuTimingFrames;
+  };
+
+  auto reportStep = [pTimings](const std::vector<TestPass>& testPasses) {
+    FString reportStr;
+    reportStr += "\n\nTest Results\n";
+    reportStr += "------------------------------------------------------\n";
+    reportStr += "(measured time) - (average GPU frame time) - (pass name)\n";
+    reportStr += "------------------------------------------------------\n";
+    for (const TestPass& pass : testPasses) {
+      if (!pass.verifyStep) {
+        // This pass only warms the cache.
+        continue;
+      }
+      const GpuTiming& timing =
+          (*pTimings)[swl::get<int>(pass.optionalParameter)];
+      // A pass that timed out may not have loaded, or may have measured fewer
+      // frames than it wanted.
+      const double loadTime = timing.loadEndMark > 0.0
+                                  ? timing.loadEndMark - pass.startMark
+                                  : pass.elapsedTime;
+      const double gpuTime =
+          timing.frames > 0 ? timing.totalMilliseconds / timing.frames : 0.0;
+      reportStr += FString::Printf(
+          TEXT("%.2f secs - %.3f ms (%d frames) - %s\n"),
+          loadTime,
+          gpuTime,
+          timing.frames,
+          *pass.name);
+    }
+    reportStr += "------------------------------------------------------\n";
+    UE_LOG(LogCesium, Display, TEXT("%s"), *reportStr);
+  };
+
+  std::vector<TestPass> testPasses;
+  testPasses.push_back(TestPass{"Cold Cache", samplesClearCache, nullptr});
+  testPasses.push_back(
+      TestPass{"Authored Meshes", setupPass, measureGpuTime, 0});
+  testPasses.push_back(
+      TestPass{"Optimized Meshes", setupPass, measureGpuTime, 1});
+
+  return RunLoadTest(
+      GetBeautifiedTestName(),
+      setupForMelbourne,
+      testPasses,
+      1024,
+      768,
+      reportStep);
+}
 #endif
@@ -9,6 +9,7 @@
 #include "CesiumAsync/IAssetResponse.h"
 #include "CesiumCommon.h"
 #include "CesiumRuntime.h"
+#include "CesiumStats.h"
 #include "HttpManager.h"
 #include "HttpModule.h"
 #include "Interfaces/IHttpRequest.h"
@@ -41,6 +42,22 @@ CesiumAsync::HttpHeaders parseHeaders(const TArray<FString>& unrealHeaders) {
   return result;
 }
 
+/**
+ * Determines if a request revalidates a response from the request cache, by
+ * its conditional headers.
+ */
+bool isRevalidation(
+    const std::vector<CesiumAsync::IAssetAccessor::THeader>& headers) {
+  for (const CesiumAsync::IAssetAccessor::THeader& header : headers) {
+    if (FCStringAnsi::Stricmp(header.first.c_str(), "If-None-Match") == 0 ||
+        FCStringAnsi::Stricmp(header.first.c_str(), "If-Modified-Since") ==
+            0) {
+      return true;
+    }
+  }
+  return false;
+}
+
 class UnrealAssetResponse : public CesiumAsync::IAssetResponse {
 public:
   UnrealAssetResponse(FHttpResponsePtr pResponse)
@@ -182,6 +199,10 @@ UnrealAssetAccessor::get(
 
   CESIUM_TRACE_BEGIN_IN_TRACK("requestAsset");
 
+  if (isRevalidation(headers)) {
+    CesiumStats::recordRevalidation();
+  }
+
   if (isFile(url)) {
     return getFromFile(asyncSystem, url, headers);
   }
@@ -209,14 +230,39 @@ UnrealAssetAccessor::get(
 
         pRequest->AppendToHeader(TEXT("User-Agent"), userAgent);
 
+        // The URL is only kept to match the request to its tile in traces.
+        std::string tracedUrl = CesiumTrace::isEnabled() ? url : std::string();
+        const uint64 requestCycle = FPlatformTime::Cycles64();
+
         pRequest->OnProcessRequestComplete().BindLambda(
-            [promise, CESIUM_TRACE_LAMBDA_CAPTURE_TRACK()](
+            [promise,
+             tracedUrl = std::move(tracedUrl),
+             requestCycle,
+             CESIUM_TRACE_LAMBDA_CAPTURE_TRACK()](
                 FHttpRequestPtr pRequest,
                 FHttpResponsePtr pResponse,
                 bool connectedSuccessfully) mutable {
               CESIUM_TRACE_USE_CAPTURED_TRACK();
               CESIUM_TRACE_END_IN_TRACK("requestAsset");
 
+              DEC_DWORD_STAT(STAT_CesiumHttpRequestsInFlight);
+              if (!tracedUrl.empty()) {
+                // The request may wait in Unreal's HTTP queue before it
+                // starts. Its elapsed time only counts from that start.
+                const uint64 endCycle = FPlatformTime::Cycles64();
+                const uint64 elapsedCycles = uint64(
+                    double(pRequest->GetElapsedTime()) /
+                    FPlatformTime::GetSecondsPerCycle64());
+                const uint64 startCycle = FMath::Max(
+                    requestCycle,
+                    endCycle - FMath::Min(endCycle, elapsedCycles));
+                CesiumTrace::traceNetworkRequest(
+                    tracedUrl,
+                    requestCycle,
+                    startCycle,
+                    endCycle);
+              }
+
               if (connectedSuccessfully) {
                 promise.resolve(
                     std::make_unique<UnrealAssetRequest>(pRequest, pResponse));
@@ -225,6 +271,7 @@ UnrealAssetAccessor::get(
               }
             });
 
+        INC_DWORD_STAT(STAT_CesiumHttpRequestsInFlight);
         pRequest->ProcessRequest();
       });
 }
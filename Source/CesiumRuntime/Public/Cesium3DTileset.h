@@ -6,6 +6,8 @@
 #include "Cesium3DTilesSelection/ViewState.h"
 #include "Cesium3DTilesSelection/ViewUpdateResult.h"
 #include "Cesium3DTilesetLoadFailureDetails.h"
+#include "CesiumAdaptiveScreenSpaceErrorState.h"
+#include "CesiumCameraPathPoint.h"
 #include "CesiumCreditSystem.h"
 #include "CesiumEncodedMetadataComponent.h"
 #include "CesiumFeaturesMetadataComponent.h"
@@ -13,27 +15,43 @@
 #include "CesiumIonServer.h"
 #include "CesiumPointCloudShading.h"
 #include "CesiumSampleHeightResult.h"
+#include "CesiumTileSelectionSnapshot.h"
+#include "CesiumTilesetMemoryReport.h"
 #include "CoreMinimal.h"
 #include "CustomDepthParameters.h"
 #include "Engine/EngineTypes.h"
 #include "GameFramework/Actor.h"
+#include "HAL/CriticalSection.h"
 #include "Interfaces/IHttpRequest.h"
 #include "PrimitiveSceneProxy.h"
 #include <PhysicsEngine/BodyInstance.h>
 #include <atomic>
 #include <chrono>
 #include <glm/mat4x4.hpp>
+#include <memory>
 #include <unordered_map>
 #include <vector>
 #include "Cesium3DTileset.generated.h"
 
 class UMaterialInterface;
+class UTexture2D;
 class ACesiumCartographicSelection;
 class ACesiumCameraManager;
 class UCesiumBoundingVolumePoolComponent;
+class UCesiumPolygonRasterOverlay;
+class UCesiumTileObjectPool;
+class CesiumInstanceAggregator;
+class CesiumPhysicsMeshCooker;
+class CesiumPolygonClipper;
+class CesiumScreenSpaceErrorGovernor;
 class CesiumViewExtension;
+class TileTeardownQueue;
 struct FCesiumCamera;
 
+namespace CesiumStyle {
+class Style;
+}
+
 namespace Cesium3DTilesSelection {
 class Tileset;
 class TilesetView;
@@ -85,6 +103,46 @@ enum class ETilesetSource : uint8 {
 UENUM(BlueprintType)
 enum class EApplyDpiScaling : uint8 { Yes, No, UseProjectDefault };
 
+/**
+ * Which tiles of a {@link Cesium3DTileset} get physics meshes.
+ */
+UENUM(BlueprintType)
+enum class ECesiumPhysicsMeshPolicy : uint8 {
+  /**
+   * A physics mesh is cooked for every tile as it is loaded.
+   */
+  AllTiles UMETA(DisplayName = "All Tiles"),
+
+  /**
+   * Physics meshes are only cooked for visible tiles that come within
+   * PhysicsMeshRadius of a physics-relevant actor. Cooking is prioritized by
+   * distance and happens on worker threads after the tile is loaded.
+   */
+  NearPhysicsRelevantActors UMETA(DisplayName = "Near Physics-Relevant Actors")
+};
+
+/**
+ * When a {@link Cesium3DTileset} loads only the collision of its tiles.
+ */
+UENUM(BlueprintType)
+enum class ECesiumCollisionOnlyMode : uint8 {
+  /**
+   * Tiles are always loaded for rendering.
+   */
+  Never,
+
+  /**
+   * Only collision is loaded in processes that cannot render, such as
+   * dedicated servers and processes started with -nullrhi.
+   */
+  WhenHeadless,
+
+  /**
+   * Only collision is loaded, even in processes that render.
+   */
+  Always
+};
+
 UCLASS()
 class CESIUMRUNTIME_API ACesium3DTileset : public AActor {
   GENERATED_BODY()
@@ -271,6 +329,21 @@ private:
       Meta = (AllowPrivateAccess))
   UCesiumBoundingVolumePoolComponent* BoundingVolumePoolComponent = nullptr;
 
+  /**
+   * The pool into which the Unreal objects of unloaded tiles are recycled, so
+   * that they can be reused for newly loaded tiles.
+   */
+  UPROPERTY(Transient)
+  UCesiumTileObjectPool* TileObjectPool = nullptr;
+
+  /**
+   * The textures that hold the style program of each property table, by
+   * property table name. The materials of all tiles share them, and they are
+   * updated in place when the style changes.
+   */
+  UPROPERTY(Transient)
+  TMap<FString, UTexture2D*> StyleProgramTextures;
+
   /**
    * The custom view extension this tileset uses to pull renderer view
    * information.
@@ -369,6 +442,93 @@ public:
       Category = "Cesium|Level of Detail")
   EApplyDpiScaling ApplyDpiScaling = EApplyDpiScaling::UseProjectDefault;
 
+  /**
+   * Whether to automatically raise the maximum screen-space error while the
+   * frame time, the tile memory, or the number of rendered tiles is over its
+   * target, and lower it back to MaximumScreenSpaceError once there is
+   * headroom again.
+   *
+   * The current decisions can be inspected with
+   * GetAdaptiveScreenSpaceErrorState, or with `stat Cesium`, which shows those
+   * of the tileset whose level of detail is reduced the most.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium|Level of Detail|Adaptive")
+  bool EnableAdaptiveScreenSpaceError = false;
+
+  /**
+   * The frame time, in milliseconds, to keep the game, render, and GPU threads
+   * under. Set this to 0.0 to ignore the frame time.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium|Level of Detail|Adaptive",
+      meta = (ClampMin = 0.0, EditCondition = "EnableAdaptiveScreenSpaceError"))
+  double TargetFrameTime = 16.6;
+
+  /**
+   * The size, in bytes, of loaded tile data to keep this tileset under. Set
+   * this to 0 to use MaximumCachedBytes. Set this to a negative value to
+   * ignore the tile memory.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium|Level of Detail|Adaptive",
+      meta = (EditCondition = "EnableAdaptiveScreenSpaceError"))
+  int64 AdaptiveMemoryCeiling = 0;
+
+  /**
+   * The number of rendered tiles to keep this tileset under. Set this to 0 to
+   * ignore the number of rendered tiles.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium|Level of Detail|Adaptive",
+      meta = (ClampMin = 0, EditCondition = "EnableAdaptiveScreenSpaceError"))
+  int32 AdaptiveMaximumTilesRendered = 0;
+
+  /**
+   * The largest maximum screen-space error that adaptation may raise this
+   * tileset to. It is never lowered below MaximumScreenSpaceError.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium|Level of Detail|Adaptive",
+      meta = (ClampMin = 0.0, EditCondition = "EnableAdaptiveScreenSpaceError"))
+  double AdaptiveMaximumScreenSpaceError = 64.0;
+
+  /**
+   * The fraction by which a measurement must be over or under its target
+   * before the level of detail is changed. Larger values make the level of
+   * detail steadier but let the measurements drift further from their targets.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium|Level of Detail|Adaptive",
+      meta =
+          (ClampMin = 0.0,
+           ClampMax = 0.9,
+           EditCondition = "EnableAdaptiveScreenSpaceError"))
+  double AdaptiveHysteresis = 0.1;
+
+  /**
+   * Whether to also reduce the maximum number of simultaneous tile loads
+   * while the frame time is over its target.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium|Level of Detail|Adaptive",
+      meta = (EditCondition = "EnableAdaptiveScreenSpaceError"))
+  bool AdaptMaximumSimultaneousTileLoads = false;
+
   /**
    * Whether to preload ancestor tiles.
    *
@@ -429,6 +589,20 @@ public:
   UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium|Tile Loading")
   int64 MaximumCachedBytes = 256 * 1024 * 1024;
 
+  /**
+   * Whether the memory that Unreal holds for the loaded tiles, such as their
+   * meshes, collision meshes, and textures, counts against MaximumCachedBytes.
+   *
+   * By default, only the size of the tile data held by cesium-native is
+   * compared against MaximumCachedBytes. When this is enabled, the Unreal
+   * memory of the tiles that are loaded but not rendered counts against it
+   * too, so those tiles are unloaded sooner. The Unreal memory of rendered
+   * tiles is left out, because they cannot be unloaded to make room. The
+   * Unreal memory is measured a few times per second.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium|Tile Loading")
+  bool CountUnrealMemoryInCache = false;
+
   /**
    * The number of loading descendents a tile should allow before deciding to
    * render itself instead of waiting.
@@ -447,6 +621,176 @@ public:
       meta = (ClampMin = 0))
   int32 LoadingDescendantLimit = 20;
 
+  /**
+   * Whether to warm-start this tileset from its TileSelectionSnapshot when it
+   * is loaded.
+   *
+   * While warm-starting, the cameras recorded in the snapshot are treated as
+   * additional views, ancestors and siblings are not preloaded, and the
+   * loading descendant limit is lifted. This causes the whole recorded
+   * refinement frontier to be requested in parallel immediately, rather than
+   * one level of detail at a time. Warm-starting ends when every tile in the
+   * snapshot has been rendered, or after WarmStartTimeout seconds.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium|Tile Loading|Warm Start")
+  bool EnableWarmStart = true;
+
+  /**
+   * The maximum number of tiles that may be loaded at once while
+   * warm-starting. The larger of this value and MaximumSimultaneousTileLoads is
+   * used.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium|Tile Loading|Warm Start",
+      meta = (EditCondition = "EnableWarmStart", ClampMin = 0))
+  int32 WarmStartMaximumSimultaneousTileLoads = 64;
+
+  /**
+   * The loading descendant limit while warm-starting. The larger of this
+   * value and LoadingDescendantLimit is used. A high value lets the tiles
+   * deep in the snapshot's frontier load before their ancestors are
+   * rendered.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium|Tile Loading|Warm Start",
+      meta = (EditCondition = "EnableWarmStart", ClampMin = 0))
+  int32 WarmStartLoadingDescendantLimit = 10000;
+
+  /**
+   * The maximum time, in seconds, to spend warm-starting before reverting to
+   * the normal tile loading settings.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium|Tile Loading|Warm Start",
+      meta = (EditCondition = "EnableWarmStart", ClampMin = 0.0))
+  float WarmStartTimeout = 30.0f;
+
+  /**
+   * The tiles that were rendered the last time CaptureTileSelectionSnapshot
+   * was called, along with the cameras that selected them. This is saved with
+   * the level and used to warm-start the tileset when it is loaded.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium|Tile Loading|Warm Start",
+      AdvancedDisplay)
+  FCesiumTileSelectionSnapshot TileSelectionSnapshot;
+
+  /**
+   * Records the tiles that are currently rendered, and the cameras that
+   * selected them, into TileSelectionSnapshot. Save the level afterward to
+   * warm-start from this snapshot in later sessions.
+   *
+   * @return True if a snapshot was captured, or false if the tileset has not
+   * been updated yet.
+   */
+  UFUNCTION(CallInEditor, BlueprintCallable, Category = "Cesium")
+  bool CaptureTileSelectionSnapshot();
+
+  /**
+   * Discards the TileSelectionSnapshot, so that this tileset starts loading
+   * from its root tile.
+   */
+  UFUNCTION(CallInEditor, BlueprintCallable, Category = "Cesium")
+  void ClearTileSelectionSnapshot();
+
+  /**
+   * Whether this tileset is currently warm-starting from its
+   * TileSelectionSnapshot.
+   */
+  UFUNCTION(BlueprintPure, Category = "Cesium")
+  bool IsWarmStarting() const { return this->_warmStartActive; }
+
+  /**
+   * Gets the current decisions of the adaptive screen-space error controller,
+   * and the measurements they were based on.
+   *
+   * Only meaningful when EnableAdaptiveScreenSpaceError is true.
+   */
+  UFUNCTION(BlueprintCallable, Category = "Cesium")
+  FCesiumAdaptiveScreenSpaceErrorState GetAdaptiveScreenSpaceErrorState() const;
+
+  /**
+   * Estimates the memory used by this tileset's loaded tiles, by the stage of
+   * tile loading that holds it. The reports of all tilesets in a world can be
+   * logged with the `cesium.memreport` console command.
+   *
+   * This walks all of the loaded tiles, so avoid calling it every frame.
+   */
+  UFUNCTION(BlueprintCallable, Category = "Cesium")
+  FCesiumTilesetMemoryReport GetMemoryReport() const;
+
+  /**
+   * How far ahead along the camera path, in seconds, to load tiles.
+   *
+   * Only relevant if a camera path has been set with SetCameraPath.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium|Tile Loading|Camera Path",
+      meta = (ClampMin = 0.0))
+  float CameraPathLookAheadSeconds = 3.0f;
+
+  /**
+   * The maximum number of upcoming camera poses along the camera path to load
+   * tiles for in each frame. The poses are spaced evenly across the look-ahead
+   * window. Higher values leave fewer gaps between prefetched poses at the
+   * cost of selecting and loading more tiles.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium|Tile Loading|Camera Path",
+      meta = (ClampMin = 0))
+  int32 MaximumCameraPathPrefetchViews = 4;
+
+  /**
+   * The number of bytes of loaded tiles, beyond MaximumCachedBytes, that
+   * prefetching upcoming camera poses may add. Once the tileset holds more
+   * than MaximumCachedBytes plus this, upcoming poses are no longer
+   * prefetched until tiles are evicted, so that the tiles needed right now
+   * are not evicted in favor of tiles that are needed later.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium|Tile Loading|Camera Path",
+      meta = (ClampMin = 0))
+  int64 CameraPathPrefetchMaximumBytes = 64 * 1024 * 1024;
+
+  /**
+   * The number of tiles waiting to load above which upcoming camera poses are
+   * not prefetched, so that the tiles of the current views load first.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium|Tile Loading|Camera Path",
+      meta = (ClampMin = 0))
+  int32 CameraPathPrefetchMaximumPendingLoads = 40;
+
+  /**
+   * Whether the camera path time advances automatically by the frame time
+   * every tick. Disable this when the time is driven explicitly with
+   * SetCameraPathTime, such as from a Level Sequence.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium|Tile Loading|Camera Path")
+  bool AdvanceCameraPathAutomatically = true;
+
   /**
    * Whether to cull tiles that are outside the frustum.
    *
@@ -638,6 +982,14 @@ public:
   UPROPERTY(EditAnywhere, Category = "Cesium|Debug")
   bool LogSharedAssetStats = false;
 
+  /**
+   * If true, logs stats on how often this tileset reuses components, meshes,
+   * and material instances from unloaded tiles instead of creating new ones
+   * to the Output Log.
+   */
+  UPROPERTY(EditAnywhere, Category = "Cesium|Debug")
+  bool LogObjectPoolStats = false;
+
   /**
    * If true, draws debug text above each tile being rendered with information
    * about that tile.
@@ -783,6 +1135,136 @@ private:
       Category = "Cesium|Physics")
   bool CreatePhysicsMeshes = true;
 
+  /**
+   * Which tiles get physics meshes when CreatePhysicsMeshes is enabled.
+   *
+   * Cooking physics meshes for every tile costs load-thread time and roughly
+   * doubles the memory used by each tile. When only a few actors interact
+   * with the tileset physically, cooking only the tiles near them avoids most
+   * of that cost.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintGetter = GetPhysicsMeshPolicy,
+      BlueprintSetter = SetPhysicsMeshPolicy,
+      Category = "Cesium|Physics",
+      meta = (EditCondition = "CreatePhysicsMeshes"))
+  ECesiumPhysicsMeshPolicy PhysicsMeshPolicy =
+      ECesiumPhysicsMeshPolicy::AllTiles;
+
+  /**
+   * The distance, in Unreal units, from a physics-relevant actor within which
+   * tiles get physics meshes when PhysicsMeshPolicy is "Near Physics-Relevant
+   * Actors". Tiles keep their physics meshes once cooked, even if the actors
+   * move away.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium|Physics",
+      meta =
+          (EditCondition =
+               "CreatePhysicsMeshes && PhysicsMeshPolicy==ECesiumPhysicsMeshPolicy::NearPhysicsRelevantActors",
+           ClampMin = 0.0,
+           Units = "Centimeters"))
+  double PhysicsMeshRadius = 50000.0;
+
+  /**
+   * The actors near which tiles get physics meshes when PhysicsMeshPolicy is
+   * "Near Physics-Relevant Actors", and for which tiles are selected in
+   * collision-only mode. The pawns of all player controllers are always
+   * included.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium|Physics",
+      meta =
+          (EditCondition =
+               "PhysicsMeshPolicy==ECesiumPhysicsMeshPolicy::NearPhysicsRelevantActors || CollisionOnlyMode!=ECesiumCollisionOnlyMode::Never"))
+  TArray<TSoftObjectPtr<AActor>> PhysicsRelevantActors;
+
+  /**
+   * The maximum number of physics meshes that are cooked on worker threads at
+   * the same time when PhysicsMeshPolicy is "Near Physics-Relevant Actors".
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium|Physics",
+      AdvancedDisplay,
+      meta =
+          (EditCondition =
+               "CreatePhysicsMeshes && PhysicsMeshPolicy==ECesiumPhysicsMeshPolicy::NearPhysicsRelevantActors",
+           ClampMin = 1))
+  int32 MaximumSimultaneousPhysicsMeshCooks = 4;
+
+  /**
+   * Simplifies physics meshes by clustering their vertices on a grid with this
+   * many cells along the longest side of each primitive. Lower values produce
+   * coarser, cheaper physics meshes. If zero, physics meshes use the full
+   * render geometry. The largest supported value is 2097151 (2^21 - 1).
+   *
+   * The face index of a hit on a simplified physics mesh still refers to the
+   * render triangle that the hit triangle came from, so metadata picking and
+   * texture coordinates from hit results keep working, but they are looked up
+   * on that render triangle rather than at the exact rendered surface.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintGetter = GetPhysicsMeshSimplificationResolution,
+      BlueprintSetter = SetPhysicsMeshSimplificationResolution,
+      Category = "Cesium|Physics",
+      AdvancedDisplay,
+      meta =
+          (EditCondition = "CreatePhysicsMeshes",
+           ClampMin = 0,
+           ClampMax = 2097151))
+  int32 PhysicsMeshSimplificationResolution = 0;
+
+  /**
+   * When to load only the physics meshes and, optionally, the features and
+   * metadata of tiles, without any textures, materials, or render resources.
+   *
+   * In collision-only mode, tiles are selected for the player pawns and the
+   * PhysicsRelevantActors rather than for cameras, using
+   * CollisionMaximumScreenSpaceError. Raster overlays are not loaded.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintGetter = GetCollisionOnlyMode,
+      BlueprintSetter = SetCollisionOnlyMode,
+      Category = "Cesium|Physics")
+  ECesiumCollisionOnlyMode CollisionOnlyMode = ECesiumCollisionOnlyMode::Never;
+
+  /**
+   * The maximum screen-space error used to select tiles in collision-only
+   * mode. It is measured in views with a 90 degree field of view and a
+   * resolution of 1024 pixels, looking in every direction from each
+   * physics-relevant actor.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium|Physics",
+      meta =
+          (EditCondition = "CollisionOnlyMode!=ECesiumCollisionOnlyMode::Never",
+           ClampMin = 0.0))
+  double CollisionMaximumScreenSpaceError = 16.0;
+
+  /**
+   * Whether to load the features and metadata of tiles in collision-only mode,
+   * so that they can be queried from hit results.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintGetter = GetLoadMetadataWhenCollisionOnly,
+      BlueprintSetter = SetLoadMetadataWhenCollisionOnly,
+      Category = "Cesium|Physics",
+      meta =
+          (EditCondition = "CollisionOnlyMode!=ECesiumCollisionOnlyMode::Never"))
+  bool LoadMetadataWhenCollisionOnly = true;
+
   /**
    * Whether to generate navigation collisions for this tileset.
    *
@@ -836,6 +1318,101 @@ private:
       Category = "Cesium|Rendering")
   bool GenerateSmoothNormals = false;
 
+  /**
+   * Whether to optimize the meshes of tiles as they are loaded, which makes
+   * them faster to render at the cost of some load time.
+   *
+   * Vertices with identical attributes are welded, and the triangles are
+   * reordered to make better use of the GPU's vertex cache and to reduce
+   * overdraw. This mostly benefits photogrammetry and converted CAD tilesets
+   * whose triangles are poorly ordered. Welding also allows more meshes to use
+   * 16-bit indices. Collision meshes are not affected.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintGetter = GetOptimizeMeshes,
+      BlueprintSetter = SetOptimizeMeshes,
+      Category = "Cesium|Rendering")
+  bool OptimizeMeshes = false;
+
+  /**
+   * Whether to store the texture coordinates of tile meshes as 16-bit floats
+   * when that does not visibly change them, which halves the memory they use.
+   *
+   * This is decided for each primitive. Texture coordinates that repeat, and
+   * texture coordinate sets that carry feature IDs too large to be represented
+   * exactly, keep full 32-bit precision. Coordinates may still move by up to a
+   * quarter of a texel of a 1024x1024 texture, so this is best left disabled
+   * for tilesets with very high-resolution textures or raster overlays.
+   *
+   * Only texture coordinates are affected. Normals and tangents are always
+   * stored as 8-bit packed vectors, and positions always keep 32-bit
+   * precision, because the engine's static mesh vertex buffers have no
+   * smaller position format.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintGetter = GetUseHalfPrecisionUVs,
+      BlueprintSetter = SetUseHalfPrecisionUVs,
+      Category = "Cesium|Rendering")
+  bool UseHalfPrecisionUVs = false;
+
+  /**
+   * Whether to merge the primitives of each tile that share a material and a
+   * vertex layout into a single mesh as the tile is loaded.
+   *
+   * Converted BIM and CAD tilesets often contain hundreds of small primitives
+   * per tile, each of which becomes its own component and draw call. Merging
+   * them greatly reduces both, at the cost of some load time and coarser
+   * culling within a tile. Feature IDs and metadata still resolve correctly
+   * for every face of a merged mesh.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintGetter = GetMergePrimitives,
+      BlueprintSetter = SetMergePrimitives,
+      Category = "Cesium|Rendering")
+  bool MergePrimitives = false;
+
+  /**
+   * Whether to render the instances of identical instanced meshes from
+   * different tiles with a single component.
+   *
+   * Vegetation and street furniture tilesets that use EXT_mesh_gpu_instancing
+   * often repeat the same mesh in thousands of tiles. With this enabled, draw
+   * calls and instance buffers scale with the number of distinct meshes
+   * rather than with the number of tiles. Meshes are identified by a hash of
+   * their geometry and material, so their textures must come from shared
+   * external images. Meshes with raster overlays or with features and
+   * metadata are never aggregated, and aggregated instances fade in and out
+   * together.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintGetter = GetAggregateInstances,
+      BlueprintSetter = SetAggregateInstances,
+      Category = "Cesium|Rendering")
+  bool AggregateInstances = false;
+
+  /**
+   * Whether to convert and upload the geometry of identical meshes only once
+   * and share it between tiles.
+   *
+   * Tilesets in which many tiles reference the same external glTF, such as
+   * tree and sign tilesets or repeated building components, otherwise convert
+   * and upload identical geometry for every tile. Meshes are identified by a
+   * hash of their geometry and material, and are shared with every tileset
+   * that enables this option. Meshes with raster overlays, with features and
+   * metadata, or with physics meshes that are cooked near physics-relevant
+   * actors are never shared.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintGetter = GetShareIdenticalMeshes,
+      BlueprintSetter = SetShareIdenticalMeshes,
+      Category = "Cesium|Rendering")
+  bool ShareIdenticalMeshes = false;
+
   /**
    * Whether to request and render the water mask.
    *
@@ -937,6 +1514,36 @@ private:
       Category = "Cesium|Rendering")
   FCesiumPointCloudShading PointCloudShading;
 
+  /**
+   * A 3D Tiles style that colors, shows, or hides features by their metadata,
+   * as a JSON object with optional "defines", "show", and "color" entries.
+   * For example:
+   *
+   * {"show": "${type} !== 'tree'", "color": "${height} > 100 ?
+   * color('red') : color('white')"}
+   *
+   * The style applies to the features of every property table that is
+   * encoded by this tileset's CesiumFeaturesMetadataComponent. The generated
+   * material multiplies the base color by the feature's color, multiplies
+   * the opacity by its alpha, and masks out hidden features. The result is
+   * also available as the "FeatureStyle" output of the generated property
+   * table nodes: its RGB is the feature's color, and its alpha is zero for
+   * hidden features.
+   *
+   * When a property table encodes every property that the style reads as a
+   * plain number or boolean, the style is compiled into a small program that
+   * the material runs, and changing the style only uploads the new program.
+   * Otherwise, such as when the style compares strings, it is evaluated for
+   * every feature of the loaded tiles. Neither reloads the tileset.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintGetter = GetStyle,
+      BlueprintSetter = SetStyle,
+      Category = "Cesium|Rendering",
+      meta = (MultiLine = true))
+  FString Style;
+
 protected:
   UPROPERTY()
   FString PlatformName;
@@ -1018,6 +1625,45 @@ public:
   UFUNCTION(BlueprintSetter, Category = "Cesium|Physics")
   void SetCreatePhysicsMeshes(bool bCreatePhysicsMeshes);
 
+  UFUNCTION(BlueprintGetter, Category = "Cesium|Physics")
+  ECesiumPhysicsMeshPolicy GetPhysicsMeshPolicy() const {
+    return PhysicsMeshPolicy;
+  }
+
+  UFUNCTION(BlueprintSetter, Category = "Cesium|Physics")
+  void SetPhysicsMeshPolicy(ECesiumPhysicsMeshPolicy NewPhysicsMeshPolicy);
+
+  UFUNCTION(BlueprintGetter, Category = "Cesium|Physics")
+  int32 GetPhysicsMeshSimplificationResolution() const {
+    return PhysicsMeshSimplificationResolution;
+  }
+
+  UFUNCTION(BlueprintSetter, Category = "Cesium|Physics")
+  void SetPhysicsMeshSimplificationResolution(int32 NewResolution);
+
+  UFUNCTION(BlueprintGetter, Category = "Cesium|Physics")
+  ECesiumCollisionOnlyMode GetCollisionOnlyMode() const {
+    return CollisionOnlyMode;
+  }
+
+  UFUNCTION(BlueprintSetter, Category = "Cesium|Physics")
+  void SetCollisionOnlyMode(ECesiumCollisionOnlyMode NewCollisionOnlyMode);
+
+  UFUNCTION(BlueprintGetter, Category = "Cesium|Physics")
+  bool GetLoadMetadataWhenCollisionOnly() const {
+    return LoadMetadataWhenCollisionOnly;
+  }
+
+  UFUNCTION(BlueprintSetter, Category = "Cesium|Physics")
+  void SetLoadMetadataWhenCollisionOnly(bool bLoadMetadata);
+
+  /**
+   * Whether this tileset currently loads only the collision of its tiles,
+   * according to its CollisionOnlyMode and the current process.
+   */
+  UFUNCTION(BlueprintPure, Category = "Cesium|Physics")
+  bool IsCollisionOnly() const;
+
   UFUNCTION(BlueprintGetter, Category = "Cesium|Navigation")
   bool GetCreateNavCollision() const { return CreateNavCollision; }
 
@@ -1036,6 +1682,36 @@ public:
   UFUNCTION(BlueprintSetter, Category = "Cesium|Rendering")
   void SetGenerateSmoothNormals(bool bGenerateSmoothNormals);
 
+  UFUNCTION(BlueprintGetter, Category = "Cesium|Rendering")
+  bool GetOptimizeMeshes() const { return OptimizeMeshes; }
+
+  UFUNCTION(BlueprintSetter, Category = "Cesium|Rendering")
+  void SetOptimizeMeshes(bool bOptimizeMeshes);
+
+  UFUNCTION(BlueprintGetter, Category = "Cesium|Rendering")
+  bool GetUseHalfPrecisionUVs() const { return UseHalfPrecisionUVs; }
+
+  UFUNCTION(BlueprintSetter, Category = "Cesium|Rendering")
+  void SetUseHalfPrecisionUVs(bool bUseHalfPrecisionUVs);
+
+  UFUNCTION(BlueprintGetter, Category = "Cesium|Rendering")
+  bool GetMergePrimitives() const { return MergePrimitives; }
+
+  UFUNCTION(BlueprintSetter, Category = "Cesium|Rendering")
+  void SetMergePrimitives(bool bMergePrimitives);
+
+  UFUNCTION(BlueprintGetter, Category = "Cesium|Rendering")
+  bool GetAggregateInstances() const { return AggregateInstances; }
+
+  UFUNCTION(BlueprintSetter, Category = "Cesium|Rendering")
+  void SetAggregateInstances(bool bAggregateInstances);
+
+  UFUNCTION(BlueprintGetter, Category = "Cesium|Rendering")
+  bool GetShareIdenticalMeshes() const { return ShareIdenticalMeshes; }
+
+  UFUNCTION(BlueprintSetter, Category = "Cesium|Rendering")
+  void SetShareIdenticalMeshes(bool bShareIdenticalMeshes);
+
   UFUNCTION(BlueprintGetter, Category = "Cesium|Rendering")
   bool GetEnableWaterMask() const { return EnableWaterMask; }
 
@@ -1083,6 +1759,46 @@ public:
   UFUNCTION(BlueprintSetter, Category = "Cesium|Rendering")
   void SetPointCloudShading(FCesiumPointCloudShading InPointCloudShading);
 
+  UFUNCTION(BlueprintGetter, Category = "Cesium|Rendering")
+  FString GetStyle() const { return Style; }
+
+  /**
+   * Sets the 3D Tiles style of this tileset, and restyles the loaded tiles.
+   * If the style cannot be compiled, an error is logged and the features are
+   * left unstyled.
+   */
+  UFUNCTION(BlueprintSetter, Category = "Cesium|Rendering")
+  void SetStyle(const FString& InStyle);
+
+  /**
+   * Gets the compiled form of the Style, or nullptr if there is no style or it
+   * could not be compiled.
+   */
+  const CesiumStyle::Style* GetCompiledStyle() const {
+    return this->_pStyle.get();
+  }
+
+  /**
+   * Gets the texture that holds the style program of a property table, which
+   * the materials of all tiles with that property table share. It is created
+   * the first time that it is needed, and left empty if the style cannot run
+   * in the material.
+   */
+  UTexture2D* GetStyleProgramTexture(const FString& PropertyTableName);
+
+  /**
+   * Sets the object that removes the triangles clipped by a polygon raster
+   * overlay as tiles are loaded, or removes it if pClipper is nullptr. This is
+   * called when the overlay is added to or removed from the tileset.
+   *
+   * Tiles that start loading afterward use the new clipper. If the clipping
+   * changed and tiles were already loaded, the tileset is refreshed on the
+   * next tick, so that no tile keeps the triangles of the old clipping.
+   */
+  void SetPolygonClipper(
+      const UCesiumPolygonRasterOverlay* pOverlay,
+      std::shared_ptr<const CesiumPolygonClipper> pClipper);
+
   UFUNCTION(BlueprintCallable, Category = "Cesium|Rendering")
   void PlayMovieSequencer();
 
@@ -1092,6 +1808,40 @@ public:
   UFUNCTION(BlueprintCallable, Category = "Cesium|Rendering")
   void PauseMovieSequencer();
 
+  /**
+   * Sets the known future trajectory of the camera. While a path is set, tiles
+   * for the poses within the next CameraPathLookAheadSeconds are loaded
+   * alongside the tiles for the current views, so that they are ready by the
+   * time the camera arrives.
+   *
+   * The path time is reset to the time of the earliest point.
+   *
+   * @param Path The timed camera poses. They do not need to be sorted.
+   */
+  UFUNCTION(BlueprintCallable, Category = "Cesium|Tile Loading")
+  void SetCameraPath(const TArray<FCesiumCameraPathPoint>& Path);
+
+  /**
+   * Removes the camera path, so that tiles are only loaded for the current
+   * views.
+   */
+  UFUNCTION(BlueprintCallable, Category = "Cesium|Tile Loading")
+  void ClearCameraPath();
+
+  /**
+   * Sets the current time along the camera path, in seconds. Use this to keep
+   * the prefetching in step with the playback that is moving the camera, for
+   * example from an event track in a Level Sequence.
+   */
+  UFUNCTION(BlueprintCallable, Category = "Cesium|Tile Loading")
+  void SetCameraPathTime(double Time);
+
+  /**
+   * Gets the current time along the camera path, in seconds.
+   */
+  UFUNCTION(BlueprintPure, Category = "Cesium|Tile Loading")
+  double GetCameraPathTime() const { return this->_cameraPathTime; }
+
   /**
    * This method is not supposed to be called by clients. It is currently
    * only required by the UnrealResourcePreparer.
@@ -1160,9 +1910,7 @@ private:
       const glm::dmat4& unrealWorldToTileset,
       UCesiumEllipsoid* ellipsoid);
 
-  std::vector<FCesiumCamera> GetCameras() const;
-  std::vector<FCesiumCamera> GetPlayerCameras() const;
-  std::vector<FCesiumCamera> GetSceneCaptures() const;
+  std::vector<FCesiumCamera> GetCameraPathPrefetchCameras() const;
 
 public:
   /**
@@ -1209,6 +1957,77 @@ private:
   void
   showTilesToRender(const std::vector<Cesium3DTilesSelection::Tile*>& tiles);
 
+  /**
+   * Starts warm-starting from the TileSelectionSnapshot, if enabled and
+   * available.
+   */
+  void beginWarmStart();
+
+  /**
+   * Ends warm-starting once all tiles in the snapshot have been rendered, or
+   * the warm-start has timed out.
+   *
+   * @param tilesToRender The tiles that are rendered in the current frame
+   */
+  void updateWarmStart(
+      const std::vector<Cesium3DTilesSelection::Tile*>& tilesToRender);
+
+  /**
+   * Starts cooking the deferred physics meshes of the tiles closest to the
+   * physics-relevant actors, when PhysicsMeshPolicy is "Near Physics-Relevant
+   * Actors".
+   */
+  void updatePhysicsMeshCooking();
+
+  /**
+   * Gets the locations of the player pawns and the PhysicsRelevantActors.
+   */
+  TArray<FVector> getPhysicsRelevantLocations() const;
+
+  /**
+   * Creates the views that select tiles in collision-only mode: one view per
+   * cube face around each physics-relevant actor.
+   */
+  void appendCollisionViewStates(
+      const glm::dmat4& unrealWorldToCesiumTileset,
+      UCesiumEllipsoid* pEllipsoid,
+      std::vector<Cesium3DTilesSelection::ViewState>& frustums) const;
+
+  /**
+   * Replaces the cache size and tile load limit of this tileset, and scales
+   * those of its raster overlays, with this tileset's share of the world tile
+   * budget.
+   */
+  void applyWorldTileBudget(Cesium3DTilesSelection::TilesetOptions& options);
+
+  /**
+   * Leaves the world tile budget after it has been disabled, restoring the
+   * unscaled settings of this tileset's raster overlays.
+   */
+  void leaveWorldTileBudget();
+
+  /**
+   * Scales the maximum screen-space error and tile load limit by the
+   * adaptive screen-space error controller's current decisions.
+   */
+  void applyAdaptiveScreenSpaceError(
+      Cesium3DTilesSelection::TilesetOptions& options);
+
+  /**
+   * Reduces the cache size by the memory that Unreal holds for the loaded
+   * tiles that are not rendered, when CountUnrealMemoryInCache is enabled.
+   */
+  void applyUnrealMemoryToCache(
+      Cesium3DTilesSelection::TilesetOptions& options);
+
+  /**
+   * Feeds this frame's measurements to the adaptive screen-space error
+   * controller.
+   */
+  void updateAdaptiveScreenSpaceError(
+      const Cesium3DTilesSelection::ViewUpdateResult& result,
+      float deltaTime);
+
   /**
    * Will be called after the tileset is loaded or spawned, to register
    * a delegate that calls OnFocusEditorViewportOnThis when this
@@ -1217,8 +2036,6 @@ private:
   void AddFocusViewportDelegate();
 
 #if WITH_EDITOR
-  std::vector<FCesiumCamera> GetEditorCameras() const;
-
   /**
    * Will focus all viewports on this tileset.
    *
@@ -1267,6 +2084,74 @@ private:
 
   bool _scaleUsingDPI;
 
+  bool _warmStartActive;
+  std::chrono::high_resolution_clock::time_point _warmStartTime;
+  std::vector<FCesiumCamera> _lastCameras;
+
+  TArray<FCesiumCameraPathPoint> _cameraPath;
+  double _cameraPathTime;
+  int32 _lastTileLoadQueueLength;
+
+  TUniquePtr<TileTeardownQueue> _pTileTeardownQueue;
+
+  TUniquePtr<CesiumPhysicsMeshCooker> _pPhysicsMeshCooker;
+
+  TUniquePtr<CesiumInstanceAggregator> _pInstanceAggregator;
+
+  TUniquePtr<CesiumScreenSpaceErrorGovernor> _pScreenSpaceErrorGovernor;
+
+  int64 _unrealMemoryBytes;
+  uint64 _unrealMemoryFrame;
+
+  bool _overlaysScaledByTileBudget;
+
+  void compileStyle();
+
+  /**
+   * Writes the programs of the compiled style to the existing style program
+   * textures.
+   */
+  void updateStyleProgramTextures();
+
+  /**
+   * Gets the compiled style for a tile that is being loaded. Unlike
+   * GetCompiledStyle, this may be called from any thread.
+   */
+  std::shared_ptr<const CesiumStyle::Style> getStyleForLoading() const;
+
+  // The style is only replaced on the game thread, but it is also read by
+  // tiles that are loading in worker threads.
+  mutable FCriticalSection _styleLock;
+  std::shared_ptr<const CesiumStyle::Style> _pStyle;
+
+  using PolygonClippers =
+      std::vector<std::shared_ptr<const CesiumPolygonClipper>>;
+
+  /**
+   * Publishes the polygon clippers set since the last call to the tiles that
+   * start loading, and refreshes the tileset if tiles were already loaded with
+   * different clipping.
+   */
+  void updatePolygonClippers();
+
+  /**
+   * Gets the polygon clippers for a tile that is being loaded. This may be
+   * called from any thread.
+   */
+  std::shared_ptr<const PolygonClippers> getPolygonClippersForLoading() const;
+
+  TMap<
+      const UCesiumPolygonRasterOverlay*,
+      std::shared_ptr<const CesiumPolygonClipper>>
+      _polygonClippersByOverlay;
+  bool _polygonClippersChanged = false;
+
+  // Like the style, the published clippers are replaced on the game thread
+  // and read by tiles that are loading in worker threads.
+  mutable FCriticalSection _polygonClipperLock;
+  std::shared_ptr<const PolygonClippers> _pPolygonClippers;
+  std::atomic<bool> _tilesLoadedWithPolygonClippers = false;
+
   // This is used as a workaround for cesium-native#186
   //
   // The tiles that are no longer supposed to be rendered in the current
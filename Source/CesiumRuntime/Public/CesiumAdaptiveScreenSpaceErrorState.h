@@ -0,0 +1,104 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "CesiumAdaptiveScreenSpaceErrorState.generated.h"
+
+/**
+ * The budget that is currently limiting the level of detail of a
+ * {@link Cesium3DTileset} with adaptive screen-space error.
+ */
+UENUM(BlueprintType)
+enum class ECesiumAdaptiveScreenSpaceErrorLimit : uint8 {
+  /**
+   * All budgets are met, so the level of detail is not being reduced.
+   */
+  None,
+
+  /**
+   * The frame time is over its target.
+   */
+  FrameTime,
+
+  /**
+   * The tile data is over its memory ceiling.
+   */
+  Memory,
+
+  /**
+   * The number of rendered tiles is over its ceiling.
+   */
+  TileCount
+};
+
+/**
+ * The decisions of a {@link Cesium3DTileset}'s adaptive screen-space error
+ * controller, and the measurements they were based on.
+ */
+USTRUCT(BlueprintType)
+struct CESIUMRUNTIME_API FCesiumAdaptiveScreenSpaceErrorState {
+  GENERATED_BODY()
+
+  /**
+   * The maximum screen-space error that the tileset is currently using, after
+   * adaptation.
+   */
+  UPROPERTY(BlueprintReadOnly, Category = "Cesium")
+  double EffectiveMaximumScreenSpaceError = 0.0;
+
+  /**
+   * The maximum number of simultaneous tile loads that the tileset is
+   * currently using, after adaptation.
+   */
+  UPROPERTY(BlueprintReadOnly, Category = "Cesium")
+  int32 EffectiveMaximumSimultaneousTileLoads = 0;
+
+  /**
+   * The factor by which the maximum screen-space error is multiplied.
+   */
+  UPROPERTY(BlueprintReadOnly, Category = "Cesium")
+  double ScreenSpaceErrorScale = 1.0;
+
+  /**
+   * The factor by which the maximum number of simultaneous tile loads is
+   * multiplied.
+   */
+  UPROPERTY(BlueprintReadOnly, Category = "Cesium")
+  double TileLoadScale = 1.0;
+
+  /**
+   * The smoothed frame time, in milliseconds.
+   */
+  UPROPERTY(BlueprintReadOnly, Category = "Cesium")
+  double FrameTime = 0.0;
+
+  /**
+   * The smoothed frame time divided by the target frame time, or zero if
+   * there is no target.
+   */
+  UPROPERTY(BlueprintReadOnly, Category = "Cesium")
+  double FrameTimePressure = 0.0;
+
+  /**
+   * The tile data size divided by the memory ceiling, or zero if there is no
+   * ceiling.
+   */
+  UPROPERTY(BlueprintReadOnly, Category = "Cesium")
+  double MemoryPressure = 0.0;
+
+  /**
+   * The number of rendered tiles divided by the tile count ceiling, or zero if
+   * there is no ceiling.
+   */
+  UPROPERTY(BlueprintReadOnly, Category = "Cesium")
+  double TileCountPressure = 0.0;
+
+  /**
+   * The budget that is currently furthest over its target.
+   */
+  UPROPERTY(BlueprintReadOnly, Category = "Cesium")
+  ECesiumAdaptiveScreenSpaceErrorLimit LimitingFactor =
+      ECesiumAdaptiveScreenSpaceErrorLimit::None;
+};
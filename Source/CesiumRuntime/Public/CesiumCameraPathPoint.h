@@ -0,0 +1,30 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CesiumCamera.h"
+#include "CoreMinimal.h"
+
+#include "CesiumCameraPathPoint.generated.h"
+
+/**
+ * A camera pose at a point in time along a known camera path. A
+ * {@link Cesium3DTileset} uses a list of these to load tiles for upcoming
+ * poses before the camera reaches them.
+ */
+USTRUCT(BlueprintType)
+struct CESIUMRUNTIME_API FCesiumCameraPathPoint {
+  GENERATED_USTRUCT_BODY()
+
+  /**
+   * The time, in seconds, at which the camera reaches this pose.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium")
+  double Time = 0.0;
+
+  /**
+   * The camera pose at this time.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium")
+  FCesiumCamera Camera;
+};
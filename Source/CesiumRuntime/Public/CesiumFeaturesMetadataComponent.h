@@ -170,6 +170,17 @@ struct CESIUMRUNTIME_API FCesiumPropertyTableDescription {
    */
   UPROPERTY(EditAnywhere, Category = "Cesium", Meta = (TitleProperty = "Name"))
   TArray<FCesiumPropertyTablePropertyDescription> Properties;
+
+  /**
+   * @brief Whether to pack the encoded properties of this property table into
+   * one texture per pixel format, rather than encoding each property into its
+   * own texture. This reduces the number of textures that each tile creates
+   * and binds, which helps tables with many properties.
+   *
+   * The material must be regenerated after this is changed.
+   */
+  UPROPERTY(EditAnywhere, Category = "Cesium")
+  bool PackProperties = false;
 };
 
 /**
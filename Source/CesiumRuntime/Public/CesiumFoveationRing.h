@@ -0,0 +1,38 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "CesiumFoveationRing.generated.h"
+
+/**
+ * A region around the gaze direction of a player view in which tiles are
+ * refined with a given fraction of the tilesets' level of detail.
+ */
+USTRUCT(BlueprintType)
+struct CESIUMRUNTIME_API FCesiumFoveationRing {
+  GENERATED_BODY()
+
+  /**
+   * The angle, in degrees, from the gaze direction to the edge of the ring.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium",
+      meta = (ClampMin = 1.0, ClampMax = 89.0, Units = "Degrees"))
+  double Angle = 15.0;
+
+  /**
+   * The factor by which a tileset's maximum screen-space error is multiplied
+   * within this ring. A value of 1.0 keeps the full level of detail; larger
+   * values load coarser tiles.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium",
+      meta = (ClampMin = 1.0))
+  double ScreenSpaceErrorScale = 1.0;
+};
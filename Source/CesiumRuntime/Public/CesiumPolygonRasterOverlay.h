@@ -4,9 +4,16 @@
 
 #include "CesiumRasterOverlay.h"
 #include "CoreMinimal.h"
+#include <memory>
+#include <vector>
 #include "CesiumPolygonRasterOverlay.generated.h"
 
 class ACesiumCartographicPolygon;
+class CesiumPolygonClipper;
+
+namespace CesiumGeospatial {
+class CartographicPolygon;
+}
 
 namespace Cesium3DTilesSelection {
 class RasterizedPolygonsTileExcluder;
@@ -54,6 +61,38 @@ public:
   UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium")
   bool ExcludeSelectedTiles = true;
 
+  /**
+   * Whether the triangles of tiles that fall entirely within the rasterized
+   * selection should be removed as the tiles are loaded, rather than being
+   * clipped by the material pixel by pixel. The overlay still clips the
+   * triangles that cross the edges of the polygons.
+   *
+   * This reduces the cost of rendering clipped tiles, and clipped triangles
+   * do not collide with anything. But it only works when this overlay is
+   * used for clipping. Because triangles are removed as tiles are loaded, the
+   * tileset is refreshed whenever the clipping changes, such as when this
+   * property is set, when this overlay is refreshed with different polygons,
+   * or when it is deactivated or destroyed.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintGetter = GetClipTrianglesOnLoad,
+      BlueprintSetter = SetClipTrianglesOnLoad,
+      Category = "Cesium")
+  bool ClipTrianglesOnLoad = false;
+
+  UFUNCTION(BlueprintGetter, Category = "Cesium")
+  bool GetClipTrianglesOnLoad() const { return ClipTrianglesOnLoad; }
+
+  UFUNCTION(BlueprintSetter, Category = "Cesium")
+  void SetClipTrianglesOnLoad(bool bClipTrianglesOnLoad);
+
+  /**
+   * Creates the object that removes the triangles clipped by this overlay as
+   * tiles are loaded, or nullptr if ClipTrianglesOnLoad is disabled.
+   */
+  std::shared_ptr<const CesiumPolygonClipper> CreatePolygonClipper() const;
+
 protected:
   virtual std::unique_ptr<CesiumRasterOverlays::RasterOverlay> CreateOverlay(
       const CesiumRasterOverlays::RasterOverlayOptions& options = {}) override;
@@ -66,6 +105,9 @@ protected:
       CesiumRasterOverlays::RasterOverlay* pOverlay) override;
 
 private:
+  std::vector<CesiumGeospatial::CartographicPolygon>
+  CreateCartographicPolygons() const;
+
   std::shared_ptr<Cesium3DTilesSelection::RasterizedPolygonsTileExcluder>
       _pExcluder;
 };
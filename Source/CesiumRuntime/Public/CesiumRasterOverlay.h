@@ -137,6 +137,16 @@ public:
   UFUNCTION(BlueprintCallable, Category = "Cesium")
   void SetSubTileCacheBytes(int64 Value);
 
+  /**
+   * Scales the maximum number of simultaneous tile loads and the sub-tile
+   * cache size that are used by the overlay, without changing the
+   * corresponding properties. This is used by the world tile budget to
+   * prioritize the overlays of the tilesets that need the most tiles.
+   *
+   * @param Scale The factor to apply to the property values.
+   */
+  void ApplyTileBudgetScale(double Scale);
+
   /**
    * Activates this raster overlay, which will display it on the Cesium3DTileset
    * to which the component is attached, if it isn't already displayed. The
@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include "CesiumFoveationRing.h"
 #include "CoreMinimal.h"
 #include "Engine/DeveloperSettings.h"
 #include "CesiumRuntimeSettings.generated.h"
@@ -37,6 +38,55 @@ public:
       meta = (DisplayName = "Scale Level-of-Detail by Display DPI"))
   bool ScaleLevelOfDetailByDPI = true;
 
+  /**
+   * Whether to select tiles for a single view that covers both eyes of a
+   * stereo player view, rather than for each eye separately. This selects
+   * fewer tiles, but the merged view is slightly wider than either eye.
+   */
+  UPROPERTY(Config, EditAnywhere, Category = "Level of Detail|XR")
+  bool MergeStereoViews = false;
+
+  /**
+   * Whether to relax the level of detail of player views away from the gaze
+   * direction. The gaze direction is taken from the eye tracker when one is
+   * available and tracking, and is the view direction otherwise.
+   */
+  UPROPERTY(Config, EditAnywhere, Category = "Level of Detail|XR")
+  bool EnableFoveatedTileSelection = false;
+
+  /**
+   * Whether to use the eye tracker's gaze direction for foveated tile
+   * selection.
+   */
+  UPROPERTY(
+      Config,
+      EditAnywhere,
+      Category = "Level of Detail|XR",
+      meta = (EditCondition = "EnableFoveatedTileSelection"))
+  bool UseEyeTrackingForFoveation = true;
+
+  /**
+   * The rings around the gaze direction, from the innermost to the outermost,
+   * and the fraction of the level of detail that each of them keeps.
+   */
+  UPROPERTY(
+      Config,
+      EditAnywhere,
+      Category = "Level of Detail|XR",
+      meta = (EditCondition = "EnableFoveatedTileSelection"))
+  TArray<FCesiumFoveationRing> FoveationRings;
+
+  /**
+   * The factor by which tilesets' maximum screen-space error is multiplied
+   * outside of the outermost foveation ring.
+   */
+  UPROPERTY(
+      Config,
+      EditAnywhere,
+      Category = "Level of Detail|XR",
+      meta = (EditCondition = "EnableFoveatedTileSelection", ClampMin = 1.0))
+  double PeripheralScreenSpaceErrorScale = 4.0;
+
   /**
    * Uses Unreal's occlusion culling engine to drive Cesium 3D Tiles selection,
    * reducing the detail of tiles that are occluded by other objects in the
@@ -45,6 +95,75 @@ public:
   UPROPERTY(Config, EditAnywhere, Category = "Experimental Feature Flags")
   bool EnableExperimentalOcclusionCullingFeature = false;
 
+  /**
+   * The maximum time, in milliseconds, to spend each frame tearing down the
+   * Unreal components of tiles that have been unloaded. Teardown that does not
+   * fit in this budget continues in later frames. At least one tile is always
+   * torn down per frame.
+   */
+  UPROPERTY(
+      Config,
+      EditAnywhere,
+      Category = "Performance",
+      meta = (ClampMin = 0.0, Units = "Milliseconds"))
+  float TileTeardownTimeBudget = 2.0f;
+
+  /**
+   * Whether all of the tilesets in a world share one memory budget and one
+   * tile load budget. When enabled, the Maximum Cached Bytes and Maximum
+   * Simultaneous Tile Loads of each tileset are ignored. Instead, each tileset
+   * is allocated a share of the world budgets below, based on how many tiles
+   * it is waiting on to reach its maximum screen-space error. The cache size
+   * and load limit of each raster overlay are scaled by the share of its
+   * tileset.
+   */
+  UPROPERTY(Config, EditAnywhere, Category = "Performance")
+  bool EnableWorldTileBudget = false;
+
+  /**
+   * The total number of bytes of tile data that all of the tilesets in a
+   * world may cache, when Enable World Tile Budget is set.
+   */
+  UPROPERTY(
+      Config,
+      EditAnywhere,
+      Category = "Performance",
+      meta = (EditCondition = "EnableWorldTileBudget", ClampMin = 0))
+  int64 WorldMaximumCachedBytes = 1024 * 1024 * 1024;
+
+  /**
+   * The total number of tiles that all of the tilesets in a world may load at
+   * the same time, when Enable World Tile Budget is set.
+   */
+  UPROPERTY(
+      Config,
+      EditAnywhere,
+      Category = "Performance",
+      meta = (EditCondition = "EnableWorldTileBudget", ClampMin = 1))
+  int32 WorldMaximumSimultaneousTileLoads = 64;
+
+  /**
+   * Whether the textures of tiles and raster overlays drop their most detailed
+   * mip levels from GPU memory while they are far from every camera, and
+   * upload them again as the camera approaches. This keeps a copy of each
+   * texture's pixel data in system memory so that the dropped mips can be
+   * restored. Textures loaded with this disabled keep all of their mips
+   * resident.
+   */
+  UPROPERTY(Config, EditAnywhere, Category = "Performance")
+  bool EnableTextureMipStreaming = false;
+
+  /**
+   * The maximum number of textures whose resident mip levels change each
+   * frame, when Enable Texture Mip Streaming is set.
+   */
+  UPROPERTY(
+      Config,
+      EditAnywhere,
+      Category = "Performance",
+      meta = (EditCondition = "EnableTextureMipStreaming", ClampMin = 1))
+  int32 MaximumTextureMipUpdatesPerFrame = 16;
+
   /**
    * The number of requests to handle before each prune of old cached results
    * from the database.
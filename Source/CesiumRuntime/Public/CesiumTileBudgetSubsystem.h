@@ -0,0 +1,103 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CesiumTilesetBudgetUsage.h"
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+
+#include "CesiumTileBudgetSubsystem.generated.h"
+
+class ACesium3DTileset;
+
+/**
+ * Distributes one memory budget and one tile load budget among all of the
+ * {@link Cesium3DTileset}s in a world, and scales the budgets of their raster
+ * overlays accordingly.
+ *
+ * This is only active when "Enable World Tile Budget" is set in the Cesium
+ * project settings. Each tileset then reports how many tiles it is waiting on
+ * to reach its maximum screen-space error, and receives a share of the budgets
+ * that grows with that deficit. Every tileset keeps a minimum share so that a
+ * tileset that is already fully refined can still replace tiles as the camera
+ * moves.
+ *
+ * The allocations can be shown on screen with the `cesium.ShowTileBudget`
+ * console variable, or read with {@link GetTilesetBudgetUsage}.
+ */
+UCLASS()
+class CESIUMRUNTIME_API UCesiumTileBudgetSubsystem : public UWorldSubsystem {
+  GENERATED_BODY()
+
+public:
+  /**
+   * Whether the world tile budget is enabled in the project settings.
+   */
+  UFUNCTION(BlueprintPure, Category = "Cesium")
+  static bool IsWorldTileBudgetEnabled();
+
+  /**
+   * Gets the current allocation and usage of every tileset that participates
+   * in the world tile budget.
+   */
+  UFUNCTION(BlueprintCallable, Category = "Cesium")
+  TArray<FCesiumTilesetBudgetUsage> GetTilesetBudgetUsage() const;
+
+  /**
+   * Reports a tileset's usage after it has updated its view for this frame.
+   *
+   * @param pTileset The tileset.
+   * @param usedBytes The number of bytes of tile data that the tileset holds.
+   * @param tilesWaiting The number of tiles that the tileset is waiting on to
+   * meet its maximum screen-space error.
+   * @param frameNumber The number of the current frame, usually GFrameCounter.
+   */
+  void reportTilesetUsage(
+      ACesium3DTileset* pTileset,
+      int64 usedBytes,
+      int32 tilesWaiting,
+      uint64 frameNumber);
+
+  /**
+   * Gets a tileset's allocation for this frame. The allocations are
+   * recomputed from the usage reported in the previous frame the first time
+   * this is called in a frame.
+   *
+   * @param pTileset The tileset.
+   * @param frameNumber The number of the current frame, usually GFrameCounter.
+   * @return The allocation, or nullptr if the tileset has not reported its
+   * usage yet.
+   */
+  const FCesiumTilesetBudgetUsage*
+  getTilesetAllocation(const ACesium3DTileset* pTileset, uint64 frameNumber);
+
+  /**
+   * Removes a tileset from the budget, so that its share is given to the
+   * other tilesets.
+   */
+  void removeTileset(const ACesium3DTileset* pTileset);
+
+  /**
+   * Gets the number of tilesets that currently share the budget.
+   */
+  int32 getTilesetCount() const { return this->_tilesets.Num(); }
+
+  /**
+   * The fraction of each budget that is divided evenly among all tilesets,
+   * regardless of their demand.
+   */
+  static constexpr double EvenlyDividedFraction = 0.25;
+
+private:
+  void updateAllocations(uint64 frameNumber);
+  void showAllocations() const;
+
+  struct TilesetEntry {
+    TWeakObjectPtr<ACesium3DTileset> pTileset;
+    FCesiumTilesetBudgetUsage usage;
+    uint64 lastReportFrame = 0;
+  };
+
+  TArray<TilesetEntry> _tilesets;
+  uint64 _allocationFrame = TNumericLimits<uint64>::Max();
+};
@@ -0,0 +1,40 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CesiumCamera.h"
+#include "CoreMinimal.h"
+
+#include "CesiumTileSelectionSnapshot.generated.h"
+
+/**
+ * A record of the tiles that a {@link Cesium3DTileset} selected for rendering
+ * from a set of camera poses. It is saved with the level and used to
+ * warm-start the tileset the next time it is loaded, so that the whole
+ * refinement frontier is requested at once instead of being rediscovered one
+ * level at a time.
+ */
+USTRUCT(BlueprintType)
+struct CESIUMRUNTIME_API FCesiumTileSelectionSnapshot {
+  GENERATED_USTRUCT_BODY()
+
+  /**
+   * The cameras that were used to select the tiles in this snapshot. While
+   * warm-starting, these cameras are added to the views that the tileset
+   * refines for.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium")
+  TArray<FCesiumCamera> Cameras;
+
+  /**
+   * The IDs of the tiles that were rendered when this snapshot was captured.
+   * Warm-starting ends once all of these tiles are rendered again.
+   */
+  UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Cesium")
+  TArray<FString> TileIDs;
+
+  /**
+   * Whether this snapshot contains anything to warm-start from.
+   */
+  bool IsEmpty() const { return Cameras.IsEmpty() || TileIDs.IsEmpty(); }
+};
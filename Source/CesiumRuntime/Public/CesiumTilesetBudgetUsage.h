@@ -0,0 +1,57 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "CesiumTilesetBudgetUsage.generated.h"
+
+class ACesium3DTileset;
+
+/**
+ * How much of the world's tile budget a {@link Cesium3DTileset} has been
+ * allocated, and how much of it the tileset is using.
+ */
+USTRUCT(BlueprintType)
+struct CESIUMRUNTIME_API FCesiumTilesetBudgetUsage {
+  GENERATED_BODY()
+
+  /**
+   * The tileset that this usage describes.
+   */
+  UPROPERTY(BlueprintReadOnly, Category = "Cesium")
+  ACesium3DTileset* Tileset = nullptr;
+
+  /**
+   * The number of bytes of tile data that the tileset currently holds.
+   */
+  UPROPERTY(BlueprintReadOnly, Category = "Cesium")
+  int64 UsedBytes = 0;
+
+  /**
+   * The number of bytes of tile data that the tileset may cache.
+   */
+  UPROPERTY(BlueprintReadOnly, Category = "Cesium")
+  int64 AllocatedBytes = 0;
+
+  /**
+   * The number of tiles that the tileset is waiting on before its views meet
+   * its maximum screen-space error. This is the tileset's demand for the
+   * budget.
+   */
+  UPROPERTY(BlueprintReadOnly, Category = "Cesium")
+  int32 TilesWaiting = 0;
+
+  /**
+   * The number of tiles that the tileset may load at the same time.
+   */
+  UPROPERTY(BlueprintReadOnly, Category = "Cesium")
+  int32 AllocatedTileLoads = 0;
+
+  /**
+   * The fraction of the world's budget allocated to the tileset, between 0.0
+   * and 1.0.
+   */
+  UPROPERTY(BlueprintReadOnly, Category = "Cesium")
+  float Share = 0.0f;
+};
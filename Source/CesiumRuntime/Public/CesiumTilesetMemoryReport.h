@@ -0,0 +1,89 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "CesiumTilesetMemoryReport.generated.h"
+
+class ACesium3DTileset;
+
+/**
+ * An estimate of the memory used by the loaded tiles of a
+ * {@link Cesium3DTileset}, by the stage of tile loading that holds it.
+ *
+ * Meshes and textures that are shared by several tiles of the tileset are
+ * counted once. Raster overlay images that are still held by cesium-native are
+ * counted in ModelBytes, while their Unreal textures are counted in
+ * TextureBytes.
+ */
+USTRUCT(BlueprintType)
+struct CESIUMRUNTIME_API FCesiumTilesetMemoryReport {
+  GENERATED_BODY()
+
+  /**
+   * The tileset that this report describes.
+   */
+  UPROPERTY(BlueprintReadOnly, Category = "Cesium")
+  ACesium3DTileset* Tileset = nullptr;
+
+  /**
+   * The number of tiles with loaded content.
+   */
+  UPROPERTY(BlueprintReadOnly, Category = "Cesium")
+  int32 TileCount = 0;
+
+  /**
+   * The size of the tile data held by cesium-native, such as the buffers and
+   * images of decoded glTF models. This is the size that MaximumCachedBytes
+   * is compared against.
+   */
+  UPROPERTY(BlueprintReadOnly, Category = "Cesium")
+  int64 ModelBytes = 0;
+
+  /**
+   * The size of the vertex and index buffers of the tiles' static meshes.
+   */
+  UPROPERTY(BlueprintReadOnly, Category = "Cesium")
+  int64 MeshBytes = 0;
+
+  /**
+   * The size of the tiles' Chaos collision meshes.
+   */
+  UPROPERTY(BlueprintReadOnly, Category = "Cesium")
+  int64 PhysicsBytes = 0;
+
+  /**
+   * The size of the GPU textures of the tiles and of their raster overlays,
+   * along with any pixel data kept on the CPU for texture mip streaming.
+   */
+  UPROPERTY(BlueprintReadOnly, Category = "Cesium")
+  int64 TextureBytes = 0;
+
+  /**
+   * The size of the GPU textures that encode the tiles' features and
+   * metadata.
+   */
+  UPROPERTY(BlueprintReadOnly, Category = "Cesium")
+  int64 MetadataBytes = 0;
+
+  /**
+   * The size of the data that the tiles' primitive components copy out of the
+   * glTF, such as their feature and metadata descriptions and texture
+   * coordinate maps.
+   */
+  UPROPERTY(BlueprintReadOnly, Category = "Cesium")
+  int64 PrimitiveDataBytes = 0;
+
+  /**
+   * The sum of all of the other sizes.
+   */
+  UPROPERTY(BlueprintReadOnly, Category = "Cesium")
+  int64 TotalBytes = 0;
+
+  /**
+   * Gets the size of the memory that Unreal holds for the tiles, in addition
+   * to ModelBytes.
+   */
+  int64 GetUnrealBytes() const { return this->TotalBytes - this->ModelBytes; }
+};
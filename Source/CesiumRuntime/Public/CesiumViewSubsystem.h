@@ -0,0 +1,197 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "Cesium3DTilesSelection/ViewState.h"
+#include "CesiumCamera.h"
+#include "CesiumFoveationRing.h"
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include <glm/mat4x4.hpp>
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+#include <vector>
+
+#include "CesiumViewSubsystem.generated.h"
+
+class ULevel;
+class USceneCaptureComponent2D;
+
+namespace CesiumGeospatial {
+class Ellipsoid;
+}
+
+/**
+ * A camera collected by {@link UCesiumViewSubsystem}, along with the parts of
+ * its view frustum that are the same for every tileset. A tileset only needs
+ * to apply its own transform to create a view state from it.
+ */
+struct CESIUMRUNTIME_API CesiumCollectedView {
+  /**
+   * The camera that this view was derived from.
+   */
+  FCesiumCamera camera;
+
+  /**
+   * The camera location in Unreal world coordinates.
+   */
+  glm::dvec3 location{0.0};
+
+  /**
+   * The unit look direction in Unreal world coordinates.
+   */
+  glm::dvec3 direction{1.0, 0.0, 0.0};
+
+  /**
+   * The unit up direction in Unreal world coordinates.
+   */
+  glm::dvec3 up{0.0, 0.0, 1.0};
+
+  /**
+   * The size of the viewport, excluding any black bars added to achieve the
+   * camera's aspect ratio.
+   */
+  glm::dvec2 viewportSize{0.0};
+
+  /**
+   * The horizontal field of view, in radians.
+   */
+  double horizontalFieldOfView = 0.0;
+
+  /**
+   * The vertical field of view, in radians.
+   */
+  double verticalFieldOfView = 0.0;
+
+  /**
+   * Derives the tileset-independent view parameters of a camera.
+   */
+  static CesiumCollectedView fromCamera(const FCesiumCamera& camera);
+
+  /**
+   * Creates the view state that a tileset uses to select tiles for this view.
+   *
+   * @param unrealWorldToTileset The transformation from Unreal world
+   * coordinates to the tileset's coordinates.
+   * @param ellipsoid The ellipsoid of the tileset.
+   */
+  Cesium3DTilesSelection::ViewState createViewState(
+      const glm::dmat4& unrealWorldToTileset,
+      const CesiumGeospatial::Ellipsoid& ellipsoid) const;
+};
+
+/**
+ * Collects the cameras that {@link Cesium3DTileset}s select tiles for, once
+ * per frame for all of the tilesets in a world.
+ *
+ * This includes the views of the player controllers, the realtime perspective
+ * viewports of the editor, and the registered scene captures. When stereo
+ * rendering is enabled, each eye of a player is a separate view, unless
+ * "Merge Stereo Views" is enabled in the Cesium project settings, in which
+ * case both eyes are merged into one view. With
+ * "Enable Foveated Tile Selection", each player view is replaced by a
+ * peripheral view with a relaxed level of detail plus one view per foveation
+ * ring around the gaze direction. Scene capture actors are
+ * registered automatically when they are spawned or their level is added to
+ * the world. Scene capture components attached to other actors must be
+ * registered with {@link RegisterSceneCapture} to be used for tile selection.
+ */
+UCLASS()
+class CESIUMRUNTIME_API UCesiumViewSubsystem : public UWorldSubsystem {
+  GENERATED_BODY()
+
+public:
+  virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+  virtual void Deinitialize() override;
+
+  /**
+   * Registers a scene capture so that tilesets load tiles for its view. Only
+   * perspective scene captures that render to a texture target are used.
+   *
+   * @param SceneCapture The scene capture component.
+   */
+  UFUNCTION(BlueprintCallable, Category = "Cesium")
+  void RegisterSceneCapture(USceneCaptureComponent2D* SceneCapture);
+
+  /**
+   * Unregisters a scene capture that was previously registered with
+   * {@link RegisterSceneCapture}, or that was registered automatically.
+   *
+   * @param SceneCapture The scene capture component.
+   */
+  UFUNCTION(BlueprintCallable, Category = "Cesium")
+  void UnregisterSceneCapture(USceneCaptureComponent2D* SceneCapture);
+
+  /**
+   * Gets the views of the current frame. They are collected the first time
+   * this is called in a frame, and shared by later calls in the same frame.
+   *
+   * @param scaleUsingDPI Whether viewport sizes are divided by the DPI scale
+   * of their viewport.
+   * @param frameNumber The number of the current frame, usually GFrameCounter.
+   */
+  const std::vector<CesiumCollectedView>&
+  GetViews(bool scaleUsingDPI, uint64 frameNumber);
+
+  /**
+   * Appends the views that foveate a camera: a copy of the camera whose
+   * screen-space error is relaxed by the peripheral scale, and a narrower view
+   * toward the gaze direction for each ring, whose screen-space error is
+   * relaxed by the ring's scale.
+   *
+   * @param camera The camera to foveate.
+   * @param gazeRotation The rotation of the gaze direction.
+   * @param rings The foveation rings.
+   * @param peripheralScreenSpaceErrorScale The factor by which the maximum
+   * screen-space error is multiplied outside of the rings.
+   * @param cameras The cameras to append to.
+   */
+  static void appendFoveatedCameras(
+      const FCesiumCamera& camera,
+      const FRotator& gazeRotation,
+      const TArray<FCesiumFoveationRing>& rings,
+      double peripheralScreenSpaceErrorScale,
+      std::vector<FCesiumCamera>& cameras);
+
+  /**
+   * Appends six square views with a 90 degree field of view, one through each
+   * face of a cube centered on a location, which together see in every
+   * direction from it. Collision-only tilesets use these to load the tiles
+   * around a physics-relevant actor no matter which way it faces.
+   *
+   * @param location The location at the center of the cube.
+   * @param cameras The cameras to append to.
+   */
+  static void appendCubeFaceCameras(
+      const FVector& location,
+      std::vector<FCesiumCamera>& cameras);
+
+private:
+  void collectPlayerCameras(
+      bool scaleUsingDPI,
+      std::vector<FCesiumCamera>& cameras) const;
+  void collectSceneCaptures(std::vector<FCesiumCamera>& cameras);
+#if WITH_EDITOR
+  void collectEditorCameras(
+      bool scaleUsingDPI,
+      std::vector<FCesiumCamera>& cameras) const;
+#endif
+
+  void registerSceneCaptureActor(AActor* pActor);
+  void registerSceneCapturesInLevel(ULevel* pLevel);
+  void onLevelAddedToWorld(ULevel* pLevel, UWorld* pWorld);
+
+  struct ViewCache {
+    uint64 frameNumber = TNumericLimits<uint64>::Max();
+    std::vector<CesiumCollectedView> views;
+  };
+
+  // Indexed by whether DPI scaling is applied.
+  ViewCache _viewCaches[2];
+
+  TArray<TWeakObjectPtr<USceneCaptureComponent2D>> _sceneCaptures;
+  bool _sceneCapturesScanned = false;
+
+  FDelegateHandle _actorSpawnedHandle;
+  FDelegateHandle _levelAddedHandle;
+};